@@ -398,7 +398,11 @@ class Node {
   bool ClearAttribute(const std::string& attr_name);
 
   /** Gets the Node's mutable attributes. */
-  NodeAttributes& GetMutableAttributes() noexcept { return attributes_; }
+  NodeAttributes& GetMutableAttributes() noexcept {
+    // someone fetching these is going to change something
+    resolve_fingerprint_ = 0;
+    return attributes_;
+  }
 
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
@@ -687,6 +691,10 @@ class Node {
 
   // Can be saved? The node cannot be saved anymore if removable attributes have been cleared.
   bool can_be_saved_;
+
+  // Fingerprint of the node and its input/output types when type/shape inferencing last ran on the node during an
+  // incremental Graph::Resolve. 0 if not set, or if the attributes of the node have changed since.
+  uint64_t resolve_fingerprint_ = 0;
 };
 
 /**
@@ -1133,6 +1141,18 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
     return graph_resolve_needed_;
   }
 
+#if !defined(ORT_MINIMAL_BUILD)
+  /** Enable or disable incremental resolve for this Graph.
+  When enabled, Graph::Resolve only re-runs type/shape inferencing for nodes that were added or changed since the
+  previous Resolve, and for nodes downstream of them whose input types or propagated shape values changed.
+  Intended for use while graph transformers are being applied to a large graph. Values from ONNX data propagation are
+  kept on the NodeArgs while enabled so unchanged producers don't need to be re-run, and are released when disabled.
+  The first Resolve after enabling runs inferencing for all nodes.
+  Only applies to the main graph. Nodes containing subgraphs always have inferencing re-run.
+  */
+  void SetIncrementalResolve(bool enable);
+#endif
+
   /** Sets flag that Graph::graph_proto_ needs to be updated to reflect changes in the Graph. */
   Graph& SetGraphProtoSyncNeeded() noexcept {
     graph_proto_sync_needed_ = true;
@@ -1763,6 +1783,10 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
   // Remove intermediate inferred shape values stored in all NodeArgs to reduce memory usage.
   common::Status CleanUpShapeValuesFromDataPropagation();
 
+  // Compute the fingerprint of the state of the node that its type/shape inferencing depends on, other than its
+  // attributes and the values of constant inputs. See Node::resolve_fingerprint_.
+  uint64_t ComputeResolveFingerprint(const Node& node, std::string& buffer) const;
+
   // Apply type-inference and type-checking to all inputs and initializers:
   common::Status TypeCheckInputsAndInitializers();
 
@@ -1997,6 +2021,15 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
   // number of times Resolve has run.
   int num_resolves_ = 0;
 
+#if !defined(ORT_MINIMAL_BUILD)
+  // See SetIncrementalResolve
+  bool incremental_resolve_ = false;
+
+  // Names of initializers added, replaced or removed since the last Resolve. Consumers need inferencing re-run
+  // during an incremental Resolve as the values may be used by type/shape inferencing.
+  std::unordered_set<std::string> initializers_changed_since_resolve_;
+#endif
+
   const logging::Logger& logger_;
 
   // If true, all inconsistencies encountered during shape and type inference
@@ -20,6 +20,47 @@
 // If the config value is set to "1" then the prepacking is disabled, otherwise prepacking is enabled (default value)
 static const char* const kOrtSessionOptionsConfigDisablePrepacking = "session.disable_prepacking";
 
+// Use the intra-op thread pool to finalize the session state in parallel.
+// Embedded initializers placed on CPU are unpacked concurrently, kernels of nodes assigned to the CPU EP are
+// created concurrently, and PrePack is called for different nodes concurrently. The resulting session behaves the
+// same as one initialized sequentially; kernels of other EPs are still created and pre-packed sequentially.
+// Unpacked initializers are kept until all of them are loaded, so peak memory during initialization can be higher.
+// Pre-packing is not parallelized when a PrepackedWeightsContainer is used to share weights across sessions.
+// Option values:
+// - "0": Finalize the session state sequentially. [DEFAULT]
+// - "1": Finalize the session state in parallel.
+static const char* const kOrtSessionOptionsParallelInitialization = "session.parallel_initialization";
+
+// Defer pre-packing of constant initializers that are memory-mapped from external data on CPU until the node using
+// them first runs. The pre-packing for a node runs once, and concurrent Run() calls wait for it to complete.
+// Initializers of nodes that never run, e.g. in rarely taken If branches, are not read, so startup time and resident
+// memory scale with the part of the model that is used. The first run of each node is slower.
+// The other constant initializers of such a node are pre-packed with them, in input order.
+// Pre-packing is not deferred when pre-packed weights are saved with the model or shared across sessions.
+// Option values:
+// - "0": Pre-pack all constant initializers during session initialization. [DEFAULT]
+// - "1": Defer pre-packing of constant initializers memory-mapped from external data.
+static const char* const kOrtSessionOptionsLazyExternalInitializers = "session.lazy_external_initializers";
+
+// Directory of a store of pre-packed weights shared by processes on the same machine.
+// Pre-packed weights of constant initializers on CPU are written to a file in the directory, named after the op type
+// and a hash of the pre-packed content, and used from a read-only mapping of the file. Processes loading the same model
+// map the same files, so the pre-packed weights are held once in the OS page cache instead of once per process.
+// Kernels still pre-pack the weight in every process to find its file; the file is used only if its content hash
+// matches, and rewritten otherwise.
+// The directory is created if it does not exist. Not used when pre-packed weights are saved with the model.
+static const char* const kOrtSessionOptionsPrepackedWeightsStoreDir = "session.prepacked_weights_store_dir";
+
+// Leave the raw data of initializers in the model file when loading an ONNX model from a file path.
+// The model file is memory mapped and parsed without the raw data of the main graph's initializers, which are
+// referenced as external data in the model file instead. This avoids holding the serialized model, the parsed
+// ModelProto and the initializers in memory at the same time, and allows loading models larger than 2GB that store
+// their initializers inline.
+// Tensors in the model file that are not aligned to their element size are copied when loaded.
+// - "0": Parse the whole model into memory. [DEFAULT]
+// - "1": Leave the raw data of initializers in the model file.
+static const char* const kOrtSessionOptionsStreamingModelLoad = "session.streaming_model_load";
+
 // A value of "1" means allocators registered in the env will be used. "0" means the allocators created in the session
 // will be used. Use this to override the usage of env allocators on a per session level.
 static const char* const kOrtSessionOptionsConfigUseEnvAllocators = "session.use_env_allocators";
@@ -111,6 +152,13 @@ static const char* const kOrtSessionOptionsMemoryOptimizerProbeConfig = "optimiz
 // Default is an empty string which means no optimizers are disabled.
 static const char* const kOrtSessionOptionsDisableSpecifiedOptimizers = "optimization.disable_specified_optimizers";
 
+// While graph optimizations are applied, Graph::Resolve only re-runs type and shape inferencing for the nodes that
+// were changed by an optimizer and the nodes downstream of them whose input types changed. This reduces optimization
+// time for large models.
+// "0": enable; "1": disable, and re-run type and shape inferencing for the whole graph after each optimizer.
+// Its default value is "0".
+static const char* const kOrtSessionOptionsDisableIncrementalGraphResolve = "optimization.disable_incremental_resolve";
+
 // It controls whether to run graph optimizations in loop or not.
 //
 // "0": disable. Graph Optimization Loop is disabled.
@@ -172,6 +220,14 @@ static const char* const kOrtSessionOptionsConfigUseORTModelBytesDirectly = "ses
 static const char* const kOrtSessionOptionsConfigUseORTModelBytesForInitializers =
     "session.use_ort_model_bytes_for_initializers";
 
+// Memory map an ORT format model loaded from a file path instead of reading it into memory.
+// Initializers use the data in the mapped file in place, so the OS page cache holds the only copy of weights that
+// kernels don't pre-pack. ORT format models saved by this version align initializer data to 64 bytes. Initializer
+// data in older models that is not aligned is copied.
+// - "0": Read the model file into memory. Initializers are copied.
+// - "1": Memory map the model file. [DEFAULT]
+static const char* const kOrtSessionOptionsConfigMapOrtModelFile = "session.map_ort_model_file";
+
 // This should only be specified when exporting an ORT format model for use on a different platform.
 // If the ORT format model will be used on ARM platforms set to "1". For other platforms set to "0"
 // Available since version 1.11.
@@ -304,6 +360,16 @@ static const char* const kOrtSessionOptionsModelExternalInitializersFileFolderPa
 static const char* const kOrtSessionOptionsSavePrePackedConstantInitializers =
     "session.save_external_prepacked_constant_initializers";
 
+// Directory of an automatic cache of optimized models.
+// Applies to ONNX models loaded from a file path or from bytes. The cache key is a hash of the model bytes, the path,
+// size and modification time of its external data files, the session options and config entries, the registered
+// execution providers, the CPU features and the ORT version.
+// On a miss, the optimized model is saved to the directory with its initializers and pre-packed constant initializers
+// in an external data file. On a hit, the saved model is loaded instead and graph optimizations are skipped.
+// Models with nodes compiled by an execution provider are not cached. The directory must exist and be writable.
+// Sample usage: sess_options.add_session_config_entry(kOrtSessionOptionsOptimizedModelCacheDir, "/tmp/ort_cache")
+static const char* const kOrtSessionOptionsOptimizedModelCacheDir = "session.optimized_model_cache_dir";
+
 // Use this config when you want to collect memory stats for each node in the graph.
 // The file format is a CSV file with the following columns:
 // The file will be created if it does not exist, and will be overwritten if it does.
@@ -454,3 +520,27 @@ static const char* const kOrtSessionOptionsRecordEpGraphAssignmentInfo = "sessio
 // - "0": disable. (default)
 // - "1": enable.
 static const char* const kOrtSessionOptionEpEnableWeightlessEpContextNodes = "ep.enable_weightless_ep_context_nodes";
+
+// Memory budget in bytes of the prompt prefix cache of the CPU GreedySearch and Sampling generation ops.
+// The present key/value state computed for a prompt is kept in a per-session LRU cache keyed by the prompt token ids.
+// When a later prompt starts with a cached prompt, the cached state is fed as past state and only the remaining
+// tokens are run through the decoder subgraph in the first step.
+// The cache is used for batch size 1 without padding, and for decoder subgraphs that do not share past/present
+// buffers.
+// With profiling enabled, each lookup is recorded as a "prefix_kv_cache_lookup" event whose args hold whether it hit,
+// the number of reused tokens and the cumulative lookup, hit, eviction, entry and byte counters of the cache.
+// Option values:
+// - "0": Prefix cache is disabled. [DEFAULT]
+// - Positive integer: Maximum number of bytes of key/value state kept in the cache.
+static const char* const kOrtSessionOptionsGenerationPrefixCacheMaxBytes = "generation.prefix_cache_max_bytes";
+
+// Query chunk size of prefill in the CPU Attention, MultiHeadAttention and GroupQueryAttention kernels.
+// When the query sequence length is larger than the chunk size, the queries are processed in chunks that attend to
+// the whole key/value sequence, so the scratch memory of attention probabilities is bounded by
+// chunk size x total sequence length per thread instead of growing with the square of the prompt length.
+// Nodes that output Q*K' are not chunked. The option also applies to the attention nodes in the subgraphs of the
+// generation ops (BeamSearch, GreedySearch and Sampling).
+// Option values:
+// - "0": Chunked prefill is disabled. [DEFAULT]
+// - Positive integer: Number of query tokens per chunk.
+static const char* const kOrtSessionOptionsAttentionPrefillChunkSize = "attention.prefill_chunk_size";
@@ -17,8 +17,11 @@ class AttentionCPUBase : public AttentionBase {
  protected:
   AttentionCPUBase(const OpKernelInfo& info, bool require_same_hidden_size)
       : AttentionBase(info, require_same_hidden_size) {
+    prefill_chunk_size_ = GetAttentionPrefillChunkSize(info.GetConfigOptions());
   }
 
+  int prefill_chunk_size_;  // number of queries per chunk of chunked prefill, 0 if disabled
+
   template <typename T>
   Status ApplyAttention(const T* Q,                // Q data with shape BxNxSxH
                         const T* K,                // K data with shape BxNxLxH
@@ -58,8 +61,26 @@ class AttentionCPUBase : public AttentionBase {
     // Total sequence length including that of past state: T = P + L
     const int total_sequence_length = past_sequence_length + kv_sequence_length;
 
-    // Merge causal mask with padding mask, and convert values from 0/1 to -inf/0, then broadcast to 3D (BxSxT).
     bool causal = (is_unidirectional_ && sequence_length > 1);
+
+    // The 3D mask cannot be applied one chunk at a time without materializing it, so it is not chunked.
+    const bool is_3d_mask = mask_index != nullptr && mask_index->Shape().NumDimensions() > 2;
+    if (prefill_chunk_size_ > 0 && sequence_length > prefill_chunk_size_ && output_qk == nullptr &&
+        !past_present_share_buffer && !is_3d_mask) {
+      const T* past_data = past != nullptr ? past->Data<T>() : nullptr;
+      const T* past_key_data = past_key != nullptr ? past_key->Data<T>() : nullptr;
+      const T* past_value_data = past_value != nullptr ? past_value->Data<T>() : nullptr;
+      T* present_data = present != nullptr ? present->MutableData<T>() : nullptr;
+      T* present_key_data = present_key != nullptr ? present_key->MutableData<T>() : nullptr;
+      T* present_value_data = present_value != nullptr ? present_value->MutableData<T>() : nullptr;
+      return ApplyChunkedAttention(Q, K, V, mask_index, past_data, past_key_data, past_value_data, present_data,
+                                   present_key_data, present_value_data, output->MutableData<T>(), batch_size,
+                                   sequence_length, kv_sequence_length, past_sequence_length,
+                                   qk_head_size == 0 ? v_head_size : qk_head_size, v_head_size, v_hidden_size, causal,
+                                   attn_bias, allocator, tp);
+    }
+
+    // Merge causal mask with padding mask, and convert values from 0/1 to -inf/0, then broadcast to 3D (BxSxT).
     void* mask_data = nullptr;
     if (mask_index != nullptr || causal) {
       size_t mask_data_bytes = SafeInt<size_t>(batch_size) * sequence_length * total_sequence_length * sizeof(T);
@@ -126,6 +147,185 @@ class AttentionCPUBase : public AttentionBase {
     return Status::OK();
   }
 
+  // Prefill in chunks of prefill_chunk_size_ queries. Keys and values are concatenated to the present state first,
+  // then each task computes softmax(Q_chunk x K' + mask) x V for one chunk of one head. The mask is built per row from
+  // a (B)xT key padding mask and the causal position, so no BxSxT or BxNxSxT buffer is allocated.
+  template <typename T>
+  Status ApplyChunkedAttention(const T* Q,                // Q data with shape BxNxSxH
+                               const T* K,                // K data with shape BxNxLxH
+                               const T* V,                // V value with size BxNxLxH_v
+                               const Tensor* mask_index,  // 1D or 2D key padding mask, or nullptr
+                               const T* past,             // past state
+                               const T* past_key,         // past key only (if not using past state)
+                               const T* past_value,       // past value only (if not using past state)
+                               T* present,                // present state
+                               T* present_key,            // present key only (if not using present state)
+                               T* present_value,          // present value only (if not using present state)
+                               T* output,                 // output with shape BxSxNxH_v
+                               int batch_size,            // batch size (B)
+                               int sequence_length,       // sequence length of Q (S)
+                               int kv_sequence_length,    // sequence length of K or V (L)
+                               int past_sequence_length,  // sequence length of past state (P)
+                               int qk_head_size,          // head size of Q or K (H)
+                               int v_head_size,           // head size of V (H_v)
+                               int v_hidden_size,         // hidden size of V (D_v)
+                               bool causal,               // whether to apply the causal mask
+                               const Tensor* attn_bias,   // additive bias applied on scaled QK.
+                               AllocatorPtr allocator,
+                               ThreadPool* tp) const {
+    const int total_sequence_length = past_sequence_length + kv_sequence_length;  // T = P + L
+    const size_t k_past_chunk_length = SafeInt<size_t>(past_sequence_length) * qk_head_size;
+    const size_t k_input_chunk_length = SafeInt<size_t>(kv_sequence_length) * qk_head_size;
+    const size_t k_present_chunk_length = k_past_chunk_length + k_input_chunk_length;
+    const size_t v_past_chunk_length = SafeInt<size_t>(past_sequence_length) * v_head_size;
+    const size_t v_input_chunk_length = SafeInt<size_t>(kv_sequence_length) * v_head_size;
+    const size_t v_present_chunk_length = v_past_chunk_length + v_input_chunk_length;
+    const size_t q_input_chunk_length = SafeInt<size_t>(sequence_length) * qk_head_size;
+    const ptrdiff_t loop_len = SafeInt<ptrdiff_t>(batch_size) * num_heads_;
+
+    // Key padding mask converted to mask_filter_value/0.0f with shape (B)xT.
+    void* key_mask_data = nullptr;
+    if (mask_index != nullptr) {
+      size_t key_mask_bytes = SafeInt<size_t>(batch_size) * total_sequence_length * sizeof(T);
+      key_mask_data = allocator->Alloc(key_mask_bytes);
+      memset(key_mask_data, 0, key_mask_bytes);
+      PrepareMask(mask_index->Data<int32_t>(), mask_index->Shape().GetDims(), static_cast<T*>(key_mask_data),
+                  false, batch_size, 1, kv_sequence_length, past_sequence_length, mask_filter_value_);
+    }
+    BufferUniquePtr key_mask_buffer(key_mask_data, BufferDeleter(allocator));
+    const T* key_mask = static_cast<const T*>(key_mask_data);
+
+    // Concatenate past and new keys and values into the present state.
+    const T* k_base = K;
+    size_t k_chunk_length = k_input_chunk_length;
+    const T* v_base = V;
+    size_t v_chunk_length = v_input_chunk_length;
+    if (present != nullptr || present_key != nullptr) {
+      if (present != nullptr) {
+        // Past and present state hold keys followed by values, so values start after the (BxNx)PxH or (BxNx)TxH keys.
+        const T* past_v = past != nullptr ? past + SafeInt<ptrdiff_t>(loop_len) * k_past_chunk_length : nullptr;
+        T* present_v = present + SafeInt<ptrdiff_t>(loop_len) * k_present_chunk_length;
+        past_key = past;
+        past_value = past_v;
+        present_key = present;
+        present_value = present_v;
+      }
+
+      TensorOpCost unit_cost;
+      unit_cost.bytes_loaded = static_cast<double>((k_present_chunk_length + v_present_chunk_length) * sizeof(T));
+      unit_cost.bytes_stored = unit_cost.bytes_loaded;
+      unit_cost.compute_cycles = 0;
+      ThreadPool::TryParallelFor(tp, loop_len, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i != end; ++i) {
+          ConcatStateChunk(past_key, K + k_input_chunk_length * i, present_key, k_past_chunk_length,
+                           k_present_chunk_length, i);
+          ConcatStateChunk(past_value, V + v_input_chunk_length * i, present_value, v_past_chunk_length,
+                           v_present_chunk_length, i);
+        }
+      });
+
+      k_base = present_key;
+      k_chunk_length = k_present_chunk_length;
+      v_base = present_value;
+      v_chunk_length = v_present_chunk_length;
+    }
+
+    const T* attn_bias_data = attn_bias != nullptr ? attn_bias->Data<T>() : nullptr;
+    auto attn_bias_dims = attn_bias != nullptr ? attn_bias->Shape().GetDims() : gsl::span<const int64_t>{};
+    const ptrdiff_t probs_matrix_size = SafeInt<ptrdiff_t>(sequence_length) * total_sequence_length;
+    const bool has_mask = key_mask != nullptr || causal;
+    const float alpha = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(qk_head_size)) : scale_;
+
+    const int chunk_size = prefill_chunk_size_;
+    const int num_chunks = (sequence_length + chunk_size - 1) / chunk_size;
+
+    TensorOpCost unit_cost;
+    unit_cost.compute_cycles = static_cast<double>(SafeInt<ptrdiff_t>(2) * chunk_size * total_sequence_length *
+                                                   (qk_head_size + v_head_size));
+    unit_cost.bytes_loaded = static_cast<double>(SafeInt<ptrdiff_t>(total_sequence_length) *
+                                                 (qk_head_size + v_head_size + chunk_size) * sizeof(T));
+    unit_cost.bytes_stored = static_cast<double>(SafeInt<ptrdiff_t>(chunk_size) *
+                                                 (total_sequence_length + v_head_size) * sizeof(T));
+
+    ThreadPool::TryParallelFor(tp, loop_len * num_chunks, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      const size_t buffer_bytes = SafeInt<size_t>(chunk_size) * (total_sequence_length + v_head_size) * sizeof(T);
+      auto buffer = allocator->Alloc(buffer_bytes);
+      BufferUniquePtr scratch_buffer(buffer, BufferDeleter(allocator));
+      T* probs = static_cast<T*>(buffer);
+      T* out_tmp = probs + SafeInt<ptrdiff_t>(chunk_size) * total_sequence_length;
+
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        const std::ptrdiff_t head_offset = i / num_chunks;  // batch_index * num_heads_ + head_index
+        const int batch_index = static_cast<int>(head_offset / num_heads_);
+        const int head_index = static_cast<int>(head_offset % num_heads_);
+        const int chunk_start = static_cast<int>(i % num_chunks) * chunk_size;
+        const int chunk_length = std::min(chunk_size, sequence_length - chunk_start);
+
+        const T* attn_bias_head = nullptr;
+        if (attn_bias_data != nullptr) {
+          // Attention bias has shape (B or 1, N or 1, S, T)
+          ptrdiff_t attn_bias_offset = 0;
+          if (attn_bias_dims[0] != 1) {
+            attn_bias_offset += SafeInt<ptrdiff_t>(batch_index) * attn_bias_dims[1] * probs_matrix_size;
+          }
+          if (attn_bias_dims[1] != 1) {
+            attn_bias_offset += SafeInt<ptrdiff_t>(head_index) * probs_matrix_size;
+          }
+          attn_bias_head = attn_bias_data + attn_bias_offset;
+        }
+
+        // Initialize the scores with attention bias and mask, in the same order as ComputeAttentionProbs.
+        for (int s = 0; s < chunk_length; s++) {
+          const int seq = chunk_start + s;
+          T* row = probs + SafeInt<ptrdiff_t>(s) * total_sequence_length;
+          if (attn_bias_head != nullptr) {
+            memcpy(row, attn_bias_head + SafeInt<ptrdiff_t>(seq) * total_sequence_length,
+                   SafeInt<size_t>(total_sequence_length) * sizeof(T));
+          } else if (has_mask) {
+            memset(row, 0, SafeInt<size_t>(total_sequence_length) * sizeof(T));
+          }
+
+          if (has_mask) {
+            const T* key_mask_row = key_mask != nullptr ? key_mask + SafeInt<ptrdiff_t>(batch_index) * total_sequence_length
+                                                        : nullptr;
+            const int causal_length = causal ? past_sequence_length + seq + 1 : total_sequence_length;
+            for (int t = 0; t < total_sequence_length; t++) {
+              if (t >= causal_length) {
+                row[t] += static_cast<T>(mask_filter_value_);
+              } else if (key_mask_row != nullptr) {
+                row[t] += key_mask_row[t];
+              }
+            }
+          }
+        }
+
+        math::Gemm<T, ThreadPool>(CblasNoTrans, CblasTrans, chunk_length, total_sequence_length, qk_head_size, alpha,
+                                  Q + q_input_chunk_length * head_offset + SafeInt<ptrdiff_t>(chunk_start) * qk_head_size,
+                                  k_base + k_chunk_length * head_offset,
+                                  (has_mask || attn_bias_head != nullptr) ? 1.0f : 0.0f,
+                                  probs, nullptr, &mlas_backend_kernel_selector_config_);
+
+        ComputeAttentionSoftmaxInplace(probs, chunk_length, total_sequence_length, nullptr);
+
+        math::MatMul<T>(chunk_length, v_head_size, total_sequence_length, probs, v_base + v_chunk_length * head_offset,
+                        out_tmp, nullptr, &mlas_backend_kernel_selector_config_);
+
+        // Transpose: out_tmp(S_chunk, H_v) -> out(B, S, N, H_v)
+        const size_t bytes_to_copy_trans = SafeInt<size_t>(v_head_size) * sizeof(T);
+        T* dest = output + (SafeInt<ptrdiff_t>(batch_index) * sequence_length * num_heads_ + head_index) * v_head_size +
+                  SafeInt<ptrdiff_t>(chunk_start) * v_hidden_size;
+        const T* src = out_tmp;
+        for (int s = 0; s < chunk_length; s++) {
+          memcpy(dest, src, bytes_to_copy_trans);
+          src += v_head_size;
+          dest += v_hidden_size;
+        }
+      }
+    });
+
+    return Status::OK();
+  }
+
   // For DecoderMaskedMultiHeadAttention
   template <typename T>
   Status ApplyAttentionWithBeams(const T* Q,
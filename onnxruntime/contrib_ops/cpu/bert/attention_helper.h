@@ -3,13 +3,19 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
+#include <string>
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
+#include "core/common/parse_string.h"
 #include "core/common/safeint.h"
+#include "core/framework/config_options.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 using onnxruntime::concurrency::ThreadPool;
 
@@ -175,5 +181,60 @@ T* ConcatStateChunkGQA(const T* past,
   return start;
 }
 
+// Quantize rows x H of key or value to int8 with a per tensor scale (one element) or a per channel scale
+// (H elements of the kv head). Values are rounded to nearest even and saturated, like the CUDA kernels.
+inline void QuantizeKVChunkInt8(const float* src,
+                                int8_t* dst,
+                                size_t rows,
+                                size_t head_size,
+                                const float* scale,
+                                bool per_channel) {
+  for (size_t r = 0; r < rows; r++) {
+    for (size_t h = 0; h < head_size; h++) {
+      const float sc = per_channel ? scale[h] : scale[0];
+      const float q = std::nearbyint(src[h] * (sc == 0.0f ? 0.0f : 1.0f / sc));
+      dst[h] = static_cast<int8_t>(std::min(127.0f, std::max(-128.0f, q)));
+    }
+    src += head_size;
+    dst += head_size;
+  }
+}
+
+// GQA version of ConcatStateChunk for an int8 KV cache: the past chunk is copied as is and the new chunk is
+// quantized while it is appended. Returns a pointer to the start of present state chunk.
+inline int8_t* ConcatQuantizedStateChunkGQA(const int8_t* past,
+                                            const float* chunk,
+                                            int8_t* present,
+                                            size_t present_buff_chunk_length,
+                                            size_t past_buff_chunk_length,
+                                            size_t past_chunk_length,
+                                            size_t new_chunk_length,
+                                            size_t head_size,
+                                            const float* scale,
+                                            bool per_channel,
+                                            bool past_present_share_buffer,
+                                            std::ptrdiff_t i) {
+  int8_t* start = present + i * present_buff_chunk_length;
+
+  int8_t* p = start;
+  if (!past_present_share_buffer && past_chunk_length > 0) {
+    const int8_t* src_past = past + i * past_buff_chunk_length;
+    memcpy(p, src_past, past_chunk_length * sizeof(int8_t));
+  }
+  p += past_chunk_length;
+
+  QuantizeKVChunkInt8(chunk, p, new_chunk_length / head_size, head_size, scale, per_channel);
+  return start;
+}
+
+// Returns the query chunk size of chunked prefill set in the session options, or 0 when it is disabled.
+inline int GetAttentionPrefillChunkSize(const ConfigOptions& config_options) {
+  const std::string value = config_options.GetConfigOrDefault(kOrtSessionOptionsAttentionPrefillChunkSize, "0");
+  int chunk_size = 0;
+  ORT_ENFORCE(TryParseStringWithClassicLocale(value, chunk_size) && chunk_size >= 0,
+              "Invalid value for ", kOrtSessionOptionsAttentionPrefillChunkSize, ": ", value);
+  return chunk_size;
+}
+
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -3,12 +3,17 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cctype>
+#include <string>
+
 #include "contrib_ops/cpu/bert/attention_base.h"
 #include "contrib_ops/cpu/bert/attention_common.h"
 #include "contrib_ops/cpu/bert/attention_helper.h"
 #include "contrib_ops/cpu/bert/attention_parameters.h"
 
 #include "core/common/common.h"
+#include "core/common/inlined_containers.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/mlas_backend_kernel_selector_config_utils.h"
@@ -41,6 +46,12 @@ class GQAAttentionBase {
 
     qk_output_ = static_cast<int>(info.GetAttrOrDefault<int64_t>("qk_output", static_cast<int64_t>(QKOutputType::NO_OUTPUT)));
 
+    k_quant_type_ = ParseKVQuantizationType(info.GetAttrOrDefault<std::string>("k_quant_type", "NONE"));
+    v_quant_type_ = ParseKVQuantizationType(info.GetAttrOrDefault<std::string>("v_quant_type", "NONE"));
+    kv_cache_bit_width_ = static_cast<int>(info.GetAttrOrDefault<int64_t>("kv_cache_bit_width", 0));
+
+    prefill_chunk_size_ = GetAttentionPrefillChunkSize(info.GetConfigOptions());
+
     SetupMlasBackendKernelSelectorFromConfigOptions(mlas_backend_kernel_selector_config_, info.GetConfigOptions());
   }
 
@@ -55,6 +66,16 @@ class GQAAttentionBase {
 
   bool use_smooth_softmax_;
 
+  KVQuantizationType k_quant_type_;  // quantization of the K cache
+  KVQuantizationType v_quant_type_;  // quantization of the V cache
+  int kv_cache_bit_width_;           // bit width of the quantized KV cache, 0 if not specified
+
+  int prefill_chunk_size_;  // number of queries per chunk of chunked prefill, 0 if disabled
+
+  bool IsKVCacheQuantized() const {
+    return k_quant_type_ != KVQuantizationType::NONE || v_quant_type_ != KVQuantizationType::NONE;
+  }
+
   template <typename T>
   Status ApplyAttention(const T* Q,                                 // Q data with shape BxNxSxH
                         const T* K,                                 // K data with shape BxN_kvxSxH
@@ -87,6 +108,13 @@ class GQAAttentionBase {
     }
     int seqlen_present_kv_cache = static_cast<int>(present_key->Shape().GetDims()[2]);
 
+    if constexpr (std::is_same_v<T, float>) {
+      if (prefill_chunk_size_ > 0 && sequence_length > prefill_chunk_size_ && output_qk == nullptr) {
+        return ApplyChunkedAttention(Q, K, V, head_sink, attention_bias, past_key, past_value, output, present_key,
+                                     present_value, seqlens_k, parameters, allocator, context);
+      }
+    }
+
     // Compute the attention score.
     bool gqa_mlas_supported = MlasGQASupported<T>(CblasNoTrans, CblasTrans) &&
                               MlasGQASupported<T>(CblasNoTrans, CblasNoTrans);
@@ -139,7 +167,365 @@ class GQAAttentionBase {
     return Status::OK();
   }
 
+  // Prefill in chunks of prefill_chunk_size_ queries. Keys and values are appended to the present cache first, then
+  // each task computes softmax(Q_chunk x K') x V for one chunk of one head. The attention probs of a chunk are kept
+  // in a per task buffer of chunk x T, instead of the B x N x S x T buffer of ApplyAttention.
+  Status ApplyChunkedAttention(const float* Q,                              // Q data with shape BxNxSxH
+                               const float* K,                              // K data with shape BxN_kvxSxH
+                               const float* V,                              // V data with shape BxN_kvxSxH
+                               const float* head_sink,                      // Head sink for smooth softmax
+                               const Tensor* attention_bias,                // Attention bias to add to QxK'
+                               const Tensor* past_key,                      // past K input tensor
+                               const Tensor* past_value,                    // past V input tensor
+                               Tensor* output,                              // output tensor
+                               Tensor* present_key,                         // present K output tensor
+                               Tensor* present_value,                       // present V output tensor
+                               const Tensor* seqlens_k,                     // past sequence lengths tensor
+                               GroupQueryAttentionParameters& parameters,  // attention parameters
+                               AllocatorPtr allocator,                      // allocator for temporary tensors
+                               OpKernelContext* context) const {
+    const bool is_prompt = parameters.is_first_prompt;
+    const size_t batch_size = static_cast<size_t>(parameters.batch_size);
+    const size_t sequence_length = static_cast<size_t>(parameters.sequence_length);
+    const size_t total_sequence_length = static_cast<size_t>(parameters.total_sequence_length);
+    const size_t head_size = static_cast<size_t>(parameters.head_size);
+    const size_t hidden_size = static_cast<size_t>(parameters.hidden_size);
+    const bool packed_qkv = parameters.is_packed_qkv;
+
+    auto* tp = context->GetOperatorThreadPool();
+
+    const size_t past_buffer_sequence_length = past_key != nullptr ? static_cast<size_t>(past_key->Shape()[2]) : 0;
+    const size_t present_buffer_sequence_length = static_cast<size_t>(present_key->Shape()[2]);
+
+    const float* past_key_data = past_key != nullptr ? past_key->Data<float>() : nullptr;
+    const float* past_value_data = past_value != nullptr ? past_value->Data<float>() : nullptr;
+    float* present_key_data = present_key->MutableData<float>();
+    float* present_value_data = present_value->MutableData<float>();
+    const bool past_present_share_buffer = past_key_data == present_key_data && past_value_data == present_value_data;
+
+    const float* attention_bias_data = attention_bias != nullptr ? attention_bias->Data<float>() : nullptr;
+    auto attention_bias_shape = attention_bias != nullptr ? attention_bias->Shape().GetDims() : gsl::span<const int64_t>{};
+    const int32_t* seqlens = seqlens_k->Data<int32_t>();
+
+    const ptrdiff_t packed_batch_stride =
+        packed_qkv ? SafeInt<ptrdiff_t>(num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size
+                   : SafeInt<ptrdiff_t>(0);
+    const float* k_input = packed_qkv ? Q + num_heads_ * sequence_length * head_size : K;
+    const float* v_input = packed_qkv ? Q + (num_heads_ + kv_num_heads_) * sequence_length * head_size : V;
+    const size_t kv_num_heads_factor = num_heads_ / kv_num_heads_;
+    const size_t q_input_chunk_length = sequence_length * head_size;                      // S x H
+    const size_t kv_input_chunk_length = sequence_length * head_size;                     // L x H
+    const size_t past_buff_chunk_length = past_buffer_sequence_length * head_size;        // L x H
+    const size_t present_buff_chunk_length = present_buffer_sequence_length * head_size;  // T x H
+
+    if (!past_present_share_buffer) {
+      const size_t present_bytes = SafeInt<size_t>(batch_size) * kv_num_heads_ * present_buff_chunk_length * sizeof(float);
+      memset(present_key_data, 0, present_bytes);
+      memset(present_value_data, 0, present_bytes);
+    }
+
+    // Append new keys and values to the present cache once per kv head.
+    {
+      TensorOpCost unit_cost;
+      unit_cost.bytes_loaded = static_cast<double>(2 * (present_buff_chunk_length + kv_input_chunk_length) * sizeof(float));
+      unit_cost.bytes_stored = static_cast<double>(2 * present_buff_chunk_length * sizeof(float));
+      unit_cost.compute_cycles = 0;
+
+      ThreadPool::TryParallelFor(tp, batch_size * kv_num_heads_, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i != end; ++i) {
+          const size_t batch_index = i / kv_num_heads_;
+          const size_t kv_head_index = i % kv_num_heads_;
+          const size_t total_seqlen = static_cast<size_t>(seqlens[batch_index]) + 1;
+          const size_t past_seqlen = is_prompt ? 0 : total_seqlen - sequence_length;  // Assume no padding sequence length
+          const size_t past_chunk_length = past_seqlen * head_size;
+
+          const ptrdiff_t input_offset = packed_qkv
+                                             ? packed_batch_stride * batch_index + kv_input_chunk_length * kv_head_index
+                                             : SafeInt<ptrdiff_t>(kv_input_chunk_length) * i;
+          ConcatStateChunkGQA(past_key_data, k_input + input_offset, present_key_data, present_buff_chunk_length,
+                              past_buff_chunk_length, past_chunk_length, kv_input_chunk_length,
+                              past_present_share_buffer, i);
+          ConcatStateChunkGQA(past_value_data, v_input + input_offset, present_value_data, present_buff_chunk_length,
+                              past_buff_chunk_length, past_chunk_length, kv_input_chunk_length,
+                              past_present_share_buffer, i);
+        }
+      });
+    }
+
+    const size_t chunk_size = static_cast<size_t>(prefill_chunk_size_);
+    const size_t num_chunks = (sequence_length + chunk_size - 1) / chunk_size;
+    const float alpha = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+    float* output_data = output->MutableData<float>();
+
+    TensorOpCost unit_cost;
+    unit_cost.compute_cycles =
+        static_cast<double>(SafeInt<ptrdiff_t>(4) * chunk_size * head_size * present_buffer_sequence_length);
+    unit_cost.bytes_loaded =
+        static_cast<double>((chunk_size + 2 * present_buffer_sequence_length) * head_size * sizeof(float));
+    unit_cost.bytes_stored = static_cast<double>(chunk_size * head_size * sizeof(float));
+
+    ThreadPool::TryParallelFor(tp, batch_size * num_heads_ * num_chunks, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      const size_t probs_bytes = SafeInt<size_t>(chunk_size) * present_buffer_sequence_length * sizeof(float);
+      auto probs_buffer = allocator->Alloc(probs_bytes);
+      BufferUniquePtr scratch_buffer(probs_buffer, BufferDeleter(allocator));
+      float* probs = static_cast<float*>(probs_buffer);
+
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        const size_t head_offset = i / num_chunks;  // batch_index * num_heads_ + head_index
+        const size_t batch_index = head_offset / num_heads_;
+        const size_t head_index = head_offset % num_heads_;
+        const size_t chunk_start = (i % num_chunks) * chunk_size;
+        const size_t chunk_length = std::min(chunk_size, sequence_length - chunk_start);
+        const size_t total_seqlen = static_cast<size_t>(seqlens[batch_index]) + 1;
+        const size_t past_seqlen = is_prompt ? 0 : total_seqlen - sequence_length;  // Assume no padding sequence length
+
+        // Keys after the causal position of the last query in the chunk are masked, so they are skipped.
+        const size_t kv_length = std::min(past_seqlen + chunk_start + chunk_length, total_seqlen);
+
+        const ptrdiff_t kv_offset =
+            SafeInt<ptrdiff_t>(batch_index * kv_num_heads_ + head_index / kv_num_heads_factor) * present_buff_chunk_length;
+        const float* k = present_key_data + kv_offset;
+        const float* v = present_value_data + kv_offset;
+
+        const float* q = packed_qkv ? Q + packed_batch_stride * batch_index + q_input_chunk_length * head_index
+                                    : Q + q_input_chunk_length * head_offset;
+        q += chunk_start * head_size;
+
+        math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasTrans, chunk_length, kv_length, head_size, alpha, q,
+                                        static_cast<int>(head_size), k, static_cast<int>(head_size), 0.0f /*beta*/,
+                                        probs, static_cast<int>(present_buffer_sequence_length), nullptr,
+                                        &mlas_backend_kernel_selector_config_);
+
+        ptrdiff_t attention_total_seqlen = 0;
+        const float* attention_bias_thread = GetAttentionBiasForHead(attention_bias_data, attention_bias_shape,
+                                                                     sequence_length, batch_index, head_index,
+                                                                     attention_total_seqlen);
+        if (attention_bias_thread != nullptr) {
+          attention_bias_thread += SafeInt<ptrdiff_t>(chunk_start) * attention_total_seqlen;
+        }
+
+        ComputeSoftmaxForHead(probs, attention_bias_thread, attention_total_seqlen, static_cast<float*>(nullptr),
+                              static_cast<float*>(nullptr), head_sink, head_index, chunk_length,
+                              past_seqlen + chunk_start, total_seqlen, total_sequence_length,
+                              present_buffer_sequence_length);
+
+        // out(S_chunk, H) = probs(S_chunk, T) x V(T, H), written to rows of the BxSxNxH output.
+        float* output_current = output_data + (batch_index * sequence_length * num_heads_ + head_index) * head_size +
+                                chunk_start * hidden_size;
+        math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasNoTrans, chunk_length, head_size, kv_length, 1.f /*alpha*/,
+                                        probs, static_cast<int>(present_buffer_sequence_length), v,
+                                        static_cast<int>(head_size), 0.0f /*beta*/, output_current,
+                                        static_cast<int>(hidden_size), nullptr, &mlas_backend_kernel_selector_config_);
+      }
+    });
+
+    return Status::OK();
+  }
+
+  // Attention over an int8 KV cache. New keys and values are quantized while they are appended to the present
+  // cache, and the cache is consumed by dot products that convert int8 to float on the fly, so no dequantized copy
+  // of the cache is materialized. The K scale is folded into the query and the V scale into the output.
+  // Scales are either per tensor (one element) or per channel (kv_num_heads x head_size elements).
+  Status ApplyAttentionWithQuantizedKVCache(const float* Q,                              // Q data with shape BxNxSxH
+                                            const float* K,                              // K data with shape BxN_kvxSxH
+                                            const float* V,                              // V data with shape BxN_kvxSxH
+                                            const float* head_sink,                      // Head sink for smooth softmax
+                                            const Tensor* attention_bias,                // Attention bias to add to QxK'
+                                            const Tensor* past_key,                      // past K input tensor (int8)
+                                            const Tensor* past_value,                    // past V input tensor (int8)
+                                            Tensor* output,                              // output tensor
+                                            Tensor* present_key,                         // present K output tensor (int8)
+                                            Tensor* present_value,                       // present V output tensor (int8)
+                                            Tensor* output_qk,                           // output QK buffer
+                                            const Tensor* seqlens_k,                     // past sequence lengths tensor
+                                            const float* k_scale,                        // scale of K cache
+                                            const float* v_scale,                        // scale of V cache
+                                            GroupQueryAttentionParameters& parameters,  // attention parameters
+                                            AllocatorPtr allocator,                      // allocator for temporary tensors
+                                            OpKernelContext* context) const {
+    const bool is_prompt = parameters.is_first_prompt;
+    const size_t batch_size = static_cast<size_t>(parameters.batch_size);
+    const size_t sequence_length = static_cast<size_t>(parameters.sequence_length);
+    const size_t total_sequence_length = static_cast<size_t>(parameters.total_sequence_length);
+    const size_t head_size = static_cast<size_t>(parameters.head_size);
+    const size_t hidden_size = static_cast<size_t>(parameters.hidden_size);
+    const bool packed_qkv = parameters.is_packed_qkv;
+    const bool k_per_channel = k_quant_type_ == KVQuantizationType::PER_CHANNEL;
+    const bool v_per_channel = v_quant_type_ == KVQuantizationType::PER_CHANNEL;
+
+    auto* tp = context->GetOperatorThreadPool();
+
+    const size_t past_buffer_sequence_length = past_key != nullptr ? static_cast<size_t>(past_key->Shape()[2]) : 0;
+    const size_t present_buffer_sequence_length = static_cast<size_t>(present_key->Shape()[2]);
+
+    const int8_t* past_key_data = past_key != nullptr ? past_key->Data<int8_t>() : nullptr;
+    const int8_t* past_value_data = past_value != nullptr ? past_value->Data<int8_t>() : nullptr;
+    int8_t* present_key_data = present_key->MutableData<int8_t>();
+    int8_t* present_value_data = present_value->MutableData<int8_t>();
+    const bool past_present_share_buffer = past_key_data == present_key_data && past_value_data == present_value_data;
+
+    const float* attention_bias_data = attention_bias != nullptr ? attention_bias->Data<float>() : nullptr;
+    auto attention_bias_shape = attention_bias != nullptr ? attention_bias->Shape().GetDims() : gsl::span<const int64_t>{};
+    float* output_qk_buffer = output_qk != nullptr ? output_qk->MutableData<float>() : nullptr;
+    const int32_t* seqlens = seqlens_k->Data<int32_t>();
+
+    const ptrdiff_t packed_batch_stride =
+        packed_qkv ? SafeInt<ptrdiff_t>(num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size
+                   : SafeInt<ptrdiff_t>(0);
+    const float* k_input = packed_qkv ? Q + num_heads_ * sequence_length * head_size : K;
+    const float* v_input = packed_qkv ? Q + (num_heads_ + kv_num_heads_) * sequence_length * head_size : V;
+    const size_t kv_num_heads_factor = num_heads_ / kv_num_heads_;
+    const size_t q_input_chunk_length = sequence_length * head_size;                      // S x H
+    const size_t kv_input_chunk_length = sequence_length * head_size;                     // L x H
+    const size_t past_buff_chunk_length = past_buffer_sequence_length * head_size;        // L x H
+    const size_t present_buff_chunk_length = present_buffer_sequence_length * head_size;  // T x H
+
+    if (!past_present_share_buffer) {
+      memset(present_key_data, 0, batch_size * kv_num_heads_ * present_buff_chunk_length);
+      memset(present_value_data, 0, batch_size * kv_num_heads_ * present_buff_chunk_length);
+    }
+
+    // Append new keys and values to the present cache once per kv head.
+    {
+      TensorOpCost unit_cost;
+      unit_cost.bytes_loaded = static_cast<double>(2 * (present_buff_chunk_length + kv_input_chunk_length * sizeof(float)));
+      unit_cost.bytes_stored = static_cast<double>(2 * present_buff_chunk_length);
+      unit_cost.compute_cycles = static_cast<double>(2 * 4 * kv_input_chunk_length);
+
+      ThreadPool::TryParallelFor(tp, batch_size * kv_num_heads_, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i != end; ++i) {
+          const size_t batch_index = i / kv_num_heads_;
+          const size_t kv_head_index = i % kv_num_heads_;
+          const size_t total_seqlen = static_cast<size_t>(seqlens[batch_index]) + 1;
+          const size_t past_seqlen = is_prompt ? 0 : total_seqlen - sequence_length;  // Assume no padding sequence length
+          const size_t past_chunk_length = past_seqlen * head_size;
+
+          const ptrdiff_t input_offset = packed_qkv
+                                             ? packed_batch_stride * batch_index + kv_input_chunk_length * kv_head_index
+                                             : SafeInt<ptrdiff_t>(kv_input_chunk_length) * i;
+          const float* k_scale_head = k_per_channel ? k_scale + kv_head_index * head_size : k_scale;
+          const float* v_scale_head = v_per_channel ? v_scale + kv_head_index * head_size : v_scale;
+
+          ConcatQuantizedStateChunkGQA(past_key_data, k_input + input_offset, present_key_data,
+                                       present_buff_chunk_length, past_buff_chunk_length, past_chunk_length,
+                                       kv_input_chunk_length, head_size, k_scale_head, k_per_channel,
+                                       past_present_share_buffer, i);
+          ConcatQuantizedStateChunkGQA(past_value_data, v_input + input_offset, present_value_data,
+                                       present_buff_chunk_length, past_buff_chunk_length, past_chunk_length,
+                                       kv_input_chunk_length, head_size, v_scale_head, v_per_channel,
+                                       past_present_share_buffer, i);
+        }
+      });
+    }
+
+    size_t bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * present_buffer_sequence_length * sizeof(float);
+    auto attention_probs = allocator->Alloc(bytes);
+    BufferUniquePtr scratch_buffer(attention_probs, BufferDeleter(allocator));
+
+    const float alpha = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+    float* output_data = output->MutableData<float>();
+
+    // Q*K', softmax and probs*V of one head are computed in a single pass so the probs stay in cache.
+    TensorOpCost unit_cost;
+    unit_cost.compute_cycles =
+        static_cast<double>(SafeInt<ptrdiff_t>(4) * sequence_length * head_size * present_buffer_sequence_length);
+    unit_cost.bytes_loaded = static_cast<double>(2 * present_buff_chunk_length + q_input_chunk_length * sizeof(float));
+    unit_cost.bytes_stored = static_cast<double>(q_input_chunk_length * sizeof(float));
+
+    ThreadPool::TryParallelFor(tp, batch_size * num_heads_, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      InlinedVector<float> row_buffer(2 * head_size);
+      float* q_scaled = row_buffer.data();
+      float* accumulator = q_scaled + head_size;
+
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        const size_t batch_index = i / num_heads_;
+        const size_t head_index = i % num_heads_;
+        const size_t kv_head_index = head_index / kv_num_heads_factor;
+        const size_t total_seqlen = static_cast<size_t>(seqlens[batch_index]) + 1;
+        const size_t past_seqlen = is_prompt ? 0 : total_seqlen - sequence_length;  // Assume no padding sequence length
+
+        const ptrdiff_t kv_offset = SafeInt<ptrdiff_t>(batch_index * kv_num_heads_ + kv_head_index) * present_buff_chunk_length;
+        const int8_t* k = present_key_data + kv_offset;
+        const int8_t* v = present_value_data + kv_offset;
+        const float* k_scale_head = k_per_channel ? k_scale + kv_head_index * head_size : k_scale;
+        const float* v_scale_head = v_per_channel ? v_scale + kv_head_index * head_size : v_scale;
+
+        const float* q = packed_qkv ? Q + packed_batch_stride * batch_index + q_input_chunk_length * head_index
+                                    : Q + q_input_chunk_length * i;
+        float* probs = static_cast<float*>(attention_probs) +
+                       SafeInt<ptrdiff_t>(i) * sequence_length * present_buffer_sequence_length;
+
+        // Scores of keys after the causal position are masked by the softmax, so they are not computed.
+        for (size_t seq = 0; seq < sequence_length; seq++) {
+          const size_t seq_causal_length = std::min(past_seqlen + seq + 1, total_seqlen);
+          for (size_t h = 0; h < head_size; h++) {
+            q_scaled[h] = q[seq * head_size + h] * alpha * (k_per_channel ? k_scale_head[h] : k_scale_head[0]);
+          }
+
+          float* probs_row = probs + seq * present_buffer_sequence_length;
+          const int8_t* k_row = k;
+          for (size_t t = 0; t < seq_causal_length; t++, k_row += head_size) {
+            float sum = 0.0f;
+            for (size_t h = 0; h < head_size; h++) {
+              sum += q_scaled[h] * static_cast<float>(k_row[h]);
+            }
+            probs_row[t] = sum;
+          }
+        }
+
+        float* output_qk_thread = nullptr;
+        if (output_qk_buffer != nullptr) {
+          output_qk_thread = output_qk_buffer +
+                             SafeInt<ptrdiff_t>(sequence_length) * total_sequence_length * (batch_index * num_heads_ + head_index);
+        }
+
+        ptrdiff_t attention_total_seqlen = 0;
+        const float* attention_bias_thread = GetAttentionBiasForHead(attention_bias_data, attention_bias_shape,
+                                                                     sequence_length, batch_index, head_index,
+                                                                     attention_total_seqlen);
+
+        ComputeSoftmaxForHead(probs, attention_bias_thread, attention_total_seqlen, static_cast<float*>(nullptr),
+                              output_qk_thread, head_sink, head_index, sequence_length, past_seqlen, total_seqlen,
+                              total_sequence_length, present_buffer_sequence_length);
+
+        // out(S, H) = probs(S, T) x V(T, H). The V scale is applied once per output element.
+        for (size_t seq = 0; seq < sequence_length; seq++) {
+          const size_t seq_causal_length = std::min(past_seqlen + seq + 1, total_seqlen);
+          const float* probs_row = probs + seq * present_buffer_sequence_length;
+          std::fill_n(accumulator, head_size, 0.0f);
+
+          const int8_t* v_row = v;
+          for (size_t t = 0; t < seq_causal_length; t++, v_row += head_size) {
+            const float p = probs_row[t];
+            for (size_t h = 0; h < head_size; h++) {
+              accumulator[h] += p * static_cast<float>(v_row[h]);
+            }
+          }
+
+          float* output_current = output_data + (batch_index * sequence_length * num_heads_ + head_index) * head_size +
+                                  seq * hidden_size;
+          for (size_t h = 0; h < head_size; h++) {
+            output_current[h] = accumulator[h] * (v_per_channel ? v_scale_head[h] : v_scale_head[0]);
+          }
+        }
+      }
+    });
+
+    return Status::OK();
+  }
+
  private:
+  static KVQuantizationType ParseKVQuantizationType(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    if (s == "PER_TENSOR") {
+      return KVQuantizationType::PER_TENSOR;
+    }
+    if (s == "PER_CHANNEL") {
+      return KVQuantizationType::PER_CHANNEL;
+    }
+    return KVQuantizationType::NONE;
+  }
+
   // Helper function to compute the attention probs. It does 2 things:
   //  attention_probs(B, N, S, T) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, T, H -> B, N, H, T)
   //  attention_probs(B, N, S, T) = Softmax(attention_probs)
@@ -218,23 +604,9 @@ class GQAAttentionBase {
           output_qk_thread = output_qk + output_qk_offset;
         }
 
-        // Compute attention bias offset based on the batch and head indexes
-        // Attention bias is of shape (B or 1, H or 1, S, T) so handle broadcasting
-        const T* attention_bias_thread = nullptr;
         ptrdiff_t attention_total_seqlen = 0;
-        if (attention_bias != nullptr) {
-          ptrdiff_t attention_bias_offset = 0;
-          attention_total_seqlen = static_cast<ptrdiff_t>(attention_bias_shape[3]);
-          const ptrdiff_t attention_matrix_size = sequence_length * attention_total_seqlen;
-          if (attention_bias_shape[0] != 1) {
-            attention_bias_offset += SafeInt<ptrdiff_t>(batch_index) * attention_bias_shape[1] * attention_matrix_size;
-          }
-          if (attention_bias_shape[1] != 1) {
-            attention_bias_offset += SafeInt<ptrdiff_t>(head_index) * attention_matrix_size;
-          }
-
-          attention_bias_thread = attention_bias + attention_bias_offset;
-        }
+        const T* attention_bias_thread = GetAttentionBiasForHead(attention_bias, attention_bias_shape, sequence_length,
+                                                                 batch_index, head_index, attention_total_seqlen);
 
         const T* k;
         if (packed_qkv) {
@@ -297,81 +669,9 @@ class GQAAttentionBase {
         }
         BufferUniquePtr scratch_buffer(attention_bias_thread_fp32, BufferDeleter(allocator));
 
-        // compute Softmax
-        U* output_softmax = output;
-        for (size_t seq = 0; seq < sequence_length; seq++) {
-          size_t seq_causal_length = past_seqlen + seq + 1;
-
-          const bool should_apply_local_window = local_window_size_ >= 0 &&
-                                                 seq_causal_length > static_cast<size_t>(local_window_size_);
-
-          const size_t start_offset = should_apply_local_window ? seq_causal_length - local_window_size_ : 0;
-          const size_t window_size = should_apply_local_window ? local_window_size_ : seq_causal_length;
-
-          // Mask everything before local window, if local window should be applied
-          if (should_apply_local_window) {
-            for (size_t total_seq_id = 0; total_seq_id < seq_causal_length - local_window_size_; total_seq_id++) {
-              if constexpr (std::is_same<U, float>::value) {
-                output_softmax[total_seq_id] = 0.f;
-              } else {
-                output_softmax[total_seq_id] = MLFloat16::FromBits(static_cast<uint16_t>(0));
-              }
-            }
-          }
-
-          if (softcap_ > 0.f) {
-            ComputeAttentionSoftcapInplace(output_softmax + start_offset, static_cast<int>(window_size),
-                                           static_cast<U>(softcap_));
-          }
-
-          // Add attention bias to QxK' if provided
-          // TODO (#23982): Implement bias addition during softmax computation in GQA CPU operator
-          if (attention_bias_thread != nullptr) {
-            if constexpr (std::is_same_v<U, T>) {
-              ApplyAttentionBias(output_softmax + start_offset, attention_bias_thread + start_offset,
-                                 static_cast<int>(window_size));
-            } else {
-              static_assert(std::is_same_v<U, float> && std::is_same_v<T, MLFloat16>);
-
-              MlasConvertHalfToFloatBuffer(attention_bias_thread + start_offset, attention_bias_thread_fp32, window_size);
-              ApplyAttentionBias(output_softmax + start_offset, attention_bias_thread_fp32, static_cast<int>(window_size));
-            }
-          }
-
-          // set causal [seq_causal_length, total_seqlen) to 0.f
-          for (size_t total_seq_id = seq_causal_length; total_seq_id < total_seqlen; total_seq_id++) {
-            if constexpr (std::is_same<U, float>::value) {
-              output_softmax[total_seq_id] = 0.f;
-            } else {
-              output_softmax[total_seq_id] = MLFloat16::FromBits(static_cast<uint16_t>(0));
-            }
-          }
-
-          if (qk_output_ == static_cast<int>(QKOutputType::BEFORE_SOFTMAX)) {
-            WriteOutputQKHeadChunk(output_qk_thread, output_softmax, total_sequence_length);
-          }
-
-          if (use_smooth_softmax_ || head_sink != nullptr) {
-            float sink = (head_sink != nullptr) ? static_cast<float>(head_sink[head_index]) : 0.0f;
-            ComputeSmoothSoftmaxInplace(output_softmax + start_offset, static_cast<int>(window_size), sink, nullptr);
-          } else {
-            ComputeAttentionSoftmaxInplace(output_softmax + start_offset, 1, static_cast<int>(window_size), nullptr);
-          }
-
-          if (qk_output_ == static_cast<int>(QKOutputType::AFTER_SOFTMAX)) {
-            WriteOutputQKHeadChunk(output_qk_thread, output_softmax, total_sequence_length);
-          }
-
-          output_softmax += present_buffer_sequence_length;
-
-          if (attention_bias_thread != nullptr) {
-            attention_bias_thread += attention_total_seqlen;
-          }
-
-          if (output_qk_thread != nullptr) {
-            output_qk_thread += total_sequence_length;
-          }
-        }
+        ComputeSoftmaxForHead(output, attention_bias_thread, attention_total_seqlen, attention_bias_thread_fp32,
+                              output_qk_thread, head_sink, head_index, sequence_length, past_seqlen, total_seqlen,
+                              total_sequence_length, present_buffer_sequence_length);
       }
     });
   }
@@ -497,6 +797,123 @@ class GQAAttentionBase {
     }
   }
 
+  // Returns the attention bias of one (batch, head) pair, or nullptr when there is no attention bias.
+  // Attention bias is of shape (B or 1, H or 1, S, T) so handle broadcasting.
+  template <typename T>
+  static const T* GetAttentionBiasForHead(const T* attention_bias,
+                                          const gsl::span<const int64_t> attention_bias_shape,
+                                          const size_t sequence_length,
+                                          const size_t batch_index,
+                                          const size_t head_index,
+                                          ptrdiff_t& attention_total_seqlen) {
+    attention_total_seqlen = 0;
+    if (attention_bias == nullptr) {
+      return nullptr;
+    }
+
+    ptrdiff_t attention_bias_offset = 0;
+    attention_total_seqlen = static_cast<ptrdiff_t>(attention_bias_shape[3]);
+    const ptrdiff_t attention_matrix_size = sequence_length * attention_total_seqlen;
+    if (attention_bias_shape[0] != 1) {
+      attention_bias_offset += SafeInt<ptrdiff_t>(batch_index) * attention_bias_shape[1] * attention_matrix_size;
+    }
+    if (attention_bias_shape[1] != 1) {
+      attention_bias_offset += SafeInt<ptrdiff_t>(head_index) * attention_matrix_size;
+    }
+
+    return attention_bias + attention_bias_offset;
+  }
+
+  // Applies local window, softcap, attention bias and causal mask to the S x T scores of one head, then computes
+  // softmax in place. output_qk_thread is optional and receives the scores before or after softmax.
+  template <typename T, typename U>
+  void ComputeSoftmaxForHead(U* output_softmax,                       // S x T scores of one head
+                             const T* attention_bias_thread,          // attention bias of this head, or nullptr
+                             const ptrdiff_t attention_total_seqlen,  // row stride of attention bias
+                             float* attention_bias_thread_fp32,       // fp32 scratch of attention_total_seqlen
+                             T* output_qk_thread,                     // QK output of this head, or nullptr
+                             const T* head_sink,                      // for smooth softmax. Its size is N.
+                             const size_t head_index,                 // head index of Q
+                             const size_t sequence_length,            // sequence length of Q (S)
+                             const size_t past_seqlen,                // past sequence length of this batch
+                             const size_t total_seqlen,               // total sequence length of this batch
+                             const size_t total_sequence_length,      // max total sequence length of the batch
+                             const size_t present_buffer_sequence_length) const {
+    for (size_t seq = 0; seq < sequence_length; seq++) {
+      size_t seq_causal_length = past_seqlen + seq + 1;
+
+      const bool should_apply_local_window = local_window_size_ >= 0 &&
+                                             seq_causal_length > static_cast<size_t>(local_window_size_);
+
+      const size_t start_offset = should_apply_local_window ? seq_causal_length - local_window_size_ : 0;
+      const size_t window_size = should_apply_local_window ? local_window_size_ : seq_causal_length;
+
+      // Mask everything before local window, if local window should be applied
+      if (should_apply_local_window) {
+        for (size_t total_seq_id = 0; total_seq_id < seq_causal_length - local_window_size_; total_seq_id++) {
+          if constexpr (std::is_same<U, float>::value) {
+            output_softmax[total_seq_id] = 0.f;
+          } else {
+            output_softmax[total_seq_id] = MLFloat16::FromBits(static_cast<uint16_t>(0));
+          }
+        }
+      }
+
+      if (softcap_ > 0.f) {
+        ComputeAttentionSoftcapInplace(output_softmax + start_offset, static_cast<int>(window_size),
+                                       static_cast<U>(softcap_));
+      }
+
+      // Add attention bias to QxK' if provided
+      // TODO (#23982): Implement bias addition during softmax computation in GQA CPU operator
+      if (attention_bias_thread != nullptr) {
+        if constexpr (std::is_same_v<U, T>) {
+          ApplyAttentionBias(output_softmax + start_offset, attention_bias_thread + start_offset,
+                             static_cast<int>(window_size));
+        } else {
+          static_assert(std::is_same_v<U, float> && std::is_same_v<T, MLFloat16>);
+
+          MlasConvertHalfToFloatBuffer(attention_bias_thread + start_offset, attention_bias_thread_fp32, window_size);
+          ApplyAttentionBias(output_softmax + start_offset, attention_bias_thread_fp32, static_cast<int>(window_size));
+        }
+      }
+
+      // set causal [seq_causal_length, total_seqlen) to 0.f
+      for (size_t total_seq_id = seq_causal_length; total_seq_id < total_seqlen; total_seq_id++) {
+        if constexpr (std::is_same<U, float>::value) {
+          output_softmax[total_seq_id] = 0.f;
+        } else {
+          output_softmax[total_seq_id] = MLFloat16::FromBits(static_cast<uint16_t>(0));
+        }
+      }
+
+      if (qk_output_ == static_cast<int>(QKOutputType::BEFORE_SOFTMAX)) {
+        WriteOutputQKHeadChunk(output_qk_thread, output_softmax, total_sequence_length);
+      }
+
+      if (use_smooth_softmax_ || head_sink != nullptr) {
+        float sink = (head_sink != nullptr) ? static_cast<float>(head_sink[head_index]) : 0.0f;
+        ComputeSmoothSoftmaxInplace(output_softmax + start_offset, static_cast<int>(window_size), sink, nullptr);
+      } else {
+        ComputeAttentionSoftmaxInplace(output_softmax + start_offset, 1, static_cast<int>(window_size), nullptr);
+      }
+
+      if (qk_output_ == static_cast<int>(QKOutputType::AFTER_SOFTMAX)) {
+        WriteOutputQKHeadChunk(output_qk_thread, output_softmax, total_sequence_length);
+      }
+
+      output_softmax += present_buffer_sequence_length;
+
+      if (attention_bias_thread != nullptr) {
+        attention_bias_thread += attention_total_seqlen;
+      }
+
+      if (output_qk_thread != nullptr) {
+        output_qk_thread += total_sequence_length;
+      }
+    }
+  }
+
   template <typename T, typename U>
   void WriteOutputQKHeadChunk(T* output_qk, const U* attention_probs, size_t total_sequence_length) const {
     if (output_qk == nullptr) {
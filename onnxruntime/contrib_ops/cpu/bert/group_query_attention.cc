@@ -21,17 +21,50 @@ using onnxruntime::concurrency::ThreadPool;
 namespace onnxruntime {
 namespace contrib {
 
+namespace {
+// The KV cache of the float kernel can be quantized to int8.
+template <typename T>
+std::vector<MLDataType> GetKVCacheTypeConstraints() {
+  if constexpr (std::is_same_v<T, float>) {
+    return BuildKernelDefConstraints<float, int8_t>();
+  } else {
+    return BuildKernelDefConstraints<T>();
+  }
+}
+
+Status CheckKVCacheScale(const Tensor* scale, KVQuantizationType quant_type, int kv_num_heads, int head_size,
+                         const char* name) {
+  if (scale == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, name, " must be provided when KV cache is quantized");
+  }
+  if (scale->DataType() != DataTypeImpl::GetType<float>()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, name, " must be float tensor");
+  }
+
+  const int64_t expected_size = quant_type == KVQuantizationType::PER_CHANNEL
+                                    ? static_cast<int64_t>(kv_num_heads) * head_size
+                                    : 1;
+  if (scale->Shape().Size() != expected_size) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, name, " is expected to have ", expected_size,
+                           " elements, got ", scale->Shape().Size());
+  }
+  return Status::OK();
+}
+}  // namespace
+
 // These ops are internal-only, so register outside of onnx
-#define REGISTER_KERNEL_TYPED(T)                                        \
-  ONNX_OPERATOR_TYPED_KERNEL_EX(                                        \
-      GroupQueryAttention,                                              \
-      kMSDomain,                                                        \
-      1,                                                                \
-      T,                                                                \
-      kCpuExecutionProvider,                                            \
-      KernelDefBuilder()                                                \
-          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())        \
-          .TypeConstraint("M", DataTypeImpl::GetTensorType<int32_t>()), \
+#define REGISTER_KERNEL_TYPED(T)                                                    \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                    \
+      GroupQueryAttention,                                                          \
+      kMSDomain,                                                                    \
+      1,                                                                            \
+      T,                                                                            \
+      kCpuExecutionProvider,                                                        \
+      KernelDefBuilder()                                                            \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())                    \
+          .TypeConstraint("T_CACHE", GetKVCacheTypeConstraints<T>())                \
+          .TypeConstraint("T_KV_SCALE", DataTypeImpl::GetTensorType<float>())       \
+          .TypeConstraint("M", DataTypeImpl::GetTensorType<int32_t>()),             \
       GroupQueryAttention<T>);
 
 REGISTER_KERNEL_TYPED(float)
@@ -55,6 +88,29 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
   const Tensor* position_ids = context->Input<Tensor>(9);
   const Tensor* attention_bias = context->Input<Tensor>(10);
   const Tensor* head_sink = context->Input<Tensor>(11);
+  const Tensor* k_scale = context->Input<Tensor>(12);
+  const Tensor* v_scale = context->Input<Tensor>(13);
+
+  const bool is_kv_cache_quantized = IsKVCacheQuantized();
+  if (is_kv_cache_quantized) {
+    if constexpr (!std::is_same_v<T, float>) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                             "Quantized KV cache is only supported for float GroupQueryAttention on CPU");
+    }
+    if (k_quant_type_ == KVQuantizationType::NONE || v_quant_type_ == KVQuantizationType::NONE) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                             "Quantized KV cache on CPU requires both k_quant_type and v_quant_type");
+    }
+    if (kv_cache_bit_width_ != 0 && kv_cache_bit_width_ != 8) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                             "Quantized KV cache on CPU only supports kv_cache_bit_width of 8, got ",
+                             kv_cache_bit_width_);
+    }
+    if (past_key != nullptr && (!past_key->IsDataType<int8_t>() || !past_value->IsDataType<int8_t>())) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "past_key and past_value must be int8 when KV cache is quantized");
+    }
+  }
 
   GroupQueryAttentionParameters parameters = {};
   ORT_RETURN_IF_ERROR(group_query_attention_helper::CheckInputs(query,
@@ -71,13 +127,21 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
                                                                 total_seqlen_tensor,
                                                                 scale_,
                                                                 softcap_,
-                                                                0));
+                                                                is_kv_cache_quantized ? 8 : 0));
 
   ORT_RETURN_IF_ERROR(group_query_attention_helper::CheckCustomAttentionInputs(position_ids,
                                                                                attention_bias,
                                                                                head_sink,
                                                                                parameters));
 
+  if (is_kv_cache_quantized) {
+    ORT_RETURN_IF_ERROR(CheckKVCacheScale(k_scale, k_quant_type_, kv_num_heads_, parameters.head_size, "k_scale"));
+    ORT_RETURN_IF_ERROR(CheckKVCacheScale(v_scale, v_quant_type_, kv_num_heads_, parameters.head_size, "v_scale"));
+    parameters.k_quant_type = k_quant_type_;
+    parameters.v_quant_type = v_quant_type_;
+    parameters.kv_cache_bit_width = 8;
+  }
+
   const int batch_size = parameters.batch_size;
   const int sequence_length = parameters.sequence_length;
   const int present_kv_seqlen = parameters.seqlen_present_kv_cache;
@@ -215,6 +279,16 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
 
   const T* head_sink_data = (head_sink != nullptr) ? head_sink->Data<T>() : nullptr;
 
+  if constexpr (std::is_same_v<T, float>) {
+    if (is_kv_cache_quantized) {
+      return ApplyAttentionWithQuantizedKVCache(q_rotary, packed_qkv ? nullptr : k_rotary,
+                                                packed_qkv ? nullptr : V.Get<Tensor>().Data<T>(),
+                                                head_sink_data, attention_bias, past_key, past_value, output,
+                                                present_k, present_v, output_qk, seqlens_k, k_scale->Data<float>(),
+                                                v_scale->Data<float>(), parameters, allocator, context);
+    }
+  }
+
   // Compute the attention score and apply the score to V
   return ApplyAttention(q_rotary, packed_qkv ? nullptr : k_rotary, packed_qkv ? nullptr : V.Get<Tensor>().Data<T>(),
                         head_sink_data, attention_bias, past_key, past_value, output, present_k, present_v,
@@ -0,0 +1,345 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/fused_elementwise.h"
+
+#include <algorithm>
+#include <memory>
+#include <string_view>
+
+#include "core/common/narrow.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math_cpuonly.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    FusedElementwise,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+namespace {
+
+// Number of output elements evaluated at a time. The scratch buffers for a tile of the intermediate results of a
+// typical chain fit in the L1 or L2 cache.
+constexpr size_t kTileSize = 1024;
+
+// An input that repeats every `size` elements of the output, which is the case when its shape is a suffix of the
+// output shape, optionally preceded by dims of 1.
+struct InputData {
+  const float* data;
+  size_t size;
+};
+
+Status ComputeOutputDims(const OpKernelContext& context, size_t num_inputs, TensorShapeVector& output_dims) {
+  size_t rank = 0;
+  for (size_t i = 0; i < num_inputs; ++i) {
+    rank = std::max(rank, context.Input<Tensor>(static_cast<int>(i))->Shape().NumDimensions());
+  }
+
+  output_dims.assign(rank, 1);
+  for (size_t i = 0; i < num_inputs; ++i) {
+    const TensorShape& shape = context.Input<Tensor>(static_cast<int>(i))->Shape();
+    const auto dims = shape.GetDims();
+    const size_t offset = rank - dims.size();
+    for (size_t j = 0; j < dims.size(); ++j) {
+      int64_t& output_dim = output_dims[offset + j];
+      if (dims[j] == output_dim || dims[j] == 1) {
+        continue;
+      }
+
+      ORT_RETURN_IF_NOT(output_dim == 1, "Input ", i, " with shape ", shape,
+                        " can't be broadcast with the other inputs of FusedElementwise.");
+      output_dim = dims[j];
+    }
+  }
+
+  return Status::OK();
+}
+
+bool IsRepeatedSuffix(gsl::span<const int64_t> input_dims, gsl::span<const int64_t> output_dims) {
+  const size_t offset = output_dims.size() - input_dims.size();
+  auto first_non_one = std::find_if(input_dims.begin(), input_dims.end(), [](int64_t dim) { return dim != 1; });
+  for (auto it = first_non_one; it != input_dims.end(); ++it) {
+    if (*it != output_dims[offset + static_cast<size_t>(it - input_dims.begin())]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Writes the broadcast of input to output_dims into output.
+void ExpandInput(const float* input, gsl::span<const int64_t> input_dims, gsl::span<const int64_t> output_dims,
+                 float* output) {
+  const size_t rank = output_dims.size();
+
+  // input strides in terms of the output dims. 0 for the dims that are broadcast.
+  TensorShapeVector strides(rank, 0);
+  const size_t offset = rank - input_dims.size();
+  int64_t stride = 1;
+  for (size_t i = input_dims.size(); i-- > 0;) {
+    if (input_dims[i] != 1) {
+      strides[offset + i] = stride;
+    }
+    stride *= input_dims[i];
+  }
+
+  const size_t inner_size = narrow<size_t>(output_dims[rank - 1]);
+  size_t outer_size = 1;
+  for (size_t d = 0; d + 1 < rank; ++d) {
+    outer_size *= narrow<size_t>(output_dims[d]);
+  }
+
+  TensorShapeVector index(rank - 1, 0);
+  for (size_t outer = 0; outer < outer_size; ++outer) {
+    int64_t input_offset = 0;
+    for (size_t d = 0; d + 1 < rank; ++d) {
+      input_offset += index[d] * strides[d];
+    }
+
+    const float* src = input + input_offset;
+    float* dst = output + outer * inner_size;
+    if (strides[rank - 1] == 0) {
+      std::fill_n(dst, inner_size, *src);
+    } else {
+      std::copy_n(src, inner_size, dst);
+    }
+
+    for (size_t d = rank - 1; d-- > 0;) {
+      if (++index[d] < output_dims[d]) {
+        break;
+      }
+      index[d] = 0;
+    }
+  }
+}
+
+// Returns the count elements of input starting at output element start. They are copied to buffer if they are not
+// contiguous in the input.
+const float* LoadTile(const InputData& input, size_t start, size_t count, float* buffer) {
+  if (input.size == 1) {
+    std::fill_n(buffer, count, *input.data);
+    return buffer;
+  }
+
+  size_t offset = start % input.size;
+  if (offset + count <= input.size) {
+    return input.data + offset;
+  }
+
+  for (size_t copied = 0; copied < count;) {
+    const size_t n = std::min(count - copied, input.size - offset);
+    std::copy_n(input.data + offset, n, buffer + copied);
+    copied += n;
+    offset = 0;
+  }
+
+  return buffer;
+}
+
+}  // namespace
+
+FusedElementwise::FusedElementwise(const OpKernelInfo& info)
+    : OpKernel(info), num_inputs_(info.GetInputCount()) {
+  std::vector<std::string> operations;
+  ORT_ENFORCE(info.GetAttrs("operations", operations).IsOK(), "Attribute 'operations' is required.");
+  std::vector<int64_t> operands;
+  ORT_ENFORCE(info.GetAttrs("operands", operands).IsOK(), "Attribute 'operands' is required.");
+  ORT_ENFORCE(!operations.empty() && operands.size() == 2 * operations.size(),
+              "Expected two operands for each of the ", operations.size(), " operations. Got ", operands.size());
+
+  struct OperationInfo {
+    std::string_view name;
+    Operation operation;
+    bool is_binary;
+  };
+
+  static constexpr OperationInfo kOperations[] = {
+      {"Add", Operation::kAdd, true},
+      {"Sub", Operation::kSub, true},
+      {"Mul", Operation::kMul, true},
+      {"Div", Operation::kDiv, true},
+      {"Relu", Operation::kRelu, false},
+      {"Sigmoid", Operation::kSigmoid, false},
+      {"Tanh", Operation::kTanh, false},
+      {"Exp", Operation::kExp, false},
+      {"Log", Operation::kLog, false},
+      {"Neg", Operation::kNeg, false},
+      {"Abs", Operation::kAbs, false},
+      {"Sqrt", Operation::kSqrt, false},
+      {"Reciprocal", Operation::kReciprocal, false},
+  };
+
+  const size_t num_steps = operations.size();
+  // index of the last step that reads the result of each step
+  std::vector<size_t> last_use(num_steps, 0);
+  steps_.reserve(num_steps);
+  for (size_t i = 0; i < num_steps; ++i) {
+    const auto* info_it = std::find_if(std::begin(kOperations), std::end(kOperations),
+                                       [&](const OperationInfo& op) { return op.name == operations[i]; });
+    ORT_ENFORCE(info_it != std::end(kOperations), "Unsupported operation: ", operations[i]);
+
+    const int64_t num_values = static_cast<int64_t>(num_inputs_ + i);
+    const int64_t lhs = operands[2 * i];
+    const int64_t rhs = operands[2 * i + 1];
+    ORT_ENFORCE(lhs >= 0 && lhs < num_values, "Invalid operand ", lhs, " for operation ", i);
+    if (info_it->is_binary) {
+      ORT_ENFORCE(rhs >= 0 && rhs < num_values, "Invalid operand ", rhs, " for operation ", i);
+    } else {
+      ORT_ENFORCE(rhs == -1, "The second operand of unary operation ", i, " must be -1. Got ", rhs);
+    }
+
+    Step step{info_it->operation, static_cast<size_t>(lhs), info_it->is_binary ? static_cast<size_t>(rhs) : 0, 0};
+    for (size_t operand : {step.lhs, step.rhs}) {
+      if (operand >= num_inputs_) {
+        last_use[operand - num_inputs_] = i;
+      }
+    }
+    steps_.push_back(step);
+  }
+
+  // assign scratch buffers to the results. a buffer is reused once the result in it has been read for the last time.
+  std::vector<size_t> free_buffers;
+  for (size_t i = 0; i + 1 < num_steps; ++i) {
+    Step& step = steps_[i];
+    for (size_t operand : {step.lhs, step.rhs}) {
+      if (operand >= num_inputs_ && last_use[operand - num_inputs_] == i) {
+        const size_t buffer = steps_[operand - num_inputs_].result_buffer;
+        if (std::find(free_buffers.begin(), free_buffers.end(), buffer) == free_buffers.end()) {
+          free_buffers.push_back(buffer);
+        }
+        // don't release the buffer twice if both operands are the same result
+        last_use[operand - num_inputs_] = num_steps;
+      }
+    }
+
+    if (free_buffers.empty()) {
+      step.result_buffer = num_result_buffers_++;
+    } else {
+      step.result_buffer = free_buffers.back();
+      free_buffers.pop_back();
+    }
+  }
+}
+
+void FusedElementwise::EvaluateStep(Operation operation, const float* lhs, const float* rhs, float* result,
+                                    size_t count) {
+  const auto size = narrow<Eigen::Index>(count);
+  ConstEigenVectorArrayMap<float> a(lhs, size);
+  EigenVectorArrayMap<float> y(result, size);
+  switch (operation) {
+    case Operation::kAdd:
+      y = a + ConstEigenVectorArrayMap<float>(rhs, size);
+      break;
+    case Operation::kSub:
+      y = a - ConstEigenVectorArrayMap<float>(rhs, size);
+      break;
+    case Operation::kMul:
+      y = a * ConstEigenVectorArrayMap<float>(rhs, size);
+      break;
+    case Operation::kDiv:
+      y = a / ConstEigenVectorArrayMap<float>(rhs, size);
+      break;
+    case Operation::kRelu:
+      y = a.cwiseMax(0.0f);
+      break;
+    case Operation::kSigmoid:
+      MlasComputeLogistic(lhs, result, count);
+      break;
+    case Operation::kTanh:
+      MlasComputeTanh(lhs, result, count);
+      break;
+    case Operation::kExp:
+      MlasComputeExp(lhs, result, count);
+      break;
+    case Operation::kLog:
+      y = a.log();
+      break;
+    case Operation::kNeg:
+      y = -a;
+      break;
+    case Operation::kAbs:
+      y = a.abs();
+      break;
+    case Operation::kSqrt:
+      y = a.sqrt();
+      break;
+    case Operation::kReciprocal:
+      y = a.inverse();
+      break;
+  }
+}
+
+Status FusedElementwise::Compute(OpKernelContext* context) const {
+  TensorShapeVector output_dims;
+  ORT_RETURN_IF_ERROR(ComputeOutputDims(*context, num_inputs_, output_dims));
+
+  Tensor& Y = *context->Output(0, TensorShape(output_dims));
+  const size_t output_size = narrow<size_t>(Y.Shape().Size());
+  if (output_size == 0) {
+    return Status::OK();
+  }
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+  // inputs that don't repeat along the output, e.g. [N, 1] with an output of [N, C], are expanded up front.
+  // ElementwiseFusion only creates nodes where every input repeats.
+  InlinedVector<InputData> inputs;
+  InlinedVector<IAllocatorUniquePtr<float>> expanded_inputs;
+  inputs.reserve(num_inputs_);
+  for (size_t i = 0; i < num_inputs_; ++i) {
+    const Tensor& X = *context->Input<Tensor>(static_cast<int>(i));
+    const auto input_dims = X.Shape().GetDims();
+    if (IsRepeatedSuffix(input_dims, output_dims)) {
+      inputs.push_back({X.Data<float>(), narrow<size_t>(X.Shape().Size())});
+    } else {
+      auto expanded = IAllocator::MakeUniquePtr<float>(allocator, output_size);
+      ExpandInput(X.Data<float>(), input_dims, output_dims, expanded.get());
+      inputs.push_back({expanded.get(), output_size});
+      expanded_inputs.push_back(std::move(expanded));
+    }
+  }
+
+  float* output = Y.MutableData<float>();
+  const size_t num_steps = steps_.size();
+  const size_t num_tiles = (output_size + kTileSize - 1) / kTileSize;
+  const double tile_bytes = static_cast<double>(kTileSize * sizeof(float));
+  const TensorOpCost cost{static_cast<double>(num_inputs_) * tile_bytes, tile_bytes,
+                          static_cast<double>(num_steps * kTileSize)};
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(num_tiles), cost,
+      [&](std::ptrdiff_t first_tile, std::ptrdiff_t last_tile) {
+        // the results of the steps, followed by a tile of each input for when it has to be copied
+        std::unique_ptr<float[]> scratch(new float[(num_result_buffers_ + num_inputs_) * kTileSize]);
+        float* input_buffers = scratch.get() + num_result_buffers_ * kTileSize;
+        InlinedVector<const float*> values(num_inputs_ + num_steps);
+
+        for (std::ptrdiff_t tile = first_tile; tile < last_tile; ++tile) {
+          const size_t start = static_cast<size_t>(tile) * kTileSize;
+          const size_t count = std::min(kTileSize, output_size - start);
+          for (size_t i = 0; i < num_inputs_; ++i) {
+            values[i] = LoadTile(inputs[i], start, count, input_buffers + i * kTileSize);
+          }
+
+          for (size_t s = 0; s < num_steps; ++s) {
+            const Step& step = steps_[s];
+            float* result = s + 1 == num_steps ? output + start : scratch.get() + step.result_buffer * kTileSize;
+            EvaluateStep(step.operation, values[step.lhs], values[step.rhs], result, count);
+            values[num_inputs_ + s] = result;
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Evaluates the DAG of element-wise operations produced by ElementwiseFusion. The output is processed in tiles small
+// enough for the intermediate results of all the operations to stay in cache, so each input is read and the output
+// is written once regardless of the number of operations.
+class FusedElementwise final : public OpKernel {
+ public:
+  explicit FusedElementwise(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  enum class Operation : uint8_t {
+    kAdd,
+    kSub,
+    kMul,
+    kDiv,
+    kRelu,
+    kSigmoid,
+    kTanh,
+    kExp,
+    kLog,
+    kNeg,
+    kAbs,
+    kSqrt,
+    kReciprocal,
+  };
+
+  static void EvaluateStep(Operation operation, const float* lhs, const float* rhs, float* result, size_t count);
+
+  struct Step {
+    Operation operation;
+    // values 0 to num_inputs_ - 1 are the inputs and value num_inputs_ + i is the result of step i
+    size_t lhs;
+    size_t rhs;  // unused by unary operations
+    // scratch buffer the result is written to. the result of the last step is written to the output.
+    size_t result_buffer;
+  };
+
+  size_t num_inputs_;
+  std::vector<Step> steps_;
+  size_t num_result_buffers_ = 0;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -5,6 +5,7 @@
 #include "contrib_ops/cpu/moe/moe_utils.h"
 #include "contrib_ops/cpu/moe/moe_helper.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/tensorprotoutils.h"
 #include "core/providers/common.h"
 #include "core/providers/cpu/math/gemm_helper.h"
 #include "core/util/math_cpuonly.h"
@@ -15,6 +16,7 @@
 #include "core/common/narrow.h"
 
 #include <algorithm>
+#include <atomic>
 #include <vector>
 #include <numeric>
 
@@ -28,13 +30,120 @@ MoE<T>::MoE(const OpKernelInfo& op_kernel_info) : OpKernel(op_kernel_info), MoEB
   }
 }
 
+template <typename T>
+Status MoE<T>::PrePack(const Tensor& /*tensor*/, int /*input_idx*/, AllocatorPtr /*alloc*/,
+                       /*out*/ bool& is_packed,
+                       /*out*/ PrePackedWeights* /*prepacked_weights*/) {
+  is_packed = false;
+  return Status::OK();
+}
+
+template <>
+Status MoE<float>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                           /*out*/ bool& is_packed,
+                           /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // Pack FC1 (2) and FC2 (4) weights.
+  if (input_idx != 2 && input_idx != 4) {
+    return Status::OK();
+  }
+
+  const auto& shape = tensor.Shape();
+  if (shape.NumDimensions() != 3) {
+    return Status::OK();
+  }
+
+  // Expert weights are always read as row-major [N, K] (i.e. B^T), also for the legacy [E, K, N]
+  // shape, so N and K are derived from the hidden size which must be known statically.
+  const auto* input_shape = Info().node().InputDefs()[0]->Shape();
+  if (input_shape == nullptr || input_shape->dim_size() == 0) {
+    return Status::OK();
+  }
+  const auto& hidden_dim = input_shape->dim(input_shape->dim_size() - 1);
+  if (!utils::HasDimValue(hidden_dim) || hidden_dim.dim_value() <= 0) {
+    return Status::OK();
+  }
+
+  const size_t hidden_size = static_cast<size_t>(hidden_dim.dim_value());
+  const size_t num_experts = static_cast<size_t>(shape[0]);
+  const size_t expert_elements = static_cast<size_t>(shape[1] * shape[2]);
+  if (expert_elements % hidden_size != 0) {
+    return Status::OK();
+  }
+
+  const size_t N = (input_idx == 2) ? expert_elements / hidden_size : hidden_size;
+  const size_t K = (input_idx == 2) ? hidden_size : expert_elements / hidden_size;
+
+  size_t expert_packed_size = MlasGemmPackBSize(CblasNoTrans, CblasTrans, N, K, &mlas_backend_kernel_selector_config_);
+  if (expert_packed_size == 0) {
+    return Status::OK();
+  }
+  expert_packed_size = (expert_packed_size + 63) & ~size_t{63};
+
+  const size_t packed_size = expert_packed_size * num_experts;
+  auto packed_buffer = IAllocator::MakeUniquePtr<void>(alloc, packed_size, true);
+  auto* packed_data = static_cast<uint8_t*>(packed_buffer.get());
+
+  // Zero the padding so that identical weights hash identically when shared between sessions.
+  memset(packed_data, 0, packed_size);
+
+  const float* weights = tensor.Data<float>();
+  for (size_t e = 0; e < num_experts; ++e) {
+    MlasGemmPackB(CblasNoTrans, CblasTrans, N, K, weights + e * N * K, K,
+                  packed_data + e * expert_packed_size, &mlas_backend_kernel_selector_config_);
+  }
+
+  if (input_idx == 2) {
+    fc1_shape_ = shape;
+    packed_fc1_expert_size_ = expert_packed_size;
+  } else {
+    fc2_shape_ = shape;
+    packed_fc2_expert_size_ = expert_packed_size;
+  }
+
+  if (prepacked_weights != nullptr) {
+    prepacked_weights->buffers_.push_back(std::move(packed_buffer));
+    prepacked_weights->buffer_sizes_.push_back(packed_size);
+  } else if (input_idx == 2) {
+    packed_fc1_ = std::move(packed_buffer);
+  } else {
+    packed_fc2_ = std::move(packed_buffer);
+  }
+
+  is_packed = true;
+  return Status::OK();
+}
+
+template <typename T>
+Status MoE<T>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                         int input_idx,
+                                         /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if constexpr (std::is_same_v<T, float>) {
+    if (input_idx == 2) {
+      packed_fc1_ = std::move(prepacked_buffers[0]);
+      used_shared_buffers = true;
+    } else if (input_idx == 4) {
+      packed_fc2_ = std::move(prepacked_buffers[0]);
+      used_shared_buffers = true;
+    }
+  } else {
+    ORT_UNUSED_PARAMETER(prepacked_buffers);
+    ORT_UNUSED_PARAMETER(input_idx);
+  }
+
+  return Status::OK();
+}
+
 template <typename T>
 Status MoE<T>::Compute(OpKernelContext* context) const {
   const Tensor* input = context->Input<Tensor>(0);
   const Tensor* router_probs = context->Input<Tensor>(1);
-  const Tensor* fc1_experts_weights = context->Input<Tensor>(2);
+  const Tensor* fc1_experts_weights = packed_fc1_ ? nullptr : context->Input<Tensor>(2);
   const Tensor* fc1_experts_bias = context->Input<Tensor>(3);
-  const Tensor* fc2_experts_weights = context->Input<Tensor>(4);
+  const Tensor* fc2_experts_weights = packed_fc2_ ? nullptr : context->Input<Tensor>(4);
   const Tensor* fc2_experts_bias = context->Input<Tensor>(5);
   const Tensor* fc3_experts_weights = context->Input<Tensor>(6);
   const Tensor* fc3_experts_bias = context->Input<Tensor>(7);
@@ -45,12 +154,15 @@ Status MoE<T>::Compute(OpKernelContext* context) const {
                            "FC3 is not implemented for CPU MoE.");
   }
 
+  const TensorShape* fc1_shape_ptr = packed_fc1_ ? &fc1_shape_ : &fc1_experts_weights->Shape();
+  const TensorShape* fc2_shape_ptr = packed_fc2_ ? &fc2_shape_ : &fc2_experts_weights->Shape();
+
   MoEParameters moe_params;
   ORT_RETURN_IF_ERROR(moe_helper::CheckInputs<Tensor>(
       moe_params, input, router_probs,
-      fc1_experts_weights, fc1_experts_bias, nullptr, nullptr,
-      fc2_experts_weights, fc2_experts_bias, nullptr, nullptr,
-      fc3_experts_weights, fc3_experts_bias, nullptr, nullptr,
+      fc1_shape_ptr, fc1_experts_bias, nullptr, nullptr,
+      fc2_shape_ptr, fc2_experts_bias, nullptr, nullptr,
+      nullptr, fc3_experts_bias, nullptr, nullptr,
       1,
       activation_type_ == ActivationType::SwiGLU));
 
@@ -71,7 +183,7 @@ Status MoE<T>::ComputeMoE(const OpKernelContext* context,
                           Tensor* output) const {
   const auto& input_shape = input->Shape();
   const auto& router_shape = router_probs->Shape();
-  const auto& fc2_shape = fc2_experts_weights->Shape();
+  const auto& fc2_shape = packed_fc2_ ? fc2_shape_ : fc2_experts_weights->Shape();
 
   const int64_t num_tokens = input_shape.Size() / input_shape[input_shape.NumDimensions() - 1];
   const int64_t hidden_size = input_shape[input_shape.NumDimensions() - 1];
@@ -82,26 +194,15 @@ Status MoE<T>::ComputeMoE(const OpKernelContext* context,
 
   const T* input_data = input->Data<T>();
   const T* router_data = router_probs->Data<T>();
-  const T* fc1_weights_data = fc1_experts_weights->Data<T>();
+  const T* fc1_weights_data = fc1_experts_weights ? fc1_experts_weights->Data<T>() : nullptr;
   const T* fc1_bias_data = fc1_experts_bias ? fc1_experts_bias->Data<T>() : nullptr;
-  const T* fc2_weights_data = fc2_experts_weights->Data<T>();
+  const T* fc2_weights_data = fc2_experts_weights ? fc2_experts_weights->Data<T>() : nullptr;
   const T* fc2_bias_data = fc2_experts_bias ? fc2_experts_bias->Data<T>() : nullptr;
   T* output_data = output->MutableData<T>();
 
   AllocatorPtr allocator;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
 
-  const T* input_data_to_use = input_data;
-  IAllocatorUniquePtr<T> input_data_copy_ptr;
-  if (normalize_routing_weights_) {
-    input_data_copy_ptr = IAllocator::MakeUniquePtr<T>(allocator, static_cast<size_t>(num_tokens * hidden_size));
-    T* input_data_copy = input_data_copy_ptr.get();
-    std::copy(input_data, input_data + (num_tokens * hidden_size), input_data_copy);
-    input_data_to_use = input_data_copy;
-  }
-
-  std::fill_n(output_data, output->Shape().Size(), T{});
-
   IAllocatorUniquePtr<float> router_logits_float_buffer;
   const float* router_logits_float = nullptr;
   if constexpr (std::is_same_v<T, MLFloat16>) {
@@ -125,17 +226,8 @@ Status MoE<T>::ComputeMoE(const OpKernelContext* context,
     num_routing_threads = std::max(1, num_routing_threads);
   }
 
-  std::vector<std::vector<std::vector<int64_t>>> thread_local_expert_token_maps(num_routing_threads);
-  for (auto& map : thread_local_expert_token_maps) {
-    map.resize(static_cast<size_t>(num_experts));
-    for (auto& expert_map : map) {
-      expert_map.reserve(static_cast<size_t>(std::max(static_cast<int64_t>(1), num_tokens / num_experts / num_routing_threads * 2)));
-    }
-  }
-
   concurrency::ThreadPool::TrySimpleParallelFor(tp, num_routing_threads, [&](std::ptrdiff_t thread_id) {
     auto work = concurrency::ThreadPool::PartitionWork(narrow<int>(thread_id), num_routing_threads, static_cast<std::ptrdiff_t>(num_tokens));
-    auto& local_expert_token_map = thread_local_expert_token_maps[thread_id];
 
     std::vector<std::pair<float, int64_t>> sorted_logits(static_cast<size_t>(num_experts));
     std::vector<float> full_softmax(static_cast<size_t>(num_experts));
@@ -162,276 +254,88 @@ Status MoE<T>::ComputeMoE(const OpKernelContext* context,
 
       std::partial_sort(sorted_logits.begin(), sorted_logits.begin() + static_cast<std::ptrdiff_t>(k_), sorted_logits.end(), std::greater<>());
 
+      float scale = 1.0f;
       if (normalize_routing_weights_) {
         float top_k_sum = 0.0f;
         for (int64_t j = 0; j < k_; ++j) {
           top_k_sum += sorted_logits[static_cast<size_t>(j)].first;
         }
-        const float inv_top_k_sum = 1.0f / top_k_sum;
-
-        for (int64_t j = 0; j < k_; ++j) {
-          int64_t expert_idx = sorted_logits[static_cast<size_t>(j)].second;
-          int64_t route_idx = i * k_ + j;
-          float normalized_weight = sorted_logits[static_cast<size_t>(j)].first * inv_top_k_sum;
-
-          route_expert[route_idx] = narrow<int>(expert_idx);
-          route_scale[route_idx] = normalized_weight;
-          if (normalized_weight > 0.0f) {
-            local_expert_token_map[static_cast<size_t>(expert_idx)].push_back(route_idx);
-          }
-        }
-      } else {
-        for (int64_t j = 0; j < k_; ++j) {
-          int64_t expert_idx = sorted_logits[static_cast<size_t>(j)].second;
-          int64_t route_idx = i * k_ + j;
-          float weight = sorted_logits[static_cast<size_t>(j)].first;
-
-          route_expert[route_idx] = narrow<int>(expert_idx);
-          route_scale[route_idx] = weight;
-          if (weight > 0.0f) {
-            local_expert_token_map[static_cast<size_t>(expert_idx)].push_back(route_idx);
-          }
-        }
-      }
-    }
-  });
-
-  std::vector<std::vector<int64_t>> expert_token_map(static_cast<size_t>(num_experts));
-
-  for (int64_t expert_idx = 0; expert_idx < num_experts; ++expert_idx) {
-    size_t total_tokens_for_expert = 0;
-    for (int t = 0; t < num_routing_threads; ++t) {
-      total_tokens_for_expert += thread_local_expert_token_maps[t][static_cast<size_t>(expert_idx)].size();
-    }
-    expert_token_map[static_cast<size_t>(expert_idx)].reserve(total_tokens_for_expert);
-  }
-
-  for (int t = 0; t < num_routing_threads; ++t) {
-    for (int64_t expert_idx = 0; expert_idx < num_experts; ++expert_idx) {
-      auto& local_tokens = thread_local_expert_token_maps[t][static_cast<size_t>(expert_idx)];
-      if (!local_tokens.empty()) {
-        auto& expert_map = expert_token_map[static_cast<size_t>(expert_idx)];
-        expert_map.insert(expert_map.end(),
-                          std::make_move_iterator(local_tokens.begin()),
-                          std::make_move_iterator(local_tokens.end()));
+        scale = 1.0f / top_k_sum;
       }
-    }
-  }
-
-  for (int64_t expert_idx = 0; expert_idx < num_experts; ++expert_idx) {
-    auto& expert_map = expert_token_map[static_cast<size_t>(expert_idx)];
-    if (!expert_map.empty()) {
-      std::sort(expert_map.begin(), expert_map.end());
-    }
-  }
 
-  IAllocatorUniquePtr<float> input_float_buffer;
-  const float* input_float;
-  if constexpr (std::is_same_v<T, MLFloat16>) {
-    input_float_buffer = IAllocator::MakeUniquePtr<float>(allocator, static_cast<size_t>(num_tokens * hidden_size));
-    input_float = input_float_buffer.get();
-    MlasConvertHalfToFloatBuffer(reinterpret_cast<const MLFloat16*>(input_data_to_use), const_cast<float*>(input_float), static_cast<size_t>(num_tokens * hidden_size));
-  } else {
-    input_float = reinterpret_cast<const float*>(input_data_to_use);
-  }
-
-  int num_expert_threads = 1;
-  if (tp != nullptr) {
-    int total_active_experts = 0;
-    for (int64_t expert_idx = 0; expert_idx < num_experts; ++expert_idx) {
-      if (!expert_token_map[static_cast<size_t>(expert_idx)].empty()) {
-        total_active_experts++;
+      for (int64_t j = 0; j < k_; ++j) {
+        int64_t route_idx = i * k_ + j;
+        route_expert[route_idx] = narrow<int>(sorted_logits[static_cast<size_t>(j)].second);
+        route_scale[route_idx] = sorted_logits[static_cast<size_t>(j)].first * scale;
       }
     }
+  });
 
-    if (total_active_experts > 0) {
-      int max_threads = concurrency::ThreadPool::DegreeOfParallelism(tp);
-      num_expert_threads = std::min(total_active_experts, max_threads);
-      num_expert_threads = std::min(num_expert_threads, 8);
-    }
-  }
-
-  // Calculate maximum possible tokens per expert for buffer sizing
-  int64_t max_tokens_per_expert = 0;
-  for (int64_t expert_idx = 0; expert_idx < num_experts; ++expert_idx) {
-    const auto& routes = expert_token_map[static_cast<size_t>(expert_idx)];
-    max_tokens_per_expert = std::max(max_tokens_per_expert, static_cast<int64_t>(routes.size()));
-  }
-
-  // Thread-local buffer pool for expert processing
-  struct ThreadLocalBuffers {
-    IAllocatorUniquePtr<float> A1_buffer;
-    IAllocatorUniquePtr<float> batch_weights_buffer;
-    IAllocatorUniquePtr<int64_t> token_ids_buffer;
-    IAllocatorUniquePtr<T> A1_t_buffer;
-    IAllocatorUniquePtr<T> C2_buffer;
-    // Additional buffers for ProcessExpertBatch to avoid repeated allocations
-    IAllocatorUniquePtr<T> fc1_output_buffer;
-    IAllocatorUniquePtr<T> activation_output_buffer;
-    int64_t current_capacity = 0;
-    int64_t current_fc1_capacity = 0;
-    int64_t current_activation_capacity = 0;
-
-    void EnsureCapacity(AllocatorPtr& allocator, int64_t required_tokens, int64_t hidden_size,
-                        int64_t fc1_output_size, int64_t inter_size) {
-      if (required_tokens > current_capacity) {
-        // Use high watermark approach - allocate more than needed for future reuse
-        int64_t new_capacity = std::max(required_tokens * 2, current_capacity + 512);
-
-        A1_buffer = IAllocator::MakeUniquePtr<float>(allocator, static_cast<size_t>(new_capacity * hidden_size));
-        batch_weights_buffer = IAllocator::MakeUniquePtr<float>(allocator, static_cast<size_t>(new_capacity));
-        token_ids_buffer = IAllocator::MakeUniquePtr<int64_t>(allocator, static_cast<size_t>(new_capacity));
-        A1_t_buffer = IAllocator::MakeUniquePtr<T>(allocator, static_cast<size_t>(new_capacity * hidden_size));
-        C2_buffer = IAllocator::MakeUniquePtr<T>(allocator, static_cast<size_t>(new_capacity * hidden_size));
-
-        current_capacity = new_capacity;
-      }
-
-      // Ensure ProcessExpertBatch buffers have sufficient capacity
-      int64_t required_fc1_capacity = required_tokens * fc1_output_size;
-      int64_t required_activation_capacity = required_tokens * inter_size;
-
-      if (required_fc1_capacity > current_fc1_capacity) {
-        int64_t new_fc1_capacity = std::max(required_fc1_capacity * 2, current_fc1_capacity + (512 * fc1_output_size));
-        fc1_output_buffer = IAllocator::MakeUniquePtr<T>(allocator, static_cast<size_t>(new_fc1_capacity));
-        current_fc1_capacity = new_fc1_capacity;
-      }
-
-      if (required_activation_capacity > current_activation_capacity) {
-        int64_t new_activation_capacity = std::max(required_activation_capacity * 2, current_activation_capacity + (512 * inter_size));
-        activation_output_buffer = IAllocator::MakeUniquePtr<T>(allocator, static_cast<size_t>(new_activation_capacity));
-        current_activation_capacity = new_activation_capacity;
-      }
-    }
-  };
-
-  // Pre-allocate thread-local buffer pools
-  std::vector<ThreadLocalBuffers> thread_buffers(num_expert_threads);
-  for (int i = 0; i < num_expert_threads; ++i) {
-    thread_buffers[i].EnsureCapacity(allocator, max_tokens_per_expert, hidden_size, fc1_output_size, inter_size);
+  // Permute: group the routed rows of each expert contiguously.
+  MoERoutingPlan plan;
+  BuildMoERoutingPlan(route_expert, route_scale, num_tokens * k_, num_experts, 0.0f, plan);
+  const int64_t num_rows = plan.NumRows();
+  if (num_rows == 0) {
+    std::fill_n(output_data, output->Shape().Size(), T{});
+    return Status::OK();
   }
 
-  const size_t output_buffer_size = static_cast<size_t>(output->Shape().Size());
-  auto thread_local_outputs_ptr = IAllocator::MakeUniquePtr<float>(allocator, static_cast<size_t>(num_expert_threads) * output_buffer_size);
-  float* thread_local_outputs = thread_local_outputs_ptr.get();
-
-  // Initialize thread-local outputs with vectorized operation
-  std::fill_n(thread_local_outputs, static_cast<size_t>(num_expert_threads) * output_buffer_size, 0.0f);
-
-  // Optimized expert processing with thread-local buffer reuse
-  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_expert_threads, [&](std::ptrdiff_t thread_id_pd) {
-    int thread_id = narrow<int>(thread_id_pd);
-    auto work = concurrency::ThreadPool::PartitionWork(thread_id, num_expert_threads, static_cast<std::ptrdiff_t>(num_experts));
-
-    float* local_output = thread_local_outputs + static_cast<size_t>(thread_id) * output_buffer_size;
-    ThreadLocalBuffers& buffers = thread_buffers[thread_id];
-
-    for (int64_t expert_idx = work.start; expert_idx < work.end; ++expert_idx) {
-      const auto& routes = expert_token_map[static_cast<size_t>(expert_idx)];
-      if (routes.empty()) continue;
-
-      const int64_t num_expert_tokens = static_cast<int64_t>(routes.size());
-
-      // Ensure thread-local buffers have sufficient capacity
-      buffers.EnsureCapacity(allocator, num_expert_tokens, hidden_size, fc1_output_size, inter_size);
-
-      // Use pre-allocated buffers from thread-local pool
-      float* A1 = buffers.A1_buffer.get();
-      float* batch_weights = buffers.batch_weights_buffer.get();
-      int64_t* token_ids = buffers.token_ids_buffer.get();
-      T* A1_t = buffers.A1_t_buffer.get();
-      T* C2 = buffers.C2_buffer.get();
-      T* fc1_output = buffers.fc1_output_buffer.get();
-      T* activation_output = buffers.activation_output_buffer.get();
-
-      // Optimized data gathering with better memory access patterns
-      for (int64_t r = 0; r < num_expert_tokens; ++r) {
-        int64_t route_idx = routes[static_cast<size_t>(r)];
-        int64_t token = route_idx / k_;
-
-        token_ids[r] = token;
-        batch_weights[r] = route_scale[route_idx];
-
-        // Use SIMD-friendly copy for better performance
-        const float* src = input_float + token * hidden_size;
-        float* dst = A1 + static_cast<size_t>(r) * static_cast<size_t>(hidden_size);
-        std::copy(src, src + hidden_size, dst);
-      }
-
-      const T* fc1_expert_weights = fc1_weights_data + expert_idx * fc1_output_size * hidden_size;
+  auto permuted_input_ptr = IAllocator::MakeUniquePtr<T>(allocator, static_cast<size_t>(num_rows * hidden_size));
+  T* permuted_input = permuted_input_ptr.get();
+  auto permuted_output_ptr = IAllocator::MakeUniquePtr<T>(allocator, static_cast<size_t>(num_rows * hidden_size));
+  T* permuted_output = permuted_output_ptr.get();
+  PermuteMoEInput(input_data, hidden_size, k_, plan, permuted_input, tp);
+
+  // Grouped GEMM: split the work over experts x row tiles so that a skewed routing still spreads
+  // the load of a hot expert over all threads. Tiles are handed out dynamically.
+  const int max_threads = tp ? concurrency::ThreadPool::DegreeOfParallelism(tp) : 1;
+  const int64_t tile_rows = GetMoETileRows(num_rows, max_threads);
+  std::vector<MoEWorkItem> work_items;
+  BuildMoEWorkItems(plan, tile_rows, work_items);
+  const int num_workers = std::max(1, std::min(max_threads, narrow<int>(work_items.size())));
+
+  const size_t scratch_per_worker = static_cast<size_t>(tile_rows * (fc1_output_size + inter_size));
+  auto scratch_ptr = IAllocator::MakeUniquePtr<T>(allocator, static_cast<size_t>(num_workers) * scratch_per_worker);
+  T* scratch = scratch_ptr.get();
+
+  std::atomic<size_t> next_work_item{0};
+  std::vector<Status> worker_status(static_cast<size_t>(num_workers));
+
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_workers, [&](std::ptrdiff_t worker_id) {
+    T* fc1_output = scratch + static_cast<size_t>(worker_id) * scratch_per_worker;
+    T* activation_output = fc1_output + tile_rows * fc1_output_size;
+    Status& status = worker_status[static_cast<size_t>(worker_id)];
+
+    for (size_t i = next_work_item++; i < work_items.size() && status.IsOK(); i = next_work_item++) {
+      const MoEWorkItem& item = work_items[i];
+      const int64_t expert_idx = item.expert_idx;
+
+      const T* fc1_expert_weights = fc1_weights_data ? fc1_weights_data + expert_idx * fc1_output_size * hidden_size : nullptr;
       const T* fc1_expert_bias = fc1_bias_data ? fc1_bias_data + expert_idx * fc1_output_size : nullptr;
-      const T* fc2_expert_weights = fc2_weights_data + expert_idx * hidden_size * inter_size;
+      const T* fc2_expert_weights = fc2_weights_data ? fc2_weights_data + expert_idx * hidden_size * inter_size : nullptr;
       const T* fc2_expert_bias = fc2_bias_data ? fc2_bias_data + expert_idx * hidden_size : nullptr;
 
-      // Convert input to T only when needed for computation
-      for (size_t i = 0; i < static_cast<size_t>(num_expert_tokens * hidden_size); ++i) {
-        A1_t[i] = static_cast<T>(A1[i]);
-      }
-
-      ORT_IGNORE_RETURN_VALUE(ProcessExpertBatch(A1_t, token_ids, batch_weights,
-                                                 num_expert_tokens, expert_idx,
-                                                 fc1_expert_weights, fc1_expert_bias,
-                                                 fc2_expert_weights, fc2_expert_bias,
-                                                 C2, hidden_size, inter_size,
-                                                 fc1_output, activation_output));
-
-      // Optimized output accumulation with vectorized operations
-      for (int64_t r = 0; r < num_expert_tokens; ++r) {
-        int64_t token = token_ids[r];
-        const T* expert_output_t = C2 + static_cast<size_t>(r) * static_cast<size_t>(hidden_size);
-        float w = batch_weights[r];
-        float* dest = local_output + static_cast<size_t>(token) * static_cast<size_t>(hidden_size);
-
-        // Use explicit loop for better vectorization opportunities
-        for (int64_t j = 0; j < hidden_size; ++j) {
-          dest[j] += w * static_cast<float>(expert_output_t[j]);
-        }
-      }
+      status = ProcessExpertBatch(permuted_input + item.row_start * hidden_size, item.row_count, expert_idx,
+                                  fc1_expert_weights, fc1_expert_bias,
+                                  fc2_expert_weights, fc2_expert_bias,
+                                  permuted_output + item.row_start * hidden_size,
+                                  hidden_size, inter_size, fc1_output, activation_output);
     }
   });
 
-  auto accumulate = [&](float* buffer) {
-    std::fill_n(buffer, output_buffer_size, 0.0f);
-
-    for (size_t j = 0; j < output_buffer_size; ++j) {
-      double sum = 0.0;
-      double c = 0.0;
-
-      for (int i = 0; i < num_expert_threads; ++i) {
-        const size_t thread_offset = static_cast<size_t>(i) * output_buffer_size;
-        double y = static_cast<double>(thread_local_outputs[thread_offset + j]) - c;
-        double t = sum + y;
-        c = (t - sum) - y;
-        sum = t;
-      }
-      buffer[j] = static_cast<float>(sum);
-    }
-  };
-
-  if constexpr (std::is_same_v<T, MLFloat16>) {
-    auto final_output_float_ptr = IAllocator::MakeUniquePtr<float>(allocator, output_buffer_size);
-    float* final_output_float = final_output_float_ptr.get();
-    accumulate(final_output_float);
-
-    MlasConvertFloatToHalfBuffer(final_output_float,
-                                 reinterpret_cast<MLFloat16*>(output->MutableData<T>()),
-                                 static_cast<size_t>(output_buffer_size));
-  } else {
-    auto final_output_float_ptr = IAllocator::MakeUniquePtr<float>(allocator, output_buffer_size);
-    float* final_output_float = final_output_float_ptr.get();
-    accumulate(final_output_float);
-
-    float* out_ptr = reinterpret_cast<float*>(output->MutableData<T>());
-    memcpy(out_ptr, final_output_float, output_buffer_size * sizeof(float));
+  for (const auto& status : worker_status) {
+    ORT_RETURN_IF_ERROR(status);
   }
+
+  // Unpermute: weighted sum of each token's expert outputs.
+  UnpermuteMoEOutput(permuted_output, route_scale, plan, num_tokens, k_, hidden_size, output_data, tp);
   return Status::OK();
 }
+
 template <typename T>
 Status MoE<T>::ProcessExpertBatch(const T* input_tokens,
-                                  const int64_t* token_expert_ids,
-                                  const float* token_weights,
-                                  int64_t batch_size,
-                                  int64_t expert_id,
+                                  int64_t num_rows,
+                                  int64_t expert_idx,
                                   const T* fc1_weights,
                                   const T* fc1_bias,
                                   const T* fc2_weights,
@@ -439,70 +343,51 @@ Status MoE<T>::ProcessExpertBatch(const T* input_tokens,
                                   T* output_buffer,
                                   int64_t hidden_size,
                                   int64_t inter_size,
-                                  T* fc1_output_buffer,
-                                  T* activation_output_buffer) const {
-  ORT_UNUSED_PARAMETER(token_expert_ids);
-  ORT_UNUSED_PARAMETER(token_weights);
-  ORT_UNUSED_PARAMETER(expert_id);
-  ORT_UNUSED_PARAMETER(fc1_output_buffer);
-  ORT_UNUSED_PARAMETER(activation_output_buffer);
+                                  T* fc1_output,
+                                  T* activation_output) const {
   const bool is_swiglu = activation_type_ == ActivationType::SwiGLU;
   const int64_t fc1_output_size = is_swiglu ? (inter_size * 2) : inter_size;
 
-  constexpr int64_t stack_threshold = 1024;
-  const bool use_stack = (batch_size * fc1_output_size) <= stack_threshold;
-
-  std::vector<T> fc1_output_vec;
-  std::vector<T> activation_output_vec;
-  T* fc1_output;
-  T* activation_output;
-
-  if (use_stack) {
-    fc1_output_vec.resize(static_cast<size_t>(batch_size * fc1_output_size));
-    activation_output_vec.resize(static_cast<size_t>(batch_size * inter_size));
-    fc1_output = fc1_output_vec.data();
-    activation_output = activation_output_vec.data();
-  } else {
-    fc1_output_vec.resize(static_cast<size_t>(batch_size * fc1_output_size));
-    activation_output_vec.resize(static_cast<size_t>(batch_size * inter_size));
-    fc1_output = fc1_output_vec.data();
-    activation_output = activation_output_vec.data();
-  }
+  const void* fc1_packed = packed_fc1_
+                               ? static_cast<const uint8_t*>(packed_fc1_.get()) + expert_idx * packed_fc1_expert_size_
+                               : nullptr;
+  const void* fc2_packed = packed_fc2_
+                               ? static_cast<const uint8_t*>(packed_fc2_.get()) + expert_idx * packed_fc2_expert_size_
+                               : nullptr;
 
   ORT_RETURN_IF_ERROR(ComputeGEMM(input_tokens, fc1_weights, fc1_output,
-                                  batch_size, hidden_size, fc1_output_size, true));
+                                  num_rows, hidden_size, fc1_output_size, true, fc1_packed));
 
   if (fc1_bias) {
-    for (int64_t batch = 0; batch < batch_size; ++batch) {
-      T* batch_output = fc1_output + batch * fc1_output_size;
-      // Explicit loop for better vectorization
+    for (int64_t row = 0; row < num_rows; ++row) {
+      T* row_output = fc1_output + row * fc1_output_size;
       for (int64_t i = 0; i < fc1_output_size; ++i) {
-        batch_output[i] = static_cast<T>(static_cast<float>(batch_output[i]) +
-                                         static_cast<float>(fc1_bias[i]));
+        row_output[i] = static_cast<T>(static_cast<float>(row_output[i]) +
+                                       static_cast<float>(fc1_bias[i]));
       }
     }
   }
 
   if (is_swiglu) {
-    for (int64_t batch = 0; batch < batch_size; ++batch) {
-      ApplySwiGLUVectorized(fc1_output + batch * fc1_output_size,
-                            activation_output + batch * inter_size,
+    for (int64_t row = 0; row < num_rows; ++row) {
+      ApplySwiGLUVectorized(fc1_output + row * fc1_output_size,
+                            activation_output + row * inter_size,
                             inter_size);
     }
   } else {
-    ApplyActivationVectorized(fc1_output, batch_size * fc1_output_size);
-    std::copy(fc1_output, fc1_output + (batch_size * fc1_output_size), activation_output);
+    ApplyActivationVectorized(fc1_output, num_rows * fc1_output_size);
+    std::copy(fc1_output, fc1_output + (num_rows * fc1_output_size), activation_output);
   }
 
   ORT_RETURN_IF_ERROR(ComputeGEMM(activation_output, fc2_weights, output_buffer,
-                                  batch_size, inter_size, hidden_size, true));
+                                  num_rows, inter_size, hidden_size, true, fc2_packed));
 
   if (fc2_bias) {
-    for (int64_t batch = 0; batch < batch_size; ++batch) {
-      T* batch_output = output_buffer + batch * hidden_size;
+    for (int64_t row = 0; row < num_rows; ++row) {
+      T* row_output = output_buffer + row * hidden_size;
       for (int64_t i = 0; i < hidden_size; ++i) {
-        batch_output[i] = static_cast<T>(static_cast<float>(batch_output[i]) +
-                                         static_cast<float>(fc2_bias[i]));
+        row_output[i] = static_cast<T>(static_cast<float>(row_output[i]) +
+                                       static_cast<float>(fc2_bias[i]));
       }
     }
   }
@@ -512,7 +397,8 @@ Status MoE<T>::ProcessExpertBatch(const T* input_tokens,
 
 template <>
 Status MoE<float>::ComputeGEMM(const float* A, const float* B, float* C,
-                               int64_t M, int64_t K, int64_t N, bool transpose_B) const {
+                               int64_t M, int64_t K, int64_t N, bool transpose_B,
+                               const void* packed_B) const {
   MLAS_SGEMM_DATA_PARAMS params;
   params.A = A;
   params.lda = static_cast<size_t>(K);
@@ -522,6 +408,11 @@ Status MoE<float>::ComputeGEMM(const float* A, const float* B, float* C,
   params.ldc = static_cast<size_t>(N);
   params.B = B;
 
+  if (packed_B != nullptr) {
+    params.B = static_cast<const float*>(packed_B);
+    params.BIsPacked = true;
+  }
+
   if (transpose_B) {
     params.ldb = static_cast<size_t>(K);
     MlasGemm(CblasNoTrans, CblasTrans, static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K), params, nullptr, &mlas_backend_kernel_selector_config_);
@@ -535,7 +426,9 @@ Status MoE<float>::ComputeGEMM(const float* A, const float* B, float* C,
 
 template <>
 Status MoE<MLFloat16>::ComputeGEMM(const MLFloat16* A, const MLFloat16* B, MLFloat16* C,
-                                   int64_t M, int64_t K, int64_t N, bool transpose_B) const {
+                                   int64_t M, int64_t K, int64_t N, bool transpose_B,
+                                   const void* packed_B) const {
+  ORT_UNUSED_PARAMETER(packed_B);
   MLAS_HALF_GEMM_DATA_PARAMS params;
   params.A = A;
   params.lda = static_cast<size_t>(K);
@@ -6,6 +6,7 @@
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "contrib_ops/cpu/moe/moe_base_cpu.h"
+#include <vector>
 
 namespace onnxruntime {
 namespace contrib {
@@ -17,6 +18,14 @@ class MoE final : public OpKernel, public MoEBaseCPU {
   Status Compute(OpKernelContext* context) const override;
 
  private:
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
   Status ComputeMoE(const OpKernelContext* context,
                     const Tensor* input,
                     const Tensor* router_probs,
@@ -27,10 +36,8 @@ class MoE final : public OpKernel, public MoEBaseCPU {
                     Tensor* output) const;
 
   Status ProcessExpertBatch(const T* input_tokens,
-                            const int64_t* token_expert_ids,
-                            const float* token_weights,
-                            int64_t num_tokens,
-                            int64_t expert_id,
+                            int64_t num_rows,
+                            int64_t expert_idx,
                             const T* fc1_weights,
                             const T* fc1_bias,
                             const T* fc2_weights,
@@ -43,10 +50,20 @@ class MoE final : public OpKernel, public MoEBaseCPU {
 
   Status ComputeGEMM(const T* A, const T* B, T* C,
                      int64_t M, int64_t K, int64_t N,
-                     bool transpose_B = false) const;
+                     bool transpose_B = false,
+                     const void* packed_B = nullptr) const;
 
   void ApplyActivationVectorized(T* data, int64_t size) const;
   void ApplySwiGLUVectorized(const T* input, T* output, int64_t size) const;
+
+  // Expert weights prepacked per expert for MlasGemm (float only). The per-expert stride of each
+  // buffer is packed_fc*_expert_size_ bytes.
+  IAllocatorUniquePtr<void> packed_fc1_;
+  IAllocatorUniquePtr<void> packed_fc2_;
+  size_t packed_fc1_expert_size_{0};
+  size_t packed_fc2_expert_size_{0};
+  TensorShape fc1_shape_;
+  TensorShape fc2_shape_;
 };
 
 }  // namespace contrib
@@ -692,8 +692,6 @@ Status QMoECPU<T>::Compute(OpKernelContext* context) const {
   AllocatorPtr allocator;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
 
-  const size_t output_buffer_size = static_cast<size_t>(output->Shape().Size());
-
   const T* input_data = input->Data<T>();
 
   IAllocatorUniquePtr<float> router_logits_float_buffer;
@@ -719,17 +717,8 @@ Status QMoECPU<T>::Compute(OpKernelContext* context) const {
   const int optimal_routing_threads = (tp == nullptr || num_tokens < min_work_per_thread) ? 1 : std::min(narrow<int>(num_tokens / std::max(int64_t{1}, min_work_per_thread)), max_threads);
   const int num_routing_threads = std::max(1, optimal_routing_threads);
 
-  std::vector<std::vector<std::vector<int64_t>>> thread_local_expert_token_maps(num_routing_threads);
-  for (auto& map : thread_local_expert_token_maps) {
-    map.resize(static_cast<size_t>(num_experts));
-    for (auto& expert_tokens : map) {
-      expert_tokens.reserve(32);
-    }
-  }
-
   concurrency::ThreadPool::TrySimpleParallelFor(tp, num_routing_threads, [&](std::ptrdiff_t thread_id) {
     auto work = concurrency::ThreadPool::PartitionWork(narrow<int>(thread_id), num_routing_threads, static_cast<std::ptrdiff_t>(num_tokens));
-    auto& local_expert_token_map = thread_local_expert_token_maps[thread_id];
 
     std::vector<std::pair<float, int64_t>> sorted_logits(static_cast<size_t>(num_experts));
     std::vector<float> top_k_exp(static_cast<size_t>(k_));
@@ -757,29 +746,20 @@ Status QMoECPU<T>::Compute(OpKernelContext* context) const {
         int64_t route_idx = i * k_ + narrow<int64_t>(j);
         route_expert[route_idx] = narrow<int>(expert_idx);
         route_scale[route_idx] = top_k_exp[j] * inv_sum;
-        if (route_scale[route_idx] > 1e-8f) {  // Use small threshold to avoid zero weights
-          local_expert_token_map[static_cast<size_t>(expert_idx)].push_back(route_idx);
-        }
       }
     }
   });
 
-  std::vector<std::vector<int64_t>> expert_token_map(static_cast<size_t>(num_experts));
+  // Use small threshold to avoid zero weights
+  MoERoutingPlan plan;
+  BuildMoERoutingPlan(route_expert, route_scale, num_tokens * k_, num_experts, 1e-8f, plan);
+
+  std::vector<gsl::span<const int64_t>> expert_token_map(static_cast<size_t>(num_experts));
   for (int64_t expert_idx = 0; expert_idx < num_experts; ++expert_idx) {
-    size_t total_tokens_for_expert = 0;
-    for (int t = 0; t < num_routing_threads; ++t) {
-      total_tokens_for_expert += thread_local_expert_token_maps[t][static_cast<size_t>(expert_idx)].size();
-    }
-    expert_token_map[static_cast<size_t>(expert_idx)].reserve(total_tokens_for_expert);
-
-    for (int t = 0; t < num_routing_threads; ++t) {
-      auto& local_tokens = thread_local_expert_token_maps[t][static_cast<size_t>(expert_idx)];
-      if (!local_tokens.empty()) {
-        expert_token_map[static_cast<size_t>(expert_idx)].insert(
-            expert_token_map[static_cast<size_t>(expert_idx)].end(),
-            local_tokens.begin(), local_tokens.end());
-      }
-    }
+    expert_token_map[static_cast<size_t>(expert_idx)] =
+        gsl::make_span(plan.permuted_routes)
+            .subspan(static_cast<size_t>(plan.expert_offsets[static_cast<size_t>(expert_idx)]),
+                     static_cast<size_t>(plan.NumExpertRows(expert_idx)));
   }
 
   IAllocatorUniquePtr<float> input_float_buffer;
@@ -796,16 +776,17 @@ Status QMoECPU<T>::Compute(OpKernelContext* context) const {
 
   const int max_expert_threads = tp ? concurrency::ThreadPool::DegreeOfParallelism(tp) : 1;
   const int64_t total_expert_work = std::accumulate(expert_token_map.begin(), expert_token_map.end(), 0LL,
-                                                    [](int64_t sum, const std::vector<int64_t>& tokens) { return sum + static_cast<int64_t>(tokens.size()); });
+                                                    [](int64_t sum, gsl::span<const int64_t> tokens) { return sum + static_cast<int64_t>(tokens.size()); });
   const int64_t expert_thread_divisor = std::max(1, max_expert_threads * 8);
   const int64_t min_expert_work_per_thread = std::max(int64_t{16}, total_expert_work / expert_thread_divisor);
 
   int num_expert_threads = (tp == nullptr || total_expert_work < min_expert_work_per_thread) ? 1 : std::min(narrow<int>(total_expert_work / std::max(int64_t{1}, min_expert_work_per_thread)), std::min(narrow<int>(num_experts), max_expert_threads));
   if (num_expert_threads == 0) num_expert_threads = 1;
 
-  auto thread_local_outputs_ptr = IAllocator::MakeUniquePtr<float>(allocator, static_cast<size_t>(num_expert_threads) * output_buffer_size);
-  float* thread_local_outputs = thread_local_outputs_ptr.get();
-  std::memset(thread_local_outputs, 0, static_cast<size_t>(num_expert_threads) * output_buffer_size * sizeof(float));
+  // Expert outputs are written unweighted to their permuted rows and reduced per token afterwards,
+  // which avoids a full-size output buffer per thread.
+  auto permuted_output_ptr = IAllocator::MakeUniquePtr<float>(allocator, static_cast<size_t>(plan.NumRows() * hidden_size));
+  float* permuted_output = permuted_output_ptr.get();
 
   size_t max_tokens_per_expert = 0;
   for (const auto& tokens : expert_token_map) {
@@ -1398,17 +1379,9 @@ Status QMoECPU<T>::Compute(OpKernelContext* context) const {
         }
       }
 
+      float* expert_output = permuted_output + plan.expert_offsets[static_cast<size_t>(expert_idx)] * hidden_size;
       for (int64_t i = 0; i < num_expert_tokens; ++i) {
-        const int64_t route_idx = routes[static_cast<size_t>(i)];
-        const int64_t token_idx = route_idx / k_;
-        const float weight = route_scale[route_idx];
-
-        if (token_idx < 0 || token_idx >= num_tokens) continue;
-
-        const size_t buffer_offset = static_cast<size_t>(token_idx) * static_cast<size_t>(hidden_size);
-        if (buffer_offset + static_cast<size_t>(hidden_size) > output_buffer_size) continue;
-
-        float* dest = thread_local_outputs + static_cast<size_t>(thread_id) * output_buffer_size + buffer_offset;
+        float* dest = expert_output + i * hidden_size;
         const float* src = C2 + i * hidden_size;
 
         if (has_fc2_bias && !fc2_bias_added_by_mlas) {
@@ -1416,91 +1389,21 @@ Status QMoECPU<T>::Compute(OpKernelContext* context) const {
           size_t j = 0;
           for (; j + unroll_factor <= narrow<size_t>(hidden_size); j += unroll_factor) {
             for (size_t loop_k = 0; loop_k < unroll_factor; ++loop_k) {
-              dest[j + loop_k] += weight * (src[j + loop_k] + thread_bias2_buffer[j + loop_k]);
+              dest[j + loop_k] = src[j + loop_k] + thread_bias2_buffer[j + loop_k];
             }
           }
           for (; j < narrow<size_t>(hidden_size); ++j) {
-            dest[j] += weight * (src[j] + thread_bias2_buffer[j]);
+            dest[j] = src[j] + thread_bias2_buffer[j];
           }
         } else {
-          const size_t unroll_factor = narrow<size_t>(GetUnrollFactor(hidden_size));
-          size_t j = 0;
-          for (; j + unroll_factor <= narrow<size_t>(hidden_size); j += unroll_factor) {
-            for (size_t loop_k = 0; loop_k < unroll_factor; ++loop_k) {
-              dest[j + loop_k] += weight * src[j + loop_k];
-            }
-          }
-          for (; j < narrow<size_t>(hidden_size); ++j) {
-            dest[j] += weight * src[j];
-          }
+          std::memcpy(dest, src, static_cast<size_t>(hidden_size) * sizeof(float));
         }
       }
     }
   });
 
-  auto accumulate = [&](float* buffer) {
-    std::memset(buffer, 0, output_buffer_size * sizeof(float));
-
-    const int max_acc_threads = tp ? concurrency::ThreadPool::DegreeOfParallelism(tp) : 1;
-    const size_t acc_thread_divisor = std::max(size_t{1}, static_cast<size_t>(max_acc_threads) * 8);
-    const size_t min_elements_per_thread = std::max(size_t{32}, output_buffer_size / acc_thread_divisor);
-    const int optimal_acc_threads = (tp == nullptr || output_buffer_size < min_elements_per_thread) ? 1 : std::min(narrow<int>(output_buffer_size / std::max(size_t{1}, min_elements_per_thread)), max_acc_threads);
-    const int num_acc_threads = std::max(1, optimal_acc_threads);
-
-    if (num_acc_threads > 1) {
-      concurrency::ThreadPool::TrySimpleParallelFor(tp, num_acc_threads, [&](std::ptrdiff_t acc_thread_id) {
-        const size_t elements_per_thread = output_buffer_size / static_cast<size_t>(num_acc_threads);
-        const size_t start_idx = static_cast<size_t>(acc_thread_id) * elements_per_thread;
-        const size_t end_idx = (acc_thread_id == num_acc_threads - 1) ? output_buffer_size : start_idx + elements_per_thread;
-
-        for (int i = 0; i < num_expert_threads; ++i) {
-          const size_t thread_offset = static_cast<size_t>(i) * output_buffer_size;
-          const float* src = thread_local_outputs + thread_offset + start_idx;
-          float* dst = buffer + start_idx;
-
-          size_t j = 0;
-          const size_t chunk_size = end_idx - start_idx;
-          const size_t unroll_factor = static_cast<size_t>(GetUnrollFactor(static_cast<int64_t>(chunk_size)));
-          for (; j + unroll_factor <= chunk_size; j += unroll_factor) {
-            for (size_t loop_k = 0; loop_k < unroll_factor; ++loop_k) {
-              dst[j + loop_k] += src[j + loop_k];
-            }
-          }
-          for (; j < chunk_size; ++j) {
-            dst[j] += src[j];
-          }
-        }
-      });
-    } else {
-      for (int i = 0; i < num_expert_threads; ++i) {
-        const size_t thread_offset = static_cast<size_t>(i) * output_buffer_size;
-        const float* src = thread_local_outputs + thread_offset;
-
-        size_t j = 0;
-        const size_t unroll_factor = narrow<size_t>(GetUnrollFactor(narrow<int64_t>(output_buffer_size)));
-        for (; j + unroll_factor <= output_buffer_size; j += unroll_factor) {
-          for (size_t loop_k = 0; loop_k < unroll_factor; ++loop_k) {
-            buffer[j + loop_k] += src[j + loop_k];
-          }
-        }
-        for (; j < output_buffer_size; ++j) {
-          buffer[j] += src[j];
-        }
-      }
-    }
-  };
-
-  if constexpr (std::is_same_v<T, MLFloat16>) {
-    auto final_output_float_ptr = IAllocator::MakeUniquePtr<float>(allocator, output_buffer_size);
-    float* final_output_float = final_output_float_ptr.get();
-    accumulate(final_output_float);
-
-    MlasConvertFloatToHalfBuffer(final_output_float,
-                                 reinterpret_cast<MLFloat16*>(output->MutableData<T>()),
-                                 static_cast<size_t>(output_buffer_size));
-  } else {
-    accumulate(output->MutableData<T>());
-  }
+  UnpermuteMoEOutput(permuted_output, route_scale, plan, num_tokens, k_, hidden_size,
+                     output->MutableData<T>(), tp);
 
   return Status::OK();
 }
@@ -3,8 +3,10 @@
 
 #include "contrib_ops/cpu/moe/moe_utils.h"
 #include <cmath>
+#include <cstring>
 #include <algorithm>
 #include "core/common/common.h"
+#include "core/common/float16.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -56,5 +58,123 @@ void ApplySwiGLUActivation(const float* input_data, float* output_data, int64_t
   }
 }
 
+void BuildMoERoutingPlan(const int* route_expert, const float* route_scale, int64_t num_routes,
+                         int64_t num_experts, float min_route_weight, MoERoutingPlan& plan) {
+  plan.expert_offsets.assign(static_cast<size_t>(num_experts) + 1, 0);
+  plan.route_to_row.assign(static_cast<size_t>(num_routes), -1);
+
+  for (int64_t r = 0; r < num_routes; ++r) {
+    if (route_scale[r] > min_route_weight) {
+      plan.expert_offsets[static_cast<size_t>(route_expert[r]) + 1]++;
+    }
+  }
+  for (size_t e = 0; e < static_cast<size_t>(num_experts); ++e) {
+    plan.expert_offsets[e + 1] += plan.expert_offsets[e];
+  }
+
+  plan.permuted_routes.resize(static_cast<size_t>(plan.expert_offsets.back()));
+  std::vector<int64_t> cursor(plan.expert_offsets.begin(), plan.expert_offsets.end() - 1);
+  for (int64_t r = 0; r < num_routes; ++r) {
+    if (route_scale[r] > min_route_weight) {
+      const int64_t row = cursor[static_cast<size_t>(route_expert[r])]++;
+      plan.permuted_routes[static_cast<size_t>(row)] = r;
+      plan.route_to_row[static_cast<size_t>(r)] = row;
+    }
+  }
+}
+
+int64_t GetMoETileRows(int64_t num_rows, int num_threads) {
+  // Aim for a few work items per thread; keep tiles large enough for the GEMM to stay efficient.
+  constexpr int64_t kMinTileRows = 16;
+  constexpr int64_t kMaxTileRows = 256;
+  const int64_t target_items = static_cast<int64_t>(std::max(1, num_threads)) * 4;
+  const int64_t rows_per_item = (num_rows + target_items - 1) / target_items;
+  return std::clamp(rows_per_item, kMinTileRows, kMaxTileRows);
+}
+
+void BuildMoEWorkItems(const MoERoutingPlan& plan, int64_t tile_rows, std::vector<MoEWorkItem>& work_items) {
+  const int64_t num_experts = static_cast<int64_t>(plan.expert_offsets.size()) - 1;
+
+  std::vector<int64_t> experts;
+  experts.reserve(static_cast<size_t>(num_experts));
+  for (int64_t e = 0; e < num_experts; ++e) {
+    if (plan.NumExpertRows(e) > 0) {
+      experts.push_back(e);
+    }
+  }
+  std::stable_sort(experts.begin(), experts.end(), [&plan](int64_t a, int64_t b) {
+    return plan.NumExpertRows(a) > plan.NumExpertRows(b);
+  });
+
+  work_items.clear();
+  for (int64_t e : experts) {
+    const int64_t begin = plan.expert_offsets[static_cast<size_t>(e)];
+    const int64_t end = plan.expert_offsets[static_cast<size_t>(e) + 1];
+    for (int64_t row = begin; row < end; row += tile_rows) {
+      work_items.push_back({e, row, std::min(tile_rows, end - row)});
+    }
+  }
+}
+
+template <typename T>
+void PermuteMoEInput(const T* input, int64_t hidden_size, int64_t k, const MoERoutingPlan& plan,
+                     T* permuted_input, concurrency::ThreadPool* tp) {
+  const double row_bytes = static_cast<double>(hidden_size * sizeof(T));
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(plan.NumRows()), TensorOpCost{row_bytes, row_bytes, 0.0},
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t row = begin; row < end; ++row) {
+          const int64_t token = plan.permuted_routes[static_cast<size_t>(row)] / k;
+          std::memcpy(permuted_input + row * hidden_size, input + token * hidden_size,
+                      static_cast<size_t>(hidden_size) * sizeof(T));
+        }
+      });
+}
+
+template <typename TIn, typename TOut>
+void UnpermuteMoEOutput(const TIn* permuted_output, const float* route_scale, const MoERoutingPlan& plan,
+                        int64_t num_tokens, int64_t k, int64_t hidden_size, TOut* output,
+                        concurrency::ThreadPool* tp) {
+  const double row_bytes = static_cast<double>(hidden_size * sizeof(TIn));
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_tokens),
+      TensorOpCost{row_bytes * static_cast<double>(k), static_cast<double>(hidden_size * sizeof(TOut)),
+                   static_cast<double>(hidden_size * k)},
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        std::vector<float> acc(static_cast<size_t>(hidden_size));
+        for (std::ptrdiff_t token = begin; token < end; ++token) {
+          std::fill(acc.begin(), acc.end(), 0.0f);
+          for (int64_t j = 0; j < k; ++j) {
+            const int64_t route_idx = token * k + j;
+            const int64_t row = plan.route_to_row[static_cast<size_t>(route_idx)];
+            if (row < 0) {
+              continue;
+            }
+            const float w = route_scale[route_idx];
+            const TIn* src = permuted_output + row * hidden_size;
+            for (int64_t h = 0; h < hidden_size; ++h) {
+              acc[static_cast<size_t>(h)] += w * static_cast<float>(src[h]);
+            }
+          }
+          TOut* dst = output + token * hidden_size;
+          for (int64_t h = 0; h < hidden_size; ++h) {
+            dst[h] = static_cast<TOut>(acc[static_cast<size_t>(h)]);
+          }
+        }
+      });
+}
+
+template void PermuteMoEInput<float>(const float*, int64_t, int64_t, const MoERoutingPlan&, float*,
+                                     concurrency::ThreadPool*);
+template void PermuteMoEInput<MLFloat16>(const MLFloat16*, int64_t, int64_t, const MoERoutingPlan&, MLFloat16*,
+                                         concurrency::ThreadPool*);
+template void UnpermuteMoEOutput<float, float>(const float*, const float*, const MoERoutingPlan&,
+                                               int64_t, int64_t, int64_t, float*, concurrency::ThreadPool*);
+template void UnpermuteMoEOutput<float, MLFloat16>(const float*, const float*, const MoERoutingPlan&,
+                                                   int64_t, int64_t, int64_t, MLFloat16*, concurrency::ThreadPool*);
+template void UnpermuteMoEOutput<MLFloat16, MLFloat16>(const MLFloat16*, const float*, const MoERoutingPlan&,
+                                                       int64_t, int64_t, int64_t, MLFloat16*,
+                                                       concurrency::ThreadPool*);
+
 }  // namespace contrib
 }  // namespace onnxruntime
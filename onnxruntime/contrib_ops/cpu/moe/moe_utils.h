@@ -3,7 +3,9 @@
 
 #pragma once
 #include <cstdint>
+#include <vector>
 #include "contrib_ops/cpu/moe/moe_base_cpu.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -13,5 +15,56 @@ float ApplyActivation(float x, ActivationType activation_type);
 void ApplySwiGLUActivation(const float* input_data, float* output_data, int64_t inter_size, bool is_interleaved_format,
                            float activation_alpha, float activation_beta, float clamp_limit);
 
+/**
+ * @brief Token permutation shared by the CPU MoE kernels.
+ *
+ * Every route (token * k + slot) that selects an expert becomes one row of a permuted activation
+ * buffer in which the rows of each expert are contiguous. The expert FFNs then run as a grouped
+ * GEMM over (expert, row tile) work items, and the outputs are gathered back per token.
+ */
+struct MoERoutingPlan {
+  // [num_experts + 1] offsets of each expert's rows in permuted_routes.
+  std::vector<int64_t> expert_offsets;
+  // Route indices grouped by expert, ascending within each expert.
+  std::vector<int64_t> permuted_routes;
+  // [num_routes] row of each route in the permuted buffer, or -1 if the route was dropped.
+  std::vector<int64_t> route_to_row;
+
+  int64_t NumRows() const { return static_cast<int64_t>(permuted_routes.size()); }
+  int64_t NumExpertRows(int64_t expert_idx) const {
+    return expert_offsets[static_cast<size_t>(expert_idx) + 1] - expert_offsets[static_cast<size_t>(expert_idx)];
+  }
+};
+
+struct MoEWorkItem {
+  int64_t expert_idx;
+  int64_t row_start;  // first row in the permuted buffer
+  int64_t row_count;
+};
+
+// Groups routes by expert with a counting sort. Routes whose weight is not greater than
+// min_route_weight are dropped.
+void BuildMoERoutingPlan(const int* route_expert, const float* route_scale, int64_t num_routes,
+                         int64_t num_experts, float min_route_weight, MoERoutingPlan& plan);
+
+// Picks the number of rows per work item so that heavily loaded experts are split across threads.
+int64_t GetMoETileRows(int64_t num_rows, int num_threads);
+
+// Splits each expert's rows into tiles of at most tile_rows rows. Tiles of the most loaded experts
+// come first so that a dynamic scheduler starts the long-running work early.
+void BuildMoEWorkItems(const MoERoutingPlan& plan, int64_t tile_rows, std::vector<MoEWorkItem>& work_items);
+
+// Gathers input rows into permuted order: permuted_input[row] = input[permuted_routes[row] / k].
+template <typename T>
+void PermuteMoEInput(const T* input, int64_t hidden_size, int64_t k, const MoERoutingPlan& plan,
+                     T* permuted_input, concurrency::ThreadPool* tp);
+
+// Scatters expert outputs back per token: output[t] = sum_j route_scale[t * k + j] * permuted_output[row(t * k + j)].
+// Each token is reduced by a single thread in slot order, so the result is deterministic.
+template <typename TIn, typename TOut>
+void UnpermuteMoEOutput(const TIn* permuted_output, const float* route_scale, const MoERoutingPlan& plan,
+                        int64_t num_tokens, int64_t k, int64_t hidden_size, TOut* output,
+                        concurrency::ThreadPool* tp);
+
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -0,0 +1,187 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/softmax_topk.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "core/common/narrow.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/common.h"
+#include "core/providers/cpu/math/top_k.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    SoftmaxTopK,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    SoftmaxTopK);
+
+namespace {
+
+// Number of elements whose exponentials are computed at a time.
+constexpr size_t kTileSize = 1024;
+
+// Minimum number of elements in a partition of a slice, when the axis is split across threads.
+constexpr int64_t kMinPartitionSize = 16384;
+
+// Computes the maximum of every lane of the steps [begin, end) of a [dim, inner] slice, and the sum of the
+// exponentials of the lane relative to that maximum.
+void ComputeMaxAndSumExp(const float* slice, int64_t inner, int64_t begin, int64_t end,
+                         float* max_values, float* sums) {
+  std::fill_n(max_values, inner, -std::numeric_limits<float>::infinity());
+  std::fill_n(sums, inner, 0.0f);
+  for (int64_t step = begin; step < end; ++step) {
+    const float* row = slice + step * inner;
+    for (int64_t i = 0; i < inner; ++i) {
+      max_values[i] = std::max(max_values[i], row[i]);
+    }
+  }
+
+  if (inner == 1) {
+    // the lane is contiguous, so the exponentials are computed by tiles with MLAS.
+    float buffer[kTileSize];
+    const float max_value = max_values[0];
+    float sum = 0.0f;
+    for (int64_t offset = begin; offset < end; offset += static_cast<int64_t>(kTileSize)) {
+      const size_t count = static_cast<size_t>(std::min(static_cast<int64_t>(kTileSize), end - offset));
+      for (size_t j = 0; j < count; ++j) {
+        buffer[j] = slice[offset + j] - max_value;
+      }
+      MlasComputeExp(buffer, buffer, count);
+      for (size_t j = 0; j < count; ++j) {
+        sum += buffer[j];
+      }
+    }
+    sums[0] = sum;
+    return;
+  }
+
+  for (int64_t step = begin; step < end; ++step) {
+    const float* row = slice + step * inner;
+    for (int64_t i = 0; i < inner; ++i) {
+      sums[i] += std::exp(row[i] - max_values[i]);
+    }
+  }
+}
+
+}  // namespace
+
+SoftmaxTopK::SoftmaxTopK(const OpKernelInfo& info) : OpKernel(info) {
+  axis_ = info.GetAttrOrDefault<int64_t>("axis", -1);
+  largest_ = info.GetAttrOrDefault<int64_t>("largest", 1) == 1;
+  sorted_ = info.GetAttrOrDefault<int64_t>("sorted", 1) == 1;
+}
+
+Status SoftmaxTopK::Compute(OpKernelContext* context) const {
+  const auto* X = context->Input<Tensor>(0);
+  const auto* K = context->Input<Tensor>(1);
+  const TensorShape& input_shape = X->Shape();
+
+  const auto k_dims = K->Shape().GetDims();
+  ORT_RETURN_IF_NOT(k_dims.size() == 1 && k_dims[0] == 1, "k tensor should be a 1D tensor of size 1");
+  const int64_t k = K->Data<int64_t>()[0];
+
+  const int64_t axis = HandleNegativeAxis(axis_, static_cast<int64_t>(input_shape.NumDimensions()));
+  const int64_t dim = input_shape[onnxruntime::narrow<size_t>(axis)];
+  ORT_RETURN_IF(k < 0 || k > dim, "k argument [", k, "] should be in the range [0, ", dim, "]");
+
+  TensorShape output_shape = input_shape;
+  output_shape[onnxruntime::narrow<size_t>(axis)] = k;
+  auto* values = context->Output(0, output_shape);
+  auto* indices = context->Output(1, output_shape);
+  if (output_shape.Size() == 0) {
+    return Status::OK();
+  }
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+  auto* thread_pool = context->GetOperatorThreadPool();
+
+  // the elements with the largest or smallest probabilities are those with the largest or smallest logits.
+  Tensor logit_values;
+  Tensor logit_indices;
+  ORT_RETURN_IF_ERROR(GetTopK<float>(X, onnxruntime::narrow<int>(axis), onnxruntime::narrow<unsigned>(k), largest_,
+                                     sorted_, allocator, thread_pool, logit_values, logit_indices));
+  std::copy_n(logit_indices.Data<int64_t>(), output_shape.Size(), indices->MutableData<int64_t>());
+
+  // The maximum and the sum of the exponentials of every lane of an [outer, dim, inner] view of the input. When there
+  // are fewer slices than threads, the axis is split into partitions whose partial results are merged below.
+  const int64_t outer = input_shape.SizeToDimension(onnxruntime::narrow<size_t>(axis));
+  const int64_t inner = input_shape.SizeFromDimension(onnxruntime::narrow<size_t>(axis) + 1);
+  const int64_t slice_size = dim * inner;
+  const int64_t dop = concurrency::ThreadPool::DegreeOfParallelism(thread_pool);
+  const int64_t partitions = std::max<int64_t>(
+      1, std::min({(dop + outer - 1) / outer, dim, slice_size / kMinPartitionSize}));
+
+  const float* input_data = X->Data<float>();
+  std::vector<float> partial_max(onnxruntime::narrow<size_t>(outer * partitions * inner));
+  std::vector<float> partial_sums(partial_max.size());
+  const double partition_elements = static_cast<double>(slice_size / partitions);
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, onnxruntime::narrow<std::ptrdiff_t>(outer * partitions),
+      {partition_elements * sizeof(float), 0.0, partition_elements * 2},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t task = first; task < last; ++task) {
+          const int64_t slice = task / partitions;
+          const int64_t partition = task % partitions;
+          ComputeMaxAndSumExp(input_data + slice * slice_size, inner, partition * dim / partitions,
+                              (partition + 1) * dim / partitions, partial_max.data() + task * inner,
+                              partial_sums.data() + task * inner);
+        }
+      });
+
+  const float* logit_values_data = logit_values.Data<float>();
+  float* values_data = values->MutableData<float>();
+  const double output_elements = static_cast<double>(k * inner);
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, onnxruntime::narrow<std::ptrdiff_t>(outer),
+      {output_elements * sizeof(float), output_elements * sizeof(float), output_elements * 2},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> max_values(onnxruntime::narrow<size_t>(inner));
+        std::vector<float> inverse_sums(onnxruntime::narrow<size_t>(inner));
+        for (std::ptrdiff_t slice = first; slice < last; ++slice) {
+          const float* slice_max = partial_max.data() + slice * partitions * inner;
+          const float* slice_sums = partial_sums.data() + slice * partitions * inner;
+          for (int64_t i = 0; i < inner; ++i) {
+            float max_value = slice_max[i];
+            for (int64_t p = 1; p < partitions; ++p) {
+              max_value = std::max(max_value, slice_max[p * inner + i]);
+            }
+
+            // a partition whose elements are all -inf, e.g. masked logits, doesn't contribute to the sum.
+            float sum = 0.0f;
+            for (int64_t p = 0; p < partitions; ++p) {
+              const float partition_max = slice_max[p * inner + i];
+              if (partition_max != -std::numeric_limits<float>::infinity()) {
+                sum += slice_sums[p * inner + i] * std::exp(partition_max - max_value);
+              }
+            }
+
+            max_values[i] = max_value;
+            inverse_sums[i] = 1.0f / sum;
+          }
+
+          const float* in = logit_values_data + slice * k * inner;
+          float* out = values_data + slice * k * inner;
+          for (int64_t j = 0; j < k; ++j) {
+            for (int64_t i = 0; i < inner; ++i) {
+              out[j * inner + i] = std::exp(in[j * inner + i] - max_values[i]) * inverse_sums[i];
+            }
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// TopK of the Softmax of the input, produced by SoftmaxTopKFusion. The top k elements are selected from the logits,
+// which gives the same elements as selecting from the probabilities, and only those are normalized, so the output of
+// Softmax is never written.
+class SoftmaxTopK final : public OpKernel {
+ public:
+  explicit SoftmaxTopK(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int64_t axis_;
+  bool largest_;
+  bool sorted_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -302,7 +302,9 @@ Status BeamSearchGpt<T>::Execute(const FeedsFetchesManager* init_run_feeds_fetch
                                       ExecutionMode::ORT_SEQUENTIAL,
                                       this->context_.GetTerminateFlag(),
                                       this->context_.Logger(),
-                                      this->ort_stream_);
+                                      this->ort_stream_,
+                                      /*sync_subgraph_fetches*/ false,
+                                      &this->subgraph_thread_pools_);
     } else {
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
       const_cast<SessionState&>(this->decoder_session_state_).IncrementGraphExecutionCounter();
@@ -315,7 +317,9 @@ Status BeamSearchGpt<T>::Execute(const FeedsFetchesManager* init_run_feeds_fetch
                                       ExecutionMode::ORT_SEQUENTIAL,
                                       this->context_.GetTerminateFlag(),
                                       this->context_.Logger(),
-                                      this->ort_stream_);
+                                      this->ort_stream_,
+                                      /*sync_subgraph_fetches*/ false,
+                                      &this->subgraph_thread_pools_);
     }
 
     ORT_RETURN_IF_ERROR(status);
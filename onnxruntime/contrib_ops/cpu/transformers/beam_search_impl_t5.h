@@ -180,7 +180,9 @@ Status BeamSearchT5<T>::Execute(const FeedsFetchesManager& encoder_feeds_fetches
                                              ExecutionMode::ORT_SEQUENTIAL,
                                              this->context_.GetTerminateFlag(),
                                              this->context_.Logger(),
-                                             this->ort_stream_));
+                                             this->ort_stream_,
+                                             /*sync_subgraph_fetches*/ false,
+                                             &this->subgraph_thread_pools_));
 
 #ifdef DEBUG_GENERATION
   const IConsoleDumper* dumper = this->GetConsoleDumper();
@@ -357,7 +359,9 @@ Status BeamSearchT5<T>::Execute(const FeedsFetchesManager& encoder_feeds_fetches
                                     ExecutionMode::ORT_SEQUENTIAL,
                                     this->context_.GetTerminateFlag(),
                                     this->context_.Logger(),
-                                    this->ort_stream_);
+                                    this->ort_stream_,
+                                    /*sync_subgraph_fetches*/ false,
+                                    &this->subgraph_thread_pools_);
 
     ORT_RETURN_IF_ERROR(status);
 
@@ -186,7 +186,9 @@ Status BeamSearchWhisper<T>::Execute(const FeedsFetchesManager& encoder_feeds_fe
                                              ExecutionMode::ORT_SEQUENTIAL,
                                              this->context_.GetTerminateFlag(),
                                              this->context_.Logger(),
-                                             this->ort_stream_));
+                                             this->ort_stream_,
+                                             /*sync_subgraph_fetches*/ false,
+                                             &this->subgraph_thread_pools_));
 
 #ifdef DEBUG_GENERATION
   const IConsoleDumper* dumper = this->GetConsoleDumper();
@@ -378,7 +380,9 @@ Status BeamSearchWhisper<T>::Execute(const FeedsFetchesManager& encoder_feeds_fe
                                     ExecutionMode::ORT_SEQUENTIAL,
                                     this->context_.GetTerminateFlag(),
                                     this->context_.Logger(),
-                                    this->ort_stream_);
+                                    this->ort_stream_,
+                                    /*sync_subgraph_fetches*/ false,
+                                    &this->subgraph_thread_pools_);
 
     ORT_RETURN_IF_ERROR(status);
 
@@ -100,6 +100,7 @@ class GenerateBase {
         thread_pool_(thread_pool),
         implicit_inputs_(context_.GetImplicitInputs()),
         ort_stream_(ort_stream),
+        subgraph_thread_pools_{context.GetOperatorThreadPool(), nullptr},
         cuda_dumper_(cuda_dumper),
         cpu_allocator_(decoder_session_state.GetAllocator(
             decoder_session_state.GetExecutionProviders()
@@ -264,6 +265,10 @@ class GenerateBase {
 
   Stream* ort_stream_;
 
+  // Thread pools for the subgraphs, which are executed on the current thread so only the intra-op pool is used.
+  // Taken from the kernel context so that a session created by InferenceSession::Clone uses its own pools.
+  const ExecutionThreadPools subgraph_thread_pools_;
+
   IConsoleDumper* cuda_dumper_;
   CpuTensorConsoleDumper cpu_dumper_;
 
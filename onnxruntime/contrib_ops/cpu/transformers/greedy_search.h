@@ -21,6 +21,8 @@ namespace transformers {
 
 using namespace onnxruntime::controlflow;  // namespace of IControlFlowKernel
 
+class PrefixKVCache;
+
 class GreedySearch : public IControlFlowKernel {
  public:
   explicit GreedySearch(const OpKernelInfo& info)
@@ -129,6 +131,10 @@ class GreedySearch : public IControlFlowKernel {
   GreedySearchParameters parameters_;
 
   bool has_init_decoder_ = false;
+
+  // Cache of past state for prompt prefixes, shared by all Run calls of the session. Null when disabled.
+  // A shared_ptr keeps the type incomplete here for the shared provider builds that include this header.
+  std::shared_ptr<PrefixKVCache> prefix_cache_;
 };
 
 }  // namespace transformers
@@ -237,7 +237,7 @@ Status GreedySearchBase<T, ParametersT>::Initialize() {
   if (!this->IsCuda()) {
     // Logits processor is used in CPU only. In CUDA, cuda kernels are used instead.
     // Initialize processors after CheckInputs so that parameters_->vocab_mask is ready.
-    this->logits_processors_.Init(*parameters_);
+    this->logits_processors_.Init(*parameters_, this->thread_pool_);
   }
 
   return Status::OK();
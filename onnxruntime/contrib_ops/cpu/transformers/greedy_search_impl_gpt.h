@@ -5,8 +5,10 @@
 #include <algorithm>
 #include <vector>
 
+#include "core/common/profiler.h"
 #include "core/common/span_utils.h"
 #include "contrib_ops/cpu/transformers/greedy_search_impl_base.h"
+#include "contrib_ops/cpu/transformers/prefix_kv_cache.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -84,6 +86,8 @@ class GreedySearchGpt : public GreedySearchBase<T, ParametersT> {
   Status Execute(const FeedsFetchesManager* init_run_feeds_fetches_manager,
                  const FeedsFetchesManager& feeds_fetches_manager);
 
+  void SetPrefixCache(PrefixKVCache* prefix_cache) { prefix_cache_ = prefix_cache; }
+
  private:
   // Prepare the inputs for first inference of subgraph
   Status CreateInitialFeeds(gsl::span<int32_t>& sequence_lengths,
@@ -91,6 +95,12 @@ class GreedySearchGpt : public GreedySearchBase<T, ParametersT> {
                             std::vector<OrtValue>& feeds,
                             IAllocatorUniquePtr<char>& buffer);
 
+  // Whether the prompt prefix cache can be used for the initial feeds of this run.
+  bool CanUsePrefixCache(const std::vector<OrtValue>& feeds) const;
+
+  // Replace the initial feeds with the prompt suffix and the cached past state of the longest cached prompt prefix.
+  Status ApplyPrefixCache(std::vector<OrtValue>& feeds, std::vector<int32_t>& prompt_tokens);
+
   // Update the input for next iteration.
   Status UpdateFeeds(
       const std::vector<OrtValue>& last_outputs,
@@ -114,6 +124,8 @@ class GreedySearchGpt : public GreedySearchBase<T, ParametersT> {
 #endif
   GenerationDeviceHelper::UpdateGptFeedsFunc<T> update_feeds_func_;
 
+  PrefixKVCache* prefix_cache_ = nullptr;
+
   const void* cuda_device_prop_ = nullptr;
   int cuda_device_arch_ = 0;
 };
@@ -158,6 +170,78 @@ Status GreedySearchGpt<T, ParametersT>::CreateInitialFeeds(gsl::span<int32_t>& s
                                           this->parameters_->max_length);
 }
 
+template <typename T, typename ParametersT>
+bool GreedySearchGpt<T, ParametersT>::CanUsePrefixCache(const std::vector<OrtValue>& feeds) const {
+  if (prefix_cache_ == nullptr || this->IsCuda() || init_run_gpt_subgraph_ != nullptr ||
+      gpt_subgraph_.past_present_share_buffer_ || this->parameters_->BatchBeamSize() != 1) {
+    return false;
+  }
+
+  // Cached state is only valid for prompts without padding.
+  gsl::span<const int32_t> attention_mask = feeds[2].Get<Tensor>().DataAsSpan<int32_t>();
+  return std::all_of(attention_mask.begin(), attention_mask.end(), [](int32_t mask) { return mask == 1; });
+}
+
+template <typename T, typename ParametersT>
+Status GreedySearchGpt<T, ParametersT>::ApplyPrefixCache(std::vector<OrtValue>& feeds,
+                                                         std::vector<int32_t>& prompt_tokens) {
+  gsl::span<const int32_t> input_ids = feeds[0].Get<Tensor>().DataAsSpan<int32_t>();
+  prompt_tokens.assign(input_ids.begin(), input_ids.end());
+
+  profiling::Profiler& profiler = this->decoder_session_state_.Profiler();
+  TimePoint lookup_start;
+  if (profiler.IsEnabled()) {
+    lookup_start = profiler.Start();
+  }
+
+  auto entry = prefix_cache_->Lookup(input_ids);
+  const size_t prefix_length = entry == nullptr ? 0 : entry->tokens.size();
+  if (entry != nullptr) {
+    ORT_RETURN_IF_NOT(entry->present.size() == static_cast<size_t>(gpt_subgraph_.num_layers),
+                      "Prefix cache entry has ", entry->present.size(), " layers, expected ",
+                      gpt_subgraph_.num_layers);
+
+    // input_ids and position_ids only keep the tokens after the cached prefix. The attention mask still covers
+    // the whole prompt since it spans past and current tokens.
+    const int64_t suffix_length = static_cast<int64_t>(prompt_tokens.size() - prefix_length);
+    for (size_t i = 0; i < 2; ++i) {
+      OrtValue suffix;
+      Tensor::InitOrtValue(DataTypeImpl::GetType<int32_t>(), TensorShape{1, suffix_length},
+                           this->cpu_allocator_, suffix);
+      gsl::copy(feeds[i].Get<Tensor>().DataAsSpan<int32_t>().subspan(prefix_length),
+                suffix.GetMutable<Tensor>()->MutableDataAsSpan<int32_t>());
+      feeds[i] = suffix;
+    }
+
+    // The feeds share the cached buffers, which keeps them alive even if the entry is evicted during this run.
+    for (int layer = 0; layer < gpt_subgraph_.num_layers; ++layer) {
+      feeds[static_cast<size_t>(gpt_subgraph_.GetFirstPastInputIndex() + layer)] = entry->present[static_cast<size_t>(layer)];
+    }
+  }
+
+  const auto stats = prefix_cache_->GetStats();
+  LOGS(this->context_.Logger(), VERBOSE) << "Prefix cache " << (entry != nullptr ? "hit" : "miss") << ": reused "
+                                         << prefix_length << " of " << prompt_tokens.size()
+                                         << " prompt tokens. Hit rate " << stats.HitRate() << " (" << stats.hits
+                                         << "/" << stats.lookups << ").";
+
+  // the counters are cumulative over the runs of the session, so the last event has the current totals
+  if (profiler.IsEnabled()) {
+    profiler.EndTimeAndRecordEvent(profiling::NODE_EVENT, "prefix_kv_cache_lookup", lookup_start,
+                                   {{"hit", entry != nullptr ? "1" : "0"},
+                                    {"reused_tokens", std::to_string(prefix_length)},
+                                    {"prompt_tokens", std::to_string(prompt_tokens.size())},
+                                    {"lookups", std::to_string(stats.lookups)},
+                                    {"hits", std::to_string(stats.hits)},
+                                    {"total_reused_tokens", std::to_string(stats.reused_tokens)},
+                                    {"evictions", std::to_string(stats.evictions)},
+                                    {"entries", std::to_string(stats.entries)},
+                                    {"bytes", std::to_string(stats.bytes)}});
+  }
+
+  return Status::OK();
+}
+
 template <typename T, typename ParametersT>
 Status GreedySearchGpt<T, ParametersT>::UpdateFeeds(
     const std::vector<OrtValue>& last_outputs,
@@ -230,6 +314,12 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
   OrtValue expanded_input_ids_in_cpu;
   ORT_RETURN_IF_ERROR(CreateInitialFeeds(greedy_state.sequence_lengths, expanded_input_ids_in_cpu, feeds, buffer));
 
+  std::vector<int32_t> prompt_tokens;
+  const bool use_prefix_cache = CanUsePrefixCache(feeds);
+  if (use_prefix_cache) {
+    ORT_RETURN_IF_ERROR(ApplyPrefixCache(feeds, prompt_tokens));
+  }
+
   if (gpt_subgraph_.past_present_share_buffer_) {  // Reuse past and present
     fetches.reserve(static_cast<size_t>(gpt_subgraph_.GetFirstPresentOutputIndex()) + gpt_subgraph_.num_layers);
     fetches.resize(gpt_subgraph_.GetFirstPresentOutputIndex(), OrtValue());
@@ -294,7 +384,9 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
                                       ExecutionMode::ORT_SEQUENTIAL,
                                       this->context_.GetTerminateFlag(),
                                       this->context_.Logger(),
-                                      this->ort_stream_);
+                                      this->ort_stream_,
+                                      /*sync_subgraph_fetches*/ false,
+                                      &this->subgraph_thread_pools_);
     } else {
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
       const_cast<SessionState&>(this->decoder_session_state_).IncrementGraphExecutionCounter();
@@ -307,11 +399,20 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
                                       ExecutionMode::ORT_SEQUENTIAL,
                                       this->context_.GetTerminateFlag(),
                                       this->context_.Logger(),
-                                      this->ort_stream_);
+                                      this->ort_stream_,
+                                      /*sync_subgraph_fetches*/ false,
+                                      &this->subgraph_thread_pools_);
     }
 
     ORT_RETURN_IF_ERROR(status);
 
+    if (iteration_counter == 1 && use_prefix_cache) {
+      const auto first_present = fetches.begin() + gpt_subgraph_.GetFirstPresentOutputIndex();
+      ORT_RETURN_IF_ERROR(prefix_cache_->Insert(prompt_tokens,
+                                                std::vector<OrtValue>(first_present,
+                                                                      first_present + gpt_subgraph_.num_layers)));
+    }
+
     const OrtValue& logits = fetches[0];
     gsl::span<int32_t> next_tokens;
 
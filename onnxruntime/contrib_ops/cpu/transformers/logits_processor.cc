@@ -17,202 +17,184 @@ namespace onnxruntime {
 namespace contrib {
 namespace transformers {
 
-// Interface for all scorers for beam search or beam sample.
 template <typename T>
-MinLengthLogitsProcessor<T>::MinLengthLogitsProcessor(int min_length, int eos_token_id)
-    : min_length_(min_length), eos_token_id_(eos_token_id) {}
-
-template <typename T>
-void MinLengthLogitsProcessor<T>::Process(const ISequences* sequences,
-                                          NextTokenScores<T>& next_token_scores) {
-  if (sequences->GetSequenceLength() < min_length_) {
-    next_token_scores.SetScore(eos_token_id_, std::numeric_limits<T>::lowest());
+FusedLogitsProcessor<T>::FusedLogitsProcessor(const IGenerationParameters& parameters)
+    : repetition_penalty_(parameters.repetition_penalty),
+      no_repeat_ngram_size_(parameters.no_repeat_ngram_size),
+      min_length_(parameters.min_length),
+      eos_token_id_(parameters.eos_token_id),
+      batch_size_(parameters.batch_size),
+      vocab_mask_(parameters.vocab_mask),
+      prefix_vocab_mask_(parameters.prefix_vocab_mask),
+      temperature_(parameters.temperature > 0 ? parameters.temperature : 1.0f),
+      presence_mask_(parameters.presence_mask),
+      presence_penalty_(parameters.presence_penalty) {
+  if (presence_penalty_ == 0.0f) {
+    presence_mask_ = {};
   }
 }
 
 template <typename T>
-RepetitionPenaltyLogitsProcessor<T>::RepetitionPenaltyLogitsProcessor(float penalty) : penalty_(penalty) {
+bool FusedLogitsProcessor<T>::IsEmpty() const {
+  return repetition_penalty_ == 1.0f &&  // 1.0 means no penalty
+         no_repeat_ngram_size_ <= 0 &&
+         min_length_ <= 0 &&
+         vocab_mask_.empty() &&
+         prefix_vocab_mask_.empty() &&
+         temperature_ == 1.0f &&
+         presence_mask_.empty();
 }
 
 template <typename T>
-void RepetitionPenaltyLogitsProcessor<T>::Process(const ISequences* sequences,
-                                                  NextTokenScores<T>& next_token_scores) {
+void FusedLogitsProcessor<T>::Process(const ISequences* sequences,
+                                      NextTokenScores<T>& next_token_scores,
+                                      bool apply_prefix_vocab_mask,
+                                      concurrency::ThreadPool* thread_pool) const {
   const int batch_beam_size = next_token_scores.batch_beam_size;
-  for (int i = 0; i < batch_beam_size; i++) {
-    gsl::span<T> beam_token_scores = next_token_scores.GetScores(i);
-    gsl::span<const int32_t> sequence = sequences->GetSequence(i);
-
-    // Find unique word IDs in sequence.
-    std::unordered_set<int32_t> unique_word_ids;
-    for (const auto& word_id : sequence) {
-      unique_word_ids.insert(word_id);
-    }
-
-    for (const int32_t word_id : unique_word_ids) {
-      T score = beam_token_scores[word_id];
-
-      // If score < 0, then repetition penalty > 1.0 has to multiplied to reduce the previous token probability,
-      // This assumes that scores are either positive (like ctrl) or negative (like GPT-2), but not a mixture.
-      beam_token_scores[word_id] = (score < 0 ? score * penalty_ : score / penalty_);
-    }
-  }
-}
-
-template <typename T>
-NoRepeatNGramLogitsProcessor<T>::NoRepeatNGramLogitsProcessor(int ngram_size) : ngram_size_(ngram_size) {
+  const int vocab_size = next_token_scores.vocab_size;
+  const int num_beams = batch_beam_size / batch_size_;
+  assert(num_beams * batch_size_ == batch_beam_size);
+  assert(presence_mask_.empty() ||
+         presence_mask_.size() == SafeInt<size_t>(batch_beam_size) * vocab_size);
+
+  const bool demote_eos = min_length_ > 0 && sequences->GetSequenceLength() < min_length_;
+
+  // Each row streams the scores and masks once, and scans the sequence once per sparse processor.
+  const double bytes_per_row = static_cast<double>(vocab_size) * (2 * sizeof(T) + sizeof(int32_t));
+  const double compute_per_row = static_cast<double>(vocab_size) +
+                                 static_cast<double>(sequences->GetSequenceLength()) *
+                                     (1 + std::max(no_repeat_ngram_size_, 0));
+
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(batch_beam_size),
+      TensorOpCost{bytes_per_row, static_cast<double>(vocab_size) * sizeof(T), compute_per_row},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; i++) {
+          const int batch_beam_index = static_cast<int>(i);
+          ProcessRow(next_token_scores.GetScores(batch_beam_index),
+                     sequences->GetSequence(batch_beam_index),
+                     batch_beam_index,
+                     num_beams,
+                     demote_eos,
+                     apply_prefix_vocab_mask);
+        }
+      });
 }
 
 template <typename T>
-void NoRepeatNGramLogitsProcessor<T>::Process(const ISequences* sequences,
-                                              NextTokenScores<T>& next_token_scores) {
-  if (ngram_size_ == 0 || ngram_size_ > sequences->GetSequenceLength()) {
-    return;
-  }
-
-  const gsl::index prefix_length = static_cast<gsl::index>(ngram_size_) - 1;
-  int batch_beam_size = next_token_scores.batch_beam_size;
-
-  for (int i = 0; i < batch_beam_size; i++) {
-    gsl::span<T> beam_token_scores = next_token_scores.GetScores(i);
-    gsl::span<const int32_t> sequence = sequences->GetSequence(i);
-
-    gsl::span<const int32_t> prefix = sequence.subspan(sequence.size() - prefix_length);
-    ORT_ENFORCE(prefix.size() == narrow<size_t>(prefix_length));
-
-    std::unordered_set<int32_t> blocked_word_ids;
-    for (int j = 0; j <= static_cast<int>(sequence.size()) - ngram_size_; j++) {
-      // Here we use naive algorithm for matching. The complexity is O(batch_beam_size * ngram_size * sequence_length)
-      // TODO(tianleiwu): build N-Gram index (hash table with prefix of length NGram - 1 as key,
-      //                  and list of last word of NGram as value) for fast matching.
-      if (ngram_size_ == 1 || SpanEq(prefix, sequence.subspan(j, prefix_length))) {
-        blocked_word_ids.insert(sequence[static_cast<gsl::index>(j) + prefix_length]);
-      }
+void FusedLogitsProcessor<T>::ProcessRow(gsl::span<T> beam_token_scores,
+                                         gsl::span<const int32_t> sequence,
+                                         int batch_beam_index,
+                                         int num_beams,
+                                         bool demote_eos,
+                                         bool apply_prefix_vocab_mask) const {
+  const int vocab_size = static_cast<int>(beam_token_scores.size());
+  T* scores = beam_token_scores.data();
+  constexpr T lowest = std::numeric_limits<T>::lowest();
+
+  // Repetition penalty. Gather the scores of all tokens in the sequence before writing any of them back,
+  // so a token that appears several times is penalized exactly once without building a set of unique ids.
+  if (repetition_penalty_ != 1.0f && !sequence.empty()) {
+    InlinedVector<T> gathered(sequence.size());
+    for (size_t k = 0; k < sequence.size(); k++) {
+      gathered[k] = scores[sequence[k]];
     }
 
-    for (const int32_t word_id : blocked_word_ids) {
-      beam_token_scores[word_id] = std::numeric_limits<T>::lowest();
+    for (size_t k = 0; k < sequence.size(); k++) {
+      // If score < 0, then repetition penalty > 1.0 has to multiplied to reduce the previous token probability,
+      // This assumes that scores are either positive (like ctrl) or negative (like GPT-2), but not a mixture.
+      const T score = gathered[k];
+      scores[sequence[k]] = (score < 0 ? score * repetition_penalty_ : score / repetition_penalty_);
     }
   }
-}
 
-template <typename T>
-VocabMaskLogitsProcessor<T>::VocabMaskLogitsProcessor(const gsl::span<const int32_t>& vocab_mask)
-    : vocab_mask_(vocab_mask) {
-}
-
-template <typename T>
-void VocabMaskLogitsProcessor<T>::Process(const ISequences* /*sequences*/,
-                                          NextTokenScores<T>& next_token_scores) {
-  assert(!vocab_mask_.empty());
-
-  // Process vocabulary mask and set tokens with mask value 0 to -inf.
-  T* p = next_token_scores.scores.data();
-  // next_token_scores shape (batch_size * num_beams, vocab_size)
-  // vocab_mask shape (vocab_size).
-  for (int i = 0; i < next_token_scores.batch_beam_size; i++) {
-    for (int j = 0; j < next_token_scores.vocab_size; j++, p++) {
-      if (vocab_mask_[j] == 0) {
-        *p = std::numeric_limits<T>::lowest();
-      }
-    }
-  }
-}
-
-template <typename T>
-PrefixVocabMaskLogitsProcessor<T>::PrefixVocabMaskLogitsProcessor(const gsl::span<const int32_t>& prefix_vocab_mask,
-                                                                  int batch_size)
-    : prefix_vocab_mask_(prefix_vocab_mask),
-      batch_size_(batch_size) {
-}
-
-template <typename T>
-void PrefixVocabMaskLogitsProcessor<T>::Process(const ISequences* /*sequences*/,
-                                                NextTokenScores<T>& next_token_scores) {
-  assert(!prefix_vocab_mask_.empty());
-
-  // next_token_scores shape (batch_size * num_beams, vocab_size)
-  int num_beams = next_token_scores.batch_beam_size / batch_size_;
-  assert(num_beams * batch_size_ == next_token_scores.batch_beam_size);
-
-  // Process prefix vocabulary mask and set tokens with mask value 0 to -inf.
-  // prefix_vocab_mask shape (batch_size, vocab_size).
-  T* p = next_token_scores.scores.data();
-  for (int i = 0; i < batch_size_; i++) {
-    size_t prefix_vocab_mask_offset = SafeInt<size_t>(i) * next_token_scores.vocab_size;
-    for (int j = 0; j < num_beams; j++) {
-      for (int k = 0; k < next_token_scores.vocab_size; k++, p++) {
-        if (prefix_vocab_mask_[prefix_vocab_mask_offset + static_cast<size_t>(k)] == 0) {
-          *p = std::numeric_limits<T>::lowest();
-        }
+  // No repeat ngram. Block the last word of every earlier ngram whose first (ngram_size - 1) words match the
+  // end of the sequence. Blocking is idempotent so matches are written directly.
+  const int sequence_length = static_cast<int>(sequence.size());
+  if (no_repeat_ngram_size_ > 0 && no_repeat_ngram_size_ <= sequence_length) {
+    const gsl::index prefix_length = static_cast<gsl::index>(no_repeat_ngram_size_) - 1;
+    gsl::span<const int32_t> prefix = sequence.subspan(sequence.size() - prefix_length);
+    for (int j = 0; j <= sequence_length - no_repeat_ngram_size_; j++) {
+      if (prefix_length == 0 || SpanEq(prefix, sequence.subspan(j, prefix_length))) {
+        scores[sequence[static_cast<gsl::index>(j) + prefix_length]] = lowest;
       }
     }
   }
-}
 
-template <typename T>
-TemperatureLogitsProcessor<T>::TemperatureLogitsProcessor(float temperature) : temperature_(temperature) {
-}
-
-template <typename T>
-void TemperatureLogitsProcessor<T>::Process(const ISequences* /*sequences*/,
-                                            NextTokenScores<T>& next_token_scores) {
-  if (temperature_ == 1.0f) {
-    return;
+  if (demote_eos) {
+    scores[eos_token_id_] = lowest;
   }
 
-  T* p = next_token_scores.scores.data();
-  for (size_t i = 0; i < next_token_scores.scores.size(); i++) {
-    *p /= temperature_;
-    ++p;
+  // Dense processors in a single pass over the vocabulary.
+  const int32_t* vocab_mask = vocab_mask_.empty() ? nullptr : vocab_mask_.data();
+  const int32_t* prefix_vocab_mask = nullptr;
+  if (apply_prefix_vocab_mask && !prefix_vocab_mask_.empty()) {
+    // prefix_vocab_mask shape (batch_size, vocab_size).
+    prefix_vocab_mask = prefix_vocab_mask_.data() + SafeInt<size_t>(batch_beam_index / num_beams) * vocab_size;
   }
-}
+  const int32_t* presence_mask = presence_mask_.empty()
+                                     ? nullptr
+                                     : presence_mask_.data() + SafeInt<size_t>(batch_beam_index) * vocab_size;
+  const float temperature = temperature_;
+  const float presence_penalty = presence_penalty_;
 
-template <typename T>
-PresencePenaltyLogitsProcessor<T>::PresencePenaltyLogitsProcessor(const gsl::span<const int32_t>& presence_mask,
-                                                                  float presence_penalty)
-    : presence_mask_(presence_mask), presence_penalty_(presence_penalty) {
-}
-
-template <typename T>
-void PresencePenaltyLogitsProcessor<T>::Process(const ISequences*,
-                                                NextTokenScores<T>& next_token_scores) {
-  if (presence_penalty_ == 0.0f) {
+  if (vocab_mask == nullptr && prefix_vocab_mask == nullptr && presence_mask == nullptr && temperature == 1.0f) {
     return;
   }
 
-  assert(!presence_mask_.empty());
-
-  T* p = next_token_scores.scores.data();
-  for (size_t i = 0; i < next_token_scores.scores.size(); i++) {
-    *p -= presence_mask_[i] * presence_penalty_;
+  if (vocab_mask != nullptr || prefix_vocab_mask != nullptr) {
+    // Tokens with mask value 0 are set to lowest before temperature is applied.
+    for (int j = 0; j < vocab_size; j++) {
+      const bool masked = (vocab_mask != nullptr && vocab_mask[j] == 0) ||
+                          (prefix_vocab_mask != nullptr && prefix_vocab_mask[j] == 0);
+      T score = masked ? lowest : scores[j];
+      if (temperature != 1.0f) {
+        score /= temperature;
+      }
+      if (presence_mask != nullptr) {
+        score -= presence_mask[j] * presence_penalty;
+      }
+      scores[j] = score;
+    }
+  } else if (presence_mask != nullptr) {
+    for (int j = 0; j < vocab_size; j++) {
+      scores[j] = scores[j] / temperature - presence_mask[j] * presence_penalty;
+    }
+  } else {
+    for (int j = 0; j < vocab_size; j++) {
+      scores[j] /= temperature;
+    }
   }
 }
 
-void LogitsProcessorList::Init(const BeamSearchParameters& parameters) {
-  LogitsProcessorInitImpl<BeamSearchParameters>(parameters);
+void LogitsProcessorList::Init(const BeamSearchParameters& parameters, concurrency::ThreadPool* thread_pool) {
+  LogitsProcessorInitImpl<BeamSearchParameters>(parameters, thread_pool);
 }
 
-void LogitsProcessorList::Init(const GreedySearchParameters& parameters) {
-  LogitsProcessorInitImpl<GreedySearchParameters>(parameters);
+void LogitsProcessorList::Init(const GreedySearchParameters& parameters, concurrency::ThreadPool* thread_pool) {
+  LogitsProcessorInitImpl<GreedySearchParameters>(parameters, thread_pool);
 }
 
-void LogitsProcessorList::Init(const SamplingParameters& parameters) {
-  LogitsProcessorInitImpl<SamplingParameters>(parameters);
+void LogitsProcessorList::Init(const SamplingParameters& parameters, concurrency::ThreadPool* thread_pool) {
+  LogitsProcessorInitImpl<SamplingParameters>(parameters, thread_pool);
 }
 
 void LogitsProcessorList::Process(const ISequences* sequences,
                                   gsl::span<float>& next_token_scores,
                                   int step) {
   NextTokenScores<float> input_scores = {next_token_scores, batch_beam_size_, vocab_size_};
-  for (size_t i = 0; i < processor_list_.size(); i++) {
+  if (fused_processor_ != nullptr) {
     // Prefix vocab mask is applied to first iteration only.
-    if (step > 1 && processor_list_[i] == prefix_vocab_mask_processor_.get()) {
-      continue;
-    }
+    fused_processor_->Process(sequences, input_scores, step <= 1, thread_pool_);
+  }
+
+  for (size_t i = 0; i < processor_list_.size(); i++) {
     processor_list_[i]->Process(sequences, input_scores);
   }
 }
 
+template class FusedLogitsProcessor<float>;
+
 }  // namespace transformers
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/common/inlined_containers.h"
+#include "core/platform/threadpool.h"
 #include "contrib_ops/cpu/transformers/sequences.h"
 #include "contrib_ops/cpu/transformers/beam_search_parameters.h"
 #include "contrib_ops/cpu/utils/dump_tensor.h"
@@ -53,105 +54,42 @@ class ILogitsProcessor {
                        NextTokenScores<T>& next_token_scores) = 0;
 };
 
+// Applies the built-in logits processors of CPU generation in one pass per batch_beam row:
+//   - Sparse processors (repetition penalty, no repeat ngram and min length) scatter into the token ids of
+//     the sequence, so their cost depends on the sequence length instead of the vocabulary size.
+//   - Dense processors (vocab mask, prefix vocab mask, temperature and presence penalty) are fused into a
+//     single loop over the vocabulary that the compiler can vectorize.
+// Rows are independent and are distributed over the intra-op thread pool.
+// The result is the same as applying the processors one after another in the order listed above.
 template <typename T>
-class MinLengthLogitsProcessor : public ILogitsProcessor<T> {
+class FusedLogitsProcessor {
  public:
-  MinLengthLogitsProcessor(int min_length, int eos_token_id);
+  explicit FusedLogitsProcessor(const IGenerationParameters& parameters);
+
+  // Returns true when none of the fused processors is enabled.
+  bool IsEmpty() const;
 
   void Process(const ISequences* sequences,
-               NextTokenScores<T>& next_token_scores) override;
+               NextTokenScores<T>& next_token_scores,
+               bool apply_prefix_vocab_mask,
+               concurrency::ThreadPool* thread_pool) const;
 
  private:
+  void ProcessRow(gsl::span<T> beam_token_scores,
+                  gsl::span<const int32_t> sequence,
+                  int batch_beam_index,
+                  int num_beams,
+                  bool demote_eos,
+                  bool apply_prefix_vocab_mask) const;
+
+  float repetition_penalty_;
+  int no_repeat_ngram_size_;
   int min_length_;
   int eos_token_id_;
-};
-
-template <typename T>
-class RepetitionPenaltyLogitsProcessor : public ILogitsProcessor<T> {
- public:
-  RepetitionPenaltyLogitsProcessor(float penalty);
-
-  void Process(const ISequences* sequences,
-               NextTokenScores<T>& next_token_scores) override;
-
- private:
-  float penalty_;
-};
-
-template <typename T>
-class NoRepeatNGramLogitsProcessor : public ILogitsProcessor<T> {
- public:
-  NoRepeatNGramLogitsProcessor(int ngram_size);
-
-  void Process(const ISequences* sequences,
-               NextTokenScores<T>& next_token_scores) override;
-
- private:
-  int ngram_size_;
-};
-
-template <typename T>
-class VocabMaskLogitsProcessor : public ILogitsProcessor<T> {
- public:
-  VocabMaskLogitsProcessor(const gsl::span<const int32_t>& vocab_mask);
-
-  void Process(const ISequences* sequences,
-               NextTokenScores<T>& next_token_scores) override;
-
- private:
+  int batch_size_;
   gsl::span<const int32_t> vocab_mask_;
-};
-
-template <typename T>
-class PrefixVocabMaskLogitsProcessor : public ILogitsProcessor<T> {
- public:
-  PrefixVocabMaskLogitsProcessor(const gsl::span<const int32_t>& vocab_mask, int batch_size);
-
-  void Process(const ISequences* sequences,
-               NextTokenScores<T>& next_token_scores) override;
-
- private:
   gsl::span<const int32_t> prefix_vocab_mask_;
-  const int batch_size_;
-};
-
-template <typename T>
-class TemperatureLogitsProcessor : public ILogitsProcessor<T> {
- public:
-  TemperatureLogitsProcessor(float temperature);
-
-  void Process(const ISequences* sequences,
-               NextTokenScores<T>& next_token_scores) override;
-
- private:
   float temperature_;
-};
-
-// template <typename T>
-// class TopPLogitsProcessor : public ILogitsProcessor<T> {
-//  public:
-//   TopPLogitsProcessor(float top_p, float filter_value,
-//                       onnxruntime::concurrency::ThreadPool* thread_pool);
-
-//   void Process(const ISequences* sequences,
-//                NextTokenScores<T>& next_token_scores) override;
-
-//  private:
-//   float top_p_;
-//   float filter_value_;
-//   onnxruntime::concurrency::ThreadPool* thread_pool_;
-// };
-
-template <typename T>
-class PresencePenaltyLogitsProcessor : public ILogitsProcessor<T> {
- public:
-  PresencePenaltyLogitsProcessor(const gsl::span<const int32_t>& presence_mask,
-                                 float presence_penalty);
-
-  void Process(const ISequences* sequences,
-               NextTokenScores<T>& next_token_scores) override;
-
- private:
   gsl::span<const int32_t> presence_mask_;
   float presence_penalty_;
 };
@@ -296,56 +234,19 @@ class TimestampLogitsProcessor : public ILogitsProcessor<T> {
 class LogitsProcessorList : public ILogitsProcessorList {
  public:
   LogitsProcessorList() = default;
-  void Init(const BeamSearchParameters& parameters);
-  void Init(const GreedySearchParameters& parameters);
-  void Init(const SamplingParameters& parameters);
+  void Init(const BeamSearchParameters& parameters, concurrency::ThreadPool* thread_pool);
+  void Init(const GreedySearchParameters& parameters, concurrency::ThreadPool* thread_pool);
+  void Init(const SamplingParameters& parameters, concurrency::ThreadPool* thread_pool);
   void Process(const ISequences* sequences, gsl::span<float>& next_token_scores, int step);
 
  private:
   template <typename GenerationParametersT>
-  void LogitsProcessorInitImpl(const GenerationParametersT& parameters) {
+  void LogitsProcessorInitImpl(const GenerationParametersT& parameters, concurrency::ThreadPool* thread_pool) {
     processor_list_.clear();
 
-    if (parameters.repetition_penalty != 1.0f) {  // 1.0 means no penalty
-      repetition_penalty_processor_ = std::make_unique<RepetitionPenaltyLogitsProcessor<float>>(
-          parameters.repetition_penalty);
-      processor_list_.push_back(repetition_penalty_processor_.get());
-    }
-
-    if (parameters.no_repeat_ngram_size > 0) {
-      no_repeat_ngram_processor_ = std::make_unique<
-          NoRepeatNGramLogitsProcessor<float>>(parameters.no_repeat_ngram_size);
-      processor_list_.push_back(no_repeat_ngram_processor_.get());
-    }
-
-    if (!parameters.vocab_mask.empty()) {
-      vocab_mask_processor_ = std::make_unique<VocabMaskLogitsProcessor<float>>(parameters.vocab_mask);
-      processor_list_.push_back(vocab_mask_processor_.get());
-    }
-
-    if (!parameters.prefix_vocab_mask.empty()) {
-      prefix_vocab_mask_processor_ = std::make_unique<
-          PrefixVocabMaskLogitsProcessor<float>>(parameters.prefix_vocab_mask,
-                                                 parameters.batch_size);
-      processor_list_.push_back(prefix_vocab_mask_processor_.get());
-    }
-
-    if (parameters.min_length > 0) {
-      min_length_processor_ = std::make_unique<MinLengthLogitsProcessor<float>>(parameters.min_length,
-                                                                                parameters.eos_token_id);
-      processor_list_.push_back(min_length_processor_.get());
-    }
-
-    if (parameters.temperature > 0) {
-      temperature_processor_ = std::make_unique<TemperatureLogitsProcessor<float>>(parameters.temperature);
-      processor_list_.push_back(temperature_processor_.get());
-    }
-
-    if (!parameters.presence_mask.empty()) {
-      presence_penalty_processor_ = std::make_unique<
-          PresencePenaltyLogitsProcessor<float>>(parameters.presence_mask,
-                                                 parameters.presence_penalty);
-      processor_list_.push_back(presence_penalty_processor_.get());
+    fused_processor_ = std::make_unique<FusedLogitsProcessor<float>>(parameters);
+    if (fused_processor_->IsEmpty()) {
+      fused_processor_.reset();
     }
 
     // Add timestamp processor for whisper model
@@ -365,19 +266,17 @@ class LogitsProcessorList : public ILogitsProcessorList {
 
     batch_beam_size_ = parameters.BatchBeamSize();
     vocab_size_ = parameters.vocab_size;
+    thread_pool_ = thread_pool;
   }
 
   int batch_beam_size_;
   int vocab_size_;
+  concurrency::ThreadPool* thread_pool_ = nullptr;
+
+  // Built-in processors run first, followed by processors in processor_list_ in order.
+  std::unique_ptr<FusedLogitsProcessor<float>> fused_processor_;
   InlinedVector<ILogitsProcessor<float>*> processor_list_;
 
-  std::unique_ptr<RepetitionPenaltyLogitsProcessor<float>> repetition_penalty_processor_;
-  std::unique_ptr<NoRepeatNGramLogitsProcessor<float>> no_repeat_ngram_processor_;
-  std::unique_ptr<VocabMaskLogitsProcessor<float>> vocab_mask_processor_;
-  std::unique_ptr<PrefixVocabMaskLogitsProcessor<float>> prefix_vocab_mask_processor_;
-  std::unique_ptr<MinLengthLogitsProcessor<float>> min_length_processor_;
-  std::unique_ptr<TemperatureLogitsProcessor<float>> temperature_processor_;
-  std::unique_ptr<PresencePenaltyLogitsProcessor<float>> presence_penalty_processor_;
   std::unique_ptr<TimestampLogitsProcessor<float>> timestamp_processor_;
 };
 
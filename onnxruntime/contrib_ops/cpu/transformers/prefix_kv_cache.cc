@@ -0,0 +1,195 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/transformers/prefix_kv_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include "core/common/parse_string.h"
+#include "core/framework/op_kernel_info.h"
+#include "core/framework/tensor.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace transformers {
+
+namespace {
+
+constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+constexpr uint64_t kFnvPrime = 1099511628211ULL;
+
+inline uint64_t HashToken(uint64_t hash, int32_t token) {
+  const auto value = static_cast<uint32_t>(token);
+  for (int shift = 0; shift < 32; shift += 8) {
+    hash ^= (value >> shift) & 0xFF;
+    hash *= kFnvPrime;
+  }
+  return hash;
+}
+
+uint64_t HashTokens(gsl::span<const int32_t> tokens) {
+  uint64_t hash = kFnvOffsetBasis;
+  for (int32_t token : tokens) {
+    hash = HashToken(hash, token);
+  }
+  return hash;
+}
+
+}  // namespace
+
+PrefixKVCache::PrefixKVCache(size_t max_bytes)
+    : max_bytes_(max_bytes), allocator_(std::make_shared<CPUAllocator>()) {
+}
+
+std::unique_ptr<PrefixKVCache> PrefixKVCache::Create(const OpKernelInfo& info) {
+  const std::string value = info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsGenerationPrefixCacheMaxBytes, "0");
+  size_t max_bytes = 0;
+  ORT_ENFORCE(TryParseStringWithClassicLocale(value, max_bytes),
+              "Invalid value for ", kOrtSessionOptionsGenerationPrefixCacheMaxBytes, ": ", value);
+  if (max_bytes == 0) {
+    return nullptr;
+  }
+  return std::make_unique<PrefixKVCache>(max_bytes);
+}
+
+std::shared_ptr<const PrefixKVCache::Entry> PrefixKVCache::Lookup(gsl::span<const int32_t> tokens) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++stats_.lookups;
+
+  if (tokens.size() < 2 || length_counts_.empty()) {
+    return nullptr;
+  }
+
+  // Hash of every prefix of the prompt, so that each cached length can be probed in O(1).
+  std::vector<uint64_t> prefix_hashes(tokens.size() + 1);
+  prefix_hashes[0] = kFnvOffsetBasis;
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    prefix_hashes[i + 1] = HashToken(prefix_hashes[i], tokens[i]);
+  }
+
+  // Probe cached prompt lengths from the longest proper prefix downwards.
+  for (auto it = length_counts_.rbegin(); it != length_counts_.rend(); ++it) {
+    const size_t length = it->first;
+    if (length >= tokens.size()) {
+      continue;
+    }
+
+    auto range = index_.equal_range(prefix_hashes[length]);
+    for (auto entry_it = range.first; entry_it != range.second; ++entry_it) {
+      const LruList::iterator lru_it = entry_it->second;
+      const auto& entry = *lru_it;
+      if (entry->tokens.size() == length &&
+          std::equal(entry->tokens.begin(), entry->tokens.end(), tokens.begin())) {
+        lru_.splice(lru_.begin(), lru_, lru_it);
+        ++stats_.hits;
+        stats_.reused_tokens += length;
+        return entry;
+      }
+    }
+  }
+
+  return nullptr;
+}
+
+Status PrefixKVCache::Insert(gsl::span<const int32_t> tokens, const std::vector<OrtValue>& present) {
+  size_t bytes = tokens.size() * sizeof(int32_t);
+  for (const auto& value : present) {
+    const Tensor& tensor = value.Get<Tensor>();
+    ORT_RETURN_IF_NOT(tensor.Location().device.Type() == OrtDevice::CPU,
+                      "Prefix cache only supports present state on CPU.");
+    bytes += tensor.SizeInBytes();
+  }
+
+  if (bytes > max_bytes_) {
+    return Status::OK();
+  }
+
+  const uint64_t hash = HashTokens(tokens);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (TouchLocked(hash, tokens)) {
+      return Status::OK();
+    }
+  }
+
+  // Copy outside of the lock; the subgraph outputs are not modified after the step that produced them.
+  auto entry = std::make_shared<Entry>();
+  entry->tokens.assign(tokens.begin(), tokens.end());
+  entry->bytes = bytes;
+  entry->present.reserve(present.size());
+  for (const auto& value : present) {
+    const Tensor& src = value.Get<Tensor>();
+    OrtValue copy;
+    Tensor::InitOrtValue(src.DataType(), src.Shape(), allocator_, copy);
+    std::memcpy(copy.GetMutable<Tensor>()->MutableDataRaw(), src.DataRaw(), src.SizeInBytes());
+    entry->present.push_back(std::move(copy));
+  }
+
+  // Another run may have inserted the same prompt while this one was copying. The check and the insert are done
+  // under the same lock so that a prompt is never cached twice.
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (TouchLocked(hash, tokens)) {
+    return Status::OK();
+  }
+
+  EvictUntilFits(bytes);
+  lru_.push_front(std::move(entry));
+  index_.emplace(hash, lru_.begin());
+  ++length_counts_[tokens.size()];
+  ++stats_.entries;
+  stats_.bytes += bytes;
+
+  return Status::OK();
+}
+
+bool PrefixKVCache::TouchLocked(uint64_t hash, gsl::span<const int32_t> tokens) {
+  auto range = index_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    const auto& entry = *it->second;
+    if (entry->tokens.size() == tokens.size() &&
+        std::equal(entry->tokens.begin(), entry->tokens.end(), tokens.begin())) {
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return true;
+    }
+  }
+  return false;
+}
+
+void PrefixKVCache::EvictUntilFits(size_t bytes) {
+  while (!lru_.empty() && stats_.bytes + bytes > max_bytes_) {
+    const auto& victim = lru_.back();
+    const uint64_t hash = HashTokens(victim->tokens);
+
+    auto range = index_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (*it->second == victim) {
+        index_.erase(it);
+        break;
+      }
+    }
+
+    auto length_it = length_counts_.find(victim->tokens.size());
+    if (--length_it->second == 0) {
+      length_counts_.erase(length_it);
+    }
+
+    --stats_.entries;
+    stats_.bytes -= victim->bytes;
+    ++stats_.evictions;
+
+    // Runs that are using the entry keep it alive through their shared_ptr.
+    lru_.pop_back();
+  }
+}
+
+PrefixKVCache::Stats PrefixKVCache::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <gsl/gsl>
+#include "core/common/common.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+
+namespace onnxruntime {
+class OpKernelInfo;
+
+namespace contrib {
+namespace transformers {
+
+// Memory bounded LRU cache of the present key/value state computed for a prompt, keyed by the prompt token ids.
+// A generation op that gets a prompt starting with a cached prompt can feed the cached state as past state and
+// only run the remaining tokens through the decoder. The cache is owned by the kernel, so it lives as long as the
+// session and is shared by concurrent Run calls.
+class PrefixKVCache {
+ public:
+  struct Entry {
+    std::vector<int32_t> tokens;
+    // One CPU tensor per layer, in the order of the present outputs of the decoder subgraph.
+    std::vector<OrtValue> present;
+    size_t bytes = 0;
+  };
+
+  struct Stats {
+    uint64_t lookups = 0;
+    uint64_t hits = 0;
+    uint64_t reused_tokens = 0;
+    uint64_t evictions = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+
+    double HitRate() const { return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups); }
+  };
+
+  explicit PrefixKVCache(size_t max_bytes);
+
+  // Creates the cache when kOrtSessionOptionsGenerationPrefixCacheMaxBytes is set to a positive value.
+  static std::unique_ptr<PrefixKVCache> Create(const OpKernelInfo& info);
+
+  // Returns the entry for the longest cached prompt that is a proper prefix of tokens, or nullptr.
+  // At least one token is always left for the decoder so that it produces the logits of the last position.
+  std::shared_ptr<const Entry> Lookup(gsl::span<const int32_t> tokens);
+
+  // Caches a copy of the present state computed for tokens. Tensors must be on CPU.
+  // Entries larger than the memory budget are not cached.
+  Status Insert(gsl::span<const int32_t> tokens, const std::vector<OrtValue>& present);
+
+  Stats GetStats() const;
+
+  size_t MaxBytes() const { return max_bytes_; }
+
+ private:
+  using LruList = std::list<std::shared_ptr<const Entry>>;
+
+  // Moves the entry cached for exactly tokens to the front of the LRU list and returns true, or returns false if
+  // there is none. mutex_ must be held.
+  bool TouchLocked(uint64_t hash, gsl::span<const int32_t> tokens);
+
+  void EvictUntilFits(size_t bytes);
+
+  const size_t max_bytes_;
+  AllocatorPtr allocator_;
+
+  mutable std::mutex mutex_;
+  LruList lru_;  // most recently used first
+  std::unordered_multimap<uint64_t, LruList::iterator> index_;
+  std::map<size_t, size_t> length_counts_;  // prompt length -> number of entries with that length
+  Stats stats_;
+};
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
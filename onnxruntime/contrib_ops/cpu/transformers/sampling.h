@@ -19,6 +19,8 @@ namespace transformers {
 
 using namespace onnxruntime::controlflow;  // namespace of IControlFlowKernel
 
+class PrefixKVCache;
+
 class Sampling : public IControlFlowKernel {
  public:
   explicit Sampling(const OpKernelInfo& info)
@@ -111,6 +113,10 @@ class Sampling : public IControlFlowKernel {
   SamplingParameters parameters_;
 
   bool has_init_decoder_ = false;
+
+  // Cache of past state for prompt prefixes, shared by all Run calls of the session. Null when disabled.
+  // A shared_ptr keeps the type incomplete here for the shared provider builds that include this header.
+  std::shared_ptr<PrefixKVCache> prefix_cache_;
 };
 
 }  // namespace transformers
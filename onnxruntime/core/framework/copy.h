@@ -8,6 +8,7 @@
 #include "core/framework/tensor.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 
+#include <algorithm>
 #include <vector>
 
 namespace onnxruntime {
@@ -45,6 +46,9 @@ void Copy1D(T* dst, int64_t dst_stride, const T* src, int64_t src_stride, std::p
   } else {
     if (dst_stride == 1 && src_stride == 1) {
       Copy1DContiguous(dst, src, count);
+    } else if (dst_stride == 1 && src_stride == 0) {
+      // broadcast of a single value, e.g. by Expand or Tile
+      std::fill_n(dst, count, *src);
     } else {
       Copy1DNonContiguous(dst, dst_stride, src, src_stride, count);
     }
@@ -104,6 +108,8 @@ struct NdCounter {
 };
 }  // namespace strided_copy_detail
 
+// Copy copy_shape elements from src to dst with the given element strides, in parallel if thread_pool is provided.
+// A src stride may be 0 to broadcast along an axis, and strides may be negative to copy an axis in reverse.
 template <typename T>
 void StridedCopy(concurrency::ThreadPool* thread_pool,
                  T* dst,
@@ -8,6 +8,7 @@
 #include <string>
 
 #include "core/common/inlined_containers.h"
+#include "core/common/profiler.h"
 #include "core/common/string_utils.h"
 #include "core/framework/compute_capability.h"
 #include "core/framework/ep_context_utils.h"
@@ -69,6 +70,7 @@ struct PartitionParams {
   std::reference_wrapper<const layout_transformation::DebugGraphFn> debug_graph_fn;
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
   std::reference_wrapper<const OnPartitionAssignmentFunction> on_partition_assignment_fn;
+  profiling::Profiler* profiler;
 };
 }  // namespace
 
@@ -150,15 +152,30 @@ struct GetCapabilityForEPParams {
   IResourceAccountant* resource_accountant;
   std::reference_wrapper<const GraphOptimizerRegistry> graph_optimizer_registry;
   std::reference_wrapper<const CheckLoadCancellationFn> check_load_cancellation_fn;
+  profiling::Profiler* profiler;
 };
 
 auto get_capabilities = [](const IExecutionProvider& ep,
                            const GraphViewer& graph_viewer,
                            const IExecutionProvider::IKernelLookup& kernel_lookup,
                            IResourceAccountant* resource_accountant,
-                           const GraphOptimizerRegistry& graph_optimizer_registry) {
+                           const GraphOptimizerRegistry& graph_optimizer_registry,
+                           profiling::Profiler* profiler) {
+  const bool profiling_enabled = profiler != nullptr && profiler->IsEnabled();
+  TimePoint start_time;
+  if (profiling_enabled) {
+    start_time = profiler->Start();
+  }
+
   auto capabilities = ep.GetCapability(graph_viewer, kernel_lookup, graph_optimizer_registry, resource_accountant);
 
+  if (profiling_enabled) {
+    profiler->EndTimeAndRecordEvent(profiling::SESSION_EVENT, ep.Type() + "_GetCapability", start_time,
+                                    {{"graph", graph_viewer.Name()},
+                                     {"num_nodes", std::to_string(graph_viewer.NumberOfNodes())},
+                                     {"num_capabilities", std::to_string(capabilities.size())}});
+  }
+
   // In theory an EP could return an empty capability. Remove those.
   capabilities.erase(std::remove_if(capabilities.begin(), capabilities.end(),
                                     [](const std::unique_ptr<ComputeCapability>& capability) {
@@ -196,7 +213,7 @@ static Status GetCapabilityForEP(const GetCapabilityForEPParams& params, const l
   {
     const GraphViewer graph_viewer(graph);
     capabilities = get_capabilities(current_ep, graph_viewer, kernel_lookup, params.resource_accountant,
-                                    graph_optimizer_registry);
+                                    graph_optimizer_registry, params.profiler);
     if (params.check_load_cancellation_fn()) {
       return ORT_MAKE_STATUS(ONNXRUNTIME, MODEL_LOAD_CANCELED,
                              "Graph partitioning was canceled by user request");
@@ -243,7 +260,7 @@ static Status GetCapabilityForEP(const GetCapabilityForEPParams& params, const l
 
     const GraphViewer graph_viewer(graph);
     capabilities = get_capabilities(current_ep, graph_viewer, kernel_lookup, params.resource_accountant,
-                                    graph_optimizer_registry);
+                                    graph_optimizer_registry, params.profiler);
     if (params.check_load_cancellation_fn()) {
       return ORT_MAKE_STATUS(ONNXRUNTIME, MODEL_LOAD_CANCELED,
                              "GetCapabilities was canceled by user request");
@@ -297,7 +314,8 @@ static Status GetCapabilityForEPForAotInlining(const GraphViewer& graph_viewer,
                                    logger};
 
   // TODO: Provide EP with a capability to look inside the functions.
-  capabilities = get_capabilities(current_ep, graph_viewer, kernel_lookup, nullptr, graph_optimizer_registry);
+  capabilities = get_capabilities(current_ep, graph_viewer, kernel_lookup, nullptr, graph_optimizer_registry,
+                                  nullptr);
 
   return Status::OK();
 }
@@ -430,7 +448,8 @@ static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
                                            const OnPartitionAssignmentFunction& on_partition_assignment_fn,
                                            const logging::Logger& logger, IResourceAccountant* resource_accountant,
                                            const GraphOptimizerRegistry& graph_optimizer_registry,
-                                           bool disable_model_compile) {
+                                           bool disable_model_compile,
+                                           profiling::Profiler* profiler) {
   // handle testing edge case where optimizers or constant lifting results in graph with no nodes.
   // doing it here saves all providers checking for this in GetCapability
   if (graph.NumberOfNodes() == 0) {
@@ -448,7 +467,8 @@ static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
                                                        check_load_cancellation_fn,
                                                        on_partition_assignment_fn,
                                                        logger, resource_accountant,
-                                                       graph_optimizer_registry, disable_model_compile));
+                                                       graph_optimizer_registry, disable_model_compile,
+                                                       profiler));
     }
   }
 
@@ -474,7 +494,8 @@ static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
       std::cref(debug_graph_fn),
       resource_accountant,
       std::ref(graph_optimizer_registry),
-      std::cref(check_load_cancellation_fn)};
+      std::cref(check_load_cancellation_fn),
+      profiler};
 
   ORT_RETURN_IF_ERROR(GetCapabilityForEP(get_capability_params, logger));
   if (capabilities.empty()) {
@@ -1046,7 +1067,7 @@ static Status PartitionOnnxFormatModel(const PartitionParams& partition_params,
                                                        check_load_cancellation_fn,
                                                        on_partition_assignment_fn,
                                                        logger, resource_accountant, graph_optimizer_registry,
-                                                       disable_model_compile));
+                                                       disable_model_compile, partition_params.profiler));
     }
 
     // expand any nodes that have an ONNX function definition but no matching ORT kernel.
@@ -1101,7 +1122,8 @@ static Status PartitionOrtFormatModelImpl(const PartitionParams& partition_param
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
       nullptr,
       std::ref(graph_optimizer_registry),
-      partition_params.check_load_cancellation_fn
+      partition_params.check_load_cancellation_fn,
+      partition_params.profiler
   };
   // clang-format on
 
@@ -1292,7 +1314,8 @@ Status GraphPartitioner::Partition(Graph& graph, FuncManager& func_mgr,
       std::ref(fused_node_unique_id),
       std::cref(transform_layout_function),
       std::cref(debug_graph_fn),
-      std::cref(on_partition_assignment_fn_)};
+      std::cref(on_partition_assignment_fn_),
+      profiler_};
 
 #else  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
@@ -1303,6 +1326,7 @@ Status GraphPartitioner::Partition(Graph& graph, FuncManager& func_mgr,
       std::ref(graph),
       std::cref(check_load_cancellation_fn),
       std::cref(on_partition_assignment_fn_),
+      profiler_,
   };
 
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
@@ -20,6 +20,10 @@ namespace epctx {
 struct ModelGenOptions;
 }
 
+namespace profiling {
+class Profiler;
+}
+
 // OnPartitionAssignmentFunction is called by GraphPartitioner when a subgraph is assigned to
 // an execution provider. Can be used to collect partitioning information.
 using OnPartitionAssignmentFunction = std::function<void(const Graph& graph,
@@ -68,6 +72,9 @@ class GraphPartitioner {
     return check_load_cancellation_fn_ && check_load_cancellation_fn_();
   }
 
+  // Record a SESSION_EVENT for each call to IExecutionProvider::GetCapability during Partition if profiler is enabled.
+  void SetProfiler(profiling::Profiler* profiler) noexcept { profiler_ = profiler; }
+
 #ifndef ORT_MINIMAL_BUILD
   /// <summary>
   // Ahead of Time Function inlining. The main purpose of the function is to inline as many
@@ -98,6 +105,7 @@ class GraphPartitioner {
   std::unique_ptr<GraphOptimizerRegistry> graph_optimizer_registry_;
   CheckLoadCancellationFn check_load_cancellation_fn_;
   OnPartitionAssignmentFunction on_partition_assignment_fn_;
+  profiling::Profiler* profiler_ = nullptr;
 };
 
 }  // namespace onnxruntime
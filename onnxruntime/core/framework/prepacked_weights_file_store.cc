@@ -0,0 +1,223 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/prepacked_weights_file_store.h"
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <system_error>
+
+#include <gsl/gsl>
+
+#include "core/common/logging/logging.h"
+#include "core/common/narrow.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+namespace {
+
+constexpr char kMagic[8] = {'O', 'R', 'T', 'P', 'P', 'W', '0', '1'};
+
+struct FileHeader {
+  char magic[8];
+  uint64_t hash;
+  uint64_t num_buffers;
+};
+
+struct BufferEntry {
+  uint64_t size;
+  uint64_t present;
+};
+
+constexpr size_t AlignOffset(size_t offset) {
+  constexpr size_t alignment = PrepackedWeightsFileStore::kBufferAlignment;
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+// Offset of each buffer's data in the file. Returns the total file size.
+size_t ComputeLayout(const InlinedVector<size_t>& buffer_sizes, InlinedVector<size_t>& offsets) {
+  size_t offset = sizeof(FileHeader) + buffer_sizes.size() * sizeof(BufferEntry);
+  offsets.clear();
+  offsets.reserve(buffer_sizes.size());
+  for (size_t size : buffer_sizes) {
+    offset = AlignOffset(offset);
+    offsets.push_back(offset);
+    offset += size;
+  }
+  return offset;
+}
+
+}  // namespace
+
+PrepackedWeightsFileStore::PrepackedWeightsFileStore(const Env& env, std::filesystem::path directory)
+    : env_(env), directory_(std::move(directory)) {}
+
+std::filesystem::path PrepackedWeightsFileStore::GetFilePath(const std::string& key) const {
+  // keys are op_type + "+" + hash. keep the file name portable.
+  std::string file_name = key;
+  for (char& c : file_name) {
+    const bool is_alnum = (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    if (!is_alnum && c != '_' && c != '-') {
+      c = '_';
+    }
+  }
+  return directory_ / (file_name + ".bin");
+}
+
+Status PrepackedWeightsFileStore::Share(const std::string& key, PrePackedWeights& packed_weights) const {
+  ORT_RETURN_IF_NOT(packed_weights.buffers_.size() == packed_weights.buffer_sizes_.size(),
+                    "Mismatch between number of pre-packed buffers and their sizes for ", key);
+
+  const auto file_path = GetFilePath(key);
+  PrePackedWeights mapped;
+  bool matches = false;
+
+  std::error_code ec;
+  if (std::filesystem::exists(file_path, ec)) {
+    ORT_RETURN_IF_ERROR(Map(file_path, packed_weights, mapped, matches));
+    if (!matches) {
+      LOGS_DEFAULT(WARNING) << "Pre-packed weights file " << file_path
+                            << " does not match the pre-packed weight. It will be rewritten.";
+    }
+  }
+
+  if (!matches) {
+    ORT_RETURN_IF_ERROR(Write(file_path, packed_weights));
+    ORT_RETURN_IF_ERROR(Map(file_path, packed_weights, mapped, matches));
+    ORT_RETURN_IF_NOT(matches, "Pre-packed weights file ", file_path.string(), " does not match after writing it.");
+  }
+
+  packed_weights.buffers_ = std::move(mapped.buffers_);
+  return Status::OK();
+}
+
+Status PrepackedWeightsFileStore::Write(const std::filesystem::path& file_path,
+                                        const PrePackedWeights& packed_weights) const {
+  std::error_code ec;
+  std::filesystem::create_directories(directory_, ec);
+  ORT_RETURN_IF(ec, "Failed to create pre-packed weights store directory ", directory_.string(), ": ", ec.message());
+
+  InlinedVector<size_t> offsets;
+  ComputeLayout(packed_weights.buffer_sizes_, offsets);
+
+  FileHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.hash = packed_weights.GetHash();
+  header.num_buffers = packed_weights.buffers_.size();
+
+  // write to a file unique to this call and rename it into place so that other writers never map a partially
+  // written file. sessions in the same process can write the same key concurrently, so the pid alone isn't unique.
+  // if several writers race, they write identical content and the last rename wins.
+  static std::atomic<uint64_t> tmp_file_counter{0};
+  auto tmp_path = file_path;
+  tmp_path += "." + std::to_string(env_.GetSelfPid()) + "." + std::to_string(tmp_file_counter++) + ".tmp";
+
+  // remove the temporary file on every failure, including exceptions
+  bool renamed = false;
+  auto remove_tmp_file = gsl::finally([&tmp_path, &renamed]() {
+    if (!renamed) {
+      std::error_code remove_ec;
+      std::filesystem::remove(tmp_path, remove_ec);
+    }
+  });
+
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    ORT_RETURN_IF_NOT(out, "Failed to open ", tmp_path.string(), " for writing.");
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (size_t i = 0; i < packed_weights.buffers_.size(); ++i) {
+      const bool present = packed_weights.buffers_[i] != nullptr;
+      BufferEntry entry{present ? packed_weights.buffer_sizes_[i] : 0, present ? 1u : 0u};
+      out.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    }
+
+    size_t offset = sizeof(FileHeader) + packed_weights.buffers_.size() * sizeof(BufferEntry);
+    static const char padding[kBufferAlignment] = {};
+    for (size_t i = 0; i < packed_weights.buffers_.size(); ++i) {
+      out.write(padding, narrow<std::streamsize>(offsets[i] - offset));
+      offset = offsets[i];
+      if (packed_weights.buffers_[i] != nullptr) {
+        out.write(static_cast<const char*>(packed_weights.buffers_[i].get()),
+                  narrow<std::streamsize>(packed_weights.buffer_sizes_[i]));
+        offset += packed_weights.buffer_sizes_[i];
+      }
+    }
+
+    out.close();
+    if (!out) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write pre-packed weights to ", tmp_path.string());
+    }
+  }
+
+  std::filesystem::rename(tmp_path, file_path, ec);
+  if (ec) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to move ", tmp_path.string(), " to ", file_path.string(),
+                           ": ", ec.message());
+  }
+
+  renamed = true;
+  return Status::OK();
+}
+
+Status PrepackedWeightsFileStore::Map(const std::filesystem::path& file_path, const PrePackedWeights& expected,
+                                      PrePackedWeights& mapped, bool& matches) const {
+  matches = false;
+  mapped = PrePackedWeights{};
+
+  size_t file_length = 0;
+  ORT_RETURN_IF_ERROR(env_.GetFileLength(file_path.native().c_str(), file_length));
+
+  const size_t num_buffers = expected.buffers_.size();
+  InlinedVector<size_t> offsets;
+  InlinedVector<size_t> expected_sizes;
+  expected_sizes.reserve(num_buffers);
+  for (size_t i = 0; i < num_buffers; ++i) {
+    expected_sizes.push_back(expected.buffers_[i] != nullptr ? expected.buffer_sizes_[i] : 0);
+  }
+  const size_t expected_length = ComputeLayout(expected_sizes, offsets);
+  if (file_length != expected_length) {
+    return Status::OK();
+  }
+
+  Env::MappedMemoryPtr mapped_memory;
+  ORT_RETURN_IF_ERROR(env_.MapFileIntoMemory(file_path.native().c_str(), 0, file_length, mapped_memory));
+  // every buffer handed out keeps the mapping alive
+  std::shared_ptr<char[]> mapping(mapped_memory.release(), mapped_memory.get_deleter());
+
+  FileHeader header;
+  std::memcpy(&header, mapping.get(), sizeof(header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.num_buffers != num_buffers) {
+    return Status::OK();
+  }
+
+  for (size_t i = 0; i < num_buffers; ++i) {
+    BufferEntry entry;
+    std::memcpy(&entry, mapping.get() + sizeof(FileHeader) + i * sizeof(BufferEntry), sizeof(entry));
+    const bool present = expected.buffers_[i] != nullptr;
+    if (entry.present != (present ? 1u : 0u) || entry.size != expected_sizes[i]) {
+      return Status::OK();
+    }
+
+    if (present) {
+      mapped.buffers_.push_back(IAllocatorUniquePtr<void>(mapping.get() + offsets[i], [mapping](void*) {}));
+    } else {
+      mapped.buffers_.push_back(nullptr);
+    }
+    mapped.buffer_sizes_.push_back(expected.buffer_sizes_[i]);
+  }
+
+  // validate the content. a file left behind by a different build or a corrupted one is rewritten by the caller.
+  const HashValue hash = mapped.GetHash();
+  matches = hash == header.hash && hash == expected.GetHash();
+  if (!matches) {
+    mapped = PrePackedWeights{};
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+#include "core/common/common.h"
+#include "core/framework/prepacked_weights.h"
+
+namespace onnxruntime {
+
+class Env;
+
+// Stores pre-packed weights in a directory, one file per pre-packed weight named after its key.
+// The key includes the hash of the pre-packed buffers, so processes that pre-pack the same weight the same way use the
+// same file. Weights are used from read-only mappings of the files, so the processes share the memory through the
+// OS page cache instead of each holding a private copy.
+//
+// File layout: a header with a magic value, the content hash and the buffer count, one (size, present) pair per
+// buffer, followed by the buffers at offsets aligned to kBufferAlignment.
+class PrepackedWeightsFileStore final {
+ public:
+  static constexpr size_t kBufferAlignment = 64;
+
+  PrepackedWeightsFileStore(const Env& env, std::filesystem::path directory);
+
+  // Replaces the buffers of packed_weights with mappings of the stored copy of the weight, writing the copy to the
+  // store first if there isn't a valid one. An existing file is only used if its content hash and buffer sizes
+  // match packed_weights.
+  // key is the key of the weight in the pre-packed weights containers: op_type + "+" + hash of the buffers.
+  Status Share(const std::string& key, PrePackedWeights& packed_weights) const;
+
+  std::filesystem::path GetFilePath(const std::string& key) const;
+
+ private:
+  Status Write(const std::filesystem::path& file_path, const PrePackedWeights& packed_weights) const;
+
+  // Maps the file at file_path. Returns false in `matches` if it doesn't hold the same weight as expected.
+  Status Map(const std::filesystem::path& file_path, const PrePackedWeights& expected,
+             PrePackedWeights& mapped, bool& matches) const;
+
+  const Env& env_;
+  const std::filesystem::path directory_;
+};
+
+}  // namespace onnxruntime
@@ -380,7 +380,7 @@ class KernelScope {
     if (session_profiling_enabled || run_profiling_enabled) {
       auto& node = kernel.Node();
       node_name_ = node.Name().empty() ? MakeString(node.OpType(), "_", node.Index()) : node.Name();
-      concurrency::ThreadPool::StartProfiling(session_state_.GetThreadPool());
+      concurrency::ThreadPool::StartProfiling(kernel_context_.GetOperatorThreadPool());
       VLOGS(session_state_.Logger(), 1) << "Computing kernel: " << node_name_;
 
       kernel_begin_time_ = session_scope_.StartProfilingIfEnabled();
@@ -415,7 +415,7 @@ class KernelScope {
           {"input_type_shape", input_type_shape_},
           {"output_type_shape", output_type_shape_},
           {"thread_scheduling_stats",
-           concurrency::ThreadPool::StopProfiling(session_state_.GetThreadPool())},
+           concurrency::ThreadPool::StopProfiling(kernel_context_.GetOperatorThreadPool())},
       };
 
       session_scope_.StopProfilingIfEnabled(profiling::NODE_EVENT,
@@ -484,13 +484,18 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
     ctx.RecycleNodeInputs(idx);
     return Status::OK();
   }
+
+  // pre-pack any weights that were left memory-mapped until the kernel's first use
+  ORT_RETURN_IF_ERROR(ctx.GetSessionState().RunDeferredPrePack(idx));
+
   // TODO: set terminate flag from run_option
   OpKernelContextInternal kernel_ctx(ctx.GetSessionState(),
                                      ctx.GetExecutionFrame(),
                                      *p_kernel,
                                      ctx.GetLogger(),
                                      terminate_flag,
-                                     ctx.GetDeviceStream(stream_idx));
+                                     ctx.GetDeviceStream(stream_idx),
+                                     ctx.GetIntraOpThreadPool());
   onnxruntime::Status status;
   auto& logger = ctx.GetLogger();
   if (p_kernel->IsAsync()) {
@@ -628,7 +633,8 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
                                    const bool& terminate_flag,
                                    const bool only_execute_path_to_fetches,
                                    bool single_thread_mode,
-                                   profiling::Profiler* run_profiler) {
+                                   profiling::Profiler* run_profiler,
+                                   const ExecutionThreadPools* thread_pools) {
   auto* execution_plan = session_state.GetExecutionPlan();
   VLOGS(logger, 0) << "Number of streams: " << execution_plan->execution_plan.size();
   int32_t valid_streams = 0;
@@ -671,9 +677,13 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
   ORT_UNUSED_PARAMETER(only_execute_path_to_fetches);
 #endif
 
+  if (thread_pools != nullptr) {
+    ctx.SetThreadPools(*thread_pools);
+  }
+
   SessionScope session_scope(session_state, ctx.GetExecutionFrame(), run_profiler);
 
-  auto* tp = single_thread_mode ? nullptr : session_state.GetInterOpThreadPool();
+  auto* tp = single_thread_mode ? nullptr : ctx.GetInterOpThreadPool();
 
   for (size_t i = 0; i < execution_plan->execution_plan.size(); ++i) {
     if (execution_plan->execution_plan[i]->steps_.empty()) {
@@ -47,7 +47,8 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
                                    const bool& terminate_flag,
                                    const bool only_execute_path_to_fetches,
                                    bool single_thread_mode,
-                                   profiling::Profiler* run_profiler = nullptr);
+                                   profiling::Profiler* run_profiler = nullptr,
+                                   const ExecutionThreadPools* thread_pools = nullptr);
 
 #ifdef ENABLE_TRAINING
 onnxruntime::Status PartialExecuteThePlan(const SessionState& session_state, gsl::span<const int> feed_mlvalue_idxs,
@@ -15,7 +15,9 @@
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/prepacked_weights_container.h"
 #include "core/framework/session_state_utils.h"
+#include "core/framework/tensorprotoutils.h"
 #include "core/framework/utils.h"
+#include "core/platform/env.h"
 #include "core/providers/cpu/controlflow/utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 
@@ -108,6 +110,14 @@ SessionState::SessionState(Graph& graph,
 {
   enable_mem_pattern_ = sess_options_.enable_mem_pattern &&
                         sess_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL;
+
+  const std::string prepacked_weights_store_dir =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsPrepackedWeightsStoreDir, "");
+  if (!prepacked_weights_store_dir.empty()) {
+    prepacked_weights_file_store_ = std::make_unique<PrepackedWeightsFileStore>(
+        Env::Default(), ToPathString(prepacked_weights_store_dir));
+  }
+
   if (parent_allocators) {
     allocators_ = parent_allocators;
     initializer_allocators_ = parent_initializer_allocators;
@@ -271,6 +281,26 @@ const KernelCreateInfo& SessionState::GetNodeKernelCreateInfo(NodeIndex node_ind
   return *entry->second;
 }
 
+// Runs fn on a thread pool worker, converting any exception into a Status so it can be reported by the caller.
+template <typename Fn>
+static Status RunAndCaptureStatus(Fn&& fn) {
+  Status status;
+  ORT_TRY {
+    status = fn();
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+    });
+  }
+  return status;
+}
+
+bool SessionState::IsParallelInitializationEnabled() const {
+  return sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsParallelInitialization, "0") == "1" &&
+         concurrency::ThreadPool::DegreeOfParallelism(thread_pool_) > 1;
+}
+
 Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_manager) {
   const auto& nodes = graph_viewer_->Nodes();
   if (!nodes.empty()) {
@@ -280,7 +310,8 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
     }
     session_kernels_.clear();
     session_kernels_.resize(max_nodeid + 1);
-    for (const auto& node : nodes) {
+
+    auto create_kernel = [this, &kernel_registry_manager](const Node& node) -> Status {
       // construct and save the kernels
       const KernelCreateInfo& kci = GetNodeKernelCreateInfo(node.Index());
 
@@ -289,7 +320,31 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
       const IExecutionProvider& exec_provider = *execution_providers_.Get(exec_provider_name);
 
       // assumes vector is already resize()'ed to the number of nodes in the graph
-      ORT_RETURN_IF_ERROR(kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci, session_kernels_[node.Index()]));
+      return kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci, session_kernels_[node.Index()]);
+    };
+
+    // CPU kernels only read from the session state in their constructors so they can be created concurrently.
+    // Kernels of other EPs may touch device state and are created sequentially.
+    const bool parallel = IsParallelInitializationEnabled();
+    InlinedVector<const Node*> cpu_nodes;
+    for (const auto& node : nodes) {
+      if (parallel && node.GetExecutionProviderType() == kCpuExecutionProvider) {
+        cpu_nodes.push_back(&node);
+      } else {
+        ORT_RETURN_IF_ERROR(create_kernel(node));
+      }
+    }
+
+    if (!cpu_nodes.empty()) {
+      std::vector<Status> statuses(cpu_nodes.size());
+      concurrency::ThreadPool::TrySimpleParallelFor(
+          thread_pool_, static_cast<std::ptrdiff_t>(cpu_nodes.size()), [&](std::ptrdiff_t i) {
+            statuses[i] = RunAndCaptureStatus([&]() { return create_kernel(*cpu_nodes[i]); });
+          });
+
+      for (const auto& status : statuses) {
+        ORT_RETURN_IF_ERROR(status);
+      }
     }
   }
   node_index_info_.emplace(*graph_viewer_, ort_value_name_idx_map_);
@@ -459,16 +514,66 @@ static std::string GenerateKeyForPrepackedWeightsMap(const std::string& op_type,
   return ss_1.str();
 }
 
+// Pre-packing of initializers of at least this size is recorded as a separate profiling event.
+static constexpr size_t kMinProfiledPrePackSize = 1024 * 1024;
+
 Status SessionState::PrepackConstantInitializedTensors(
     InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
     const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map) {
-  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map](
-                                        bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
-    for (auto& node : GetGraphViewer().Nodes()) {
+  // Pre-packing of initializers memory-mapped from external data can be deferred until the node first runs, unless the
+  // pre-packed weights are being saved with the model.
+  const bool defer_external_prepacks =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsLazyExternalInitializers, "0") == "1" &&
+      !graph_.GetPrepacked().IsSaveModeOn();
+
+  // Whether a constant initializer the node uses, from this graph or an outer scope, can have its pre-packing deferred.
+  auto uses_lazy_external_initializer = [this](const Node& node) {
+    for (const auto* input_def : node.InputDefs()) {
+      if (!input_def->Exists()) {
+        continue;
+      }
+
+      const std::string& input_name = input_def->Name();
+      for (const SessionState* st = this; st != nullptr; st = st->parent_) {
+        int ort_value_idx;
+        if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
+          if (st->constant_initialized_tensors_.count(ort_value_idx) != 0 &&
+              st->lazy_external_initializer_idxs_.count(ort_value_idx) != 0) {
+            return true;
+          }
+          if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
+            break;
+          }
+        }
+      }
+    }
+    return false;
+  };
+
+  // When bookkeeping_mutex is provided, nodes are being pre-packed concurrently. The mutex guards the shared
+  // maps, containers and counters, and is only released around the kernel's PrePack() call.
+  auto prepack_node = [this, &constant_initializers_use_count, &initializers_to_share_map, defer_external_prepacks,
+                       &uses_lazy_external_initializer](
+                          const Node& node, bool should_cache_prepacked_weights_for_shared_initializers,
+                          std::mutex* bookkeeping_mutex) -> Status {
+    std::unique_lock<std::mutex> bookkeeping_lock;
+    if (bookkeeping_mutex != nullptr) {
+      bookkeeping_lock = std::unique_lock<std::mutex>(*bookkeeping_mutex);
+    }
+
+    {
       if (sess_options_.IsLoadCancellationFlagSet()) {
         return ORT_MAKE_STATUS(ONNXRUNTIME, MODEL_LOAD_CANCELED,
                                "Weight pre-packing was canceled due to user request.");
       }
+
+      // Kernels can rely on PrePack being called in input order, e.g. MatMulNBits packs the scales and zero points
+      // into the buffer it created when packing B. So if any input is deferred, all of the node's inputs are.
+      // Weights shared through the pre-packed weights container are always packed eagerly, so no input is deferred.
+      const bool defer_node = defer_external_prepacks && !should_cache_prepacked_weights_for_shared_initializers &&
+                              node.GetExecutionProviderType() == kCpuExecutionProvider &&
+                              uses_lazy_external_initializer(node);
+
       auto kernel = GetMutableKernel(node.Index());
       int input_idx = 0;
       for (auto& input_def : node.InputDefs()) {
@@ -487,6 +592,13 @@ Status SessionState::PrepackConstantInitializedTensors(
                 bool is_packed = false;
                 const Tensor& const_initialized_tensor = constant_initialized_tensors[ort_value_idx].Get<Tensor>();
 
+                const size_t initializer_size = const_initialized_tensor.SizeInBytes();
+                const bool profile_prepack = profiler_.IsEnabled() && initializer_size >= kMinProfiledPrePackSize;
+                TimePoint prepack_start_time;
+                if (profile_prepack) {
+                  prepack_start_time = profiler_.Start();
+                }
+
                 auto iter = initializers_to_share_map.find(input_name);
                 bool is_shared_initializer = (iter != initializers_to_share_map.end());
 
@@ -574,6 +686,12 @@ Status SessionState::PrepackConstantInitializedTensors(
                         weights_to_be_filled_in = std::move(*prepacked_from_disk);
                       }
 
+                      if (!prepacked_from_disk.has_value() && prepacked_weights_file_store_ != nullptr &&
+                          !prepacked_for_graph->IsSaveModeOn()) {
+                        ORT_RETURN_IF_ERROR(prepacked_weights_file_store_->Share(prepacked_weights_container_key,
+                                                                                 weights_to_be_filled_in));
+                      }
+
                       if (!prepacked_weights_container_->WriteWeight(prepacked_weights_container_key,
                                                                      std::move(weights_to_be_filled_in))) {
                         return ORT_MAKE_STATUS(
@@ -589,6 +707,14 @@ Status SessionState::PrepackConstantInitializedTensors(
                     }
                   }
 
+                } else if (defer_node) {
+                  // leave the initializer untouched until the node runs. it is kept as the kernel still needs it as
+                  // an input until then.
+                  auto& deferred = deferred_prepacks_[node.Index()];
+                  if (!deferred) {
+                    deferred = std::make_unique<DeferredPrePack>();
+                  }
+                  deferred->inputs.emplace_back(input_idx, constant_initialized_tensors[ort_value_idx]);
                 } else {
                   // cross session caching of pre-packed weights' turned OFF
                   // we use serialization container to share weights loaded from disk
@@ -603,9 +729,16 @@ Status SessionState::PrepackConstantInitializedTensors(
                   // pre-packed weight with the pre-packed weight generated by this instance of the same op_type because
                   // other static properties of the node like node attributes could play a role in the pre-packed
                   // weights' contents.
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, session_initializer_alloc,
-                                                      is_packed,
-                                                      &weights_to_be_filled_in));
+                  if (bookkeeping_lock.owns_lock()) {
+                    bookkeeping_lock.unlock();
+                  }
+                  Status prepack_status = kernel->PrePack(const_initialized_tensor, input_idx,
+                                                          session_initializer_alloc, is_packed,
+                                                          &weights_to_be_filled_in);
+                  if (bookkeeping_mutex != nullptr) {
+                    bookkeeping_lock.lock();
+                  }
+                  ORT_RETURN_IF_ERROR(prepack_status);
 
                   // Some kernels (matmul_nbits and non-CPU related kernels) do not share their pre-packed results
                   // even though they set is_packed = true so we leave it up to them.
@@ -624,6 +757,10 @@ Status SessionState::PrepackConstantInitializedTensors(
 
                     if (weights_to_use == nullptr) {
                       // In this case pre-packed container owns the data
+                      if (prepacked_weights_file_store_ != nullptr && !prepacked_for_graph->IsSaveModeOn()) {
+                        ORT_RETURN_IF_ERROR(prepacked_weights_file_store_->Share(prepacked_weights_container_key,
+                                                                                 weights_to_be_filled_in));
+                      }
                       prepacked_for_graph->WritePackedMaybeForSave(input_name, prepacked_weights_container_key,
                                                                    std::move(weights_to_be_filled_in));
                       weights_to_use = prepacked_for_graph->GetPrepackedWeights(prepacked_weights_container_key);
@@ -639,6 +776,14 @@ Status SessionState::PrepackConstantInitializedTensors(
                 if (is_packed) {
                   ++number_of_prepacks_counter_;
 
+                  if (profile_prepack) {
+                    profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, input_name + "_prepack",
+                                                    prepack_start_time,
+                                                    {{"node_name", node.Name()},
+                                                     {"op_type", node.OpType()},
+                                                     {"size", std::to_string(initializer_size)}});
+                  }
+
                   if (constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
                     // release the constant initialized tensor
                     st->initialized_tensors_.erase(ort_value_idx);
@@ -670,10 +815,75 @@ Status SessionState::PrepackConstantInitializedTensors(
     // serialize calls to the method that looks up the container, calls UseCachedPrePackedWeight/PrePack
     // and writes pre-packed weights to the container
     std::lock_guard<std::mutex> l(prepacked_weights_container_->mutex_);
-    return prepacked_constant_weights(true);
-  } else {
-    return prepacked_constant_weights(false);
+    for (auto& node : GetGraphViewer().Nodes()) {
+      ORT_RETURN_IF_ERROR(prepack_node(node, true, nullptr));
+    }
+    return Status::OK();
+  }
+
+  if (!IsParallelInitializationEnabled()) {
+    for (auto& node : GetGraphViewer().Nodes()) {
+      ORT_RETURN_IF_ERROR(prepack_node(node, false, nullptr));
+    }
+    return Status::OK();
+  }
+
+  // Kernels of other EPs may pre-pack onto their device so they keep running sequentially.
+  InlinedVector<const Node*> cpu_nodes;
+  for (auto& node : GetGraphViewer().Nodes()) {
+    if (node.GetExecutionProviderType() == kCpuExecutionProvider) {
+      cpu_nodes.push_back(&node);
+    } else {
+      ORT_RETURN_IF_ERROR(prepack_node(node, false, nullptr));
+    }
+  }
+
+  std::mutex bookkeeping_mutex;
+  std::vector<Status> statuses(cpu_nodes.size());
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool_, static_cast<std::ptrdiff_t>(cpu_nodes.size()), [&](std::ptrdiff_t i) {
+        statuses[i] = RunAndCaptureStatus([&]() {
+          return prepack_node(*cpu_nodes[i], false, &bookkeeping_mutex);
+        });
+      });
+
+  for (const auto& status : statuses) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+  return Status::OK();
+}
+
+Status SessionState::RunDeferredPrePack(NodeIndex node_index) const {
+  if (deferred_prepacks_.empty()) {
+    return Status::OK();
+  }
+
+  auto it = deferred_prepacks_.find(node_index);
+  if (it == deferred_prepacks_.end()) {
+    return Status::OK();
   }
+
+  DeferredPrePack& deferred = *it->second;
+  std::call_once(deferred.once, [this, node_index, &deferred]() {
+    OpKernel* kernel = session_kernels_[node_index].get();
+    AllocatorPtr session_initializer_alloc = GetInitializerAllocator(
+        kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
+
+    // the kernel keeps the pre-packed buffers itself as they are not shared or saved in this mode.
+    // the inputs were recorded in input order, which is the order PrePack is called in when it isn't deferred.
+    deferred.status = RunAndCaptureStatus([&]() -> Status {
+      for (const auto& [input_idx, value] : deferred.inputs) {
+        bool is_packed = false;
+        ORT_RETURN_IF_ERROR(kernel->PrePack(value.Get<Tensor>(), input_idx, session_initializer_alloc,
+                                            is_packed, nullptr));
+      }
+      return Status::OK();
+    });
+
+    deferred.inputs.clear();
+  });
+
+  return deferred.status;
 }
 
 static int64_t
@@ -1695,6 +1905,24 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   }
 #endif
 
+  if (session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsLazyExternalInitializers, "0") == "1") {
+    static const auto default_cpu_device = OrtDevice();
+    for (const auto& [name, tensor_proto] : graph_.GetAllInitializedTensors()) {
+      int idx;
+      if (utils::HasExternalData(*tensor_proto) && !utils::HasExternalDataInMemory(*tensor_proto) &&
+          ort_value_name_idx_map_.GetIdx(name, idx).IsOK() &&
+          p_seq_exec_plan_->GetLocation(idx) == default_cpu_device) {
+        lazy_external_initializer_idxs_.insert(idx);
+      }
+    }
+  }
+
+  // per-phase startup time breakdown
+  TimePoint phase_start;
+  if (profiler_.IsEnabled()) {
+    phase_start = profiler_.Start();
+  }
+
   ORT_RETURN_IF_ERROR(session_state_utils::SaveInitializedTensors(
       Env::Default(), graph_location, *graph_viewer_,
       GetAllocator(OrtDevice()),
@@ -1708,7 +1936,13 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
         return Status::OK();
       },
       logger_, data_transfer_mgr_, external_data_loader_mgr_, *p_seq_exec_plan_, session_options,
-      memory_profile_func, graph_.GetPrepacked()));
+      memory_profile_func, graph_.GetPrepacked(),
+      IsParallelInitializationEnabled() ? thread_pool_ : nullptr));
+
+  if (profiler_.IsEnabled()) {
+    profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "session_state_initializers", phase_start);
+    phase_start = profiler_.Start();
+  }
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Record Weight allocation info on device
@@ -1724,9 +1958,18 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
 
   ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager));
 
+  if (profiler_.IsEnabled()) {
+    profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "session_state_kernel_creation", phase_start);
+    phase_start = profiler_.Start();
+  }
+
   if (!disable_prepacking) {
     ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count,
                                                           session_options.initializers_to_share_map));
+
+    if (profiler_.IsEnabled()) {
+      profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "session_state_prepacking", phase_start);
+    }
   }
 
   ORT_RETURN_IF_ERROR(
@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <map>
+#include <mutex>
 #include <unordered_map>
 #include <string>
 #include <vector>
@@ -25,6 +26,7 @@
 #include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/prepacked_weights_container.h"
+#include "core/framework/prepacked_weights_file_store.h"
 #include "core/framework/fuse_nodes_funcs.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/mem_pattern.h"
@@ -86,6 +88,13 @@ class MemoryInfo;
 using SubgraphSessionStateMap =
     std::unordered_map<onnxruntime::NodeIndex, std::unordered_map<std::string, std::unique_ptr<SessionState>>>;
 
+// The thread pools used to execute a graph. A run can use thread pools other than the ones the SessionState was
+// created with, which allows sessions sharing a SessionState to each use their own thread pools.
+struct ExecutionThreadPools {
+  concurrency::ThreadPool* intra_op{nullptr};
+  concurrency::ThreadPool* inter_op{nullptr};
+};
+
 class SessionState {
  public:
   SessionState(Graph& graph,
@@ -118,6 +127,11 @@ class SessionState {
     return (node_id < session_kernels_.size()) ? session_kernels_[node_id].get() : nullptr;
   }
 
+  // Pre-pack the constant initializers of the node whose pre-packing was deferred until first use
+  // (see kOrtSessionOptionsLazyExternalInitializers). Runs once; concurrent callers wait for it to complete and
+  // all callers get the same status. No-op for nodes without deferred pre-packing.
+  Status RunDeferredPrePack(NodeIndex node_index) const;
+
   const ExecutionProviders& GetExecutionProviders() const noexcept { return execution_providers_; }
 
   /**
@@ -400,6 +414,9 @@ class SessionState {
   // create kernels using info in kernel_create_info_map_
   Status CreateKernels(const KernelRegistryManager& custom_registry_manager);
 
+  // true if kOrtSessionOptionsParallelInitialization is set and the intra-op thread pool can run work concurrently
+  bool IsParallelInitializationEnabled() const;
+
   // remove TensorProto versions of initializers from Graph instance
   // (replaced byOrtValue instances in initialized_tensors_)
   void CleanInitializedTensorsFromGraph();
@@ -554,6 +571,10 @@ class SessionState {
   // prepacked_weights_container_ can be nullptr if no caching is required for prepacked weights
   PrepackedWeightsContainer* const prepacked_weights_container_{};
 
+  // Store of pre-packed weights shared with other processes through memory-mapped files.
+  // Only created if kOrtSessionOptionsPrepackedWeightsStoreDir is set.
+  std::unique_ptr<PrepackedWeightsFileStore> prepacked_weights_file_store_;
+
 #ifdef ENABLE_TRAINING
 // Needed for ORTTrainer. Should be removed along with ORTTrainer code
 #ifndef DISABLE_ABSEIL
@@ -580,6 +601,20 @@ class SessionState {
   // part the model
   size_t number_of_prepacks_counter_ = 0;
 
+  // OrtValue indexes of the initializers that are memory-mapped from external data on CPU and can have their
+  // pre-packing deferred. Only populated if kOrtSessionOptionsLazyExternalInitializers is set.
+  InlinedHashSet<int> lazy_external_initializer_idxs_;
+
+  struct DeferredPrePack {
+    std::once_flag once;
+    Status status;
+    // input index and the constant initializer to pre-pack for it
+    InlinedVector<std::pair<int, OrtValue>> inputs;
+  };
+
+  // Pre-packing deferred until the node first runs
+  InlinedHashMap<NodeIndex, std::unique_ptr<DeferredPrePack>> deferred_prepacks_;
+
   // Counter for number of times a shared version of the pre-packed weight corresponding to
   // a constant initialized weight was used by the session state
   size_t used_shared_pre_packed_weights_counter_ = 0;
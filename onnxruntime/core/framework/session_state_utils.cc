@@ -28,6 +28,7 @@
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/framework/mem_buffer.h"
 #include "core/framework/tensor_allocator.h"
+#include "core/platform/threadpool.h"
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 #include "core/framework/memory_info.h"
 #endif
@@ -245,7 +246,8 @@ common::Status SaveInitializedTensors(
     const ExecutionPlanBase& exec_plan,
     const SessionOptions& session_options,
     const MemoryProfileFunction& memory_profile_func,
-    PrepackedWeightsForGraph& prepacked_for_graph) {
+    PrepackedWeightsForGraph& prepacked_for_graph,
+    concurrency::ThreadPool* thread_pool) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > -1, "OrtValue indexes should have been populated.");
 
@@ -359,6 +361,84 @@ common::Status SaveInitializedTensors(
       session_options.config_options.GetConfigOrDefault(
           kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
 
+  // Initializers embedded in the model and planned on CPU are unpacked concurrently ahead of the sequential loop
+  // below, into the buffer planned for them if any. External, in-memory, device and shared initializers keep the
+  // sequential path.
+  InlinedHashMap<int, OrtValue> unpacked_initializers;
+  if (concurrency::ThreadPool::DegreeOfParallelism(thread_pool) > 1) {
+    struct InitializerToUnpack {
+      int ort_value_index;
+      const ONNX_NAMESPACE::TensorProto* tensor_proto;
+      std::optional<MemBuffer> memory_buffer;
+      AllocatorPtr alloc;
+    };
+
+    std::vector<InitializerToUnpack> to_unpack;
+    for (const auto& entry : id_to_initialized_tensor) {
+      const ONNX_NAMESPACE::TensorProto& tensor_proto = *entry.second;
+      if (tensor_proto.name().empty() ||
+          user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end() ||
+          utils::HasExternalData(tensor_proto) ||
+          exec_plan.GetLocation(entry.first) != default_cpu_device) {
+        continue;
+      }
+
+      if (OrtValue ort_value_from_graph; graph.GetOrtValueInitializer(tensor_proto.name(), ort_value_from_graph)) {
+        continue;
+      }
+
+      // the planner isn't thread safe, so the buffers are retrieved here.
+      InitializerToUnpack initializer{entry.first, entry.second, std::nullopt, nullptr};
+      ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(entry.first, tensor_proto.name(),
+                                                        initializer.memory_buffer, initializer.alloc));
+      const auto& memory_info = (initializer.alloc != nullptr) ? initializer.alloc->Info()
+                                                               : initializer.memory_buffer->GetAllocInfo();
+      if (memory_info.device != default_cpu_device) {
+        continue;
+      }
+
+      to_unpack.push_back(std::move(initializer));
+    }
+
+    std::vector<OrtValue> values(to_unpack.size());
+    std::vector<Status> statuses(to_unpack.size());
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        thread_pool, static_cast<std::ptrdiff_t>(to_unpack.size()), [&](std::ptrdiff_t i) {
+          const InitializerToUnpack& initializer = to_unpack[i];
+          if (!initializer.memory_buffer.has_value()) {
+            statuses[i] = DeserializeTensorProto(env, graph_loc, *initializer.tensor_proto, nullptr,
+                                                 initializer.alloc, default_cpu_alloc, values[i], data_transfer_mgr,
+                                                 external_data_loader_mgr, prepacked_for_graph,
+                                                 use_device_allocator_for_initializers);
+            return;
+          }
+
+          // deserialize directly into the planned buffer, so the initializer isn't allocated twice.
+          TensorShape tensor_shape = utils::GetTensorShapeFromTensorProto(*initializer.tensor_proto);
+          const DataTypeImpl* const type =
+              DataTypeImpl::TensorTypeFromONNXEnum(initializer.tensor_proto->data_type())->GetElementType();
+          Tensor tensor;
+          statuses[i] = AllocateTensor(&*initializer.memory_buffer, tensor, type, tensor_shape,
+                                       use_device_allocator_for_initializers, initializer.alloc);
+          if (statuses[i].IsOK()) {
+            statuses[i] = utils::TensorProtoToTensor(env, graph_loc.c_str(), *initializer.tensor_proto, tensor);
+          }
+          if (statuses[i].IsOK()) {
+            Tensor::InitOrtValue(std::move(tensor), values[i]);
+          }
+        });
+
+    unpacked_initializers.reserve(to_unpack.size());
+    for (size_t i = 0; i < to_unpack.size(); ++i) {
+      if (!statuses[i].IsOK()) {
+        std::ostringstream oss;
+        oss << "Deserialize tensor " << to_unpack[i].tensor_proto->name() << " failed." << statuses[i].ErrorMessage();
+        return Status(statuses[i].Category(), statuses[i].Code(), oss.str());
+      }
+      unpacked_initializers.emplace(to_unpack[i].ort_value_index, std::move(values[i]));
+    }
+  }
+
   // 3. create weight tensors based on weights buffer
   for (const auto& entry : id_to_initialized_tensor) {
     // We check for cancellation for every initializer since mapping from disk can be costly
@@ -380,6 +460,9 @@ common::Status SaveInitializedTensors(
     if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
       ort_value = *(session_options.initializers_to_share_map.at(name));
       LOGS(logger, INFO) << "Using user supplied initializer with name (" << name << ").";
+    } else if (auto unpacked = unpacked_initializers.find(ort_value_index);
+               unpacked != unpacked_initializers.end()) {
+      ort_value = std::move(unpacked->second);
     } else {
       const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
 
@@ -30,6 +30,8 @@ StreamExecutionContext::StreamExecutionContext(const SessionState& sess_state,
              device_stream_map,
              sess_state),
       logger_(&sess_logger),
+      intra_op_thread_pool_(sess_state.GetThreadPool()),
+      inter_op_thread_pool_(sess_state.GetInterOpThreadPool()),
       single_thread_mode_(single_thread_mode),
       device_stream_map_(device_stream_map),
       count_down_barriers_(num_barriers) {
@@ -101,6 +103,8 @@ StreamExecutionContext::StreamExecutionContext(const SessionState& sess_state,
              fetch_allocators,
              sess_state),
       logger_(&sess_logger),
+      intra_op_thread_pool_(sess_state.GetThreadPool()),
+      inter_op_thread_pool_(sess_state.GetInterOpThreadPool()),
       single_thread_mode_(single_thread_mode) {
 #ifdef _WIN32
 #pragma warning(push)
@@ -137,6 +141,11 @@ const SessionState& StreamExecutionContext ::GetSessionState() const { return *s
 
 const logging::Logger& StreamExecutionContext ::GetLogger() const { return *logger_; }
 
+void StreamExecutionContext::SetThreadPools(const ExecutionThreadPools& thread_pools) {
+  intra_op_thread_pool_ = thread_pools.intra_op;
+  inter_op_thread_pool_ = thread_pools.inter_op;
+}
+
 ExecutionFrame& StreamExecutionContext ::GetExecutionFrame() { return frame_; }
 
 const Status& StreamExecutionContext ::TaskStatus() const {
@@ -267,7 +276,7 @@ void ScheduleDownstream(StreamExecutionContext& ctx, size_t trigger, bool single
                         const bool& terminate_flag, SessionScope& session_scope) {
   auto* plan = ctx.GetSessionState().GetExecutionPlan();
   auto& downstream_map = plan->downstream_map;
-  auto* tp = single_thread_mode ? nullptr : ctx.GetSessionState().GetInterOpThreadPool();
+  auto* tp = single_thread_mode ? nullptr : ctx.GetInterOpThreadPool();
   auto it = downstream_map.find(trigger);
   if (it != downstream_map.end()) {
     for (auto downstream : it->second) {
@@ -16,6 +16,10 @@
 
 namespace onnxruntime {
 class SessionState;
+struct ExecutionThreadPools;
+namespace concurrency {
+class ThreadPool;
+}
 
 class SessionScope;
 typedef InlinedHashMap<std::string, OrtValue> OrtValueCache;
@@ -84,6 +88,15 @@ class StreamExecutionContext {
     logger_ = &current_logger;
   }
 
+  // Use thread pools other than the ones of the SessionState for the execution.
+  void SetThreadPools(const ExecutionThreadPools& thread_pools);
+
+  // The intra-op thread pool given to the kernels.
+  concurrency::ThreadPool* GetIntraOpThreadPool() const { return intra_op_thread_pool_; }
+
+  // The inter-op thread pool used to schedule the streams in multi-threads mode.
+  concurrency::ThreadPool* GetInterOpThreadPool() const { return inter_op_thread_pool_; }
+
   // Get status of the execution.
   // if one of the stream got non-OK status, the whole task status will be set as that non-OK status.
   const Status& TaskStatus() const;
@@ -154,6 +167,10 @@ class StreamExecutionContext {
 
   const logging::Logger* logger_;
 
+  concurrency::ThreadPool* intra_op_thread_pool_;
+
+  concurrency::ThreadPool* inter_op_thread_pool_;
+
   std::unique_ptr<std::atomic_int[]> release_plan_;
 
   CountDownBarrier remain_tasks_;
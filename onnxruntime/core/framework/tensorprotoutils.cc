@@ -1391,8 +1391,10 @@ ORT_API(void, OrtUninitializeBuffer, _In_opt_ void* input, size_t input_len, enu
 #endif
 
 #if !defined(__wasm__)
+// alignment is the required alignment of the returned buffer. A mapping of data at an offset in the file that doesn't
+// meet it is replaced with a copy.
 static Status GetFileContent(const Env& env, const std::filesystem::path& file_path, FileOffsetType offset,
-                             size_t length, IAllocatorUniquePtr<void>& external_data) {
+                             size_t length, size_t alignment, IAllocatorUniquePtr<void>& external_data) {
   // query length if it is 0
   if (length == 0) {
     // The return type of std::filesystem::file_size is uintmax_t which could be bigger than size_t
@@ -1403,7 +1405,7 @@ static Status GetFileContent(const Env& env, const std::filesystem::path& file_p
   {
     Env::MappedMemoryPtr mapped_memory{};
     auto status = env.MapFileIntoMemory(file_path.native().c_str(), offset, length, mapped_memory);
-    if (status.IsOK()) {
+    if (status.IsOK() && reinterpret_cast<uintptr_t>(mapped_memory.get()) % alignment == 0) {
       IAllocatorUniquePtr<void> raw_buffer(mapped_memory.release(),
                                            mapped_memory.get_deleter());
       external_data.swap(raw_buffer);
@@ -1498,7 +1500,10 @@ Status GetExtDataFromTensorProto(const Env& env,
                   " are out of bounds or can not be read in full.");
 
     IAllocatorUniquePtr<void> ext_data_buf;
-    ORT_RETURN_IF_ERROR(GetFileContent(env, external_data_file_path, file_offset, raw_data_safe_len,
+    // tensors are accessed through pointers to their element type. raw data inline in a model file is not aligned.
+    const size_t element_size = type->Size();
+    const size_t alignment = element_size != 0 && (element_size & (element_size - 1)) == 0 ? element_size : 1;
+    ORT_RETURN_IF_ERROR(GetFileContent(env, external_data_file_path, file_offset, raw_data_safe_len, alignment,
                                        ext_data_buf));
 
     // Data on disk is little endian
@@ -1541,7 +1546,7 @@ Status GetExtDataFromTensorProto(const Env& env,
                         " is out of bounds and can not read in full");
 
           IAllocatorUniquePtr<void> data_ptr;
-          ORT_RETURN_IF_ERROR(GetFileContent(env, external_data_file_path, blob_offset, blob_length,
+          ORT_RETURN_IF_ERROR(GetFileContent(env, external_data_file_path, blob_offset, blob_length, 1,
                                              data_ptr));
           prepacked_weights.buffers_.push_back(std::move(data_ptr));
           prepacked_weights.buffer_sizes_.push_back(blob_length);
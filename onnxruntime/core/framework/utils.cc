@@ -600,7 +600,8 @@ ExecuteGraphImpl(const SessionState& session_state,
 #endif
                  const bool only_execute_path_to_fetches = false,
                  Stream* parent_stream = nullptr,
-                 profiling::Profiler* run_profiler = nullptr) {
+                 profiling::Profiler* run_profiler = nullptr,
+                 const ExecutionThreadPools* thread_pools = nullptr) {
   const auto& feeds_fetches_info = feeds_fetches_manager.GetFeedsFetchesInfo();
   const auto& device_copy_checks = feeds_fetches_manager.GetDeviceCopyChecks();
 #ifdef ORT_ENABLE_STREAM
@@ -633,7 +634,8 @@ ExecuteGraphImpl(const SessionState& session_state,
                                   only_execute_path_to_fetches,
                                   // single thread mode
                                   single_thread_mode,
-                                  run_profiler));
+                                  run_profiler,
+                                  thread_pools));
     ORT_RETURN_IF_ERROR(status);
   } else {
     auto feeds_to_use = feeds;
@@ -682,7 +684,8 @@ ExecuteGraphImpl(const SessionState& session_state,
                                   terminate_flag,
                                   only_execute_path_to_fetches,
                                   single_thread_mode,
-                                  run_profiler));
+                                  run_profiler,
+                                  thread_pools));
     ORT_RETURN_IF_ERROR(status);
     InlinedVector<Stream*> fetches_streams;
     fetches_streams.reserve(feeds_fetches_info.fetches_mlvalue_idxs.size());
@@ -721,7 +724,8 @@ common::Status ExecuteGraph(const SessionState& session_state,
 #endif
                             bool only_execute_path_to_fetches,
                             Stream* parent_stream,
-                            profiling::Profiler* run_profiler) {
+                            profiling::Profiler* run_profiler,
+                            const ExecutionThreadPools* thread_pools) {
   ORT_RETURN_IF_ERROR(utils::InitializeFeedFetchCopyInfo(session_state, feeds_fetches_manager));
 
   // finalize the copy info using the provided feeds and fetches. will update device_copy_checks in the background
@@ -733,14 +737,16 @@ common::Status ExecuteGraph(const SessionState& session_state,
                                  device_stream_collection,
                                  only_execute_path_to_fetches,
                                  parent_stream,
-                                 run_profiler);
+                                 run_profiler,
+                                 thread_pools);
   return retval;
 #else
   return ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, {},
                           execution_mode, terminate_flag, logger,
                           only_execute_path_to_fetches,
                           parent_stream,
-                          run_profiler);
+                          run_profiler,
+                          thread_pools);
 #endif
 }
 
@@ -752,7 +758,8 @@ common::Status ExecuteGraph(const SessionState& session_state,
                             DeviceStreamCollectionHolder& device_stream_collection_holder,
 #endif
                             const logging::Logger& logger,
-                            profiling::Profiler* run_profiler) {
+                            profiling::Profiler* run_profiler,
+                            const ExecutionThreadPools* thread_pools) {
   return ExecuteGraph(session_state, feeds_fetches_manager, feeds, fetches,
                       execution_mode, run_options.terminate, logger,
 #ifdef ORT_ENABLE_STREAM
@@ -760,7 +767,8 @@ common::Status ExecuteGraph(const SessionState& session_state,
 #endif
                       run_options.only_execute_path_to_fetches,
                       nullptr /* parent_stream */,
-                      run_profiler);
+                      run_profiler,
+                      thread_pools);
 }
 
 #ifdef ENABLE_TRAINING
@@ -883,18 +891,20 @@ common::Status ExecuteSubgraph(const SessionState& session_state, const FeedsFet
                                const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
                                ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger,
                                Stream* parent_stream,
-                               bool sync_subgraph_fetches) {
+                               bool sync_subgraph_fetches,
+                               const ExecutionThreadPools* thread_pools) {
 #ifdef ORT_ENABLE_STREAM
   DeviceStreamCollectionHolder device_stream_collection_holder(&session_state);
   DeviceStreamCollection* device_stream_collection = device_stream_collection_holder.p_.get();
 
   auto retval = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators,
-                                 execution_mode, terminate_flag, logger, device_stream_collection, false, parent_stream);
+                                 execution_mode, terminate_flag, logger, device_stream_collection, false, parent_stream,
+                                 nullptr, thread_pools);
   if (device_stream_collection)
     ORT_CHECK_AND_SET_RETVAL(device_stream_collection->CleanUp(false));
 #else
   auto retval = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators,
-                                 execution_mode, terminate_flag, logger, false, parent_stream);
+                                 execution_mode, terminate_flag, logger, false, parent_stream, nullptr, thread_pools);
 #endif
   if (retval.IsOK() && sync_subgraph_fetches && parent_stream) {
     parent_stream->Flush();
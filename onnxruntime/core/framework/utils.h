@@ -84,7 +84,8 @@ common::Status ExecuteGraph(const SessionState& session_state, FeedsFetchesManag
 #endif
                             bool only_execute_path_to_fetches = false,
                             Stream* parent_stream = nullptr,
-                            profiling::Profiler* run_profiler = nullptr);
+                            profiling::Profiler* run_profiler = nullptr,
+                            const ExecutionThreadPools* thread_pools = nullptr);
 
 common::Status ExecuteGraph(const SessionState& session_state, FeedsFetchesManager& feeds_fetches_manager,
                             gsl::span<const OrtValue> feeds, std::vector<OrtValue>& fetches,
@@ -93,7 +94,8 @@ common::Status ExecuteGraph(const SessionState& session_state, FeedsFetchesManag
                             DeviceStreamCollectionHolder& device_stream_collection_holder,
 #endif
                             const logging::Logger& logger,
-                            profiling::Profiler* run_profiler = nullptr);
+                            profiling::Profiler* run_profiler = nullptr,
+                            const ExecutionThreadPools* thread_pools = nullptr);
 
 #ifdef ENABLE_TRAINING
 common::Status ExecutePartialGraph(const SessionState& session_state, FeedsFetchesManager& feeds_fetches_manager,
@@ -107,6 +109,7 @@ common::Status ExecutePartialGraph(const SessionState& session_state, FeedsFetch
 
 // Execute a subgraph. The feeds_fetches_manager should have been finalized prior to calling this function.
 // See IControlFlowNode::SetupSubgraphExecutionInfo usage in the control flow kernels.
+// If thread_pools is nullptr the thread pools of session_state are used.
 common::Status ExecuteSubgraph(const SessionState& session_state, const FeedsFetchesManager& feeds_fetches_manager,
                                gsl::span<const OrtValue> feeds, std::vector<OrtValue>& fetches,
                                const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
@@ -115,7 +118,8 @@ common::Status ExecuteSubgraph(const SessionState& session_state, const FeedsFet
                                /*when this is enabled, we will sync the parent stream to make sure the subgraph fetches
                                is complete. this is mainly used when the parent kernel depends on the CPU value of the
                                subgraph fetches, i.e. the loop condition*/
-                               bool sync_subgraph_fetches = false);
+                               bool sync_subgraph_fetches = false,
+                               const ExecutionThreadPools* thread_pools = nullptr);
 
 bool IsInputOnCpu(const Node& node, const KernelCreateInfo* p_kci, size_t index);
 bool IsOutputOnCpu(const Node& node, const KernelCreateInfo* p_kci, size_t index);
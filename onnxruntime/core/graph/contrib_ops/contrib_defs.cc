@@ -633,6 +633,99 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
           return true;
         }));
 
+constexpr const char* FusedElementwise_ver1_doc = R"DOC(
+Evaluates a DAG of element-wise operations in a single pass over the output.
+
+The operations are evaluated in the order given by the 'operations' attribute. Each operation reads its operands from
+the values numbered by the 'operands' attribute, which holds two entries per operation. Values 0 to N-1 are the N
+inputs of this operator and value N+i is the result of operation i. The second operand of a unary operation is -1.
+The result of the last operation is the output.
+
+Every operation is evaluated on the multidirectional broadcast of all the inputs, which gives the same result as
+evaluating it on the broadcast of its own operands as the operations are element-wise.
+
+Supported operations: Add, Sub, Mul, Div, Relu, Sigmoid, Tanh, Exp, Log, Neg, Abs, Sqrt, Reciprocal.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    FusedElementwise, 1,
+    OpSchema()
+        .SetDoc(FusedElementwise_ver1_doc)
+        .Attr("operations", "The op type of each operation, in evaluation order.", AttributeProto::STRINGS)
+        .Attr("operands",
+              "The two operands of each operation. Values 0 to N-1 are the inputs and value N+i is the result of "
+              "operation i. -1 is the second operand of a unary operation.",
+              AttributeProto::INTS)
+        .Input(0, "inputs", "The inputs of the operations.", "T", OpSchema::Variadic)
+        .Output(0, "Y", "The result of the last operation.", "T")
+        .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          propagateElemTypeFromInputToOutput(ctx, 0, 0);
+          std::vector<const TensorShapeProto*> shapes;
+          for (size_t i = 0; i < ctx.getNumInputs(); ++i) {
+            if (!hasInputShape(ctx, i)) {
+              return;
+            }
+            shapes.push_back(&getInputShape(ctx, i));
+          }
+          multidirectionalBroadcastShapeInference(shapes, *getOutputShape(ctx, 0));
+        }));
+
+constexpr const char* SoftmaxTopK_ver1_doc = R"DOC(
+Computes TopK(Softmax(X, axis), K, axis) without materializing the output of Softmax.
+
+Softmax is monotonic along the axis, so the top K elements are selected from X, and only their values are normalized
+with the maximum and the sum of the exponentials of X along the axis.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    SoftmaxTopK, 1,
+    OpSchema()
+        .SetDoc(SoftmaxTopK_ver1_doc)
+        .Attr("axis", "The axis of Softmax and TopK. A negative value counts from the back.", AttributeProto::INT,
+              static_cast<int64_t>(-1))
+        .Attr("largest", "Whether to return the top K largest or smallest elements.", AttributeProto::INT,
+              static_cast<int64_t>(1))
+        .Attr("sorted", "Whether to return the elements in sorted order.", AttributeProto::INT,
+              static_cast<int64_t>(1))
+        .Input(0, "X", "The logits.", "T")
+        .Input(1, "K", "A 1-D tensor containing a single value, the number of top elements to retrieve.",
+               "tensor(int64)")
+        .Output(0, "Values", "The top K softmax probabilities along the axis.", "T")
+        .Output(1, "Indices", "The indices of the top K elements along the axis.", "tensor(int64)")
+        .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          propagateElemTypeFromInputToOutput(ctx, 0, 0);
+          updateOutputElemType(ctx, 1, ONNX_NAMESPACE::TensorProto::INT64);
+
+          if (!hasInputShape(ctx, 0)) {
+            return;
+          }
+
+          const auto& input_shape = getInputShape(ctx, 0);
+          const int64_t rank = input_shape.dim_size();
+          int64_t axis = getAttribute(ctx, "axis", -1);
+          if (axis < -rank || axis >= rank) {
+            fail_shape_inference("axis must be in [-rank, rank-1]. input rank was ", rank);
+          }
+          axis = axis < 0 ? axis + rank : axis;
+
+          ONNX_NAMESPACE::TensorShapeProto output_shape = input_shape;
+          const ONNX_NAMESPACE::TensorProto* k_initializer = ctx.getInputData(1);
+          if (k_initializer != nullptr) {
+            const auto k = ParseData<int64_t>(k_initializer);
+            if (k.size() != 1) {
+              fail_shape_inference("K input must be a one-dimensional tensor of size 1.");
+            }
+            output_shape.mutable_dim(static_cast<int>(axis))->set_dim_value(k[0]);
+          } else {
+            output_shape.mutable_dim(static_cast<int>(axis))->clear_dim_value();
+          }
+
+          updateOutputShape(ctx, 0, output_shape);
+          updateOutputShape(ctx, 1, output_shape);
+        }));
+
 // Used to be ONNX 1.7 Inverse(12)
 // Comment out docs not to increase the binary size
 //
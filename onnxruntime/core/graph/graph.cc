@@ -19,6 +19,7 @@
 #include "core/providers/common.h"
 #include "core/flatbuffers/flatbuffers_utils.h"
 #include "core/framework/error_code_helper.h"
+#include "core/framework/murmurhash3.h"
 #include "core/framework/tensor_type_and_shape.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "core/framework/tensor_external_data_info.h"
@@ -992,6 +993,7 @@ void Node::CreateSubgraph(const std::string& attr_name) {
 
 void Node::AddAttributeProto(AttributeProto value) {
   utils::SetNodeAttribute(std::move(value), attributes_);
+  resolve_fingerprint_ = 0;
   if (graph_) {
     graph_->SetGraphResolveNeeded();
     graph_->SetGraphProtoSyncNeeded();
@@ -1042,6 +1044,7 @@ void Node::AddAttribute(std::string attr_name, GraphProto value) {
 bool Node::ClearAttribute(const std::string& attr_name) {
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
+  resolve_fingerprint_ = 0;
   return attributes_.erase(attr_name) > 0;
 }
 
@@ -3469,6 +3472,30 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
     lsc.output_names.insert(std::string(input));
   }
 
+  // in an incremental resolve type/shape inferencing is skipped for nodes whose fingerprint hasn't changed since it
+  // last ran, unless an input is produced by a node that was re-run and has propagated shape values, or is an
+  // initializer that changed.
+  const bool incremental = incremental_resolve_ && parent_graph_ == nullptr && !options.override_types;
+  std::string fingerprint_buffer;
+  InlinedHashSet<const NodeArg*> args_with_updated_values;
+  size_t num_nodes_inferred = 0;
+
+  auto needs_inferencing = [&](const Node& node) {
+    if (node.resolve_fingerprint_ == 0 || node.ContainsSubgraph() ||
+        node.resolve_fingerprint_ != ComputeResolveFingerprint(node, fingerprint_buffer)) {
+      return true;
+    }
+
+    for (const auto* input : node.InputDefs()) {
+      if (args_with_updated_values.count(input) != 0 ||
+          initializers_changed_since_resolve_.count(input->Name()) != 0) {
+        return true;
+      }
+    }
+
+    return false;
+  };
+
   for (auto node_index : nodes_in_topological_order_) {
     // Node verification.
     auto& node = *GetNode(node_index);
@@ -3558,7 +3585,31 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
       }
     }
 
-    NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
+    if (!incremental) {
+      NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
+    } else if (needs_inferencing(node)) {
+      // values propagated by a previous run are replaced by this one. an output whose values are cleared counts as
+      // updated too, so its consumers don't keep shapes inferred from the stale values.
+      for (auto* output : node.definitions_.output_defs) {
+        if (output->inferred_shape_values_.has_value() || output->inferred_scalar_value_.has_value()) {
+          args_with_updated_values.insert(output);
+        }
+        output->inferred_shape_values_.reset();
+        output->inferred_scalar_value_.reset();
+      }
+
+      NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
+      ++num_nodes_inferred;
+
+      for (const auto* output : node.OutputDefs()) {
+        if (output->inferred_shape_values_.has_value() || output->inferred_scalar_value_.has_value()) {
+          args_with_updated_values.insert(output);
+        }
+      }
+
+      // the output types are part of the fingerprint so it's computed after inferencing updates them
+      node.resolve_fingerprint_ = ComputeResolveFingerprint(node, fingerprint_buffer);
+    }
 
     // Accumulate output names of the iterated Node
     for (const auto& output : node.OutputDefs()) {
@@ -3575,11 +3626,91 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
     }
   }
 
-  ORT_RETURN_IF_ERROR(CleanUpShapeValuesFromDataPropagation());
+  if (incremental) {
+    // propagated shape values are kept so nodes downstream of unchanged producers can use them in later resolves.
+    // they're released by SetIncrementalResolve(false).
+    LOGS(logger_, VERBOSE) << "Incremental resolve ran type/shape inferencing for " << num_nodes_inferred << " of "
+                           << nodes_in_topological_order_.size() << " nodes.";
+  } else {
+    ORT_RETURN_IF_ERROR(CleanUpShapeValuesFromDataPropagation());
+
+    if (incremental_resolve_) {
+      // the next incremental resolve can't rely on the released values
+      for (auto& node : Nodes()) {
+        node.resolve_fingerprint_ = 0;
+      }
+    }
+  }
 
   return Status::OK();
 }
 
+uint64_t Graph::ComputeResolveFingerprint(const Node& node, std::string& buffer) const {
+  buffer.clear();
+
+  auto append = [&buffer](const auto& value) {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+
+  auto append_def = [&](const NodeArg* def) {
+    append(def);
+    if (def != nullptr && def->Exists()) {
+      const TypeProto* type = def->TypeAsProto();
+      if (type != nullptr) {
+        std::string serialized = type->SerializeAsString();
+        append(serialized.size());
+        buffer += serialized;
+      } else {
+        append(size_t{0});
+      }
+    }
+  };
+
+  append(node.Op());
+  append(node.SinceVersion());
+  append(node.InputDefs().size());
+  for (const auto* def : node.InputDefs()) {
+    append_def(def);
+  }
+
+  append(node.InputArgCount().size());
+  for (int count : node.InputArgCount()) {
+    append(count);
+  }
+
+  append(node.OutputDefs().size());
+  for (const auto* def : node.OutputDefs()) {
+    append_def(def);
+  }
+
+  uint32_t hash[4] = {0, 0, 0, 0};
+  MurmurHash3::x86_128(buffer.data(), buffer.size(), hash[0], &hash);
+  uint64_t fingerprint = (uint64_t(hash[1]) << 32) | hash[0];
+
+  // 0 means no fingerprint
+  return fingerprint != 0 ? fingerprint : 1;
+}
+
+void Graph::SetIncrementalResolve(bool enable) {
+  ORT_ENFORCE(parent_graph_ == nullptr, "Incremental resolve can only be enabled for the main graph.");
+
+  // fingerprints from a previous incremental resolve may not match the current state of the NodeArgs as propagated
+  // values are released when not running incrementally, so start from a full resolve.
+  for (auto& node : Nodes()) {
+    node.resolve_fingerprint_ = 0;
+
+    if (incremental_resolve_ && !enable) {
+      for (auto* output : node.definitions_.output_defs) {
+        output->inferred_shape_values_.reset();
+        output->inferred_scalar_value_.reset();
+      }
+    }
+  }
+
+  initializers_changed_since_resolve_.clear();
+  incremental_resolve_ = enable;
+}
+
 Status Graph::CleanUpShapeValuesFromDataPropagation() {
   for (auto node_index : nodes_in_topological_order_) {
     auto& node = *GetNode(node_index);
@@ -3722,6 +3853,7 @@ Status Graph::Resolve(const ResolveOptions& options) {
 
             graph.CleanUnusedInitializersAndNodeArgs(options.initializer_names_to_preserve);
             graph.GraphResolveNeeded(false);
+            graph.initializers_changed_since_resolve_.clear();
 
             // if we are resolving immediately after loading from a GraphProto, we don't need to
             // do a proto sync
@@ -3855,6 +3987,12 @@ void Graph::AddInitializedTensor(const TensorProto& tensor) {
     ORT_IGNORE_RETURN_VALUE(GetOrCreateNodeArg(tensor.name(), &t));
   }
 
+#if !defined(ORT_MINIMAL_BUILD)
+  if (incremental_resolve_) {
+    initializers_changed_since_resolve_.insert(tensor.name());
+  }
+#endif
+
   SetGraphResolveNeeded();
 }
 
@@ -3887,6 +4025,12 @@ Status Graph::AddInitializedOrtValue(const ONNX_NAMESPACE::TensorProto& tensor_p
                 "Stray leftover ort_value for a small initializer being inserted.");
   }
 
+#if !defined(ORT_MINIMAL_BUILD)
+  if (incremental_resolve_) {
+    initializers_changed_since_resolve_.insert(tensor_proto.name());
+  }
+#endif
+
   SetGraphResolveNeeded();
   if (!is_loaded_from_model_file_ && GetNodeArg(tensor_proto.name()) == nullptr) {
     // make sure there is a NodeArg for the initializer as SetGraphInputsOutputs may add it to the graph inputs.
@@ -3984,6 +4128,12 @@ void Graph::RemoveInitializedTensor(const std::string& tensor_name) {
     // doesn't matter if it existed or not
     ORT_IGNORE_RETURN_VALUE(ortvalue_initializers_.erase(tensor_name));
 
+#if !defined(ORT_MINIMAL_BUILD)
+    if (incremental_resolve_) {
+      initializers_changed_since_resolve_.insert(tensor_name);
+    }
+#endif
+
     SetGraphResolveNeeded();
   } else {
 #if !defined(DISABLE_SPARSE_TENSORS)
@@ -4068,6 +4218,10 @@ Status Graph::ReplaceInitializedTensorImpl(ONNX_NAMESPACE::TensorProto new_initi
     sparse_tensor_names_.insert((**existing_entry).name());
   }
 
+  if (incremental_resolve_) {
+    initializers_changed_since_resolve_.insert((**existing_entry).name());
+  }
+
   return Status::OK();
 }
 
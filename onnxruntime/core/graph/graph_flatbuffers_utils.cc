@@ -67,6 +67,11 @@ Status SaveInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
       ORT_RETURN_IF_ERROR(external_writer(src_type, unpacked_tensor, offset));
       external_data_offset = onnxruntime::narrow<int64_t>(offset);  // offset in fb is int64_t so -1 can mark not in use
     } else {
+      // align data that may be used in place when loading so that kernels can use it directly
+      if (unpacked_tensor.size() > onnxruntime::utils::kSmallTensorExternalDataThreshold) {
+        builder.ForceVectorAlignment(unpacked_tensor.size(), sizeof(uint8_t), kInitializerAlignment);
+      }
+
       raw_data = builder.CreateVector(unpacked_tensor.data(), unpacked_tensor.size());
     }
   }
@@ -308,9 +313,11 @@ Status LoadInitializerOrtFormat(const fbs::Tensor& fbs_tensor, TensorProto& init
   } else {
     const auto* fbs_raw_data = fbs_tensor.raw_data();
     if (fbs_raw_data) {
-      if (load_options.can_use_flatbuffer_for_initializers && fbs_raw_data->size() > 127) {
+      const void* data_offset = fbs_raw_data->Data();
+      if (load_options.can_use_flatbuffer_for_initializers &&
+          fbs_raw_data->size() > onnxruntime::utils::kSmallTensorExternalDataThreshold &&
+          reinterpret_cast<uintptr_t>(data_offset) % load_options.initializer_alignment == 0) {
         static_assert(sizeof(void*) <= sizeof(ExternalDataInfo::OFFSET_TYPE));
-        const void* data_offset = fbs_raw_data->Data();
         // we reinterpret_cast this back to void* in tensorprotoutils.cc:GetExtDataFromTensorProto.
         // use intptr_t as OFFSET_TYPE is signed. in theory you could get a weird looking value if the address uses the
         // high bit, but that should be unlikely in a scenario where we care about memory usage enough to use this path.
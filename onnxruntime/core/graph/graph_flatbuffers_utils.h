@@ -61,6 +61,13 @@ using ExternalDataReader = std::function<Status(uint64_t offset, gsl::span<uint8
 /// </remarks>
 constexpr uint32_t kMinimumSizeForExternalData = 64;
 
+/// <summary>
+/// Alignment of the raw data of initializers that can be used in place from the flatbuffer.
+/// </summary>
+/// <remarks>The alignment is relative to the start of the flatbuffer, so it holds for a memory mapped ORT format model
+/// file or a buffer that is aligned to at least this value.</remarks>
+constexpr size_t kInitializerAlignment = 64;
+
 /// <summary>
 /// Save an initializer to an ORT format flatbuffer.
 /// </summary>
@@ -9,6 +9,7 @@
 #include "core/graph/model.h"
 #include "core/graph/model_editor_api_types.h"
 #include "core/graph/model_load_utils.h"
+#include "core/graph/streaming_model_loader.h"
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -784,7 +785,11 @@ Status Model::Load(int fd, const PathString& model_path, std::shared_ptr<Model>&
                    const ModelOptions& options) {
   ModelProto model_proto;
 
-  ORT_RETURN_IF_ERROR(Load(fd, model_proto));
+  if (options.stream_initializers_from_file && !model_path.empty()) {
+    ORT_RETURN_IF_ERROR(model_load_utils::LoadModelProtoStreaming(model_path, model_proto));
+  } else {
+    ORT_RETURN_IF_ERROR(Load(fd, model_proto));
+  }
 
   p_model = std::make_shared<Model>(std::move(model_proto), model_path, local_registries, logger, options);
 
@@ -41,6 +41,11 @@ struct ModelOptions {
 
   CheckLoadCancellationFn check_load_cancellation_fn;
 
+  // If true, a model loaded from a file leaves the raw data of the main graph's initializers in the file and
+  // references it as external data instead of reading it into the ModelProto.
+  // See model_load_utils::LoadModelProtoStreaming.
+  bool stream_initializers_from_file = false;
+
   ModelOptions(bool allow_released_opsets_only, bool strict_shape_type_inference,
                CheckLoadCancellationFn check_load_cancellation_fn)
       : allow_released_opsets_only(allow_released_opsets_only),
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 namespace onnxruntime {
 
 /// Options to configure how an ORT format model is loaded.
@@ -11,6 +13,10 @@ struct OrtFormatLoadOptions {
   /// This requires the flatbuffer to remain valid for the entire duration of the InferenceSession.
   bool can_use_flatbuffer_for_initializers{true};
 
+  /// Required alignment of initializer data used in place when can_use_flatbuffer_for_initializers is true.
+  /// Data that is not aligned is copied.
+  size_t initializer_alignment{1};
+
   /// If true, do not load any saved runtime optimizations.
   bool ignore_saved_runtime_optimizations{false};
 };
@@ -0,0 +1,226 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/graph/streaming_model_loader.h"
+
+#include <climits>
+#include <optional>
+
+#include "google/protobuf/io/coded_stream.h"
+
+#include "core/common/narrow.h"
+#include "core/framework/tensor_external_data_info.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+namespace model_load_utils {
+
+#if !defined(__wasm__)
+namespace {
+
+// field numbers from onnx.proto
+constexpr uint32_t kModelProtoGraph = 7;
+constexpr uint32_t kGraphProtoInitializer = 5;
+constexpr uint32_t kTensorProtoRawData = 9;
+
+enum class WireType : uint32_t {
+  kVarint = 0,
+  kFixed64 = 1,
+  kLengthDelimited = 2,
+  kStartGroup = 3,
+  kEndGroup = 4,
+  kFixed32 = 5,
+};
+
+struct WireField {
+  uint32_t number;
+  WireType wire_type;
+  const uint8_t* begin;  // start of the tag
+  const uint8_t* value;  // start of the payload of a length-delimited field
+  size_t value_size;     // size of the payload of a length-delimited field
+  const uint8_t* end;    // end of the field
+};
+
+// Minimal reader of the protobuf wire format. Only splits a message into its fields; payloads are not decoded.
+class WireReader {
+ public:
+  WireReader(const uint8_t* begin, const uint8_t* end) : pos_(begin), end_(end) {}
+
+  bool AtEnd() const { return pos_ == end_; }
+
+  Status Next(WireField& field) {
+    field.begin = pos_;
+    uint64_t tag = 0;
+    ORT_RETURN_IF_ERROR(ReadVarint(tag));
+    field.number = static_cast<uint32_t>(tag >> 3);
+    field.wire_type = static_cast<WireType>(tag & 0x7);
+    field.value = nullptr;
+    field.value_size = 0;
+    ORT_RETURN_IF(field.number == 0, "Invalid field number in model file.");
+
+    switch (field.wire_type) {
+      case WireType::kVarint: {
+        uint64_t unused = 0;
+        ORT_RETURN_IF_ERROR(ReadVarint(unused));
+        break;
+      }
+      case WireType::kFixed64:
+        ORT_RETURN_IF_ERROR(Skip(8));
+        break;
+      case WireType::kFixed32:
+        ORT_RETURN_IF_ERROR(Skip(4));
+        break;
+      case WireType::kLengthDelimited: {
+        uint64_t size = 0;
+        ORT_RETURN_IF_ERROR(ReadVarint(size));
+        field.value = pos_;
+        field.value_size = narrow<size_t>(size);
+        ORT_RETURN_IF_ERROR(Skip(field.value_size));
+        break;
+      }
+      default:
+        // groups are not used by onnx.proto
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_PROTOBUF, "Unsupported wire type ",
+                               static_cast<uint32_t>(field.wire_type), " for field ", field.number,
+                               " in model file.");
+    }
+
+    field.end = pos_;
+    return Status::OK();
+  }
+
+ private:
+  Status ReadVarint(uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      ORT_RETURN_IF(pos_ == end_, "Truncated varint in model file.");
+      const uint8_t byte = *pos_++;
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        return Status::OK();
+      }
+    }
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_PROTOBUF, "Malformed varint in model file.");
+  }
+
+  Status Skip(size_t size) {
+    ORT_RETURN_IF(static_cast<size_t>(end_ - pos_) < size, "Truncated field in model file.");
+    pos_ += size;
+    return Status::OK();
+  }
+
+  const uint8_t* pos_;
+  const uint8_t* end_;
+};
+
+// Merges the serialized fields in [begin, end) into message.
+Status MergeFields(const uint8_t* begin, const uint8_t* end, google::protobuf::MessageLite& message) {
+  if (begin == end) {
+    return Status::OK();
+  }
+
+  const size_t size = static_cast<size_t>(end - begin);
+  ORT_RETURN_IF(size > static_cast<size_t>(INT_MAX), "A ", message.GetTypeName(),
+                " in the model file exceeds the 2GB protobuf limit without its initializers.");
+
+  google::protobuf::io::CodedInputStream input(begin, static_cast<int>(size));
+  ORT_RETURN_IF_NOT(message.MergeFromCodedStream(&input) && input.ConsumedEntireMessage(),
+                    "Protobuf parsing failed.");
+  return Status::OK();
+}
+
+// Calls handle_field for each field of the message in [begin, end) with the given number, and merges runs of the other
+// fields into message.
+template <typename HandleField>
+Status SplitMessage(const uint8_t* begin, const uint8_t* end, uint32_t field_number,
+                    google::protobuf::MessageLite& message, HandleField handle_field) {
+  WireReader reader(begin, end);
+  const uint8_t* run_begin = begin;
+  WireField field;
+  while (!reader.AtEnd()) {
+    ORT_RETURN_IF_ERROR(reader.Next(field));
+    if (field.number == field_number) {
+      ORT_RETURN_IF(field.wire_type != WireType::kLengthDelimited, "Unexpected wire type for field ", field_number,
+                    " of ", message.GetTypeName(), " in model file.");
+      ORT_RETURN_IF_ERROR(MergeFields(run_begin, field.begin, message));
+      ORT_RETURN_IF_ERROR(handle_field(field));
+      run_begin = field.end;
+    }
+  }
+
+  return MergeFields(run_begin, end, message);
+}
+
+}  // namespace
+#endif  // !defined(__wasm__)
+
+Status LoadModelProtoStreaming(const std::filesystem::path& model_path, ONNX_NAMESPACE::ModelProto& model_proto) {
+#if defined(__wasm__)
+  // external data is loaded from the files mounted by the JS side in WebAssembly builds, which doesn't include the
+  // model file.
+  ORT_UNUSED_PARAMETER(model_path);
+  ORT_UNUSED_PARAMETER(model_proto);
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Streaming model load is not supported in WebAssembly builds.");
+#else
+  const Env& env = Env::Default();
+
+  size_t file_length = 0;
+  ORT_RETURN_IF_ERROR(env.GetFileLength(model_path.native().c_str(), file_length));
+  ORT_RETURN_IF(file_length == 0, "Model file ", model_path.string(), " is empty.");
+
+  Env::MappedMemoryPtr mapped_file;
+  ORT_RETURN_IF_ERROR(env.MapFileIntoMemory(model_path.native().c_str(), 0, file_length, mapped_file));
+
+  const auto* file_begin = reinterpret_cast<const uint8_t*>(mapped_file.get());
+  const auto* file_end = file_begin + file_length;
+
+  // external data locations are relative to the model directory
+  const std::filesystem::path location = model_path.filename();
+
+  model_proto.Clear();
+  ONNX_NAMESPACE::GraphProto* graph = nullptr;
+
+  auto handle_initializer = [&](const WireField& initializer_field) -> Status {
+    auto* initializer = graph->add_initializer();
+    std::optional<WireField> raw_data;
+    ORT_RETURN_IF_ERROR(SplitMessage(
+        initializer_field.value, initializer_field.value + initializer_field.value_size, kTensorProtoRawData,
+        *initializer, [&raw_data](const WireField& field) {
+          // for a repeated bytes field the last value wins
+          raw_data = field;
+          return Status::OK();
+        }));
+
+    if (!raw_data.has_value()) {
+      return Status::OK();
+    }
+
+    if (raw_data->value_size > utils::kSmallTensorExternalDataThreshold && initializer->external_data_size() == 0) {
+      ExternalDataInfo::SetExternalLocationToProto(location, narrow<int64_t>(raw_data->value - file_begin),
+                                                   raw_data->value_size, *initializer);
+    } else {
+      initializer->set_raw_data(raw_data->value, raw_data->value_size);
+    }
+
+    return Status::OK();
+  };
+
+  auto handle_graph = [&](const WireField& graph_field) -> Status {
+    graph = model_proto.mutable_graph();
+    return SplitMessage(graph_field.value, graph_field.value + graph_field.value_size, kGraphProtoInitializer,
+                        *graph, handle_initializer);
+  };
+
+  ORT_RETURN_IF_ERROR(SplitMessage(file_begin, file_end, kModelProtoGraph, model_proto, handle_graph));
+
+  return Status::OK();
+#endif
+}
+
+}  // namespace model_load_utils
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -0,0 +1,35 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include <filesystem>
+
+#include "core/common/common.h"
+#include "core/graph/onnx_protobuf.h"
+
+namespace onnxruntime {
+namespace model_load_utils {
+
+/**
+Loads the ModelProto in the file at model_path without copying the raw data of the main graph's initializers.
+
+The file is memory mapped and walked at the protobuf wire format level. Everything except the initializers of the main
+graph is parsed as usual. An initializer whose raw_data is larger than utils::kSmallTensorExternalDataThreshold is
+parsed without it and is changed to reference the location of the raw_data in the model file as external data, so the
+bytes are only read from the file when the initializer is loaded. Smaller raw_data is copied into the TensorProto.
+
+Peak memory while loading is the size of the non-initializer part of the model instead of the size of the whole
+model, and models larger than the 2GB protobuf limit can be loaded as long as no single message other than the main
+graph and the model exceeds it.
+
+Initializers in subgraphs, sparse initializers and tensors in node attributes are parsed inline.
+*/
+Status LoadModelProtoStreaming(const std::filesystem::path& model_path, ONNX_NAMESPACE::ModelProto& model_proto);
+
+}  // namespace model_load_utils
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -0,0 +1,270 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/elementwise_fusion.h"
+
+#include <algorithm>
+#include <array>
+#include <queue>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+// Operators supported by the FusedElementwise kernel.
+bool IsFusableOp(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sub", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Exp", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Log", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Neg", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Abs", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sqrt", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Reciprocal", {6, 13});
+}
+
+bool IsFloatTensorWithShape(const NodeArg& arg) {
+  const TypeProto* type = arg.TypeAsProto();
+  return arg.Exists() && type != nullptr && type->has_tensor_type() &&
+         type->tensor_type().elem_type() == TensorProto_DataType_FLOAT && arg.Shape() != nullptr;
+}
+
+bool IsDimEqual(const TensorShapeProto_Dimension& a, const TensorShapeProto_Dimension& b) {
+  if (utils::HasDimValue(a) && utils::HasDimValue(b)) {
+    return a.dim_value() == b.dim_value();
+  }
+  return utils::HasDimParam(a) && utils::HasDimParam(b) && a.dim_param() == b.dim_param();
+}
+
+bool IsSameShape(const TensorShapeProto& a, const TensorShapeProto& b) {
+  if (a.dim_size() != b.dim_size()) {
+    return false;
+  }
+
+  for (int i = 0; i < a.dim_size(); ++i) {
+    if (!IsDimEqual(a.dim(i), b.dim(i))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Whether the shape is a suffix of output_shape optionally preceded by dims of 1, so that a tensor with this shape
+// repeats along a tensor with output_shape.
+bool IsRepeatedSuffix(const TensorShapeProto& shape, const TensorShapeProto& output_shape) {
+  const int offset = output_shape.dim_size() - shape.dim_size();
+  if (offset < 0) {
+    return false;
+  }
+
+  int i = 0;
+  while (i < shape.dim_size() && utils::HasDimValue(shape.dim(i)) && shape.dim(i).dim_value() == 1) {
+    ++i;
+  }
+
+  for (; i < shape.dim_size(); ++i) {
+    if (!IsDimEqual(shape.dim(i), output_shape.dim(offset + i))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
+Status ElementwiseFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                    const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::vector<size_t> topological_position(graph.MaxNodeIndex(), 0);
+  for (size_t i = 0; i < node_topology_list.size(); ++i) {
+    auto* node = graph.GetNode(node_topology_list[i]);
+    if (!node) continue;
+
+    ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
+    topological_position[node_topology_list[i]] = i;
+  }
+
+  auto can_fuse = [&](const Node& node) {
+    if (!IsFusableOp(node) || !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      return false;
+    }
+
+    // leave the consumers of NCHWc tensors to NchwcTransformer, which fuses them into the NCHWc operators
+    for (auto edge = node.InputEdgesBegin(), edge_end = node.InputEdgesEnd(); edge != edge_end; ++edge) {
+      if (edge->GetNode().Domain() == kMSNchwcDomain) {
+        return false;
+      }
+    }
+
+    for (const auto* input : node.InputDefs()) {
+      if (!IsFloatTensorWithShape(*input)) {
+        return false;
+      }
+    }
+    return IsFloatTensorWithShape(*node.OutputDefs()[0]);
+  };
+
+  // nodes created by this transformer have indexes past the end and are never part of a group
+  std::vector<bool> in_group(graph.MaxNodeIndex(), false);
+  auto is_in_group = [&in_group](NodeIndex index) { return index < in_group.size() && in_group[index]; };
+
+  // visit the nodes in reverse topological order so that each group is grown from the last node of a chain and
+  // includes as many of its producers as possible.
+  for (auto it = node_topology_list.rbegin(), end = node_topology_list.rend(); it != end; ++it) {
+    Node* root = graph.GetNode(*it);
+    if (root == nullptr || is_in_group(root->Index()) || !can_fuse(*root)) {
+      continue;
+    }
+
+    const TensorShapeProto& output_shape = *root->OutputDefs()[0]->Shape();
+    auto inputs_repeat = [&output_shape](const Node& node) {
+      for (const auto* input : node.InputDefs()) {
+        if (!IsRepeatedSuffix(*input->Shape(), output_shape)) {
+          return false;
+        }
+      }
+      return true;
+    };
+
+    if (!inputs_repeat(*root)) {
+      continue;
+    }
+
+    // grow the group through producers whose output is only consumed inside the group. candidates are visited in
+    // reverse topological order so all the consumers of a candidate are decided before the candidate.
+    InlinedVector<Node*> group{root};
+    in_group[root->Index()] = true;
+    std::priority_queue<std::pair<size_t, NodeIndex>> candidates;
+    auto add_producers = [&](const Node& node) {
+      for (auto edge = node.InputEdgesBegin(), edge_end = node.InputEdgesEnd(); edge != edge_end; ++edge) {
+        const Node& producer = edge->GetNode();
+        if (!is_in_group(producer.Index()) && can_fuse(producer)) {
+          candidates.emplace(topological_position[producer.Index()], producer.Index());
+        }
+      }
+    };
+
+    add_producers(*root);
+    while (!candidates.empty()) {
+      const NodeIndex index = candidates.top().second;
+      candidates.pop();
+      if (in_group[index]) {
+        continue;
+      }
+
+      // a producer with a smaller output than the group would be evaluated again for every element it's repeated
+      // to, so only producers of the output shape are fused.
+      Node& producer = *graph.GetNode(index);
+      if (graph.NodeProducesGraphOutput(producer) ||
+          !IsSameShape(*producer.OutputDefs()[0]->Shape(), output_shape) || !inputs_repeat(producer)) {
+        continue;
+      }
+
+      bool consumed_in_group = true;
+      for (auto edge = producer.OutputEdgesBegin(), edge_end = producer.OutputEdgesEnd(); edge != edge_end; ++edge) {
+        if (!is_in_group(edge->GetNode().Index())) {
+          consumed_in_group = false;
+          break;
+        }
+      }
+
+      if (!consumed_in_group) {
+        continue;
+      }
+
+      in_group[index] = true;
+      group.push_back(&producer);
+      add_producers(producer);
+    }
+
+    if (group.size() < 2) {
+      in_group[root->Index()] = false;
+      continue;
+    }
+
+    // the group was collected in reverse topological order
+    std::reverse(group.begin(), group.end());
+
+    InlinedHashMap<const NodeArg*, int64_t> step_of_output;
+    for (size_t i = 0; i < group.size(); ++i) {
+      step_of_output[group[i]->OutputDefs()[0]] = static_cast<int64_t>(i);
+    }
+
+    InlinedVector<NodeArg*> fused_inputs;
+    InlinedHashMap<const NodeArg*, int64_t> fused_input_index;
+    for (Node* node : group) {
+      for (NodeArg* input : node->MutableInputDefs()) {
+        if (step_of_output.count(input) == 0 && fused_input_index.count(input) == 0) {
+          fused_input_index[input] = static_cast<int64_t>(fused_inputs.size());
+          fused_inputs.push_back(input);
+        }
+      }
+    }
+
+    const auto num_inputs = static_cast<int64_t>(fused_inputs.size());
+    std::vector<std::string> operations;
+    std::vector<int64_t> operands;
+    for (Node* node : group) {
+      operations.push_back(node->OpType());
+      for (const NodeArg* input : node->InputDefs()) {
+        auto step = step_of_output.find(input);
+        operands.push_back(step != step_of_output.end() ? num_inputs + step->second : fused_input_index[input]);
+      }
+      if (node->InputDefs().size() == 1) {
+        operands.push_back(-1);
+      }
+    }
+
+    // edges from producers outside of the group, keyed by the input of the fused node
+    InlinedHashMap<int64_t, std::pair<NodeIndex, int>> input_edges;
+    for (Node* node : group) {
+      auto edges = graph_utils::GraphEdge::GetNodeInputEdges(*node);
+      for (const auto& edge : edges) {
+        if (!is_in_group(edge.src_node)) {
+          const int64_t input_index = fused_input_index[node->InputDefs()[edge.dst_arg_index]];
+          input_edges.emplace(input_index, std::make_pair(edge.src_node, edge.src_arg_index));
+        }
+      }
+      graph_utils::GraphEdge::RemoveGraphEdges(graph, edges);
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName(root->Name() + "/ElementwiseFusion/"), "FusedElementwise",
+                                     "fused element-wise operators", fused_inputs,
+                                     std::array{root->MutableOutputDefs()[0]}, nullptr, kMSDomain);
+    fused_node.AddAttribute("operations", operations);
+    fused_node.AddAttribute("operands", operands);
+    fused_node.SetExecutionProviderType(root->GetExecutionProviderType());
+
+    InlinedVector<std::reference_wrapper<Node>> nodes_to_fuse;
+    for (Node* node : group) {
+      nodes_to_fuse.emplace_back(*node);
+    }
+    graph_utils::FinalizeNodeFusion(graph, nodes_to_fuse, fused_node);
+
+    for (const auto& [input_index, src] : input_edges) {
+      graph.AddEdge(src.first, fused_node.Index(), src.second, static_cast<int>(input_index));
+    }
+
+    LOGS(logger, VERBOSE) << "Fused " << group.size() << " element-wise nodes into " << fused_node.Name();
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ElementwiseFusion
+
+Rewrite maximal subgraphs of float element-wise operators (Add, Sub, Mul, Div, Relu, Sigmoid, Tanh, Exp, Log, Neg,
+Abs, Sqrt, Reciprocal) with a single output to a com.microsoft.FusedElementwise node, which evaluates them in one pass
+over the output instead of reading and writing a full tensor per operator.
+
+Each input of the subgraph must broadcast to the output by repeating, i.e. its shape is a suffix of the output shape
+optionally preceded by dims of 1. This covers scalars, biases and tensors of the output shape. Every operator in the
+subgraph produces a tensor of the output shape, as a broadcast intermediate would be recomputed for each element.
+
+Runs after the fusions into specific operators so those are preferred.
+*/
+class ElementwiseFusion : public GraphTransformer {
+ public:
+  ElementwiseFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ElementwiseFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/optimizer/graph_transformer_mgr.h"
+#include "core/common/profiler.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 
 #include <memory>
@@ -39,8 +40,29 @@ common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, Transfor
       if (step > 0 && transformer->ShouldOnlyApplyOnce())
         continue;
 
+      const bool profiling_enabled = profiler_ != nullptr && profiler_->IsEnabled();
+      TimePoint start_time;
+      const int num_nodes_before = graph.NumberOfNodes();
+      const NodeIndex max_node_index_before = graph.MaxNodeIndex();
+      if (profiling_enabled) {
+        start_time = profiler_->Start();
+      }
+
       bool modified = false;
       ORT_RETURN_IF_ERROR(transformer->Apply(graph, modified, logger));
+
+      if (profiling_enabled) {
+        // node indexes are not reused, so every node added has an index past the previous maximum
+        const size_t nodes_added = graph.MaxNodeIndex() - max_node_index_before;
+        const size_t nodes_removed = static_cast<size_t>(num_nodes_before) + nodes_added -
+                                     static_cast<size_t>(graph.NumberOfNodes());
+        profiler_->EndTimeAndRecordEvent(profiling::SESSION_EVENT, transformer->Name(), start_time,
+                                         {{"level", std::to_string(static_cast<int>(level))},
+                                          {"step", std::to_string(step)},
+                                          {"modified", modified ? "1" : "0"},
+                                          {"nodes_added", std::to_string(nodes_added)},
+                                          {"nodes_removed", std::to_string(nodes_removed)}});
+      }
       graph_changed = graph_changed || modified;
       _is_graph_modified = _is_graph_modified || modified;
     }
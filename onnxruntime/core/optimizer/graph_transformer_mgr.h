@@ -10,6 +10,9 @@
 #include "core/optimizer/rewrite_rule.h"
 
 namespace onnxruntime {
+namespace profiling {
+class Profiler;
+}
 
 // Manages a list of graph transformers. It is initialized with a list of graph
 // transformers. Each inference session can further register additional ones.
@@ -34,6 +37,12 @@ class GraphTransformerManager {
     return check_load_cancellation_fn_ && check_load_cancellation_fn_();
   }
 
+  // Record a SESSION_EVENT for each application of a transformer if profiler is enabled.
+  // The event args include the number of nodes the transformer added and removed.
+  void SetProfiler(profiling::Profiler* profiler) noexcept {
+    profiler_ = profiler;
+  }
+
   // Register a transformer with a level.
   common::Status Register(std::unique_ptr<GraphTransformer> transformer, TransformerLevel level);
 
@@ -54,6 +63,7 @@ class GraphTransformerManager {
   InlinedHashMap<TransformerLevel, InlinedVector<std::unique_ptr<GraphTransformer>>> level_to_transformer_map_;
   InlinedHashMap<std::string, GraphTransformer*> transformers_info_;
   CheckLoadCancellationFn check_load_cancellation_fn_;
+  profiling::Profiler* profiler_ = nullptr;
   mutable bool _is_graph_modified = false;
 };
 }  // namespace onnxruntime
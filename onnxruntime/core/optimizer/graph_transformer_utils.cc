@@ -38,6 +38,7 @@
 #include "core/optimizer/double_qdq_pairs_remover.h"
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/elementwise_fusion.h"
 #include "core/optimizer/embed_layer_norm_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
@@ -81,6 +82,7 @@
 #include "core/optimizer/rule_based_graph_transformer.h"
 #include "core/optimizer/skip_layer_norm_fusion.h"
 #include "core/optimizer/slice_elimination.h"
+#include "core/optimizer/softmax_topk_fusion.h"
 #include "core/optimizer/transpose_optimizer.h"
 #include "core/optimizer/unsqueeze_elimination.h"
 #ifdef ENABLE_TRAINING
@@ -404,6 +406,8 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       }
 #endif  // ENABLE_TRITON
 
+      // SoftmaxTopKFusion runs before BiasSoftmaxFusion, as avoiding the Softmax output saves more than fusing its bias.
+      transformers.emplace_back(std::make_unique<SoftmaxTopKFusion>(cpu_ep));
       transformers.emplace_back(std::make_unique<BiasSoftmaxFusion>(cpu_cuda_eps));
       transformers.emplace_back(std::make_unique<BiasDropoutFusion>(cuda_eps));
 #ifdef ENABLE_TRAINING
@@ -450,6 +454,10 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       // PR #6351 implemented similar fusion-pattern for CUDA only, and can only fuse conv-add-relu,
       // while we can fuse more activation.
       transformers.emplace_back(std::make_unique<ConvAddActivationFusion>(cpu_ep));
+
+      // ElementwiseFusion runs last so that it only fuses the element-wise operators that none of the fusions into
+      // specific operators, including the NCHWc and Conv ones above, have consumed.
+      transformers.emplace_back(std::make_unique<ElementwiseFusion>(cpu_ep));
 #else
       ORT_UNUSED_PARAMETER(logger);
 #endif
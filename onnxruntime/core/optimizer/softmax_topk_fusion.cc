@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/softmax_topk_fusion.h"
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+#include "core/providers/common.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+int64_t GetIntAttribute(const Node& node, const std::string& name, int64_t default_value) {
+  const auto* attr = graph_utils::GetNodeAttribute(node, name);
+  return attr != nullptr && utils::HasInt(*attr) ? attr->i() : default_value;
+}
+
+}  // namespace
+
+Status SoftmaxTopKFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                    const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (!p_node) continue;
+
+    Node& softmax_node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(softmax_node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(softmax_node, "Softmax", {1, 11, 13}) ||
+        !graph_utils::IsSupportedProvider(softmax_node, GetCompatibleExecutionProviders()) ||
+        softmax_node.GetOutputEdgesCount() != 1 || graph.NodeProducesGraphOutput(softmax_node)) {
+      continue;
+    }
+
+    NodeArg* input = softmax_node.MutableInputDefs()[0];
+    const auto* input_type = input->TypeAsProto();
+    if (input_type == nullptr || input_type->tensor_type().elem_type() != TensorProto_DataType_FLOAT) {
+      continue;
+    }
+
+    Node& topk_node = *graph.GetNode(softmax_node.OutputNodesBegin()->Index());
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(topk_node, "TopK", {10, 11, 24}) ||
+        topk_node.GetExecutionProviderType() != softmax_node.GetExecutionProviderType() ||
+        topk_node.InputDefs()[0] != softmax_node.OutputDefs()[0]) {
+      continue;
+    }
+
+    // K is moved to the fused node, which only receives the input edges of Softmax.
+    NodeArg* k = topk_node.MutableInputDefs()[1];
+    if (graph_utils::GetConstantInitializer(graph, k->Name()) == nullptr) {
+      continue;
+    }
+
+    const int softmax_opset = softmax_node.SinceVersion();
+    int64_t softmax_axis = GetIntAttribute(softmax_node, "axis", softmax_opset >= 13 ? -1 : 1);
+    int64_t topk_axis = GetIntAttribute(topk_node, "axis", -1);
+    int64_t last_axis = -1;
+    if (input->Shape() != nullptr) {
+      const int64_t rank = input->Shape()->dim_size();
+      softmax_axis = HandleNegativeAxis(softmax_axis, rank);
+      topk_axis = HandleNegativeAxis(topk_axis, rank);
+      last_axis = rank - 1;
+    } else if (softmax_axis >= 0 || topk_axis >= 0) {
+      continue;
+    }
+
+    if (softmax_axis != topk_axis || (softmax_opset < 13 && softmax_axis != last_axis)) {
+      continue;
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName(topk_node.Name() + "/SoftmaxTopKFusion/"), "SoftmaxTopK",
+                                     "Fused Softmax and TopK", {input, k}, topk_node.MutableOutputDefs(), nullptr,
+                                     kMSDomain);
+    fused_node.AddAttribute("axis", topk_axis);
+    fused_node.AddAttribute("largest", GetIntAttribute(topk_node, "largest", 1));
+    fused_node.AddAttribute("sorted", GetIntAttribute(topk_node, "sorted", 1));
+    fused_node.SetExecutionProviderType(softmax_node.GetExecutionProviderType());
+
+    graph_utils::FinalizeNodeFusion(graph, {softmax_node, topk_node}, fused_node);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class SoftmaxTopKFusion
+
+Rewrite a float Softmax whose only consumer is a TopK along the same axis, with a constant K, to a
+com.microsoft.SoftmaxTopK node. The fused kernel selects the top K elements from the logits and normalizes only those,
+so the output of Softmax is never materialized.
+
+Before opset 13 Softmax normalizes over all the dims from its axis on, so the fusion requires the axis to be the last
+dim in that case.
+*/
+class SoftmaxTopKFusion : public GraphTransformer {
+ public:
+  SoftmaxTopKFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("SoftmaxTopKFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -466,9 +466,12 @@ Status IfImpl::Execute(const FeedsFetchesManager& ffm) {
     }
   }
 
+  // subgraphs are executed on the current thread so only the intra-op thread pool is used
+  const ExecutionThreadPools thread_pools{context_.GetOperatorThreadPool(), nullptr};
   status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, fetch_allocators,
                                   ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(),
-                                  context_.Logger(), context_.GetComputeStream());
+                                  context_.Logger(), context_.GetComputeStream(),
+                                  /*sync_subgraph_fetches*/ false, &thread_pools);
 
   ORT_RETURN_IF_ERROR(status);
 
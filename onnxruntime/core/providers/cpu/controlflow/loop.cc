@@ -533,6 +533,9 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
 
   CreateInitialFeeds(feeds);
 
+  // subgraphs are executed on the current thread so only the intra-op thread pool is used
+  const ExecutionThreadPools thread_pools{context_.GetOperatorThreadPool(), nullptr};
+
   auto& iter_num_value = *iter_num_mlvalue_.GetMutable<Tensor>()->MutableData<int64_t>();
 
   while (iter_num_value < max_trip_count_ && *condition_mlvalue_.GetMutable<Tensor>()->MutableData<bool>()) {
@@ -546,7 +549,8 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
                                     context_.GetComputeStream(),
                                     // because the fetch[0] is the loop condition which we need to access on CPU,
                                     // have to perofrm a stream sync to make sure the data arrived.
-                                    true);
+                                    true,
+                                    &thread_pools);
     ORT_RETURN_IF_ERROR(status);
 
     condition_mlvalue_ = fetches[0];
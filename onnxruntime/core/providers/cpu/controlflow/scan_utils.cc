@@ -202,6 +202,9 @@ Status IterateSequence(OpKernelContextInternal& context, const SessionState& ses
   feeds.resize(num_inputs);
   fetches.resize(num_variadic_outputs);
 
+  // subgraphs are executed on the current thread so only the intra-op thread pool is used
+  const ExecutionThreadPools thread_pools{context.GetOperatorThreadPool(), nullptr};
+
   // add implicit inputs and pass in implicit inputs as feeds. we're going to pass in the explicit inputs
   // first in each iteration though so offset by num_variadic_inputs
   for (size_t i = 0; i < num_implicit_inputs; ++i) {
@@ -272,7 +275,7 @@ Status IterateSequence(OpKernelContextInternal& context, const SessionState& ses
     // Create Executor and run graph.
     status = utils::ExecuteSubgraph(session_state, ffm, feeds, fetches, fetch_allocators,
                                     ExecutionMode::ORT_SEQUENTIAL, context.GetTerminateFlag(), context.Logger(),
-                                    context.GetComputeStream());
+                                    context.GetComputeStream(), /*sync_subgraph_fetches*/ false, &thread_pools);
 
     ORT_RETURN_IF_ERROR(status);
 
@@ -41,7 +41,8 @@ using Transpose = std::function<Status(const gsl::span<const size_t>& permutatio
 template <typename T>
 using MatMul = std::function<Status(const T* input_1_data, const T* input_2_data, T* output_data,
                                     size_t left_stride, size_t right_stride, size_t output_stride,
-                                    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+                                    size_t num_batches, size_t M, size_t K, size_t N,
+                                    bool transpose_left, bool transpose_right, concurrency::ThreadPool* tp,
                                     const void* mlas_backend_config,
                                     void* einsum_cuda_assets)>;
 
@@ -3,6 +3,8 @@
 
 #include "einsum_auxiliary_ops.h"
 
+#include "core/util/math_cpuonly.h"
+
 using namespace onnxruntime::common;
 
 namespace onnxruntime {
@@ -42,18 +44,70 @@ Status Transpose(const gsl::span<const size_t>& permutation, const Tensor& input
 template <typename T>
 Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
               size_t left_stride, size_t right_stride, size_t output_stride,
-              size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+              size_t num_batches, size_t M, size_t K, size_t N,
+              bool transpose_left, bool transpose_right, concurrency::ThreadPool* tp,
               const void* mlas_backend_config,
               void* /*einsum_cuda_assets*/) {
-  for (size_t i = 0; i < num_batches; ++i) {
-    math::MatMul<T>(
-        static_cast<int>(M),
-        static_cast<int>(N),
-        static_cast<int>(K),
-        input_1_data + i * left_stride,
-        input_2_data + i * right_stride,
-        output_data + i * output_stride, tp,
-        reinterpret_cast<const MLAS_BACKEND_KERNEL_SELECTOR_CONFIG*>(mlas_backend_config));
+  const auto* mlas_backend_kernel_selector_config =
+      reinterpret_cast<const MLAS_BACKEND_KERNEL_SELECTOR_CONFIG*>(mlas_backend_config);
+  const CBLAS_TRANSPOSE trans_a = transpose_left ? CblasTrans : CblasNoTrans;
+  const CBLAS_TRANSPOSE trans_b = transpose_right ? CblasTrans : CblasNoTrans;
+
+  if constexpr (std::is_same_v<T, float>) {
+    // A single batched call, so that the batches are also split across the threads of the pool
+    std::vector<MLAS_SGEMM_DATA_PARAMS> data(num_batches);
+    for (size_t i = 0; i < num_batches; ++i) {
+      data[i].A = input_1_data + i * left_stride;
+      data[i].lda = transpose_left ? M : K;
+      data[i].B = input_2_data + i * right_stride;
+      data[i].ldb = transpose_right ? K : N;
+      data[i].C = output_data + i * output_stride;
+      data[i].ldc = N;
+    }
+    MlasGemmBatch(trans_a, trans_b, M, N, K, data.data(), num_batches, tp, mlas_backend_kernel_selector_config);
+  } else if constexpr (std::is_same_v<T, double>) {
+    for (size_t i = 0; i < num_batches; ++i) {
+      math::Gemm<T, concurrency::ThreadPool>(trans_a, trans_b,
+                                             static_cast<ptrdiff_t>(M),
+                                             static_cast<ptrdiff_t>(N),
+                                             static_cast<ptrdiff_t>(K),
+                                             1.0,
+                                             input_1_data + i * left_stride,
+                                             input_2_data + i * right_stride,
+                                             0.0,
+                                             output_data + i * output_stride, tp,
+                                             mlas_backend_kernel_selector_config);
+    }
+  } else if (!transpose_left && !transpose_right) {
+    for (size_t i = 0; i < num_batches; ++i) {
+      math::MatMul<T>(
+          static_cast<int>(M),
+          static_cast<int>(N),
+          static_cast<int>(K),
+          input_1_data + i * left_stride,
+          input_2_data + i * right_stride,
+          output_data + i * output_stride, tp,
+          mlas_backend_kernel_selector_config);
+    }
+  } else {
+    // The row major matrices are column major matrices of the transposed shapes,
+    // so compute output^T = right^T * left^T with Eigen
+    const auto m = static_cast<ptrdiff_t>(M);
+    const auto k = static_cast<ptrdiff_t>(K);
+    const auto n = static_cast<ptrdiff_t>(N);
+    for (size_t i = 0; i < num_batches; ++i) {
+      const T* left = input_1_data + i * left_stride;
+      const T* right = input_2_data + i * right_stride;
+      auto output = EigenMatrixMap<T>(output_data + i * output_stride, n, m);
+      if (transpose_left && transpose_right) {
+        output.noalias() = ConstEigenMatrixMap<T>(right, k, n).transpose() *
+                           ConstEigenMatrixMap<T>(left, m, k).transpose();
+      } else if (transpose_left) {
+        output.noalias() = ConstEigenMatrixMap<T>(right, n, k) * ConstEigenMatrixMap<T>(left, m, k).transpose();
+      } else {
+        output.noalias() = ConstEigenMatrixMap<T>(right, k, n).transpose() * ConstEigenMatrixMap<T>(left, k, m);
+      }
+    }
   }
 
   return Status::OK();
@@ -269,7 +323,8 @@ std::unique_ptr<Tensor> Diagonal(const Tensor& input, int64_t dim_1, int64_t dim
 template Status DeviceHelpers::CpuDeviceHelpers::MatMul<float>(
     const float* input_1_data, const float* input_2_data, float* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N,
+    bool transpose_left, bool transpose_right, concurrency::ThreadPool* tp,
     const void* mlas_backend_config,
     void* einsum_cuda_assets);
 
@@ -283,7 +338,8 @@ template std::unique_ptr<Tensor> DeviceHelpers::CpuDeviceHelpers::ReduceSum<floa
 template Status DeviceHelpers::CpuDeviceHelpers::MatMul<int32_t>(
     const int32_t* input_1_data, const int32_t* input_2_data, int32_t* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N,
+    bool transpose_left, bool transpose_right, concurrency::ThreadPool* tp,
     const void* mlas_backend_config,
     void* einsum_cuda_assets);
 
@@ -297,7 +353,8 @@ template std::unique_ptr<Tensor> DeviceHelpers::CpuDeviceHelpers::ReduceSum<int3
 template Status DeviceHelpers::CpuDeviceHelpers::MatMul<double>(
     const double* input_1_data, const double* input_2_data, double* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N,
+    bool transpose_left, bool transpose_right, concurrency::ThreadPool* tp,
     const void* mlas_backend_config,
     void* einsum_cuda_assets);
 
@@ -311,7 +368,8 @@ template std::unique_ptr<Tensor> DeviceHelpers::CpuDeviceHelpers::ReduceSum<doub
 template Status DeviceHelpers::CpuDeviceHelpers::MatMul<int64_t>(
     const int64_t* input_1_data, const int64_t* input_2_data, int64_t* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N,
+    bool transpose_left, bool transpose_right, concurrency::ThreadPool* tp,
     const void* mlas_backend_config,
     void* einsum_cuda_assets);
 
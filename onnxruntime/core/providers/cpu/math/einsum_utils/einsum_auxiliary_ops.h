@@ -39,10 +39,13 @@ using Transpose = std::function<Status(const gsl::span<const size_t>& permutatio
                                        void* einsum_cuda_assets)>;
 
 // MatMul op - Multiplies two inputs of shapes [num_batches, M, K] and [num_batches, K, N]
+// If `transpose_left` is true, the left input is stored as [num_batches, K, M] instead
+// If `transpose_right` is true, the right input is stored as [num_batches, N, K] instead
 template <typename T>
 using MatMul = std::function<Status(const T* input_1_data, const T* input_2_data, T* output_data,
                                     size_t left_stride, size_t right_stride, size_t output_stride,
-                                    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+                                    size_t num_batches, size_t M, size_t K, size_t N,
+                                    bool transpose_left, bool transpose_right, concurrency::ThreadPool* tp,
                                     const void* mlas_backend_config,
                                     void* einsum_cuda_assets)>;
 
@@ -80,7 +83,8 @@ Status Transpose(const gsl::span<const size_t>& permutation, const Tensor& input
 template <typename T>
 Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
               size_t left_stride, size_t right_stride, size_t output_stride,
-              size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+              size_t num_batches, size_t M, size_t K, size_t N,
+              bool transpose_left, bool transpose_right, concurrency::ThreadPool* tp,
               const void* mlas_backend_config,
               void* einsum_cuda_assets);
 
@@ -148,9 +152,13 @@ inline std::unique_ptr<Tensor> Transpose(const Tensor& input, const TensorShape&
 // Thin wrapper over the MatMul op to be called from Einsum that does some checks and invokes the device specific helper
 // Not using the MatMulHelper for checks and to compute output dims as it adds a lot of checking overhead involving transposes of the inputs
 // In our case, we have a more simplistic version which doesn't need to have those checks
+// The shape overrides are the shapes of the inputs as multiplied ([batches, M, K] and [batches, K, N]).
+// `transpose_left` and `transpose_right` tell that an input is stored with its last two dims swapped,
+// which lets the device GEMM read it as is instead of requiring a transposed copy.
 template <typename T>
 inline std::unique_ptr<Tensor> MatMul(const Tensor& input_1, const gsl::span<const int64_t>& input_1_shape_override,
                                       const Tensor& input_2, const gsl::span<const int64_t>& input_2_shape_override,
+                                      bool transpose_left, bool transpose_right,
                                       AllocatorPtr allocator, concurrency::ThreadPool* tp, const void* mlas_backend_config,
                                       void* einsum_cuda_assets,
                                       const DeviceHelpers::MatMul<T>& device_matmul_func,
@@ -185,7 +193,8 @@ inline std::unique_ptr<Tensor> MatMul(const Tensor& input_1, const gsl::span<con
   T* output_data = output->template MutableData<T>();
 
   auto status = device_matmul_func(input_1_data, input_2_data, output_data,
-                                   left_offset, right_offset, output_offset, batches, M, K, N, tp, mlas_backend_config, einsum_cuda_assets);
+                                   left_offset, right_offset, output_offset, batches, M, K, N,
+                                   transpose_left, transpose_right, tp, mlas_backend_config, einsum_cuda_assets);
 
   if (!status.IsOK()) {
     ORT_THROW(common::ONNXRUNTIME, common::FAIL, "Einsum op: Exception during MatMul operation: ",
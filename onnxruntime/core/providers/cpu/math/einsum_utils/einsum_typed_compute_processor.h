@@ -7,7 +7,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <limits>
 #include <memory>
+#include <utility>
 #include "einsum_auxiliary_ops.h"
 #include "einsum_compute_preprocessor.h"
 
@@ -147,8 +150,61 @@ class EinsumTypedComputeProcessor {
 };
 #endif
 
+#ifndef SHARED_PROVIDER
 namespace EinsumOp {
+
+// Picks the next pair of operands to contract, given the homogenized dims of the operands left to contract.
+// Like the greedy search of opt_einsum, it picks the pair that removes the most elements (the size of the result
+// minus the sizes of the pair), and then the one with the fewest multiply-adds. Contracting the operands in input
+// order instead can create large intermediate results, up to an outer product of two operands.
+// `label_counts` holds the number of operands that have each subscript label (with a dim value > 1) and
+// `subscript_indices_to_output_indices` is -1 for the subscript labels that are not in the output.
+inline std::pair<size_t, size_t> PickPairToContract(gsl::span<const TensorShape> operand_dims,
+                                                    gsl::span<const int64_t> label_counts,
+                                                    gsl::span<const int64_t> subscript_indices_to_output_indices) {
+  std::pair<size_t, size_t> best_pair{0, 1};
+  double best_cost = std::numeric_limits<double>::max();
+  double best_multiply_adds = std::numeric_limits<double>::max();
+
+  for (size_t left = 0; left < operand_dims.size(); ++left) {
+    for (size_t right = left + 1; right < operand_dims.size(); ++right) {
+      const auto left_dims = operand_dims[left].GetDims();
+      const auto right_dims = operand_dims[right].GetDims();
+
+      double result_size = 1.0;
+      double multiply_adds = 1.0;
+      for (size_t label = 0; label < label_counts.size(); ++label) {
+        const bool has_left_dim = left_dims[label] > 1;
+        const bool has_right_dim = right_dims[label] > 1;
+        if (!has_left_dim && !has_right_dim) {
+          continue;
+        }
+
+        const auto dim = static_cast<double>(std::max(left_dims[label], right_dims[label]));
+        multiply_adds *= dim;
+
+        // The label is kept in the result if it is in the output or in another operand
+        const int64_t count_in_other_operands = label_counts[label] - has_left_dim - has_right_dim;
+        if (subscript_indices_to_output_indices[label] != -1 || count_in_other_operands > 0) {
+          result_size *= dim;
+        }
+      }
+
+      const double cost = result_size - static_cast<double>(operand_dims[left].Size()) -
+                          static_cast<double>(operand_dims[right].Size());
+      if (cost < best_cost || (cost == best_cost && multiply_adds < best_multiply_adds)) {
+        best_pair = {left, right};
+        best_cost = cost;
+        best_multiply_adds = multiply_adds;
+      }
+    }
+  }
+
+  return best_pair;
+}
+
 }  // namespace EinsumOp
+#endif
 
 #include "core/common/narrow.h"
 #include "core/common/span_utils.h"
@@ -226,9 +282,10 @@ inline void EinsumTypedComputeProcessor<T>::FinalizeOutput(const Tensor& candida
 }
 #endif
 
-static inline bool IsTransposeReshapeForEinsum(const gsl::span<const size_t>& perm,
-                                               gsl::span<const int64_t> input_dims,
-                                               TensorShapeVector& new_shape) {
+// Whether permuting the dims of a tensor by `perm` leaves its data in the same order,
+// in which case no transpose is needed.
+static inline bool IsLayoutPreservingPermutation(const gsl::span<const size_t>& perm,
+                                                 gsl::span<const int64_t> input_dims) {
   // As long as the dims with values > 1 stay in the same relative order, it's a reshape.
   // Example: Shape=(1,1,1024,4096) -> perm=(2,0,3,1).
   size_t last_permuted_axis = 0;
@@ -239,6 +296,15 @@ static inline bool IsTransposeReshapeForEinsum(const gsl::span<const size_t>& pe
       return false;
     last_permuted_axis = perm[i];
   }
+  return true;
+}
+
+static inline bool IsTransposeReshapeForEinsum(const gsl::span<const size_t>& perm,
+                                               gsl::span<const int64_t> input_dims,
+                                               TensorShapeVector& new_shape) {
+  if (!IsLayoutPreservingPermutation(perm, input_dims)) {
+    return false;
+  }
   new_shape.assign(input_dims.begin(), input_dims.end());
   for (size_t i = 0; i < perm.size(); ++i) {
     new_shape[i] = input_dims[perm[i]];
@@ -348,63 +414,62 @@ inline std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandPr
     }
   }
 
-  // Permutate the left operand so that the axes order go like this: [lro, lo, reduce_dims, ro]
-  TensorShapeVector reshaped_dims;
-  InlinedVector<size_t> left_permutation;
-  left_permutation.reserve(lro.size() + lo.size() + reduce_dims.size() + ro.size());
-  left_permutation.insert(left_permutation.end(), lro.begin(), lro.end());
-  left_permutation.insert(left_permutation.end(), lo.begin(), lo.end());
-  //  left_permutation.insert(left_permutation.end(), reduce_dims.begin(), reduce_dims.end());
+  InlinedVector<size_t> reduce;
+  reduce.reserve(reduce_dims.size());
   for (auto& a : reduce_dims) {
-    left_permutation.push_back(onnxruntime::narrow<size_t>(a));
+    reduce.push_back(onnxruntime::narrow<size_t>(a));
   }
-  left_permutation.insert(left_permutation.end(), ro.begin(), ro.end());
-  if (EinsumOp::IsTransposeRequired(current_left ? current_left->Shape().NumDimensions() : left_dims.size(),
-                                    left_permutation)) {
-    if (current_left && IsTransposeReshapeForEinsum(left_permutation,
-                                                    current_left->Shape().GetDims(),
-                                                    reshaped_dims)) {
-      // This can be done because current_* tensors (if they exist) and output tensors are
-      // intermediate tensors and cannot be input tensors to the Einsum node itself
-      // (which are immutable).
-      // Covered by ExplicitEinsumAsTensorContractionReshapeLeft.
-      current_left->Reshape(reshaped_dims);
-    } else {
-      // Covered by ExplicitEinsumAsTensorContraction, DiagonalWithMatmul, ...
-      current_left = EinsumOp::Transpose(current_left ? *current_left : left,
-                                         current_left ? current_left->Shape().GetDims() : left_dims,
-                                         left_permutation, allocator_, einsum_ep_assets_,
-                                         device_transpose_func_, device_create_tensor_func_);
+
+  auto make_permutation = [](std::initializer_list<const InlinedVector<size_t>*> axes_groups) {
+    InlinedVector<size_t> permutation;
+    for (const auto* axes : axes_groups) {
+      permutation.insert(permutation.end(), axes->begin(), axes->end());
     }
-  }
+    return permutation;
+  };
 
-  // Permutate the right operand so that the axes order go like this: [lro, reduce_dims, ro, lo]
-  InlinedVector<size_t> right_permutation;
-  right_permutation.reserve(lro.size() + lo.size() + reduce_dims.size() + ro.size());
-  right_permutation.insert(right_permutation.end(), lro.begin(), lro.end());
-  //  right_permutation.insert(right_permutation.end(), reduce_dims.begin(), reduce_dims.end());
-  for (auto& a : reduce_dims) {
-    right_permutation.push_back(onnxruntime::narrow<size_t>(a));
+  // The left operand is multiplied as [lro, lo, reduce_dims] (the `ro` dims are trivial for it).
+  // It is used as is if its non-trivial dims are already in this order, or in the order [lro, reduce_dims, lo]
+  // which the GEMM reads as a transposed matrix. Otherwise it is permutated to [lro, lo, reduce_dims, ro].
+  bool transpose_left = false;
+  {
+    const Tensor& left_operand = current_left ? *current_left : left;
+    const auto left_operand_dims = current_left ? current_left->Shape().GetDims() : left_dims;
+    const auto left_permutation = make_permutation({&lro, &lo, &reduce, &ro});
+    if (!IsLayoutPreservingPermutation(left_permutation, left_operand_dims)) {
+      if (IsLayoutPreservingPermutation(make_permutation({&lro, &reduce, &lo, &ro}), left_operand_dims)) {
+        // Covered by ExplicitEinsumAsMatmulNhcwTransposeA, ...
+        transpose_left = true;
+      } else {
+        // Covered by ExplicitEinsumAsTensorContraction, DiagonalWithMatmul, ...
+        current_left = EinsumOp::Transpose(left_operand, left_operand_dims, left_permutation, allocator_,
+                                           einsum_ep_assets_, device_transpose_func_, device_create_tensor_func_);
+      }
+    }
   }
-  right_permutation.insert(right_permutation.end(), ro.begin(), ro.end());
-  right_permutation.insert(right_permutation.end(), lo.begin(), lo.end());
-  if (EinsumOp::IsTransposeRequired(current_right ? current_right->Shape().GetDims().size() : right_dims.size(),
-                                    right_permutation)) {
-    if (current_right && IsTransposeReshapeForEinsum(right_permutation,
-                                                     current_right->Shape().GetDims(),
-                                                     reshaped_dims)) {
-      // See note following the previous call of function IsTransposeReshapeForEinsum.
-      // Covered by ExplicitEinsumAsBatchedMatmulWithBroadcasting_1, ExplicitEinsumAsMatmul_2, ...
-      current_right->Reshape(reshaped_dims);
-    } else {
-      // Covered by DiagonalWithMatmul, ExplicitEinsumAsBatchedMatmul, ...
-      current_right = EinsumOp::Transpose(current_right ? *current_right : right,
-                                          current_right ? current_right->Shape().GetDims() : right_dims,
-                                          right_permutation, allocator_, einsum_ep_assets_,
-                                          device_transpose_func_, device_create_tensor_func_);
+
+  // The right operand is multiplied as [lro, reduce_dims, ro] (the `lo` dims are trivial for it).
+  // It is used as is if its non-trivial dims are already in this order, or in the order [lro, ro, reduce_dims]
+  // which the GEMM reads as a transposed matrix. Otherwise it is permutated to [lro, reduce_dims, ro, lo].
+  bool transpose_right = false;
+  {
+    const Tensor& right_operand = current_right ? *current_right : right;
+    const auto right_operand_dims = current_right ? current_right->Shape().GetDims() : right_dims;
+    const auto right_permutation = make_permutation({&lro, &reduce, &ro, &lo});
+    if (!IsLayoutPreservingPermutation(right_permutation, right_operand_dims)) {
+      if (IsLayoutPreservingPermutation(make_permutation({&lro, &ro, &reduce, &lo}), right_operand_dims)) {
+        // Covered by ExplicitEinsumAsMatmul_Multi_Input_ContractionOrder, ...
+        transpose_right = true;
+      } else {
+        // Covered by DiagonalWithMatmul, ExplicitEinsumAsBatchedMatmul, ...
+        current_right = EinsumOp::Transpose(right_operand, right_operand_dims, right_permutation, allocator_,
+                                            einsum_ep_assets_, device_transpose_func_, device_create_tensor_func_);
+      }
     }
   }
 
+  TensorShapeVector reshaped_dims;
+
   // Calculate output size
   // Output shape will be determined by rules of MatMul:
   // because we are multiplying two tensors of shapes [lro, lo, reduce_dims] , [lro, reduce_dims, ro]
@@ -463,6 +528,7 @@ inline std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandPr
   // Multiply the mutated inputs
   auto output = EinsumOp::MatMul<T>(current_left ? *current_left : left, TensorShapeVector{lro_size, lo_size, reduced_size},
                                     current_right ? *current_right : right, TensorShapeVector{lro_size, reduced_size, ro_size},
+                                    transpose_left, transpose_right,
                                     allocator_, tp_, mlas_backend_config_,
                                     einsum_ep_assets_, device_matmul_func_, device_create_tensor_func_);
 
@@ -518,10 +584,12 @@ inline Status EinsumTypedComputeProcessor<T>::Run() {
     }
   }
 
-  // Pre-process the first input so as to reduce any dims that only it has
-  std::unique_ptr<const Tensor> result;
+  const auto& subscript_indices_to_output_indices = einsum_compute_preprocessor_.GetMappedSubscriptIndicesToOutputindices();
+
+  if (num_inputs == 1) {
+    // Reduce the dims that are not in the output
+    std::unique_ptr<const Tensor> result;
 
-  {
     TensorShapeVector reduced_dims;              // All dims of the input that are reduced using the `ReduceSum` op
     reduced_dims.reserve(num_subscript_labels);  // num_subscript_labels is the upper bound. No harm in over-reserving
 
@@ -537,7 +605,6 @@ inline Status EinsumTypedComputeProcessor<T>::Run() {
       all_dims.push_back(i);
     }
 
-    // Reduce the dims that are last seen in the first input alone
     if (reduced_dims.size() != 0) {
       result = EinsumOp::ReduceSum<T>(preprocessed_inputs[0] ? *preprocessed_inputs[0] : *raw_inputs[0],
                                       homogenized_input_dims[0].GetDims(), reduced_dims, allocator_, tp_,
@@ -550,39 +617,92 @@ inline Status EinsumTypedComputeProcessor<T>::Run() {
       }
     }
 
-    // Finalize the output at this stage if num_inputs == 1
-    if (num_inputs == 1) {
-      // Finalize the output by applying any transpose required to get
-      // it to the required output ordering and move it to the op's output
-      FinalizeOutput(result ? *result : *raw_inputs[0], all_dims);
+    // Finalize the output by applying any transpose required to get
+    // it to the required output ordering and move it to the op's output
+    FinalizeOutput(result ? *result : *raw_inputs[0], all_dims);
+
+    return Status::OK();
+  }
+
+  // The operands left to contract, with their axes in the homogenized order.
+  // `owned_operands` holds the pre-processed inputs and the intermediate results.
+  std::vector<std::unique_ptr<const Tensor>> owned_operands;
+  std::vector<const Tensor*> operands;
+  std::vector<TensorShape> operand_dims;
+  owned_operands.reserve(num_inputs);
+  operands.reserve(num_inputs);
+  operand_dims.reserve(num_inputs);
+
+  // Number of operands that have each subscript label (with a dim value > 1)
+  std::vector<int64_t> label_counts(num_subscript_labels, 0);
+  for (int input = 0; input < num_inputs; ++input) {
+    const auto dims = homogenized_input_dims[input].GetDims();
+    for (size_t label = 0; label < num_subscript_labels; ++label) {
+      label_counts[label] += dims[label] > 1;
+    }
+  }
+
+  for (int input = 0; input < num_inputs; ++input) {
+    std::unique_ptr<const Tensor> operand = std::move(preprocessed_inputs[input]);
+    TensorShape dims = homogenized_input_dims[input];
 
-      return Status::OK();
+    // Reduce the dims that only this input has (and that are not in the output) right away
+    TensorShapeVector reduced_dims;
+    for (size_t label = 0; label < num_subscript_labels; ++label) {
+      if (dims[label] > 1 && label_counts[label] == 1 && subscript_indices_to_output_indices[label] == -1) {
+        reduced_dims.push_back(label);
+        label_counts[label] = 0;
+      }
+    }
+
+    if (!reduced_dims.empty()) {
+      operand = EinsumOp::ReduceSum<T>(operand ? *operand : *raw_inputs[input], dims, reduced_dims, allocator_, tp_,
+                                       einsum_ep_assets_, device_reduce_sum_func_, device_create_tensor_func_);
+      dims = operand->Shape();
     }
+
+    operands.push_back(operand ? operand.get() : raw_inputs[input]);
+    owned_operands.push_back(std::move(operand));
+    operand_dims.push_back(std::move(dims));
   }
 
-  // Process the operands in a pair-wise fashion
-  {
-    bool is_final_pair = false;
-    // Keep processing each input pair-wise
-    for (int input = 1; input < num_inputs; ++input) {
-      TensorShapeVector reduced_dims;
-      reduced_dims.reserve(num_subscript_labels);  // num_subscript_labels is the upper bound. No harm in over-reserving by a small margin.
-      for (size_t dim = 0; dim < num_subscript_labels; ++dim) {
-        if (mapped_indices_to_last_input_index[dim] == input) {
-          // This is the last input we are seeing this dimension (and it doesn't occur in the output), so reduce along the dimension
-          reduced_dims.push_back(dim);
-        }
+  // Contract the operands pair-wise until one is left, which is the output
+  while (operands.size() > 1) {
+    const auto [left, right] = EinsumOp::PickPairToContract(operand_dims, label_counts,
+                                                            subscript_indices_to_output_indices);
+
+    // Reduce the dims that neither the output nor the other operands have
+    TensorShapeVector reduced_dims;
+    reduced_dims.reserve(num_subscript_labels);  // num_subscript_labels is the upper bound. No harm in over-reserving by a small margin.
+    const auto left_dims = operand_dims[left].GetDims();
+    const auto right_dims = operand_dims[right].GetDims();
+    for (size_t label = 0; label < num_subscript_labels; ++label) {
+      const bool has_left_dim = left_dims[label] > 1;
+      const bool has_right_dim = right_dims[label] > 1;
+      if (!has_left_dim && !has_right_dim) {
+        continue;
       }
-      if (input == num_inputs - 1) {
-        is_final_pair = true;
+
+      label_counts[label] -= has_left_dim + has_right_dim;
+      if (subscript_indices_to_output_indices[label] == -1 && label_counts[label] == 0) {
+        reduced_dims.push_back(label);
+      } else {
+        ++label_counts[label];  // The result has the label
       }
-      // Use either the preprocessed inputs (if it is available) or the corresponding raw inputs
-      result = PairwiseOperandProcess(result ? *result : *raw_inputs[0],
-                                      result ? result->Shape() : homogenized_input_dims[0],
-                                      preprocessed_inputs[input] ? *preprocessed_inputs[input] : *raw_inputs[input],
-                                      homogenized_input_dims[input],
-                                      reduced_dims, is_final_pair);
     }
+
+    const bool is_final_pair = operands.size() == 2;
+    auto result = PairwiseOperandProcess(*operands[left], operand_dims[left], *operands[right], operand_dims[right],
+                                         reduced_dims, is_final_pair);
+
+    // The result takes the place of the left operand
+    operand_dims[left] = result->Shape();
+    operands[left] = result.get();
+    owned_operands[left] = std::move(result);
+
+    operand_dims.erase(operand_dims.begin() + right);
+    operands.erase(operands.begin() + right);
+    owned_operands.erase(owned_operands.begin() + right);
   }
 
   return Status::OK();
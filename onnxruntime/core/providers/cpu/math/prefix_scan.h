@@ -0,0 +1,141 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace prefix_scan {
+
+namespace detail {
+
+// Number of lanes that a single task scans. Large enough for the row by row combination to be vectorized.
+constexpr int64_t kLanesPerTask = 256;
+
+// Minimum number of elements in a block of the scan axis, when the axis is split across threads.
+constexpr int64_t kMinAxisBlockSize = 16384;
+
+// Scans the rows [first, last) of the scan order of a [dim, inner] slice, for the lanes [lane_begin, lane_end).
+// The scan starts from the identity at row `first`.
+template <typename T, typename TOp>
+void ScanRows(const T* input, T* output, int64_t dim, int64_t inner, int64_t first, int64_t last,
+              int64_t lane_begin, int64_t lane_end, bool exclusive, bool reverse, T identity, const TOp& op) {
+  auto row_offset = [dim, inner, lane_begin, reverse](int64_t step) {
+    return (reverse ? dim - 1 - step : step) * inner + lane_begin;
+  };
+
+  const int64_t lanes = lane_end - lane_begin;
+  if (exclusive) {
+    std::fill_n(output + row_offset(first), lanes, identity);
+  } else {
+    std::copy_n(input + row_offset(first), lanes, output + row_offset(first));
+  }
+
+  for (int64_t step = first + 1; step < last; ++step) {
+    const int64_t prev = row_offset(step - 1);
+    const int64_t cur = row_offset(step);
+    const T* in = input + (exclusive ? prev : cur);
+    const T* prev_out = output + prev;
+    T* out = output + cur;
+    for (int64_t i = 0; i < lanes; ++i) {
+      out[i] = op(prev_out[i], in[i]);
+    }
+  }
+}
+
+}  // namespace detail
+
+// Inclusive or exclusive prefix scan with the associative `op` along the axis of an input viewed as
+// [outer, dim, inner], in reverse if `reverse` is true. `identity` is the identity of `op`, e.g. 0 for a sum.
+//
+// The inner elements are independent lanes that are combined row by row, which vectorizes. The outer slices and
+// blocks of lanes are split across the thread pool. When there are fewer of those than threads, e.g. for a long
+// 1D input, the axis is split into blocks that are scanned in parallel, and a second pass combines every block with
+// the totals of the blocks before it.
+template <typename T, typename TOp>
+void PrefixScan(concurrency::ThreadPool* thread_pool, const T* input, T* output,
+                int64_t outer, int64_t dim, int64_t inner, bool exclusive, bool reverse, T identity, TOp op) {
+  if (outer == 0 || dim == 0 || inner == 0) {
+    return;
+  }
+
+  const int64_t slice_size = dim * inner;
+  const int64_t lanes_per_task = std::min(inner, detail::kLanesPerTask);
+  const int64_t num_lane_blocks = (inner + lanes_per_task - 1) / lanes_per_task;
+  const int64_t num_tasks = outer * num_lane_blocks;
+
+  const int64_t dop = concurrency::ThreadPool::DegreeOfParallelism(thread_pool);
+  const int64_t num_axis_blocks = std::min({dop, dim, slice_size / detail::kMinAxisBlockSize});
+
+  if (num_tasks >= dop || num_axis_blocks < 2) {
+    const double task_elements = static_cast<double>(dim * lanes_per_task);
+    concurrency::ThreadPool::TryParallelFor(
+        thread_pool, static_cast<std::ptrdiff_t>(num_tasks),
+        {task_elements * sizeof(T), task_elements * sizeof(T), task_elements},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t task = first; task < last; ++task) {
+            const int64_t slice = task / num_lane_blocks;
+            const int64_t lane_begin = (task % num_lane_blocks) * lanes_per_task;
+            const int64_t lane_end = std::min(inner, lane_begin + lanes_per_task);
+            detail::ScanRows(input + slice * slice_size, output + slice * slice_size, dim, inner, 0, dim,
+                             lane_begin, lane_end, exclusive, reverse, identity, op);
+          }
+        });
+    return;
+  }
+
+  // Blocked scan along the axis. Block b of every slice covers the steps [block_begin(b), block_begin(b + 1)) of the
+  // scan order, and is first scanned on its own.
+  auto block_begin = [dim, num_axis_blocks](int64_t block) { return block * dim / num_axis_blocks; };
+  auto row_offset = [dim, inner, reverse](int64_t step) { return (reverse ? dim - 1 - step : step) * inner; };
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(outer * num_axis_blocks), [&](std::ptrdiff_t task) {
+        const int64_t slice = task / num_axis_blocks;
+        const int64_t block = task % num_axis_blocks;
+        detail::ScanRows(input + slice * slice_size, output + slice * slice_size, dim, inner,
+                         block_begin(block), block_begin(block + 1), 0, inner, exclusive, reverse, identity, op);
+      });
+
+  // The value to combine with each block is the combination of the totals of the blocks before it.
+  std::vector<T> block_offsets(static_cast<size_t>(outer * num_axis_blocks * inner), identity);
+  for (int64_t slice = 0; slice < outer; ++slice) {
+    const T* slice_input = input + slice * slice_size;
+    const T* slice_output = output + slice * slice_size;
+    for (int64_t block = 1; block < num_axis_blocks; ++block) {
+      const int64_t last_row = row_offset(block_begin(block) - 1);
+      const T* prev_offset = block_offsets.data() + (slice * num_axis_blocks + block - 1) * inner;
+      T* offset = block_offsets.data() + (slice * num_axis_blocks + block) * inner;
+      for (int64_t i = 0; i < inner; ++i) {
+        T total = exclusive ? op(slice_output[last_row + i], slice_input[last_row + i]) : slice_output[last_row + i];
+        offset[i] = op(prev_offset[i], total);
+      }
+    }
+  }
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(outer * num_axis_blocks), [&](std::ptrdiff_t task) {
+        const int64_t slice = task / num_axis_blocks;
+        const int64_t block = task % num_axis_blocks;
+        if (block == 0) {
+          return;
+        }
+
+        const T* offset = block_offsets.data() + task * inner;
+        T* slice_output = output + slice * slice_size;
+        for (int64_t step = block_begin(block); step < block_begin(block + 1); ++step) {
+          T* out = slice_output + row_offset(step);
+          for (int64_t i = 0; i < inner; ++i) {
+            out[i] = op(offset[i], out[i]);
+          }
+        }
+      });
+}
+
+}  // namespace prefix_scan
+}  // namespace onnxruntime
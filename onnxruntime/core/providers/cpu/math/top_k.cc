@@ -25,6 +25,7 @@
 #include <queue>
 #include <algorithm>
 #include <cmath>
+#include <numeric>
 #include <core/common/safeint.h>
 
 namespace onnxruntime {
@@ -140,6 +141,81 @@ static void SelectTopK(const Comparator& comparer,
   // the data_holder now contains the indices of the top k elements in the first k elements
 }
 
+// Selects the top k of the elements [begin, end) of a row with a contiguous axis, and writes their indices to
+// 'candidates'. The order of the selected indices is unspecified.
+template <class Comparator>
+static void SelectTopKCandidates(const Comparator& comparer, const typename Comparator::DataType* input_data,
+                                 int64_t begin, int64_t end, const unsigned k, bool use_priority_queue,
+                                 int64_t* candidates) {
+  if (use_priority_queue) {
+    // add first k items starting from the bottom up
+    for (unsigned l = 0; l < k; ++l) {
+      candidates[k - l - 1] = begin + l;
+      HeapifyIthPosition(candidates, k - l - 1, k, comparer);
+    }
+
+    // the top of the heap is the current worst top k value, so it's the threshold that the remaining values
+    // need to beat.
+    auto top = input_data[candidates[0]];
+    for (int64_t idx = begin + k; idx < end; ++idx) {
+      if (comparer.CompareValueOnly(input_data[idx], top)) {
+        candidates[0] = idx;
+        HeapifyIthPosition(candidates, 0, k, comparer);
+        top = input_data[candidates[0]];
+      }
+    }
+  } else {
+    std::vector<int64_t> data_holder(onnxruntime::narrow<size_t>(end - begin));
+    std::iota(data_holder.begin(), data_holder.end(), begin);
+    std::nth_element(data_holder.begin(), data_holder.begin() + (k - 1), data_holder.end(), comparer);
+    std::copy_n(data_holder.begin(), k, candidates);
+  }
+}
+
+// Minimum number of elements in a partition of a row when a row is split across threads.
+constexpr int64_t kMinTopKRowPartitionSize = 16 * 1024;
+
+// Finds the top k elements of rows with a contiguous axis when there are fewer rows than threads, e.g. a single row
+// of retrieval scores. Each row is split into partitions whose top k candidates are selected in parallel, and the
+// candidates of a row are then merged. The comparer orders equal values by index, so the result is the same as
+// selecting from the whole row.
+template <class Comparator>
+static void FindTopKElementsInRowPartitions(const typename Comparator::DataType* input_data,
+                                            typename Comparator::DataType* values_data, int64_t* indices_data,
+                                            int64_t rows, int64_t cols, int64_t partitions_per_row,
+                                            const unsigned k, bool sorted, concurrency::ThreadPool* threadpool) {
+  const int64_t candidates_per_row = partitions_per_row * k;
+  std::vector<int64_t> candidates(onnxruntime::narrow<size_t>(rows * candidates_per_row));
+
+  const bool use_priority_queue = k < 4 || (std::log2(k) / std::log2(cols / partitions_per_row)) < 0.725;
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      threadpool, onnxruntime::narrow<std::ptrdiff_t>(rows * partitions_per_row), [&](std::ptrdiff_t task) {
+        const int64_t row = task / partitions_per_row;
+        const int64_t partition = task % partitions_per_row;
+        const int64_t begin = row * cols + partition * cols / partitions_per_row;
+        const int64_t end = row * cols + (partition + 1) * cols / partitions_per_row;
+        SelectTopKCandidates(Comparator(input_data), input_data, begin, end, k, use_priority_queue,
+                             candidates.data() + task * k);
+      });
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      threadpool, onnxruntime::narrow<std::ptrdiff_t>(rows), [&](std::ptrdiff_t row) {
+        Comparator comparer(input_data);
+        auto row_candidates_begin = candidates.begin() + row * candidates_per_row;
+        auto row_candidates_end = row_candidates_begin + candidates_per_row;
+        std::nth_element(row_candidates_begin, row_candidates_begin + (k - 1), row_candidates_end, comparer);
+        if (sorted) {
+          std::sort(row_candidates_begin, row_candidates_begin + k, comparer);
+        }
+
+        for (unsigned l = 0; l < k; ++l) {
+          const int64_t idx = row_candidates_begin[l];
+          values_data[row * k + l] = input_data[idx];
+          indices_data[row * k + l] = idx - row * cols;
+        }
+      });
+}
+
 // Given an input tensor 'input' and metadata values - 'k' and 'axis_parsed',
 // this method will extract the sorted top k largest/smallest elements and place them in the output tensor 'values'
 // along with the metadata output 'indices'
@@ -165,6 +241,18 @@ static void FindTopKElements(const Tensor* input, const TensorShape& input_shape
   const int64_t block_slice = reduced_cols / k;
 
   int64_t tp_threads = concurrency::ThreadPool::DegreeOfParallelism(threadpool);
+
+  // with a contiguous axis and fewer rows than threads, split the rows so that all the threads are used.
+  if (block_slice == 1 && rows < tp_threads) {
+    const int64_t partitions_per_row = std::min((tp_threads + rows - 1) / rows,
+                                                num_blocks / std::max<int64_t>(kMinTopKRowPartitionSize, 4 * k));
+    if (partitions_per_row > 1) {
+      FindTopKElementsInRowPartitions<Comparator>(input_data, values_data, indices_data, rows, cols,
+                                                  partitions_per_row, k, sorted, threadpool);
+      return;
+    }
+  }
+
   int64_t num_threads = std::min(tp_threads, rows);  // split on rows so can't have more threads than rows
 
   // rough attempt to make sure there's enough work for each thread. if there's insufficient work the usage of
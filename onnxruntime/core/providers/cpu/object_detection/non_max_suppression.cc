@@ -13,10 +13,12 @@ limitations under the License.
 
 #include "non_max_suppression.h"
 
-#include <queue>
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "core/common/narrow.h"
+#include "core/platform/threadpool.h"
 #include "non_max_suppression_helper.h"
 
 // TODO:fix the warnings
@@ -43,6 +45,119 @@ ONNX_OPERATOR_KERNEL_EX(
 
 using namespace nms_helpers;
 
+namespace {
+
+// Boxes of a batch as corners in structure-of-arrays layout, so the IOU of a candidate against all the selected boxes
+// of a class is computed in a loop the compiler can vectorize.
+struct BoxCorners {
+  std::vector<float> x_min;
+  std::vector<float> y_min;
+  std::vector<float> x_max;
+  std::vector<float> y_max;
+  std::vector<float> area;
+
+  void Resize(size_t num_boxes) {
+    x_min.resize(num_boxes);
+    y_min.resize(num_boxes);
+    x_max.resize(num_boxes);
+    y_max.resize(num_boxes);
+    area.resize(num_boxes);
+  }
+
+  void Clear() {
+    x_min.clear();
+    y_min.clear();
+    x_max.clear();
+    y_max.clear();
+    area.clear();
+  }
+
+  void Set(size_t i, float box_x_min, float box_y_min, float box_x_max, float box_y_max) {
+    x_min[i] = box_x_min;
+    y_min[i] = box_y_min;
+    x_max[i] = box_x_max;
+    y_max[i] = box_y_max;
+    area[i] = (box_x_max - box_x_min) * (box_y_max - box_y_min);
+  }
+
+  void Append(const BoxCorners& other, size_t i) {
+    x_min.push_back(other.x_min[i]);
+    y_min.push_back(other.y_min[i]);
+    x_max.push_back(other.x_max[i]);
+    y_max.push_back(other.y_max[i]);
+    area.push_back(other.area[i]);
+  }
+};
+
+// Converts the boxes of a batch to corners the same way SuppressByIOU does.
+void ToBoxCorners(const float* boxes, size_t num_boxes, int64_t center_point_box, BoxCorners& corners) {
+  corners.Resize(num_boxes);
+  for (size_t i = 0; i < num_boxes; ++i, boxes += 4) {
+    float x_min{}, y_min{}, x_max{}, y_max{};
+    if (0 == center_point_box) {
+      // boxes data format [y1, x1, y2, x2]
+      MaxMin(boxes[1], boxes[3], x_min, x_max);
+      MaxMin(boxes[0], boxes[2], y_min, y_max);
+    } else {
+      // boxes data format [x_center, y_center, width, height]
+      const float width_half = boxes[2] / 2;
+      const float height_half = boxes[3] / 2;
+      x_min = boxes[0] - width_half;
+      x_max = boxes[0] + width_half;
+      y_min = boxes[1] - height_half;
+      y_max = boxes[1] + height_half;
+    }
+    corners.Set(i, x_min, y_min, x_max, y_max);
+  }
+}
+
+// Whether box `index` of `boxes` has an IOU greater than iou_threshold with any of the selected boxes.
+// Matches SuppressByIOU for each pair.
+bool SuppressBySelected(const BoxCorners& boxes, size_t index, const BoxCorners& selected, float iou_threshold) {
+  // the selected boxes are checked in blocks so that the loop over a block is vectorized and a candidate that
+  // overlaps one of the highest scoring boxes is still rejected early
+  constexpr size_t kBlockSize = 16;
+
+  const float x_min = boxes.x_min[index];
+  const float y_min = boxes.y_min[index];
+  const float x_max = boxes.x_max[index];
+  const float y_max = boxes.y_max[index];
+  const float area = boxes.area[index];
+  if (area <= .0f) {
+    return false;
+  }
+
+  const size_t num_selected = selected.area.size();
+  const float* selected_x_min = selected.x_min.data();
+  const float* selected_y_min = selected.y_min.data();
+  const float* selected_x_max = selected.x_max.data();
+  const float* selected_y_max = selected.y_max.data();
+  const float* selected_area = selected.area.data();
+
+  for (size_t block_start = 0; block_start < num_selected; block_start += kBlockSize) {
+    const size_t block_end = std::min(block_start + kBlockSize, num_selected);
+    int suppressed = 0;
+    for (size_t i = block_start; i < block_end; ++i) {
+      const float intersection_width = std::min(x_max, selected_x_max[i]) - std::max(x_min, selected_x_min[i]);
+      const float intersection_height = std::min(y_max, selected_y_max[i]) - std::max(y_min, selected_y_min[i]);
+      const float intersection_area = intersection_width * intersection_height;
+      const float union_area = area + selected_area[i] - intersection_area;
+      suppressed |= static_cast<int>(intersection_width > .0f) & static_cast<int>(intersection_height > .0f) &
+                    static_cast<int>(intersection_area > .0f) & static_cast<int>(selected_area[i] > .0f) &
+                    static_cast<int>(union_area > .0f) &
+                    static_cast<int>(intersection_area / union_area > iou_threshold);
+    }
+
+    if (suppressed) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+}  // namespace
+
 Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
   PrepareContext pc;
   ORT_RETURN_IF_ERROR(PrepareCompute(ctx, pc));
@@ -73,62 +188,92 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
   };
 
   const auto center_point_box = GetCenterPointBox();
+  const auto num_batches = narrow<size_t>(pc.num_batches_);
+  const auto num_classes = narrow<size_t>(pc.num_classes_);
+  const auto num_boxes = narrow<size_t>(pc.num_boxes_);
+  const size_t max_selected = std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), num_boxes);
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
 
-  std::vector<SelectedIndex> selected_indices;
-  std::vector<BoxInfoPtr> selected_boxes_inside_class;
-  selected_boxes_inside_class.reserve(std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), pc.num_boxes_));
-
-  for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
-    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
-      const float* batch_boxes = boxes_data + (batch_index * pc.num_boxes_ * 4);
-      std::vector<BoxInfoPtr> candidate_boxes;
-      candidate_boxes.reserve(pc.num_boxes_);
-
-      // Filter by score_threshold_
-      const auto* class_scores = scores_data + box_score_offset;
-      if (pc.score_threshold_ != nullptr) {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          if (*class_scores > score_threshold) {
-            candidate_boxes.emplace_back(*class_scores, box_index);
-          }
-        }
-      } else {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          candidate_boxes.emplace_back(*class_scores, box_index);
+  // the corners of the boxes are shared by all the classes of a batch
+  std::vector<BoxCorners> batch_corners(num_batches);
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(num_batches),
+      static_cast<double>(num_boxes * 4 * sizeof(float)),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t batch_index = first; batch_index < last; ++batch_index) {
+          ToBoxCorners(boxes_data + batch_index * num_boxes * 4, num_boxes, center_point_box,
+                       batch_corners[batch_index]);
         }
-      }
-      std::priority_queue<BoxInfoPtr, std::vector<BoxInfoPtr>> sorted_boxes(std::less<BoxInfoPtr>(), std::move(candidate_boxes));
-
-      selected_boxes_inside_class.clear();
-      // Get the next box with top score, filter by iou_threshold
-      while (!sorted_boxes.empty() && static_cast<int64_t>(selected_boxes_inside_class.size()) < max_output_boxes_per_class) {
-        const BoxInfoPtr& next_top_score = sorted_boxes.top();
-
-        bool selected = true;
-        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
-        for (const auto& selected_index : selected_boxes_inside_class) {
-          if (SuppressByIOU(batch_boxes, next_top_score.index_, selected_index.index_, center_point_box, iou_threshold)) {
-            selected = false;
-            break;
+      });
+
+  // each (batch, class) pair is independent. the selected indices of each pair are concatenated afterwards so the
+  // output order matches a serial evaluation.
+  std::vector<std::vector<SelectedIndex>> selected_per_class(num_batches * num_classes);
+  const TensorOpCost cost{static_cast<double>(num_boxes * sizeof(float)),
+                          static_cast<double>(max_selected * sizeof(SelectedIndex)),
+                          static_cast<double>(num_boxes * 16)};
+
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(num_batches * num_classes), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<BoxInfoPtr> candidate_boxes;
+        candidate_boxes.reserve(num_boxes);
+        BoxCorners selected_boxes;
+
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const int64_t batch_index = i / pc.num_classes_;
+          const int64_t class_index = i % pc.num_classes_;
+          const BoxCorners& corners = batch_corners[batch_index];
+
+          // Filter by score_threshold_
+          candidate_boxes.clear();
+          const auto* class_scores = scores_data + i * pc.num_boxes_;
+          if (pc.score_threshold_ != nullptr) {
+            for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index) {
+              if (class_scores[box_index] > score_threshold) {
+                candidate_boxes.emplace_back(class_scores[box_index], box_index);
+              }
+            }
+          } else {
+            for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index) {
+              candidate_boxes.emplace_back(class_scores[box_index], box_index);
+            }
           }
-        }
 
-        if (selected) {
-          selected_boxes_inside_class.push_back(next_top_score);
-          selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
+          // a heap is cheaper than sorting as usually only the top few candidates are visited
+          std::make_heap(candidate_boxes.begin(), candidate_boxes.end());
+
+          auto& selected_indices = selected_per_class[i];
+          selected_boxes.Clear();
+          // Get the next box with top score, filter by iou_threshold
+          auto heap_end = candidate_boxes.end();
+          while (heap_end != candidate_boxes.begin() && selected_indices.size() < max_selected) {
+            std::pop_heap(candidate_boxes.begin(), heap_end);
+            --heap_end;
+            const auto box_index = narrow<size_t>(heap_end->index_);
+
+            // Check with existing selected boxes for this class, suppress if exceed the IOU threshold
+            if (!SuppressBySelected(corners, box_index, selected_boxes, iou_threshold)) {
+              selected_boxes.Append(corners, box_index);
+              selected_indices.emplace_back(batch_index, class_index, heap_end->index_);
+            }
+          }
         }
-        sorted_boxes.pop();
-      }  // while
-    }  // for class_index
-  }  // for batch_index
+      });
 
   constexpr auto last_dim = 3;
-  const auto num_selected = selected_indices.size();
+  size_t num_selected = 0;
+  for (const auto& selected_indices : selected_per_class) {
+    num_selected += selected_indices.size();
+  }
+
   Tensor* output = ctx->Output(0, {static_cast<int64_t>(num_selected), last_dim});
   ORT_ENFORCE(output != nullptr);
   static_assert(last_dim * sizeof(int64_t) == sizeof(SelectedIndex), "Possible modification of SelectedIndex");
-  memcpy(output->MutableData<int64_t>(), selected_indices.data(), num_selected * sizeof(SelectedIndex));
+  auto* output_data = reinterpret_cast<SelectedIndex*>(output->MutableData<int64_t>());
+  for (const auto& selected_indices : selected_per_class) {
+    output_data = std::copy(selected_indices.begin(), selected_indices.end(), output_data);
+  }
 
   return Status::OK();
 }
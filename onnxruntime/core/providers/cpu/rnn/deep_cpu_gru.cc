@@ -492,21 +492,37 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
     gsl::span<T> hidden_output_2 = hidden_output.subspan(hidden_output_size_per_direction,
                                                          hidden_output_size_per_direction);
 
+    const bool concurrent = ComputeDirectionsConcurrently(thread_pool, batch_size, hidden_size_);
+    concurrency::ThreadPool* direction_thread_pool = concurrent ? nullptr : thread_pool;
     detail::UniDirectionalGru<T> fw(alloc, seq_length, batch_size, input_size, hidden_size_,
                                     linear_before_reset_ != 0, Direction::kForward, bias_1, initial_hidden_1,
                                     activation_funcs_.Entries()[0],
                                     activation_funcs_.Entries()[1],
-                                    clip_, thread_pool, &mlas_backend_kernel_selector_config_);
-    fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_ZR_1, recurrent_weights_H_1,
-               output_1, hidden_output_1);
-
+                                    clip_, direction_thread_pool, &mlas_backend_kernel_selector_config_);
     detail::UniDirectionalGru<T> bw(alloc, seq_length, batch_size, input_size, hidden_size_,
                                     linear_before_reset_ != 0, Direction::kReverse, bias_2, initial_hidden_2,
                                     activation_funcs_.Entries()[2],
                                     activation_funcs_.Entries()[3],
-                                    clip_, thread_pool, &mlas_backend_kernel_selector_config_);
-    bw.Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_ZR_2, recurrent_weights_H_2,
-               output_2, hidden_output_2);
+                                    clip_, direction_thread_pool, &mlas_backend_kernel_selector_config_);
+
+    ComputeBidirectional(
+        thread_pool, concurrent, seq_length, batch_size, input_size, hidden_size_,
+        [&](Direction direction, concurrency::ThreadPool* input_thread_pool) {
+          if (direction == Direction::kForward) {
+            fw.ApplyInputWeights(input, sequence_lens_span, input_weights_1, input_thread_pool);
+          } else {
+            bw.ApplyInputWeights(input, sequence_lens_span, input_weights_2, input_thread_pool);
+          }
+        },
+        [&](Direction direction) {
+          if (direction == Direction::kForward) {
+            fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_ZR_1,
+                       recurrent_weights_H_1, output_1, hidden_output_1);
+          } else {
+            bw.Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_ZR_2,
+                       recurrent_weights_H_2, output_2, hidden_output_2);
+          }
+        });
   } else {
     detail::UniDirectionalGru<T> gru_p(alloc, seq_length, batch_size, input_size, hidden_size_,
                                        linear_before_reset_ != 0, direction_, bias_1, initial_hidden_1,
@@ -643,64 +659,45 @@ void UniDirectionalGru<T>::Compute(gsl::span<const T> inputs_arg,
 }
 
 template <typename T>
-void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
-                                       gsl::span<const int> sequence_lengths_arg,
-                                       const int num_directions,
-                                       const GemmWeights<T>& input_weights_s,
-                                       const GemmWeights<T>& recurrent_weightsZR_s,
-                                       const GemmWeights<T>& recurrent_weightsH_s,
-                                       gsl::span<T>& outputs,
-                                       gsl::span<T>& final_hidden_state,
-                                       gsl::span<T>& zrh) {
-  using span_T_const_iter = typename gsl::span<const T>::iterator;
-  using span_T_iter = typename gsl::span<T>::iterator;
-
-  // copy inputs_arg as we may change it to point to inputs_reverse_
-  gsl::span<const T> inputs = inputs_arg;
-  gsl::span<const int> sequence_lengths = sequence_lengths_arg;
+void UniDirectionalGru<T>::ApplyInputWeights(gsl::span<const T> inputs,
+                                             gsl::span<const int> sequence_lengths,
+                                             const GemmWeights<T>& input_weights_s,
+                                             onnxruntime::concurrency::ThreadPool* thread_pool) {
+  ApplyInputWeightsImpl(inputs, GetSequenceLengths(sequence_lengths), input_weights_s, outputZRH_, thread_pool);
+  input_weights_applied_ = true;
+}
 
+template <typename T>
+gsl::span<const int> UniDirectionalGru<T>::GetSequenceLengths(gsl::span<const int> sequence_lengths) {
   // if sequence lengths weren't provided, use internal array and init all to seq_length
-  if (sequence_lengths.empty()) {
-    sequence_lengths_ = Allocate(allocator_, batch_size_, sequence_lengths_ptr_, true, seq_length_);
-    sequence_lengths = sequence_lengths_;
+  if (!sequence_lengths.empty()) {
+    return sequence_lengths;
   }
 
-  gsl::span<const T> input_weights;
-  if (!input_weights_s.is_prepacked_) {
-    input_weights = input_weights_s.GetUnpackedSpan();
-    DumpMatrix("Inputs", inputs.data(), seq_length_ * batch_size_, input_size_);
-    DumpMatrix("input_weights", input_weights.data(), 3 * hidden_size_, input_size_);
-    DumpMatrix("recurrent_weights", recurrent_weights.data(), 3 * hidden_size_, hidden_size_);
+  if (sequence_lengths_.empty()) {
+    sequence_lengths_ = Allocate(allocator_, batch_size_, sequence_lengths_ptr_, true, seq_length_);
   }
 
-  gsl::span<const T> recurrent_weightsZR;
-  if (!recurrent_weightsZR_s.is_prepacked_)
-    recurrent_weightsZR = recurrent_weightsZR_s.GetUnpackedSpan();
-
-  gsl::span<const T> recurrent_weightsH;
-  if (!recurrent_weightsH_s.is_prepacked_)
-    recurrent_weightsH = recurrent_weightsH_s.GetUnpackedSpan();
+  return sequence_lengths_;
+}
 
-  gsl::span<T> original_outputs = outputs;
-  const bool output_sequence = !outputs.empty();
+template <typename T>
+void UniDirectionalGru<T>::ApplyInputWeightsImpl(gsl::span<const T> inputs_arg,
+                                                 gsl::span<const int> sequence_lengths,
+                                                 const GemmWeights<T>& input_weights_s,
+                                                 gsl::span<T>& zrh,
+                                                 onnxruntime::concurrency::ThreadPool* thread_pool) {
+  // copy inputs_arg as we may change it to point to inputs_reverse_
+  gsl::span<const T> inputs = inputs_arg;
 
   if (direction_ == kReverse) {
-    ReverseSequence(inputs, inputs_reverse_, sequence_lengths, seq_length_, batch_size_, input_size_, 1, ttp_);
+    ReverseSequence(inputs, inputs_reverse_, sequence_lengths, seq_length_, batch_size_, input_size_, 1, thread_pool);
     // DumpMatrix("Reversed inputs", inputs_reverse_.data(), seq_length_ * batch_size_, input_size_);
 
     inputs = inputs_reverse_;
-
-    if (output_sequence) {
-      outputs = outputs_reverse_;
-    }
   }
 
-  // Calculate the max and min length
-  int32_t max_sequence_length = *std::max_element(sequence_lengths.begin(), sequence_lengths.end());
-  int32_t min_sequence_length = std::min(seq_length_, *std::min_element(sequence_lengths.begin(),
-                                                                        sequence_lengths.end()));
-
-  const int hidden_size_x2 = 2 * hidden_size_;
+  const int max_sequence_length = *std::max_element(sequence_lengths.begin(), sequence_lengths.end());
   const int hidden_size_x3 = 3 * hidden_size_;
   const int total_rows = max_sequence_length * batch_size_;
 
@@ -708,13 +705,17 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
 
   // apply weights to all the inputs
   if (!input_weights_s.is_prepacked_) {
+    gsl::span<const T> input_weights = input_weights_s.GetUnpackedSpan();
+    DumpMatrix("Inputs", inputs.data(), seq_length_ * batch_size_, input_size_);
+    DumpMatrix("input_weights", input_weights.data(), 3 * hidden_size_, input_size_);
+
     ComputeGemm(total_rows, hidden_size_x3, input_size_, alpha,
                 inputs.begin(), inputs.end(),
                 input_size_,
                 input_weights.begin(), input_weights.end(),
                 input_size_, 0.f,
                 zrh.begin(), zrh.end(),
-                hidden_size_x3, ttp_, mlas_backend_kernel_selector_config_);
+                hidden_size_x3, thread_pool, mlas_backend_kernel_selector_config_);
   } else {
     MlasGemm(
         CblasNoTrans,
@@ -727,7 +728,52 @@ void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs_arg,
         input_weights_s.buffer_,
         0.0f,
         &*zrh.begin(),
-        static_cast<size_t>(hidden_size_x3), ttp_, mlas_backend_kernel_selector_config_);
+        static_cast<size_t>(hidden_size_x3), thread_pool, mlas_backend_kernel_selector_config_);
+  }
+}
+
+template <typename T>
+void UniDirectionalGru<T>::ComputeImpl(gsl::span<const T> inputs,
+                                       gsl::span<const int> sequence_lengths_arg,
+                                       const int num_directions,
+                                       const GemmWeights<T>& input_weights_s,
+                                       const GemmWeights<T>& recurrent_weightsZR_s,
+                                       const GemmWeights<T>& recurrent_weightsH_s,
+                                       gsl::span<T>& outputs,
+                                       gsl::span<T>& final_hidden_state,
+                                       gsl::span<T>& zrh) {
+  using span_T_const_iter = typename gsl::span<const T>::iterator;
+  using span_T_iter = typename gsl::span<T>::iterator;
+
+  gsl::span<const int> sequence_lengths = GetSequenceLengths(sequence_lengths_arg);
+
+  gsl::span<const T> recurrent_weightsZR;
+  if (!recurrent_weightsZR_s.is_prepacked_)
+    recurrent_weightsZR = recurrent_weightsZR_s.GetUnpackedSpan();
+
+  gsl::span<const T> recurrent_weightsH;
+  if (!recurrent_weightsH_s.is_prepacked_)
+    recurrent_weightsH = recurrent_weightsH_s.GetUnpackedSpan();
+
+  gsl::span<T> original_outputs = outputs;
+  const bool output_sequence = !outputs.empty();
+
+  if (direction_ == kReverse && output_sequence) {
+    outputs = outputs_reverse_;
+  }
+
+  // Calculate the max and min length
+  int32_t max_sequence_length = *std::max_element(sequence_lengths.begin(), sequence_lengths.end());
+  int32_t min_sequence_length = std::min(seq_length_, *std::min_element(sequence_lengths.begin(),
+                                                                        sequence_lengths.end()));
+
+  const int hidden_size_x2 = 2 * hidden_size_;
+  const int hidden_size_x3 = 3 * hidden_size_;
+
+  float alpha = 1.0f;
+
+  if (!input_weights_applied_) {
+    ApplyInputWeightsImpl(inputs, sequence_lengths, input_weights_s, zrh, ttp_);
   }
 
   DumpMatrix("inputs with weights applied", zrh.data(), seq_length_ * batch_size_ * 3, hidden_size_);
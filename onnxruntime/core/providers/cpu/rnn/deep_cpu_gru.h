@@ -129,9 +129,21 @@ class UniDirectionalGru {
                gsl::span<T>& outputs, gsl::span<T>& final_hidden_state,
                gsl::span<T>& zrh);
 
+  // Applies the input weights to all the steps ahead of Compute, with the given thread pool instead of the one the
+  // recurrent steps run with. Only for the Compute overload without zrh.
+  void ApplyInputWeights(gsl::span<const T> inputs, gsl::span<const int> sequence_lengths,
+                         const rnn::detail::GemmWeights<T>& input_weights,
+                         onnxruntime::concurrency::ThreadPool* thread_pool);
+
   ~UniDirectionalGru() = default;
 
  private:
+  gsl::span<const int> GetSequenceLengths(gsl::span<const int> sequence_lengths);
+
+  void ApplyInputWeightsImpl(gsl::span<const T> inputs, gsl::span<const int> sequence_lengths,
+                             const rnn::detail::GemmWeights<T>& input_weights, gsl::span<T>& zrh,
+                             onnxruntime::concurrency::ThreadPool* thread_pool);
+
   void ComputeImpl(gsl::span<const T> inputs, gsl::span<const int> sequence_lengths, int num_directions,
                    const rnn::detail::GemmWeights<T>& input_weights,
                    const rnn::detail::GemmWeights<T>& recurrent_weights_ZR,
@@ -202,6 +214,9 @@ class UniDirectionalGru {
   const MLAS_BACKEND_KERNEL_SELECTOR_CONFIG* mlas_backend_kernel_selector_config_;
 
   const bool training_mode_ = false;
+
+  // set by ApplyInputWeights, in which case outputZRH_ already holds the weighted inputs
+  bool input_weights_applied_ = false;
 };
 }  // namespace detail
 
@@ -143,20 +143,36 @@ Status LSTMBase::ComputeImpl(OpKernelContext& context,
         hidden_output.subspan(hidden_output_size_per_direction, hidden_output_size_per_direction);
     gsl::span<InputT> last_cell_2 = last_cell.subspan(last_cell_size_per_direction, last_cell_size_per_direction);
 
+    const bool concurrent = ComputeDirectionsConcurrently(thread_pool, batch_size, hidden_size_);
+    concurrency::ThreadPool* direction_thread_pool = concurrent ? nullptr : thread_pool;
     lstm::UniDirectionalLstm<InputT> fw(alloc, logger, seq_length, batch_size, input_size, hidden_size_,
                                         Direction::kForward, input_forget_, bias_1, peephole_weights_1, initial_hidden_1,
                                         initial_cell_1, activation_funcs_.Entries()[0], activation_funcs_.Entries()[1],
-                                        activation_funcs_.Entries()[2], clip_, thread_pool, &mlas_backend_kernel_selector_config_);
+                                        activation_funcs_.Entries()[2], clip_, direction_thread_pool, &mlas_backend_kernel_selector_config_);
 
     lstm::UniDirectionalLstm<InputT> bw(alloc, logger, seq_length, batch_size, input_size, hidden_size_,
                                         Direction::kReverse, input_forget_, bias_2, peephole_weights_2, initial_hidden_2,
                                         initial_cell_2, activation_funcs_.Entries()[3], activation_funcs_.Entries()[4],
-                                        activation_funcs_.Entries()[5], clip_, thread_pool, &mlas_backend_kernel_selector_config_);
-
-    fw.Compute(input, sequence_lens_span, num_directions_, W_1, R_1, output_1,
-               hidden_output_1, last_cell_1);
-    bw.Compute(input, sequence_lens_span, num_directions_, W_2, R_2, output_2,
-               hidden_output_2, last_cell_2);
+                                        activation_funcs_.Entries()[5], clip_, direction_thread_pool, &mlas_backend_kernel_selector_config_);
+
+    ComputeBidirectional(
+        thread_pool, concurrent, seq_length, batch_size, input_size, hidden_size_,
+        [&](Direction direction, concurrency::ThreadPool* input_thread_pool) {
+          if (direction == Direction::kForward) {
+            fw.ApplyInputWeights(input, sequence_lens_span, W_1, input_thread_pool);
+          } else {
+            bw.ApplyInputWeights(input, sequence_lens_span, W_2, input_thread_pool);
+          }
+        },
+        [&](Direction direction) {
+          if (direction == Direction::kForward) {
+            fw.Compute(input, sequence_lens_span, num_directions_, W_1, R_1, output_1,
+                       hidden_output_1, last_cell_1);
+          } else {
+            bw.Compute(input, sequence_lens_span, num_directions_, W_2, R_2, output_2,
+                       hidden_output_2, last_cell_2);
+          }
+        });
   } else {
     lstm::UniDirectionalLstm<InputT> fw(alloc, logger, seq_length, batch_size, input_size, hidden_size_, direction_,
                                         input_forget_, bias_1, peephole_weights_1, initial_hidden_1, initial_cell_1,
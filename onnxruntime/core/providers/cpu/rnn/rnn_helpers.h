@@ -68,6 +68,58 @@ gsl::span<TAlloc> Allocate(std::shared_ptr<IAllocator> allocator,
   return span;
 }
 
+/** Whether the recurrent steps of the forward and reverse directions of a bidirectional LSTM or GRU run concurrently.
+@param thread_pool Thread pool of the operator.
+@param batch_size Number of sequences in the batch.
+@param hidden_size Number of neurons in the hidden layer.
+
+The directions are independent. When a time step is too small to be split efficiently across the threads of the
+pool, which is the case of a single utterance in speech models, they run concurrently with a single thread each.
+That halves the number of sequential steps. Otherwise they run one after the other with the whole pool.
+*/
+inline bool ComputeDirectionsConcurrently(const concurrency::ThreadPool* thread_pool, int batch_size, int hidden_size) {
+  constexpr int64_t max_concurrent_step_size = 256 * 256;
+  return concurrency::ThreadPool::DegreeOfParallelism(thread_pool) > 1 &&
+         int64_t{batch_size} * hidden_size * hidden_size <= max_concurrent_step_size;
+}
+
+/** Compute the forward and reverse directions of a bidirectional LSTM or GRU.
+@param thread_pool Thread pool of the operator.
+@param concurrent Result of ComputeDirectionsConcurrently. If set, the directions must compute their recurrent steps
+without a thread pool, as the thread pool does not support nested parallel loops.
+@param seq_length Number of steps of the sequences.
+@param batch_size Number of sequences in the batch.
+@param input_size Number of features of the input.
+@param hidden_size Number of neurons in the hidden layer.
+@param apply_input_weights Callable with the signature void(Direction direction, concurrency::ThreadPool* thread_pool)
+that applies the input weights to all the steps of one direction using thread_pool.
+@param compute_direction Callable with the signature void(Direction direction) that computes one direction, applying
+the input weights first unless apply_input_weights was called for it.
+
+When the directions run concurrently, the input weights are applied to both of them beforehand with the whole pool
+unless the GEMM is too small to be split, so that only the recurrent steps run on a single thread.
+*/
+template <typename TApplyInputWeights, typename TComputeDirection>
+void ComputeBidirectional(concurrency::ThreadPool* thread_pool, bool concurrent,
+                          int seq_length, int batch_size, int input_size, int hidden_size,
+                          const TApplyInputWeights& apply_input_weights, const TComputeDirection& compute_direction) {
+  if (!concurrent) {
+    compute_direction(kForward);
+    compute_direction(kReverse);
+    return;
+  }
+
+  constexpr int64_t min_split_input_gemm_size = 64 * 1024;
+  if (int64_t{seq_length} * batch_size * input_size * hidden_size >= min_split_input_gemm_size) {
+    apply_input_weights(kForward, thread_pool);
+    apply_input_weights(kReverse, thread_pool);
+  }
+
+  concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, 2, [&compute_direction](std::ptrdiff_t direction) {
+    compute_direction(direction == 0 ? kForward : kReverse);
+  });
+}
+
 // validate the common inputs to RNN, LSTM and GRU operators
 Status ValidateCommonRnnInputs(const Tensor& X,
                                const TensorShape& W_shape,
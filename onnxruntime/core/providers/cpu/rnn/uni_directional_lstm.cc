@@ -222,23 +222,71 @@ void UniDirectionalLstm<T>::AllocateQuantizeBuffers(int max_sequence_length) {
   }
 }
 
+template <typename T>
+gsl::span<const int> UniDirectionalLstm<T>::GetSequenceLengths(const gsl::span<const int>& sequence_lengths) {
+  // if sequence lengths weren't provided, use internal array and init all to seq_length
+  if (!sequence_lengths.empty()) {
+    return sequence_lengths;
+  }
+
+  if (sequence_lengths_.empty()) {
+    sequence_lengths_ = Allocate(allocator_, batch_size_, sequence_lengths_ptr_, true, seq_length_);
+  }
+
+  return sequence_lengths_;
+}
+
+template <typename T>
+template <typename WeightT>
+void UniDirectionalLstm<T>::ApplyInputWeightsImpl(const gsl::span<const T>& inputs_arg,
+                                                  const gsl::span<const int>& sequence_lengths,
+                                                  const GemmWeights<WeightT>& input_weights,
+                                                  gsl::span<T>& output_iofc, concurrency::ThreadPool* thread_pool) {
+  // copy the span as we may change it to point to inputs_reverse_
+  gsl::span<const T> inputs = inputs_arg;
+
+  if (direction_ == kReverse) {
+    ReverseSequence(inputs, inputs_reverse_, sequence_lengths, seq_length_, batch_size_, input_size_, 1, thread_pool);
+    inputs = inputs_reverse_;
+  }
+
+  // DumpMatrix("Input", inputs.data(), seq_length_, batch_size_ * input_size_);
+
+  const int max_sequence_length = *std::max_element(sequence_lengths.begin(), sequence_lengths.end());
+  const int hidden_size_x4 = 4 * hidden_size_;
+  const int total_rows = max_sequence_length * batch_size_;
+
+  AllocateQuantizeBuffers<WeightT>(max_sequence_length);
+
+  // apply the weights to all the inputs and save to output_IOFC
+  ComputeGemm(total_rows, hidden_size_x4, input_size_, 1.0f, inputs,
+              input_weights,
+              0.0f, output_iofc, hidden_size_x4,
+              quantized_input_or_a_.data(),
+              nullptr,
+              thread_pool,
+              mlas_backend_kernel_selector_config_);
+}
+
+template <typename T>
+template <typename WeightT>
+void UniDirectionalLstm<T>::ApplyInputWeights(const gsl::span<const T>& inputs,
+                                              const gsl::span<const int>& sequence_lengths,
+                                              const GemmWeights<WeightT>& input_weights,
+                                              concurrency::ThreadPool* thread_pool) {
+  ApplyInputWeightsImpl(inputs, GetSequenceLengths(sequence_lengths), input_weights, output_iofc_, thread_pool);
+  input_weights_applied_ = true;
+}
+
 template <typename T>
 template <typename WeightT>
-void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
+void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs,
                                         const gsl::span<const int>& sequence_lengths_arg, const int num_directions,
                                         const GemmWeights<WeightT>& input_weights, const GemmWeights<WeightT>& recurrent_weights,
                                         gsl::span<T>& outputs, gsl::span<T>& final_hidden_state,
                                         gsl::span<T>& final_cell_state, gsl::span<T>& all_cell_states,
                                         gsl::span<T>& output_iofc) {
-  // copy spans (just T* and size, not data in span) as we may change them
-  gsl::span<const T> inputs = inputs_arg;
-  gsl::span<const int> sequence_lengths = sequence_lengths_arg;
-
-  // if sequence lengths weren't provided, use internal array and init all to seq_length
-  if (sequence_lengths.empty()) {
-    sequence_lengths_ = Allocate(allocator_, batch_size_, sequence_lengths_ptr_, true, seq_length_);
-    sequence_lengths = sequence_lengths_;
-  }
+  gsl::span<const int> sequence_lengths = GetSequenceLengths(sequence_lengths_arg);
 
   // LSTM Layer
   gsl::span<const T> batched_hidden_state_one_step = batched_hidden0_;
@@ -260,16 +308,10 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
   gsl::span<T> original_outputs = outputs;
   const bool output_sequence = !outputs.empty();
 
-  if (direction_ == kReverse) {
-    ReverseSequence(inputs, inputs_reverse_, sequence_lengths, seq_length_, batch_size_, input_size_, 1, thread_pool_);
-    inputs = inputs_reverse_;
-
-    if (output_sequence)
-      outputs = outputs_reverse_;
+  if (direction_ == kReverse && output_sequence) {
+    outputs = outputs_reverse_;
   }
 
-  // DumpMatrix("Input", inputs.data(), seq_length_, batch_size_ * input_size_);
-
   // Calculate the max and min length
   const auto min_max_pair = std::minmax_element(sequence_lengths.begin(), sequence_lengths.end());
   int max_sequence_length = *min_max_pair.second;
@@ -277,26 +319,17 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
 
   ///**************************LSTM Calculations****************************/
   float alpha = 1.0f;
-  float beta = 0.0f;  // first call to ComputeGemm zeros out any existing data
+  float beta = 1.0f;  // calls to ComputeGemm add to the weighted inputs
 
   const int hidden_size_x4 = 4 * hidden_size_;
   const int total_rows = max_sequence_length * batch_size_;
 
-  AllocateQuantizeBuffers<WeightT>(max_sequence_length);
-
-  // apply the weights to all the inputs and save to output_IOFC
-  ComputeGemm(total_rows, hidden_size_x4, input_size_, alpha, inputs,
-              input_weights,
-              beta, output_iofc, hidden_size_x4,
-              quantized_input_or_a_.data(),
-              nullptr,
-              thread_pool_,
-              mlas_backend_kernel_selector_config_);
+  if (!input_weights_applied_) {
+    ApplyInputWeightsImpl(inputs, sequence_lengths, input_weights, output_iofc, thread_pool_);
+  }
 
   DumpMatrix("Xt*(W[iofc]^T)", output_iofc.data(), total_rows, hidden_size_x4);
 
-  beta = 1.0f;  // calls to ComputeGemm now add to existing data
-
   // NOTE: we could refine the bounds checking in the calls below that use these values to instead
   // explicitly check just the range for each iteration, however if it's going to run over
   // it should also run over on the last iteration, so this should be good enough to catch any
@@ -659,5 +692,13 @@ template void UniDirectionalLstm<float>::Compute<uint8_t>(
     gsl::span<float>& outputs,
     gsl::span<float>& final_hidden_state, gsl::span<float>& final_cell_state);
 
+template void UniDirectionalLstm<float>::ApplyInputWeights<float>(
+    const gsl::span<const float>& inputs, const gsl::span<const int>& sequence_lengths,
+    const GemmWeights<float>& input_weights, concurrency::ThreadPool* thread_pool);
+
+template void UniDirectionalLstm<float>::ApplyInputWeights<uint8_t>(
+    const gsl::span<const float>& inputs, const gsl::span<const int>& sequence_lengths,
+    const GemmWeights<uint8_t>& input_weights, concurrency::ThreadPool* thread_pool);
+
 }  // namespace lstm
 }  // namespace onnxruntime
@@ -48,11 +48,24 @@ class UniDirectionalLstm {
                gsl::span<T>& final_hidden_state, gsl::span<T>& final_cell_state, gsl::span<T>& all_cell_states,
                gsl::span<T>& iofc);
 
+  // Applies the input weights to all the steps ahead of Compute, with the given thread pool instead of the one the
+  // recurrent steps run with. Only for the Compute overload without iofc.
+  template <typename WeightT>
+  void ApplyInputWeights(const gsl::span<const T>& inputs, const gsl::span<const int>& sequence_lengths,
+                         const GemmWeights<WeightT>& input_weights, concurrency::ThreadPool* thread_pool);
+
   ~UniDirectionalLstm() = default;
 
  private:
   using span_T_iter = typename gsl::span<T>::iterator;
 
+  gsl::span<const int> GetSequenceLengths(const gsl::span<const int>& sequence_lengths);
+
+  template <typename WeightT>
+  void ApplyInputWeightsImpl(const gsl::span<const T>& inputs, const gsl::span<const int>& sequence_lengths,
+                             const GemmWeights<WeightT>& input_weights, gsl::span<T>& output_iofc,
+                             concurrency::ThreadPool* thread_pool);
+
   void SetNumThreads();
 
   void GateComputations(span_T_iter& out, span_T_iter& out_end, span_T_iter& C_prev,
@@ -143,6 +156,9 @@ class UniDirectionalLstm {
   gsl::span<int32_t> quantized_C_buffer_;
 
   const bool training_mode_ = false;
+
+  // set by ApplyInputWeights, in which case output_iofc_ already holds the weighted inputs
+  bool input_weights_applied_ = false;
 };
 
 }  // namespace lstm
@@ -3,6 +3,10 @@
 
 #include "core/providers/cpu/tensor/compress.h"
 #include "core/providers/common.h"
+#include "core/providers/cpu/tensor/select_helpers.h"
+
+#include <algorithm>
+
 using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
@@ -25,6 +29,30 @@ ONNX_CPU_OPERATOR_KERNEL(
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<bool>()),
     Compress);
 
+namespace {
+
+// Copies the entries of input in [begin, end) whose condition is true to output.
+template <typename T>
+void CompressBlock(const T* input, const bool* condition, int64_t begin, int64_t end, T* output) {
+  for (int64_t i = begin; i < end; ++i) {
+    if (condition[i]) {
+      *output++ = input[i];
+    }
+  }
+}
+
+template <typename T>
+void CompressFlattened(concurrency::ThreadPool* thread_pool, const void* input_data, const bool* condition,
+                       int64_t length, const std::vector<int64_t>& offsets, void* output_data) {
+  const T* input = static_cast<const T*>(input_data);
+  T* output = static_cast<T*>(output_data);
+  select_helpers::SelectBlocks(thread_pool, length, offsets, [&](int64_t begin, int64_t end, int64_t output_offset) {
+    CompressBlock(input, condition, begin, end, output + output_offset);
+  });
+}
+
+}  // namespace
+
 Status Compress::Compute(OpKernelContext* ctx) const {
   const auto* input_tensor = ctx->Input<Tensor>(0);
   size_t rank = input_tensor->Shape().NumDimensions();
@@ -38,17 +66,18 @@ Status Compress::Compute(OpKernelContext* ctx) const {
   auto condition_length = condition->Shape().Size();
   auto condition_data = condition->Data<bool>();
 
-  int64_t positive_condition_count = 0;
   // if has axis, we need to compress on dimension[axis], otherwise compress on the flattened input data
   int64_t compress_input_length = has_axis_ ? input_dimensions[onnxruntime::narrow<size_t>(axis)] : input_tensor->Shape().Size();
   int64_t valid_condition_length = compress_input_length < condition_length ? compress_input_length : condition_length;
 
-  // Figure out output shape
-  for (int i = 0; i < valid_condition_length; ++i) {
-    if (condition_data[i]) {
-      ++positive_condition_count;
-    }
-  }
+  // Figure out output shape. The condition is counted in blocks, which are the blocks the flattened input is
+  // compressed in.
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+  const auto offsets = select_helpers::CountSelected(
+      thread_pool, valid_condition_length, [condition_data](int64_t begin, int64_t end) {
+        return static_cast<int64_t>(std::count(condition_data + begin, condition_data + end, true));
+      });
+  const int64_t positive_condition_count = offsets.back();
 
   std::vector<int64_t> output_dims(input_dimensions.begin(), input_dimensions.end());
   if (has_axis_) {
@@ -68,7 +97,6 @@ Status Compress::Compute(OpKernelContext* ctx) const {
   auto* output_data = static_cast<uint8_t*>(output_tensor->MutableDataRaw());
   auto element_bytes = input_tensor->DataType()->Size();
   bool is_string_type = input_tensor->IsDataTypeString();
-  int64_t output_index = 0;
 
   if (has_axis_) {
     int64_t axes_left_stride = 1;
@@ -81,41 +109,74 @@ Status Compress::Compute(OpKernelContext* ctx) const {
       axes_right_stride *= input_dimensions[i];
     }
     int64_t axes_included_right_stride = axes_right_stride * input_dimensions[onnxruntime::narrow<size_t>(axis)];
-    int64_t axes_included_right_stride_bytes = axes_included_right_stride * element_bytes;
     ORT_ENFORCE(axes_right_stride >= 0 &&
                 static_cast<uint64_t>(axes_right_stride) < std::numeric_limits<size_t>::max());
     size_t axes_right_stride_bytes = 0;
     if (!IAllocator::CalcMemSizeForArray(static_cast<size_t>(axes_right_stride), element_bytes,
                                          &axes_right_stride_bytes))
       return Status(ONNXRUNTIME, FAIL, "size overflow");
-    for (int i = 0; i < axes_left_stride; ++i) {
-      for (int j = 0; j < valid_condition_length; ++j) {
-        if (!condition_data[j]) {
-          continue;
-        }
-        if (is_string_type) {
-          for (int idxItem = 0; idxItem < axes_right_stride; ++idxItem) {
-            reinterpret_cast<std::string*>(output_data)[output_index + idxItem] =
-                reinterpret_cast<const std::string*>(input_data)[i * axes_included_right_stride + j * axes_right_stride + idxItem];
-          }
-          output_index += axes_right_stride;
-        } else {
-          memcpy(output_data + output_index, input_data + i * axes_included_right_stride_bytes + j * axes_right_stride_bytes, axes_right_stride_bytes);
-          output_index += axes_right_stride_bytes;
-        }
+
+    std::vector<int64_t> selected_indices;
+    selected_indices.reserve(onnxruntime::narrow<size_t>(positive_condition_count));
+    for (int64_t j = 0; j < valid_condition_length; ++j) {
+      if (condition_data[j]) {
+        selected_indices.push_back(j);
       }
     }
+
+    // every output slice of axes_right_stride elements is copied from one input slice, in parallel.
+    const double slice_bytes = static_cast<double>(axes_right_stride_bytes);
+    concurrency::ThreadPool::TryParallelFor(
+        thread_pool, static_cast<std::ptrdiff_t>(axes_left_stride * positive_condition_count),
+        {slice_bytes, slice_bytes, static_cast<double>(axes_right_stride)},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t output_slice = first; output_slice < last; ++output_slice) {
+            const int64_t i = output_slice / positive_condition_count;
+            const int64_t j = selected_indices[onnxruntime::narrow<size_t>(output_slice % positive_condition_count)];
+            const int64_t input_offset = i * axes_included_right_stride + j * axes_right_stride;
+            const int64_t output_offset = output_slice * axes_right_stride;
+            if (is_string_type) {
+              std::copy_n(reinterpret_cast<const std::string*>(input_data) + input_offset, axes_right_stride,
+                          reinterpret_cast<std::string*>(output_data) + output_offset);
+            } else {
+              memcpy(output_data + output_offset * element_bytes, input_data + input_offset * element_bytes,
+                     axes_right_stride_bytes);
+            }
+          }
+        });
+  } else if (is_string_type) {
+    CompressFlattened<std::string>(thread_pool, input_data, condition_data, valid_condition_length, offsets,
+                                   output_data);
   } else {
-    for (int i = 0; i < valid_condition_length; ++i) {
-      if (!condition_data[i]) {
-        continue;
-      }
-      if (is_string_type) {
-        reinterpret_cast<std::string*>(output_data)[output_index] = reinterpret_cast<const std::string*>(input_data)[i];
-      } else {
-        memcpy(output_data + output_index * element_bytes, input_data + i * element_bytes, element_bytes);
-      }
-      ++output_index;
+    switch (element_bytes) {
+      case sizeof(uint8_t):
+        CompressFlattened<uint8_t>(thread_pool, input_data, condition_data, valid_condition_length, offsets,
+                                   output_data);
+        break;
+      case sizeof(uint16_t):
+        CompressFlattened<uint16_t>(thread_pool, input_data, condition_data, valid_condition_length, offsets,
+                                    output_data);
+        break;
+      case sizeof(uint32_t):
+        CompressFlattened<uint32_t>(thread_pool, input_data, condition_data, valid_condition_length, offsets,
+                                    output_data);
+        break;
+      case sizeof(uint64_t):
+        CompressFlattened<uint64_t>(thread_pool, input_data, condition_data, valid_condition_length, offsets,
+                                    output_data);
+        break;
+      default:
+        select_helpers::SelectBlocks(
+            thread_pool, valid_condition_length, offsets, [&](int64_t begin, int64_t end, int64_t output_offset) {
+              auto* output = output_data + output_offset * element_bytes;
+              for (int64_t i = begin; i < end; ++i) {
+                if (condition_data[i]) {
+                  memcpy(output, input_data + i * element_bytes, element_bytes);
+                  output += element_bytes;
+                }
+              }
+            });
+        break;
     }
   }
 
@@ -3,10 +3,12 @@
 
 #include "core/providers/cpu/tensor/nonzero_op.h"
 
+#include <algorithm>
 #include <cassert>
-#include <vector>
-#include <core/common/safeint.h>
-#include "core/util/math_cpuonly.h"
+
+#include "core/common/inlined_containers.h"
+#include "core/common/narrow.h"
+#include "core/providers/cpu/tensor/select_helpers.h"
 
 namespace onnxruntime {
 // kernel builder functions
@@ -59,25 +61,43 @@ Status NonZero<T>::Compute(OpKernelContext* context) const {
   const auto& X_shape = X->Shape();
   assert(X_shape.Size() >= 0);
 
-  const Eigen::Index coordinate_size = X_shape.IsScalar() ? 1 : onnxruntime::narrow<Eigen::Index>(X_shape.NumDimensions());
-  std::vector<int64_t> non_zero_indices_buffer{};
-  // reserve enough space for indices for every element of X
-  non_zero_indices_buffer.reserve(SafeInt<size_t>(X_shape.Size()) * coordinate_size);
-
   const T* data = X->Data<T>();
 
   if (X_shape.IsScalar()) {
-    const T& value = *data;
-    if (value != T{}) {
-      non_zero_indices_buffer.push_back(0);
+    const int64_t num_non_zero_values = *data != T{} ? 1 : 0;
+    Tensor* const Y = context->Output(0, {1, num_non_zero_values});
+    ORT_ENFORCE(Y, "failed to get first output!");
+    if (num_non_zero_values > 0) {
+      *Y->MutableData<int64_t>() = 0;
+    }
+    return Status::OK();
+  }
+
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+  const int64_t size = X_shape.Size();
+  const auto offsets = select_helpers::CountSelected(thread_pool, size, [data](int64_t begin, int64_t end) {
+    return static_cast<int64_t>(std::count_if(data + begin, data + end, [](const T& value) { return value != T{}; }));
+  });
+  const int64_t num_non_zero_values = offsets.back();
+
+  const size_t coordinate_size = X_shape.NumDimensions();
+  Tensor* const Y = context->Output(0, {static_cast<int64_t>(coordinate_size), num_non_zero_values});
+  ORT_ENFORCE(Y, "failed to get first output!");
+  int64_t* y_data = Y->MutableData<int64_t>();
+
+  // the output is [coordinate_size, num_non_zero_values], so each block writes the columns from its offset.
+  select_helpers::SelectBlocks(thread_pool, size, offsets, [&](int64_t begin, int64_t end, int64_t output_offset) {
+    InlinedVector<int64_t> coordinate(coordinate_size, 0);
+    for (size_t idx = coordinate_size, remaining = onnxruntime::narrow<size_t>(begin); idx-- > 0;) {
+      const auto dim = onnxruntime::narrow<size_t>(X_shape[idx]);
+      coordinate[idx] = static_cast<int64_t>(remaining % dim);
+      remaining /= dim;
     }
-  } else {
-    std::vector<int64_t> coordinate(coordinate_size, 0);
 
     // as we iterate the entries, increment the coordinate for the current entry
     // e.g. if shape is {2,2}, we start with 0,0 increment to 0,1 increment to 1,0 and finally 1,1
-    auto increment_coordinate = [&coordinate, &coordinate_size, &X_shape]() {
-      for (Eigen::Index idx = coordinate_size - 1; idx >= 0; --idx) {
+    auto increment_coordinate = [&coordinate, coordinate_size, &X_shape]() {
+      for (size_t idx = coordinate_size; idx-- > 0;) {
         int64_t& cur_coord = coordinate[idx];
         if (cur_coord != X_shape[idx] - 1) {
           ++cur_coord;
@@ -87,31 +107,18 @@ Status NonZero<T>::Compute(OpKernelContext* context) const {
       }
     };
 
-    for (size_t i = 0, end = onnxruntime::narrow<size_t>(X_shape.Size()); i < end; ++i) {
-      const T& value = *data++;
-      if (value != T{}) {
-        non_zero_indices_buffer.insert(non_zero_indices_buffer.end(),
-                                       coordinate.begin(), coordinate.end());
+    int64_t column = output_offset;
+    for (int64_t i = begin; i < end; ++i) {
+      if (data[i] != T{}) {
+        for (size_t idx = 0; idx < coordinate_size; ++idx) {
+          y_data[idx * num_non_zero_values + column] = coordinate[idx];
+        }
+        ++column;
       }
 
       increment_coordinate();
     }
-  }
-
-  const Eigen::Index num_non_zero_values = onnxruntime::narrow<Eigen::Index>(non_zero_indices_buffer.size()) / coordinate_size;
-
-  // transpose result for output
-  ConstEigenMatrixMapRowMajor<int64_t> non_zero_indices_matrix{
-      non_zero_indices_buffer.data(),
-      num_non_zero_values, coordinate_size};
-
-  Tensor* const Y = context->Output(0, {coordinate_size, num_non_zero_values});
-  ORT_ENFORCE(Y, "failed to get first output!");
-
-  EigenMatrixMapRowMajor<int64_t> y_matrix{
-      Y->MutableData<int64_t>(),
-      coordinate_size, num_non_zero_values};
-  y_matrix = non_zero_indices_matrix.transpose();
+  });
 
   return Status::OK();
 }
@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/tensor/pad.h"
 
+#include "core/framework/copy.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/providers/common.h"
 #include "core/providers/cpu/tensor/utils.h"
@@ -403,6 +404,31 @@ static void PadAxisConstant(OutputSink<T>& sink, T* output, T constant, size_t s
   }
 }
 
+// Constant padding that is split across threads. The output is filled with the constant and the input is then copied
+// into it with a strided copy. This writes the copied elements twice, so it's only used when there are threads to
+// share the work.
+template <typename T>
+static void PadConstantParallel(concurrency::ThreadPool* thread_pool, T* output, size_t total_output_elems, T value,
+                                const T* input, const TensorShapeVector& input_dims,
+                                gsl::span<const int64_t> input_starts, const TensorShapeVector& copy_dims,
+                                const TensorPitches& output_pitches, size_t output_offset) {
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(total_output_elems),
+      {0.0F, static_cast<float>(sizeof(T)), 1.0F},
+      [output, value](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::fill(output + first, output + last, value);
+      });
+
+  const TensorPitches input_pitches(input_dims);
+  std::ptrdiff_t input_offset = 0;
+  for (size_t i = 0; i < input_dims.size(); ++i) {
+    input_offset += narrow<std::ptrdiff_t>(input_starts[i] * input_pitches[i]);
+  }
+
+  StridedCopy<T>(thread_pool, output + output_offset, output_pitches, TensorShape(copy_dims),
+                 input + input_offset, input_pitches);
+}
+
 template <typename T>
 static Status PadImpl(OpKernelContext* ctx,
                       const PadsVector& pads,
@@ -538,6 +564,13 @@ static Status PadImpl(OpKernelContext* ctx,
 
   switch (mode) {
     case Mode::Constant:
+      if (concurrency::ThreadPool::DegreeOfParallelism(ctx->GetOperatorThreadPool()) > 1) {
+        PadConstantParallel<T>(ctx->GetOperatorThreadPool(), output, total_output_elems, value,
+                               reinterpret_cast<const T*>(input_tensor.DataRaw()), reshaped_input_dims,
+                               input_starts, effective_input_extents, output_pitches, align_skip);
+        break;
+      }
+
       // Loop over the output tensor, writing out padding between the blocks of copied data
       // On loop entry, 'pad' is already set to the first continuous block of padding, and
       // after every pass through the inner loop it gets set to the next continuous pad size.
@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+// Helpers for ops whose output holds the selected entries of their input, e.g. NonZero and Compress.
+// The output size depends on the data, so the input is split into blocks that are processed in two parallel passes:
+// the first counts the selected entries of each block, and the second writes them at the offset of the block, which is
+// the sum of the counts of the blocks before it.
+namespace select_helpers {
+
+// Number of input entries in a block.
+constexpr int64_t kBlockSize = 16384;
+
+// Counts the selected entries of every block of [0, size) with count(begin, end), and returns the offset of each block
+// in the output followed by the total count.
+template <typename TCount>
+std::vector<int64_t> CountSelected(concurrency::ThreadPool* thread_pool, int64_t size, const TCount& count) {
+  const int64_t num_blocks = (size + kBlockSize - 1) / kBlockSize;
+  std::vector<int64_t> offsets(static_cast<size_t>(num_blocks + 1), 0);
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(num_blocks), [&](std::ptrdiff_t block) {
+        const int64_t begin = block * kBlockSize;
+        offsets[block + 1] = count(begin, std::min(size, begin + kBlockSize));
+      });
+
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  return offsets;
+}
+
+// Calls select(begin, end, output_offset) for every block of [0, size) that has selected entries, where output_offset
+// is the offset of the block returned by CountSelected.
+template <typename TSelect>
+void SelectBlocks(concurrency::ThreadPool* thread_pool, int64_t size, const std::vector<int64_t>& offsets,
+                  const TSelect& select) {
+  const int64_t num_blocks = static_cast<int64_t>(offsets.size()) - 1;
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(num_blocks), [&](std::ptrdiff_t block) {
+        if (offsets[block + 1] != offsets[block]) {
+          const int64_t begin = block * kBlockSize;
+          select(begin, std::min(size, begin + kBlockSize), offsets[block]);
+        }
+      });
+}
+
+}  // namespace select_helpers
+}  // namespace onnxruntime
@@ -7,6 +7,7 @@
 #include <unordered_map>
 
 #include "core/common/narrow.h"
+#include "core/framework/copy.h"
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/providers/common.h"
@@ -70,10 +71,11 @@ ONNX_CPU_OPERATOR_KERNEL(
         .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
     Slice10);
 
-template <typename T>
+// Slicing is a strided copy from the input to the output. The input strides are the input pitches scaled by the
+// steps, which may be negative, and the copy starts at the element given by the starts.
 static Status SliceImpl(OpKernelContext* ctx,
                         const Tensor& input_tensor,
-                        SliceOp::PrepareForComputeMetadata& compute_metadata) {
+                        const SliceOp::PrepareForComputeMetadata& compute_metadata) {
   TensorShape output_shape(compute_metadata.output_dims_);
   auto& output_tensor = *ctx->Output(0, output_shape);
 
@@ -81,44 +83,25 @@ static Status SliceImpl(OpKernelContext* ctx,
   if (output_shape.Size() == 0)
     return Status::OK();
 
-  // use MutableDataRaw as actual data type in tensor may not match as we templatize on data size
-  T* output = reinterpret_cast<T*>(output_tensor.MutableDataRaw());
-  const auto* output_end = output + output_tensor.Shape().Size();
-
-  auto create_output = [&output, &output_end](SliceIterator<T>& slice_input_iterator) {
-    while (output < output_end) {
-      output = slice_input_iterator.CopyContiguousInnermostAxes(output);
-    }
-
-    ORT_ENFORCE(output == output_end);
-  };
-
-  if (compute_metadata.p_flattened_input_dims_) {
-    // If we were able to coalesce the input and output shapes, use the new shapes.
-    auto input_iterator2 =
-        SliceIterator<T>(input_tensor, TensorShape(compute_metadata.flattened_input_dims_), compute_metadata.starts_,
-                         compute_metadata.flattened_output_dims_, compute_metadata.steps_);
-    create_output(input_iterator2);
-  } else {
-    auto input_iterator2 = SliceIterator<T>(input_tensor, compute_metadata.starts_, compute_metadata.output_dims_,
-                                            compute_metadata.steps_);
-    create_output(input_iterator2);
+  // If we were able to coalesce the input and output shapes, use the new shapes.
+  // The starts and steps are always in terms of the shapes used.
+  const bool flattened = compute_metadata.p_flattened_input_dims_ != nullptr;
+  const TensorPitches input_pitches(flattened ? gsl::make_span(compute_metadata.flattened_input_dims_)
+                                              : compute_metadata.input_dimensions_);
+  const TensorShape copy_shape(flattened ? compute_metadata.flattened_output_dims_ : compute_metadata.output_dims_);
+
+  const size_t rank = input_pitches.size();
+  std::ptrdiff_t input_offset = 0;
+  TensorShapeVector input_strides(rank);
+  for (size_t i = 0; i < rank; ++i) {
+    input_offset += onnxruntime::narrow<std::ptrdiff_t>(compute_metadata.starts_[i] * input_pitches[i]);
+    input_strides[i] = compute_metadata.steps_[i] * input_pitches[i];
   }
 
-  return Status::OK();
-}
-
-template <typename EnabledTypes, typename T>
-static inline bool CallSliceImplIfEnabled(OpKernelContext* ctx,
-                                          const Tensor& input_tensor,
-                                          SliceOp::PrepareForComputeMetadata& compute_metadata,
-                                          Status& status) {
-  constexpr bool enabled = utils::HasTypeWithSameSize<EnabledTypes, T>();
-  if constexpr (enabled) {
-    status = SliceImpl<T>(ctx, input_tensor, compute_metadata);
-  }
-
-  return enabled;
+  return DispatchStridedCopy<EnabledDataTypes>(ctx->GetOperatorThreadPool(),
+                                               output_tensor, 0, TensorPitches(copy_shape),
+                                               copy_shape,
+                                               input_tensor, input_offset, input_strides);
 }
 
 Status SliceBase::Compute(OpKernelContext* ctx) const {
@@ -150,41 +133,7 @@ Status SliceBase::Compute(OpKernelContext* ctx) const {
     ORT_RETURN_IF_ERROR(PrepareForCompute(attr_starts_, attr_ends_, attr_axes_, compute_metadata));
   }
 
-  Status status = Status::OK();
-
-  bool supported = false;
-  if (input_tensor.IsDataTypeString()) {
-    if (utils::HasType<EnabledDataTypes, std::string>()) {
-      supported = true;
-      status = SliceImpl<std::string>(ctx, input_tensor, compute_metadata);
-    }
-  } else {
-    const auto element_size = input_tensor.DataType()->Size();
-    // call SliceImpl
-    switch (element_size) {
-      case sizeof(uint32_t):
-        supported = CallSliceImplIfEnabled<EnabledDataTypes, uint32_t>(ctx, input_tensor, compute_metadata, status);
-        break;
-      case sizeof(uint64_t):
-        supported = CallSliceImplIfEnabled<EnabledDataTypes, uint64_t>(ctx, input_tensor, compute_metadata, status);
-        break;
-      case sizeof(uint16_t):
-        supported = CallSliceImplIfEnabled<EnabledDataTypes, uint16_t>(ctx, input_tensor, compute_metadata, status);
-        break;
-      case sizeof(uint8_t):
-        supported = CallSliceImplIfEnabled<EnabledDataTypes, uint8_t>(ctx, input_tensor, compute_metadata, status);
-        break;
-      default:
-        // leave 'supported' as false
-        break;
-    }
-  }
-
-  if (!supported) {
-    status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Unsupported input data type of ", input_tensor.DataType());
-  }
-
-  return status;
+  return SliceImpl(ctx, input_tensor, compute_metadata);
 }
 
 }  // namespace onnxruntime
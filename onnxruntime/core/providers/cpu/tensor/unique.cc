@@ -2,8 +2,6 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/unique.h"
-#include <map>
-#include <core/common/safeint.h>
 #include <gsl/gsl>
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/providers/common.h"
@@ -107,130 +105,34 @@ Status Unique::Compute(OpKernelContext* context) const {
   return status;
 }
 
-// class to represent a subtensor along a given axis for a single entry on that axis
-template <typename T>
-class Subtensor {
- public:
-  // Create Subtensor for entry 'idx' on axis 'axis'
-  // n_axis is the number of entries for 'axis' is the original data.
-  //   e.g. if original shape was [4, 2] and axis is 1, n_axis == 2.
-  // subtensor_shape is the shape for the subtensor. the dimension value for the 'axis' dimension in it will be 1.
-  Subtensor(const gsl::span<const T>& data, const TensorShape& subtensor_shape,
-            int64_t axis, int64_t n_axis, int64_t idx) {
-    // rows and columns for the slice along axis, flattened to 2D by merging the dimensions before and after the axis
-    int64_t columns = subtensor_shape.SizeFromDimension(onnxruntime::narrow<size_t>(axis));
-    int64_t rows = subtensor_shape.SizeToDimension(onnxruntime::narrow<size_t>(axis));
-    items_.reserve(SafeInt<size_t>(rows) * columns);
-    size_t cur_data = SafeInt<size_t>(idx) * columns;  // offset into data for first row of slice
-
-    for (int r = 0; r < rows; ++r) {
-      for (int c = 0; c < columns; ++c) {
-        // TODO: could copy blocks instead of individual items for non std::string types
-        items_.push_back(data[cur_data + c]);
-      }
-
-      cur_data += SafeInt<size_t>(columns) * n_axis;
-    }
-  }
-
-  bool operator<(const Subtensor& rhs) const {
-    return items_ < rhs.items_;
-  }
-
-  const std::vector<T>& GetItems() const { return items_; }
-
- private:
-  // TODO: Simple copy for now. std::string would be better as std::reference_wrapper<std::string>
-  std::vector<T> items_;
-};
-
-template <typename T>
-static void CreateFlattenedOutput(OpKernelContext& context,
-                                  const std::map<const T, int64_t>& offsets,         // map sorted key to unsorted idx
-                                  const std::vector<std::vector<int64_t>>& indices,  // unsorted
-                                  const std::vector<int64_t>& inverse_index,         // unsorted
-                                  bool sorted) {
-  int64_t num_unique = static_cast<int64_t>(indices.size());
-  Tensor& Y = *context.Output(0, {num_unique});
-  Tensor* indices_out = context.Output(1, {num_unique});
-  Tensor* inverse_indices = context.Output(2, {static_cast<int64_t>(inverse_index.size())});
-  Tensor* counts = context.Output(3, {num_unique});
-
-  auto Y_data = Y.MutableDataAsSpan<T>();
-  gsl::span<int64_t> indices_data = indices_out != nullptr ? indices_out->MutableDataAsSpan<int64_t>()
-                                                           : gsl::span<int64_t>();
-  gsl::span<int64_t> inverse_indices_data = inverse_indices != nullptr ? inverse_indices->MutableDataAsSpan<int64_t>()
-                                                                       : gsl::span<int64_t>();
-  gsl::span<int64_t> counts_data = counts != nullptr ? counts->MutableDataAsSpan<int64_t>()
-                                                     : gsl::span<int64_t>();
-
-  // iterate using 'offsets' which is sorted, but contains the offset of the unsorted entry
-  auto offsets_iter = offsets.begin();
-  for (int64_t i = 0, end = num_unique; i < end; ++i, ++offsets_iter) {
-    // write sequentially if we want sorted output, use the unsorted_idx if not
-    auto unsorted_idx = offsets_iter->second;
-    auto output_idx = sorted ? i : unsorted_idx;
-
-    Y_data[onnxruntime::narrow<size_t>(output_idx)] = offsets_iter->first;
-
-    if (indices_out) {
-      indices_data[onnxruntime::narrow<size_t>(output_idx)] = indices[onnxruntime::narrow<size_t>(unsorted_idx)].front();
-    }
-
-    if (counts) {
-      counts_data[onnxruntime::narrow<size_t>(output_idx)] = indices[onnxruntime::narrow<size_t>(unsorted_idx)].size();
-    }
-  }
-
-  if (inverse_indices) {
-    if (sorted) {
-      // need to convert unsorted entries in the inverse index to their sorted values
-      std::vector<int64_t> unsorted_to_sorted;
-      unsorted_to_sorted.resize(onnxruntime::narrow<size_t>(num_unique));
-      int64_t sorted_idx = 0;
-      for (const auto& offset : offsets) {
-        unsorted_to_sorted[onnxruntime::narrow<size_t>(offset.second)] = sorted_idx++;
-      }
-
-      for (size_t i = 0, end = inverse_index.size(); i < end; ++i) {
-        inverse_indices_data[onnxruntime::narrow<size_t>(i)] = unsorted_to_sorted[onnxruntime::narrow<size_t>(inverse_index[i])];
-      }
-    } else {
-      for (size_t i = 0, end = inverse_index.size(); i < end; ++i) {
-        inverse_indices_data[i] = inverse_index[i];
-      }
-    }
-  }
-}
-
+// Writes the outputs for the unique entries of data viewed as [rows, num_slices, columns], where the entries are the
+// slices along the middle dimension. y_dims is the shape of Y with 0 for the axis dimension.
 template <typename T>
 static void CreateOutput(OpKernelContext& context,
-                         const TensorShape& subtensor_shape,
-                         int64_t axis,
-                         const std::map<const Subtensor<T>, int64_t>& offsets,  // map sorted key to unsorted idx
-                         const std::vector<std::vector<int64_t>>& indices,      // unsorted
-                         const std::vector<int64_t>& inverse_index,             // unsorted
+                         gsl::span<const T> data,
+                         size_t rows, size_t num_slices, size_t columns,
+                         TensorShapeVector y_dims, size_t axis,
+                         const unique_helpers::UniqueEntries& entries,
                          bool sorted) {
-  int64_t num_unique = static_cast<int64_t>(indices.size());
-
-  // rows and columns for the slice along axis, flattened to 2D by merging the dimensions before and after the axis
-  int64_t num_cols = subtensor_shape.SizeFromDimension(onnxruntime::narrow<size_t>(axis));
-  int64_t num_rows = subtensor_shape.SizeToDimension(onnxruntime::narrow<size_t>(axis));
+  const auto order = unique_helpers::GetOutputOrder(entries, sorted, [&](int64_t lhs, int64_t rhs) {
+    const T* lhs_data = data.data() + static_cast<size_t>(lhs) * columns;
+    const T* rhs_data = data.data() + static_cast<size_t>(rhs) * columns;
+    for (size_t r = 0; r < rows; ++r, lhs_data += num_slices * columns, rhs_data += num_slices * columns) {
+      auto mismatch = std::mismatch(lhs_data, lhs_data + columns, rhs_data);
+      if (mismatch.first != lhs_data + columns) {
+        return unique_helpers::Less(*mismatch.first, *mismatch.second);
+      }
+    }
+    return false;
+  });
 
-  auto subtensor_dims = subtensor_shape.GetDims();
-  std::vector<int64_t> Y_dims;
-  Y_dims.reserve(subtensor_dims.size());
-  for (int64_t i = 0, end = subtensor_dims.size(); i < end; ++i) {
-    if (i == axis)
-      Y_dims.push_back(num_unique);
-    else
-      Y_dims.push_back(subtensor_dims[onnxruntime::narrow<size_t>(i)]);
-  }
+  const size_t num_unique = entries.Size();
+  y_dims[axis] = static_cast<int64_t>(num_unique);
 
-  Tensor& Y = *context.Output(0, TensorShape(std::move(Y_dims)));
-  Tensor* indices_out = context.Output(1, {num_unique});
-  Tensor* inverse_indices = context.Output(2, {static_cast<int64_t>(inverse_index.size())});
-  Tensor* counts = context.Output(3, {num_unique});
+  Tensor& Y = *context.Output(0, TensorShape(y_dims));
+  Tensor* indices_out = context.Output(1, {static_cast<int64_t>(num_unique)});
+  Tensor* inverse_indices = context.Output(2, {static_cast<int64_t>(num_slices)});
+  Tensor* counts = context.Output(3, {static_cast<int64_t>(num_unique)});
 
   auto Y_data = Y.MutableDataAsSpan<T>();
   gsl::span<int64_t> indices_data = indices_out != nullptr ? indices_out->MutableDataAsSpan<int64_t>()
@@ -240,60 +142,31 @@ static void CreateOutput(OpKernelContext& context,
   gsl::span<int64_t> counts_data = counts != nullptr ? counts->MutableDataAsSpan<int64_t>()
                                                      : gsl::span<int64_t>();
 
-  // iterate using 'offsets' which is sorted, but contains the offset of the unsorted entry
-  auto offsets_iter = offsets.begin();
-
-  for (int64_t i = 0, end = num_unique; i < end; ++i, ++offsets_iter) {
-    // write sequentially if we want sorted output, use the unsorted_idx if not
-    auto unsorted_idx = offsets_iter->second;
-    auto output_idx = (sorted ? i : unsorted_idx);
-
-    const auto& items = offsets_iter->first.GetItems();
-    auto item = items.cbegin();
-    assert(static_cast<int64_t>(items.size()) == num_rows * num_cols);
-
-    int64_t out_offset = output_idx * num_cols;
-
-    for (int64_t row = 0; row < num_rows; ++row) {
-      // copy num_cols items from entries to output
-      if (std::is_same<T, std::string>::value) {
-        std::copy(item, item + onnxruntime::narrow<size_t>(num_cols), &Y_data[onnxruntime::narrow<size_t>(out_offset)]);
-      } else {
-        std::copy_n(item, onnxruntime::narrow<size_t>(num_cols), &Y_data[onnxruntime::narrow<size_t>(out_offset)]);
-      }
-
-      item += onnxruntime::narrow<size_t>(num_cols);
-      out_offset += num_unique * num_cols;
+  // output position of each unique entry, which is in order of first occurrence
+  std::vector<int64_t> output_positions(num_unique);
+  for (size_t i = 0; i < num_unique; ++i) {
+    const auto unique_idx = onnxruntime::narrow<size_t>(order[i]);
+    const auto first_idx = onnxruntime::narrow<size_t>(entries.first_indices[unique_idx]);
+    output_positions[unique_idx] = static_cast<int64_t>(i);
+
+    // copy the rows of the slice
+    for (size_t r = 0; r < rows; ++r) {
+      std::copy_n(data.data() + (r * num_slices + first_idx) * columns, columns,
+                  Y_data.data() + (r * num_unique + i) * columns);
     }
 
-    assert(item == items.cend());
-
     if (indices_out) {
-      indices_data[onnxruntime::narrow<size_t>(output_idx)] = indices[onnxruntime::narrow<size_t>(unsorted_idx)].front();
+      indices_data[i] = entries.first_indices[unique_idx];
     }
 
     if (counts) {
-      counts_data[onnxruntime::narrow<size_t>(output_idx)] = indices[onnxruntime::narrow<size_t>(unsorted_idx)].size();
+      counts_data[i] = entries.counts[unique_idx];
     }
   }
 
   if (inverse_indices) {
-    if (sorted) {
-      // need to convert unsorted entries in the inverse index to their sorted values
-      std::vector<int64_t> unsorted_to_sorted;
-      unsorted_to_sorted.resize(onnxruntime::narrow<size_t>(num_unique));
-      int64_t sorted_idx = 0;
-      for (const auto& offset : offsets) {
-        unsorted_to_sorted[onnxruntime::narrow<size_t>(offset.second)] = sorted_idx++;
-      }
-
-      for (size_t i = 0, end = inverse_index.size(); i < end; ++i) {
-        inverse_indices_data[i] = unsorted_to_sorted[onnxruntime::narrow<size_t>(inverse_index[i])];
-      }
-    } else {
-      for (size_t i = 0, end = inverse_index.size(); i < end; ++i) {
-        inverse_indices_data[i] = inverse_index[i];
-      }
+    for (size_t i = 0; i < num_slices; ++i) {
+      inverse_indices_data[i] = output_positions[onnxruntime::narrow<size_t>(entries.inverse_indices[i])];
     }
   }
 }
@@ -306,72 +179,23 @@ Status Unique::ComputeImpl(OpKernelContext& context) const {
 
   const Tensor& input = *context.Input<Tensor>(0);
   auto data = input.DataAsSpan<T>();
+  unique_helpers::UniqueEntries entries;
 
   if (flatten_) {
-    std::map<const T, int64_t> offsets;  // offset of entry in indices. provides map between sorted and unsorted values
-    std::vector<std::vector<int64_t>> indices;
-    std::vector<int64_t> inverse_index;
-
-    indices.reserve(data.size() / 2);  // arbitrary value. at worst 1 realloc but could be too large
-    inverse_index.reserve(data.size());
-
-    int64_t num_unique = 0;
-
-    for (int64_t i = 0, end = input.Shape().Size(); i < end; ++i) {
-      auto entry = offsets.find(data[onnxruntime::narrow<size_t>(i)]);
-      if (entry == offsets.end()) {
-        offsets[data[onnxruntime::narrow<size_t>(i)]] = num_unique;
-        inverse_index.push_back({num_unique});
-        indices.push_back({i});
-        ++num_unique;
-      } else {
-        size_t indices_idx = onnxruntime::narrow<size_t>(entry->second);
-        indices[indices_idx].push_back(i);
-        inverse_index.push_back(onnxruntime::narrow<int64_t>(indices_idx));
-      }
-    }
-
-    CreateFlattenedOutput(context, offsets, indices, inverse_index, sort_);
+    unique_helpers::FindUniqueValues(data, entries);
+    CreateOutput(context, data, 1, data.size(), 1, TensorShapeVector{0}, 0, entries, sort_);
   } else {
     const auto& input_shape = input.Shape();
     const int64_t input_dims = static_cast<int64_t>(input_shape.NumDimensions());
-    const int64_t axis = HandleNegativeAxis(axis_, input_dims);
+    const auto axis = onnxruntime::narrow<size_t>(HandleNegativeAxis(axis_, input_dims));
 
-    std::vector<int64_t> subtensor_dims;
-    subtensor_dims.reserve(onnxruntime::narrow<size_t>(input_dims));
-    for (int64_t i = 0; i < input_dims; ++i) {
-      subtensor_dims.push_back(i == axis ? 1 : input_shape[onnxruntime::narrow<size_t>(i)]);
-    }
-
-    TensorShape subtensor_shape(std::move(subtensor_dims));
-
-    std::map<const Subtensor<T>, int64_t> offsets;
-    std::vector<std::vector<int64_t>> indices;
-    std::vector<int64_t> inverse_index;
-
-    indices.reserve(data.size() / 2);  // arbitrary value. at worst 1 realloc but could be too large
-    inverse_index.reserve(data.size());
-
-    int64_t num_unique = 0;
-    int64_t n_axis = input_shape[onnxruntime::narrow<size_t>(axis)];
-
-    for (int64_t i = 0; i < n_axis; ++i) {
-      Subtensor<T> s(data, subtensor_shape, axis, n_axis, i);
-
-      auto entry = offsets.find(s);
-      if (entry == offsets.end()) {
-        offsets[std::move(s)] = num_unique;
-        inverse_index.push_back({num_unique});
-        indices.push_back({i});
-        ++num_unique;
-      } else {
-        size_t indices_idx = onnxruntime::narrow<size_t>(entry->second);
-        indices[indices_idx].push_back(i);
-        inverse_index.push_back(onnxruntime::narrow<int64_t>(indices_idx));
-      }
-    }
+    // view the input as [rows, n_axis, columns] by merging the dimensions before and after the axis
+    const auto rows = onnxruntime::narrow<size_t>(input_shape.SizeToDimension(axis));
+    const auto n_axis = onnxruntime::narrow<size_t>(input_shape[axis]);
+    const auto columns = onnxruntime::narrow<size_t>(input_shape.SizeFromDimension(axis + 1));
 
-    CreateOutput(context, subtensor_shape, axis, offsets, indices, inverse_index, sort_);
+    unique_helpers::FindUniqueSlices(data, rows, n_axis, columns, entries);
+    CreateOutput(context, data, rows, n_axis, columns, input_shape.AsShapeVector(), axis, entries, sort_);
   }
 
   return Status::OK();
@@ -3,7 +3,17 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
 #include "core/common/common.h"
+#include "core/common/hash_combine.h"
+#include "core/common/inlined_containers.h"
 #include "core/framework/op_kernel.h"
 
 namespace onnxruntime {
@@ -27,4 +37,114 @@ class Unique final : public OpKernel {
   bool flatten_{false};
   int64_t axis_{0};
 };
+
+namespace unique_helpers {
+
+// Type used to hash a value. Strings are hashed by view so they aren't copied.
+template <typename T>
+using HashKey = std::conditional_t<std::is_same_v<T, std::string>, std::string_view, T>;
+
+// Ordering of the unique values. NaNs are greater than any other value and equivalent to each other.
+template <typename T>
+bool Less(const T& lhs, const T& rhs) {
+  if constexpr (std::is_floating_point_v<T>) {
+    return lhs < rhs || (!std::isnan(lhs) && std::isnan(rhs));
+  } else {
+    return lhs < rhs;
+  }
+}
+
+// The unique entries of an input, in order of their first occurrence.
+struct UniqueEntries {
+  std::vector<int64_t> first_indices;    // index of the first occurrence of each unique entry
+  std::vector<int64_t> counts;           // number of occurrences of each unique entry
+  std::vector<int64_t> inverse_indices;  // index of the unique entry of each entry of the input
+
+  size_t Size() const { return first_indices.size(); }
+
+  void Add(size_t input_index, int64_t unique_index) {
+    if (static_cast<size_t>(unique_index) == first_indices.size()) {
+      first_indices.push_back(static_cast<int64_t>(input_index));
+      counts.push_back(1);
+    } else {
+      ++counts[static_cast<size_t>(unique_index)];
+    }
+    inverse_indices[input_index] = unique_index;
+  }
+};
+
+// Finds the unique values of data with a single pass over a hash table.
+template <typename T>
+void FindUniqueValues(gsl::span<const T> data, UniqueEntries& entries) {
+  entries.inverse_indices.resize(data.size());
+  InlinedHashMap<HashKey<T>, int64_t> unique_indices;
+  for (size_t i = 0; i < data.size(); ++i) {
+    auto result = unique_indices.try_emplace(HashKey<T>(data[i]), static_cast<int64_t>(entries.Size()));
+    entries.Add(i, result.first->second);
+  }
+}
+
+// Finds the unique slices along an axis of data, where data is viewed as [rows, num_slices, columns].
+template <typename T>
+void FindUniqueSlices(gsl::span<const T> data, size_t rows, size_t num_slices, size_t columns,
+                      UniqueEntries& entries) {
+  auto element = [&](size_t slice, size_t row, size_t column) -> const T& {
+    return data[(row * num_slices + slice) * columns + column];
+  };
+
+  auto slices_equal = [&](size_t lhs, size_t rhs) {
+    for (size_t r = 0; r < rows; ++r) {
+      for (size_t c = 0; c < columns; ++c) {
+        if (!(element(lhs, r, c) == element(rhs, r, c))) {
+          return false;
+        }
+      }
+    }
+    return true;
+  };
+
+  entries.inverse_indices.resize(num_slices);
+
+  // unique slices by hash. slices with the same hash are compared element by element.
+  InlinedHashMap<size_t, InlinedVector<int64_t, 1>> unique_indices_by_hash;
+  for (size_t i = 0; i < num_slices; ++i) {
+    size_t hash = 0;
+    for (size_t r = 0; r < rows; ++r) {
+      for (size_t c = 0; c < columns; ++c) {
+        HashCombine<HashKey<T>>(element(i, r, c), hash);
+      }
+    }
+
+    auto& candidates = unique_indices_by_hash[hash];
+    auto match = std::find_if(candidates.begin(), candidates.end(), [&](int64_t unique_index) {
+      return slices_equal(static_cast<size_t>(entries.first_indices[static_cast<size_t>(unique_index)]), i);
+    });
+
+    if (match == candidates.end()) {
+      candidates.push_back(static_cast<int64_t>(entries.Size()));
+      entries.Add(i, candidates.back());
+    } else {
+      entries.Add(i, *match);
+    }
+  }
+}
+
+// Returns the order of the unique entries in the output: sorted by value if sorted is true, or in the order of their
+// first occurrence if not. `less` compares the entries at two input indexes.
+// Only the unique entries are sorted, which are usually far fewer than the input entries.
+template <typename TLess>
+std::vector<int64_t> GetOutputOrder(const UniqueEntries& entries, bool sorted, TLess less) {
+  std::vector<int64_t> order(entries.Size());
+  std::iota(order.begin(), order.end(), int64_t{0});
+  if (sorted) {
+    // stable so that entries that are equivalent but not equal, i.e. NaNs, keep their order of first occurrence
+    std::stable_sort(order.begin(), order.end(), [&](int64_t lhs, int64_t rhs) {
+      return less(entries.first_indices[static_cast<size_t>(lhs)], entries.first_indices[static_cast<size_t>(rhs)]);
+    });
+  }
+
+  return order;
+}
+
+}  // namespace unique_helpers
 }  // namespace onnxruntime
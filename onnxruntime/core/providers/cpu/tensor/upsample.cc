@@ -81,25 +81,27 @@ void UpsampleNearest2x(int64_t batch_size,
                        int64_t input_height,
                        int64_t input_width,
                        const T* input,
-                       T* output) {
-  const int64_t output_height = input_height * 2;
+                       T* output,
+                       concurrency::ThreadPool* tp) {
   const int64_t output_width = input_width * 2;
-  for (int64_t n = 0; n < batch_size; ++n) {
-    for (int64_t c = 0; c < num_channels; ++c) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        const int64_t in_y = y / 2;
-        for (int64_t x = 0; x < input_width; ++x) {
-          const T v = input[in_y * input_width + x];
-          const int64_t oidx = output_width * y + x * 2;
-          output[oidx + 0] = v;
-          output[oidx + 1] = v;
-        }
-      }
 
-      input += input_height * input_width;
-      output += output_height * output_width;
-    }
-  }
+  // each input row produces two output rows
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(batch_size * num_channels * input_height),
+      TensorOpCost{static_cast<double>(input_width * sizeof(T)), static_cast<double>(output_width * 2 * sizeof(T)),
+                   static_cast<double>(output_width * 2)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t in_row = first; in_row < last; ++in_row) {
+          const T* input_row = input + in_row * input_width;
+          T* output_row = output + in_row * output_width * 2;
+          for (int64_t x = 0; x < input_width; ++x) {
+            const T v = input_row[x];
+            output_row[x * 2 + 0] = v;
+            output_row[x * 2 + 1] = v;
+          }
+          std::copy_n(output_row, output_width, output_row + output_width);
+        }
+      });
 }
 
 static std::vector<int64_t> UpsampleNearestSetupRank1InputMapping(
@@ -191,19 +193,16 @@ static Status UpsampleNearestImpl(const T* input,
                                   bool extrapolation_enabled,
                                   const T extrapolation_value,
                                   const GetOriginalCoordinateFunc& get_original_coordinate,
-                                  const GetNearestPixelFunc& get_nearest_pixel) {
+                                  const GetNearestPixelFunc& get_nearest_pixel,
+                                  concurrency::ThreadPool* tp) {
   int64_t n_dim = static_cast<int64_t>(input_shape.NumDimensions());
 
-  std::vector<int64_t> input_dim_counters(narrow<size_t>(n_dim));
   std::vector<int64_t> input_dim_factor(narrow<size_t>(n_dim));
   input_dim_factor[SafeInt<size_t>(n_dim) - 1] = 1;  // initialize dimension factor
   for (int64_t dim_idx = n_dim - 2; dim_idx >= 0; dim_idx--) {
     input_dim_factor[narrow<size_t>(dim_idx)] = input_dim_factor[SafeInt<size_t>(dim_idx) + 1] * input_shape[SafeInt<size_t>(dim_idx) + 1];
   }
 
-  int64_t output_idx = 0;
-  int64_t input_idx = 0;
-
   if (n_dim == 1) {
     std::vector<int64_t> input_mapping = UpsampleNearestSetupRank1InputMapping(input_shape[0],
                                                                                output_shape[0],
@@ -221,82 +220,39 @@ static Status UpsampleNearestImpl(const T* input,
     return Status::OK();
   }
 
+  // input offset for each index of each output dim. the offset of an output element is the sum of the offsets of its
+  // indexes, and it is negative when any of them needs extrapolation.
   std::vector<std::vector<int64_t>> input_mappings =
       UpsampleNearestSetupInputMappings(n_dim, input_shape, output_shape, input_dim_factor, scales, roi,
                                         extrapolation_enabled, get_original_coordinate, get_nearest_pixel);
 
-  if (n_dim == 2) {
-    const std::vector<int64_t>& input_mapping_0 = input_mappings[0];
-    const std::vector<int64_t>& input_mapping_1 = input_mappings[1];
-
-    for (int64_t output_dim0_inx = 0; output_dim0_inx < output_shape[0]; output_dim0_inx++) {
-      int64_t input_idx_0 = input_mapping_0[narrow<size_t>(output_dim0_inx)];
-      for (int64_t output_dim1_inx = 0; output_dim1_inx < output_shape[1]; output_dim1_inx++) {
-        int64_t input_idx_1 = input_idx_0 + input_mapping_1[narrow<size_t>(output_dim1_inx)];
-        output[output_idx++] = (input_idx_1 < 0) ? extrapolation_value : input[input_idx_1];
-      }
-    }
-    return Status::OK();
-  }
-
-  if (n_dim == 3) {
-    const std::vector<int64_t>& input_mapping_0 = input_mappings[0];
-    const std::vector<int64_t>& input_mapping_1 = input_mappings[1];
-    const std::vector<int64_t>& input_mapping_2 = input_mappings[2];
-
-    for (int64_t output_dim0_inx = 0; output_dim0_inx < output_shape[0]; output_dim0_inx++) {
-      int64_t input_idx_0 = input_mapping_0[narrow<size_t>(output_dim0_inx)];
-      for (int64_t output_dim1_inx = 0; output_dim1_inx < output_shape[1]; output_dim1_inx++) {
-        int64_t input_idx_1 = input_idx_0 + input_mapping_1[narrow<size_t>(output_dim1_inx)];
-        for (int64_t output_dim2_inx = 0; output_dim2_inx < output_shape[2]; output_dim2_inx++) {
-          int64_t input_idx_2 = input_idx_1 + input_mapping_2[narrow<size_t>(output_dim2_inx)];
-          output[output_idx++] = (input_idx_2 < 0) ? extrapolation_value : input[input_idx_2];
-        }
-      }
-    }
-    return Status::OK();
-  }
+  // the output is processed by rows of the innermost dim, which are independent of each other
+  const auto inner_dim = narrow<size_t>(n_dim - 1);
+  const int64_t output_width = output_shape[inner_dim];
+  const int64_t num_rows = output_shape.SizeToDimension(inner_dim);
+  const std::vector<int64_t>& inner_mapping = input_mappings[inner_dim];
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_rows),
+      TensorOpCost{static_cast<double>(output_width * sizeof(T)), static_cast<double>(output_width * sizeof(T)),
+                   static_cast<double>(output_width)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          // input offset of the start of the row
+          int64_t row_input_idx = 0;
+          for (int64_t dim_idx = n_dim - 2, remaining = row; dim_idx >= 0; dim_idx--) {
+            const int64_t output_dim = output_shape[narrow<size_t>(dim_idx)];
+            row_input_idx += input_mappings[narrow<size_t>(dim_idx)][narrow<size_t>(remaining % output_dim)];
+            remaining /= output_dim;
+          }
 
-  if (n_dim == 4) {
-    const std::vector<int64_t>& input_mapping_0 = input_mappings[0];
-    const std::vector<int64_t>& input_mapping_1 = input_mappings[1];
-    const std::vector<int64_t>& input_mapping_2 = input_mappings[2];
-    const std::vector<int64_t>& input_mapping_3 = input_mappings[3];
-
-    for (int64_t output_dim0_inx = 0; output_dim0_inx < output_shape[0]; output_dim0_inx++) {
-      int64_t input_idx_0 = input_mapping_0[narrow<size_t>(output_dim0_inx)];
-      for (int64_t output_dim1_inx = 0; output_dim1_inx < output_shape[1]; output_dim1_inx++) {
-        int64_t input_idx_1 = input_idx_0 + input_mapping_1[narrow<size_t>(output_dim1_inx)];
-        for (int64_t output_dim2_inx = 0; output_dim2_inx < output_shape[2]; output_dim2_inx++) {
-          int64_t input_idx_2 = input_idx_1 + input_mapping_2[narrow<size_t>(output_dim2_inx)];
-          for (int64_t output_dim3_inx = 0; output_dim3_inx < output_shape[3]; output_dim3_inx++) {
-            int64_t input_idx_3 = input_idx_2 + input_mapping_3[narrow<size_t>(output_dim3_inx)];
-            output[output_idx++] = (input_idx_3 < 0) ? static_cast<T>(extrapolation_value) : input[narrow<size_t>(input_idx_3)];
+          T* output_row = output + row * output_width;
+          for (int64_t x = 0; x < output_width; ++x) {
+            const int64_t input_idx = row_input_idx + inner_mapping[narrow<size_t>(x)];
+            output_row[x] = (input_idx < 0) ? extrapolation_value : input[narrow<size_t>(input_idx)];
           }
         }
-      }
-    }
-    return Status::OK();
-  }
-
-  std::vector<int64_t> output_dim_counter(onnxruntime::narrow<size_t>(n_dim));
-  for (int64_t dim_idx = 0; dim_idx < n_dim; dim_idx++) {
-    input_idx += input_mappings[narrow<size_t>(dim_idx)][0 /* output_dim_counter[narrow<size_t>(dim_idx)] */];
-  }
-
-  for (int64_t output_size = output_shape.Size(); output_idx < output_size; output_idx++) {
-    output[narrow<size_t>(output_idx)] = (input_idx < 0) ? extrapolation_value : input[narrow<size_t>(input_idx)];
-
-    for (int64_t dim_idx = n_dim - 1; dim_idx >= 0; dim_idx--) {
-      input_idx -= input_mappings[narrow<size_t>(dim_idx)][narrow<size_t>(output_dim_counter[narrow<size_t>(dim_idx)])];
-      if (++output_dim_counter[narrow<size_t>(dim_idx)] < output_shape[narrow<size_t>(dim_idx)]) {
-        input_idx += input_mappings[narrow<size_t>(dim_idx)][narrow<size_t>(output_dim_counter[narrow<size_t>(dim_idx)])];
-        break;
-      }
-      output_dim_counter[narrow<size_t>(dim_idx)] = 0;
-      input_idx += input_mappings[narrow<size_t>(dim_idx)][0 /* output_dim_counter[narrow<size_t>(dim_idx)] */];
-    }
-  }
+      });
 
   return Status::OK();
 }
@@ -326,7 +282,7 @@ static Status ValidateUpsampleInput(const void* input, const void* output,
 }
 
 template <typename T>
-static Status UpsampleNearest(const T* input,
+Status UpsampleNearest(const T* input,
                               T* output,
                               const TensorShape& input_shape,
                               const TensorShape& output_shape,
@@ -337,21 +293,31 @@ static Status UpsampleNearest(const T* input,
                               T extrapolation_value,
                               bool use_nearest2x_optimization,
                               const GetOriginalCoordinateFunc& get_original_coordinate,
-                              const GetNearestPixelFunc& get_nearest_pixel) {
+                              const GetNearestPixelFunc& get_nearest_pixel,
+                              concurrency::ThreadPool* tp) {
   ORT_RETURN_IF_ERROR(ValidateUpsampleInput(input, output, input_shape, output_shape, is_resize));
 
   // special case with fast path
   if (use_nearest2x_optimization && input_shape.NumDimensions() == 4 &&
       scales[0] == 1 && scales[1] == 1 && scales[2] == 2 && scales[3] == 2) {
-    UpsampleNearest2x<T>(input_shape[0], input_shape[1], input_shape[2], input_shape[3], input, output);
+    UpsampleNearest2x<T>(input_shape[0], input_shape[1], input_shape[2], input_shape[3], input, output, tp);
     return Status::OK();
   }
 
   return UpsampleNearestImpl(input, output, input_shape, output_shape, scales, roi,
                              extrapolation_enabled, extrapolation_value,
-                             get_original_coordinate, get_nearest_pixel);
+                             get_original_coordinate, get_nearest_pixel, tp);
 }
 
+template Status UpsampleNearest<float>(const float*, float*, const TensorShape&, const TensorShape&,
+                                       gsl::span<const float>, gsl::span<const float>, bool, bool, float, bool,
+                                       const GetOriginalCoordinateFunc&, const GetNearestPixelFunc&,
+                                       concurrency::ThreadPool*);
+template Status UpsampleNearest<uint8_t>(const uint8_t*, uint8_t*, const TensorShape&, const TensorShape&,
+                                         gsl::span<const float>, gsl::span<const float>, bool, bool, uint8_t, bool,
+                                         const GetOriginalCoordinateFunc&, const GetNearestPixelFunc&,
+                                         concurrency::ThreadPool*);
+
 /*
 
 // This is a generic upsample in linear mode for N-D tensor.
@@ -854,54 +820,51 @@ void UpsampleTrilinear(int64_t batch_size,
                                              depth_scale, height_scale, width_scale, roi,
                                              alloc, get_original_coordinate);
 
-  for (int64_t n = 0; n < batch_size; ++n) {
-    concurrency::ThreadPool::TrySimpleParallelFor(
-        tp, static_cast<std::ptrdiff_t>(num_channels),
-        [&](std::ptrdiff_t c) {
-          const T* Xdata = XdataBase + (n * num_channels + c) * (input_depth * input_height * input_width);
-          T* Ydata = YdataBase + (n * num_channels + c) * (output_depth * output_height * output_width);
-          for (int64_t z = 0; z < output_depth; ++z) {
-            for (int64_t y = 0; y < output_height; ++y) {
-              for (int64_t x = 0; x < output_width; ++x) {
-                // when use_extrapolation is set and original index of x or y is out of the dim range
-                // then use extrapolation_value as the output value.
-                if (use_extrapolation &&
-                    ((p.z_original[narrow<size_t>(z)] < 0 || p.z_original[narrow<size_t>(z)] > static_cast<float>(input_depth - 1)) ||
-                     (p.y_original[narrow<size_t>(y)] < 0 || p.y_original[narrow<size_t>(y)] > static_cast<float>(input_height - 1)) ||
-                     (p.x_original[narrow<size_t>(x)] < 0 || p.x_original[narrow<size_t>(x)] > static_cast<float>(input_width - 1)))) {
-                  Ydata[output_width * output_height * z + output_width * y + x] =
-                      static_cast<T>(extrapolation_value);
-                  continue;
-                }
-
-                // subscript ordering in the variable - (xyz)
-                T X111 = Xdata[p.input_height_width_mul_z1[narrow<size_t>(z)] + p.input_width_mul_y1[narrow<size_t>(y)] + p.in_x1[narrow<size_t>(x)]];
-                T X211 = Xdata[p.input_height_width_mul_z1[narrow<size_t>(z)] + p.input_width_mul_y1[narrow<size_t>(y)] + p.in_x2[narrow<size_t>(x)]];
-                T X121 = Xdata[p.input_height_width_mul_z1[narrow<size_t>(z)] + p.input_width_mul_y2[narrow<size_t>(y)] + p.in_x1[narrow<size_t>(x)]];
-                T X221 = Xdata[p.input_height_width_mul_z1[narrow<size_t>(z)] + p.input_width_mul_y2[narrow<size_t>(y)] + p.in_x2[narrow<size_t>(x)]];
-
-                T X112 = Xdata[p.input_height_width_mul_z2[narrow<size_t>(z)] + p.input_width_mul_y1[narrow<size_t>(y)] + p.in_x1[narrow<size_t>(x)]];
-                T X212 = Xdata[p.input_height_width_mul_z2[narrow<size_t>(z)] + p.input_width_mul_y1[narrow<size_t>(y)] + p.in_x2[narrow<size_t>(x)]];
-                T X122 = Xdata[p.input_height_width_mul_z2[narrow<size_t>(z)] + p.input_width_mul_y2[narrow<size_t>(y)] + p.in_x1[narrow<size_t>(x)]];
-                T X222 = Xdata[p.input_height_width_mul_z2[narrow<size_t>(z)] + p.input_width_mul_y2[narrow<size_t>(y)] + p.in_x2[narrow<size_t>(x)]];
-
+  // parallelize over the volumes of all the batches
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      tp, static_cast<std::ptrdiff_t>(batch_size * num_channels),
+      [&](std::ptrdiff_t volume) {
+        const T* Xdata = XdataBase + volume * (input_depth * input_height * input_width);
+        T* Ydata = YdataBase + volume * (output_depth * output_height * output_width);
+        for (int64_t z = 0; z < output_depth; ++z) {
+          for (int64_t y = 0; y < output_height; ++y) {
+            for (int64_t x = 0; x < output_width; ++x) {
+              // when use_extrapolation is set and original index of x or y is out of the dim range
+              // then use extrapolation_value as the output value.
+              if (use_extrapolation &&
+                  ((p.z_original[narrow<size_t>(z)] < 0 || p.z_original[narrow<size_t>(z)] > static_cast<float>(input_depth - 1)) ||
+                   (p.y_original[narrow<size_t>(y)] < 0 || p.y_original[narrow<size_t>(y)] > static_cast<float>(input_height - 1)) ||
+                   (p.x_original[narrow<size_t>(x)] < 0 || p.x_original[narrow<size_t>(x)] > static_cast<float>(input_width - 1)))) {
                 Ydata[output_width * output_height * z + output_width * y + x] =
-                    static_cast<T>(p.dx2[narrow<size_t>(x)] * p.dy2[narrow<size_t>(y)] * p.dz2[narrow<size_t>(z)] * X111 +
-                                   p.dx1[narrow<size_t>(x)] * p.dy2[narrow<size_t>(y)] * p.dz2[narrow<size_t>(z)] * X211 +
-                                   p.dx2[narrow<size_t>(x)] * p.dy1[narrow<size_t>(y)] * p.dz2[narrow<size_t>(z)] * X121 +
-                                   p.dx1[narrow<size_t>(x)] * p.dy1[narrow<size_t>(y)] * p.dz2[narrow<size_t>(z)] * X221 +
-
-                                   p.dx2[narrow<size_t>(x)] * p.dy2[narrow<size_t>(y)] * p.dz1[narrow<size_t>(z)] * X112 +
-                                   p.dx1[narrow<size_t>(x)] * p.dy2[narrow<size_t>(y)] * p.dz1[narrow<size_t>(z)] * X212 +
-                                   p.dx2[narrow<size_t>(x)] * p.dy1[narrow<size_t>(y)] * p.dz1[narrow<size_t>(z)] * X122 +
-                                   p.dx1[narrow<size_t>(x)] * p.dy1[narrow<size_t>(y)] * p.dz1[narrow<size_t>(z)] * X222);
+                    static_cast<T>(extrapolation_value);
+                continue;
               }
+
+              // subscript ordering in the variable - (xyz)
+              T X111 = Xdata[p.input_height_width_mul_z1[narrow<size_t>(z)] + p.input_width_mul_y1[narrow<size_t>(y)] + p.in_x1[narrow<size_t>(x)]];
+              T X211 = Xdata[p.input_height_width_mul_z1[narrow<size_t>(z)] + p.input_width_mul_y1[narrow<size_t>(y)] + p.in_x2[narrow<size_t>(x)]];
+              T X121 = Xdata[p.input_height_width_mul_z1[narrow<size_t>(z)] + p.input_width_mul_y2[narrow<size_t>(y)] + p.in_x1[narrow<size_t>(x)]];
+              T X221 = Xdata[p.input_height_width_mul_z1[narrow<size_t>(z)] + p.input_width_mul_y2[narrow<size_t>(y)] + p.in_x2[narrow<size_t>(x)]];
+
+              T X112 = Xdata[p.input_height_width_mul_z2[narrow<size_t>(z)] + p.input_width_mul_y1[narrow<size_t>(y)] + p.in_x1[narrow<size_t>(x)]];
+              T X212 = Xdata[p.input_height_width_mul_z2[narrow<size_t>(z)] + p.input_width_mul_y1[narrow<size_t>(y)] + p.in_x2[narrow<size_t>(x)]];
+              T X122 = Xdata[p.input_height_width_mul_z2[narrow<size_t>(z)] + p.input_width_mul_y2[narrow<size_t>(y)] + p.in_x1[narrow<size_t>(x)]];
+              T X222 = Xdata[p.input_height_width_mul_z2[narrow<size_t>(z)] + p.input_width_mul_y2[narrow<size_t>(y)] + p.in_x2[narrow<size_t>(x)]];
+
+              Ydata[output_width * output_height * z + output_width * y + x] =
+                  static_cast<T>(p.dx2[narrow<size_t>(x)] * p.dy2[narrow<size_t>(y)] * p.dz2[narrow<size_t>(z)] * X111 +
+                                 p.dx1[narrow<size_t>(x)] * p.dy2[narrow<size_t>(y)] * p.dz2[narrow<size_t>(z)] * X211 +
+                                 p.dx2[narrow<size_t>(x)] * p.dy1[narrow<size_t>(y)] * p.dz2[narrow<size_t>(z)] * X121 +
+                                 p.dx1[narrow<size_t>(x)] * p.dy1[narrow<size_t>(y)] * p.dz2[narrow<size_t>(z)] * X221 +
+
+                                 p.dx2[narrow<size_t>(x)] * p.dy2[narrow<size_t>(y)] * p.dz1[narrow<size_t>(z)] * X112 +
+                                 p.dx1[narrow<size_t>(x)] * p.dy2[narrow<size_t>(y)] * p.dz1[narrow<size_t>(z)] * X212 +
+                                 p.dx2[narrow<size_t>(x)] * p.dy1[narrow<size_t>(y)] * p.dz1[narrow<size_t>(z)] * X122 +
+                                 p.dx1[narrow<size_t>(x)] * p.dy1[narrow<size_t>(y)] * p.dz1[narrow<size_t>(z)] * X222);
             }
           }
-          Xdata += input_depth * input_height * input_width;
-          Ydata += output_depth * output_width * output_height;
-        });
-  }
+        }
+      });
 }
 
 // Calculates cubic coeff based on Robert Keys approach
@@ -918,49 +881,81 @@ std::array<float, CubicModeGridLength> GetCubicCoeffs(float s, float cubic_coeff
   return coeffs;
 }
 
-// Get the tensor data at the requested coordinate
-template <typename T>
-T GetDataForCoordinate(const T* Xdata,
-                       int64_t x, int64_t y,
-                       int64_t input_height, int64_t input_width) {
-  x = std::max(static_cast<int64_t>(0), std::min(x, input_width - 1));
-  y = std::max(static_cast<int64_t>(0), std::min(y, input_height - 1));
-  return Xdata[y * input_width + x];
-}
+namespace {
 
-// Computes cubic convolution interpolation in 1D
-template <typename T>
-float CubicInterpolation1D(const T* Xdata,
-                           int64_t x,
-                           int64_t y,
-                           int64_t input_height,
-                           int64_t input_width,
-                           std::array<float, CubicModeGridLength>& coeff_array,
-                           float coeff_sum,
-                           std::unordered_map<int64_t, float>& cache) {
-  // When calculating cubic interpolation we move the 4*4 grid across the original data and therefore there is
-  // opportunity to cache the results for previously seen combinations.
-  // Check if the result is already available in the cache
-  auto grid_start_pos = (y)*input_width + (x - 1);
-  if (cache.find(grid_start_pos) != cache.end()) {
-    return cache[grid_start_pos];
-  }
+// Taps of the cubic interpolation for each output index of an axis.
+struct CubicAxisTable {
+  std::vector<int64_t> first_input_idx;  // input index of the first of the 4 taps before clamping
+  std::vector<std::array<float, CubicModeGridLength>> coeffs;
+  std::vector<float> coeff_sums;
+  std::vector<uint8_t> extrapolate;  // whether the output index uses the extrapolation value
+};
+
+CubicAxisTable SetupCubicAxisTable(int64_t input_size, int64_t output_size, float scale, float roi_start,
+                                   float roi_end, float cubic_coeff_a, bool use_extrapolation, bool exclude_outside,
+                                   const GetOriginalCoordinateFunc& get_original_coordinate) {
+  CubicAxisTable table;
+  table.first_input_idx.resize(narrow<size_t>(output_size));
+  table.coeffs.resize(narrow<size_t>(output_size));
+  table.coeff_sums.resize(narrow<size_t>(output_size));
+  table.extrapolate.resize(narrow<size_t>(output_size));
+
+  // the fractional parts are often repeated, e.g. for integer scales
+  InlinedHashMap<float, std::array<float, CubicModeGridLength>> cubic_coeffs;
+
+  for (int64_t i = 0; i < output_size; ++i) {
+    const auto out_idx = narrow<size_t>(i);
+    const float in_coord = scale == 1 ? static_cast<float>(i)
+                                      : get_original_coordinate(static_cast<float>(i), scale,
+                                                                static_cast<float>(output_size),
+                                                                static_cast<float>(input_size),
+                                                                roi_start, roi_end);
+
+    // when use_extrapolation is set and original index is out of the dim range
+    // then use extrapolation_value as the output value.
+    if (use_extrapolation && (in_coord < 0 || in_coord > static_cast<float>(input_size - 1))) {
+      table.extrapolate[out_idx] = 1;
+      continue;
+    }
+
+    const auto in_int = static_cast<int64_t>(std::floor(in_coord));
+    const float s = in_coord - in_int;
+    auto coeffs_it = cubic_coeffs.find(s);
+    if (coeffs_it == cubic_coeffs.end()) {
+      coeffs_it = cubic_coeffs.emplace(s, GetCubicCoeffs(s, cubic_coeff_a)).first;
+    }
+
+    auto& coeffs = table.coeffs[out_idx];
+    coeffs = coeffs_it->second;
+    float coeff_sum = 1;
+    if (exclude_outside) {
+      // When true, the weight of sampling locations outside the grid will be set to 0
+      // and the weight will be renormalized so that their sum is 1.0
+      coeff_sum = 0;
+      for (int64_t tap = 0, val = in_int - 1; val <= in_int + 2; val++, tap++) {
+        if (val < 0 || val >= static_cast<float>(input_size)) {
+          coeffs[narrow<size_t>(tap)] = 0.0f;
+        }
+        coeff_sum += coeffs[narrow<size_t>(tap)];
+      }
+    }
 
-  // get the neighbors in 1D and find interpolation for this dimension
-  // for 1D cubic interpolation 4 samples are used. 2 on the left and 2 on the right of x
-  float result = 0;
-  for (int i = 0, j = -1; i < static_cast<int>(CubicModeGridLength); i++, j++) {
-    auto orig_data = GetDataForCoordinate(Xdata, x + j, y, input_height, input_width);
-    result += coeff_array[narrow<size_t>(i)] / coeff_sum * orig_data;
+    table.first_input_idx[out_idx] = in_int - 1;
+    table.coeff_sums[out_idx] = coeff_sum;
   }
-  cache[grid_start_pos] = result;
 
-  return result;
+  return table;
 }
+
+}  // namespace
+
 #if defined(_MSC_VER)
 #pragma warning(push)
 #pragma warning(disable : 6001)
 #endif
+// Bicubic resize of NCHW data as two separable passes per image: the rows of the input that are needed are first
+// interpolated horizontally to the output width, then the output rows are interpolated vertically from those.
+// Images are processed in parallel.
 template <typename T>
 void ResizeBiCubic(int64_t batch_size,
                    int64_t num_channels,
@@ -977,139 +972,111 @@ void ResizeBiCubic(int64_t batch_size,
                    gsl::span<const float> roi,
                    const T* Xdata,
                    T* Ydata,
-                   const GetOriginalCoordinateFunc& get_original_coordinate) {
-  std::vector<float> y_original;
-  y_original.reserve(narrow<size_t>(output_height));
-
-  std::vector<float> x_original;
-  x_original.reserve(narrow<size_t>(output_width));
-
-  std::unordered_map<float, std::array<float, CubicModeGridLength>> cubic_coeffs;
-  std::unordered_map<float, std::unordered_map<int64_t, float>> coeff_to_1Dinterpolation_map;
-  auto roi_y_start = roi.size() / 2 - 2;
-  auto roi_y_end = roi.size() - 2;
-  auto roi_x_start = roi.size() / 2 - 1;
-  auto roi_x_end = roi.size() - 1;
-
-  // generate coefficients in y direction
+                   const GetOriginalCoordinateFunc& get_original_coordinate,
+                   concurrency::ThreadPool* tp) {
+  const auto roi_y_start = roi.size() / 2 - 2;
+  const auto roi_y_end = roi.size() - 2;
+  const auto roi_x_start = roi.size() / 2 - 1;
+  const auto roi_x_end = roi.size() - 1;
+
+  const CubicAxisTable y_table = SetupCubicAxisTable(input_height, output_height, height_scale, roi[roi_y_start],
+                                                     roi[roi_y_end], cubic_coeff_a, use_extrapolation,
+                                                     exclude_outside, get_original_coordinate);
+  const CubicAxisTable x_table = SetupCubicAxisTable(input_width, output_width, width_scale, roi[roi_x_start],
+                                                     roi[roi_x_end], cubic_coeff_a, use_extrapolation,
+                                                     exclude_outside, get_original_coordinate);
+
+  auto clamp = [](int64_t idx, int64_t size) { return std::max<int64_t>(0, std::min(idx, size - 1)); };
+
+  // input rows used by the vertical pass, clamped to the input
+  std::vector<uint8_t> row_needed(narrow<size_t>(input_height), 0);
   for (int64_t y = 0; y < output_height; ++y) {
-    float in_y = height_scale == 1 ? static_cast<float>(y)
-                                   : get_original_coordinate(static_cast<float>(y), height_scale,
-                                                             static_cast<float>(output_height),
-                                                             static_cast<float>(input_height),
-                                                             roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
-    auto s = y_original[narrow<size_t>(y)] - std::floor(y_original[narrow<size_t>(y)]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
-    }
-  }
-
-  // generate coefficients in x direction
-  for (int64_t x = 0; x < output_width; ++x) {
-    float in_x = width_scale == 1 ? static_cast<float>(x)
-                                  : get_original_coordinate(static_cast<float>(x),
-                                                            width_scale,
-                                                            static_cast<float>(output_width),
-                                                            static_cast<float>(input_width),
-                                                            roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
-    auto s = x_original[narrow<size_t>(x)] - std::floor(x_original[narrow<size_t>(x)]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
+    if (!y_table.extrapolate[narrow<size_t>(y)]) {
+      for (int64_t tap = 0; tap < static_cast<int64_t>(CubicModeGridLength); ++tap) {
+        row_needed[narrow<size_t>(clamp(y_table.first_input_idx[narrow<size_t>(y)] + tap, input_height))] = 1;
+      }
     }
   }
 
-  // setup up temp arrays to hold coefficients when exclude_outside is set to true
-  std::array<float, CubicModeGridLength> y_coeff_holder;
-  std::array<float, CubicModeGridLength> x_coeff_holder;
-  float y_coeff_sum = 1;
-  float x_coeff_sum = 1;
+  const TensorOpCost cost{static_cast<double>(input_height * input_width * sizeof(T)),
+                          static_cast<double>(output_height * output_width * sizeof(T)),
+                          static_cast<double>((input_height + output_height) * output_width * CubicModeGridLength * 2)};
 
-  for (int64_t n = 0; n < batch_size; n++) {
-    for (int64_t c = 0; c < num_channels; c++) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        auto in_y = y_original[narrow<size_t>(y)];
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(batch_size * num_channels), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        // input rows interpolated horizontally to the output width
+        std::vector<float> horizontal(narrow<size_t>(input_height * output_width));
 
-        // when use_extrapolation is set and original index is out of the dim range
-        // then use extrapolation_value as the output value.
-        if (use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1))) {
-          for (int64_t x = 0; x < output_width; ++x) {
-            Ydata[y * output_width + x] = extrapolation_value;
-          }
-          continue;
-        }
+        for (std::ptrdiff_t image = first; image < last; ++image) {
+          const T* X = Xdata + image * input_height * input_width;
+          T* Y = Ydata + image * output_height * output_width;
 
-        auto y_int = static_cast<int64_t>(std::floor(in_y));
-        auto& coeff_y = exclude_outside ? y_coeff_holder : cubic_coeffs[in_y - y_int];
-        y_coeff_sum = 1;
-
-        if (exclude_outside) {
-          // When true, the weight of sampling locations outside the grid will be set to 0
-          // and the weight will be renormalized so that their sum is 1.0
-          y_coeff_sum = 0;
-          auto& orig_y_coeffs = cubic_coeffs[in_y - y_int];
-          for (int64_t i = 0, y_val = y_int - 1; y_val <= y_int + 2; y_val++, i++) {
-            y_coeff_holder[narrow<size_t>(i)] = (y_val < 0 || y_val >= static_cast<float>(input_height)) ? 0.0f : orig_y_coeffs[narrow<size_t>(i)];
-            y_coeff_sum += y_coeff_holder[narrow<size_t>(i)];
-          }
-        }
-
-        for (int64_t x = 0; x < output_width; ++x) {
-          auto in_x = x_original[narrow<size_t>(x)];
+          for (int64_t in_y = 0; in_y < input_height; ++in_y) {
+            if (!row_needed[narrow<size_t>(in_y)]) {
+              continue;
+            }
 
-          // when use_extrapolation is set and original index is out of the dim range
-          // then use extrapolation_value as the output value.
-          if (use_extrapolation && (in_x < 0 || in_x > static_cast<float>(input_width - 1))) {
-            Ydata[y * output_width + x] = extrapolation_value;
-            continue;
-          }
+            const T* input_row = X + in_y * input_width;
+            float* horizontal_row = horizontal.data() + in_y * output_width;
+            for (int64_t x = 0; x < output_width; ++x) {
+              const auto x_idx = narrow<size_t>(x);
+              if (x_table.extrapolate[x_idx]) {
+                continue;
+              }
 
-          auto x_int = static_cast<int64_t>(std::floor(in_x));
-          auto s_x = static_cast<float>(in_x - x_int);
-          auto& coeff_x = exclude_outside ? x_coeff_holder : cubic_coeffs[s_x];
-          x_coeff_sum = 1;
-
-          if (exclude_outside) {
-            // When true, the weight of sampling locations outside the grid will be set to 0
-            // and the weight will be renormalized so that their sum is 1.0
-            x_coeff_sum = 0;
-            auto& orig_x_coeff = cubic_coeffs[s_x];
-            for (int64_t i = 0, x_val = x_int - 1; x_val <= x_int + 2; x_val++, i++) {
-              x_coeff_holder[narrow<size_t>(i)] = (x_val < 0 || x_val >= static_cast<float>(input_width)) ? 0.0f : orig_x_coeff[narrow<size_t>(i)];
-              x_coeff_sum += x_coeff_holder[narrow<size_t>(i)];
+              // for 1D cubic interpolation 4 samples are used. 2 on the left and 2 on the right of x
+              const auto& coeff_x = x_table.coeffs[x_idx];
+              const float x_coeff_sum = x_table.coeff_sums[x_idx];
+              const int64_t first_x = x_table.first_input_idx[x_idx];
+              float result = 0;
+              for (size_t tap = 0; tap < CubicModeGridLength; ++tap) {
+                result += coeff_x[tap] / x_coeff_sum * input_row[clamp(first_x + static_cast<int64_t>(tap), input_width)];
+              }
+              horizontal_row[x] = result;
             }
           }
 
-          // Compute cubic interpolation in x dimension using the x coefficients.
-          // From the result of cubic interpolation in x dim, compute cubic interpolation in y dimension
-          auto& interpolation_result_cache = coeff_to_1Dinterpolation_map[s_x];
-          float result = 0;
-          for (int64_t y_val = y_int - 1, i = 0; y_val <= y_int + 2; y_val++, i++) {
-            auto x_interpolation_result = CubicInterpolation1D(Xdata, x_int, y_val,
-                                                               input_height, input_width, coeff_x, x_coeff_sum,
-                                                               interpolation_result_cache);
-            result += x_interpolation_result * coeff_y[narrow<size_t>(i)] / y_coeff_sum;
-          }
+          for (int64_t y = 0; y < output_height; ++y) {
+            const auto y_idx = narrow<size_t>(y);
+            T* output_row = Y + y * output_width;
+            if (y_table.extrapolate[y_idx]) {
+              std::fill_n(output_row, output_width, static_cast<T>(extrapolation_value));
+              continue;
+            }
 
-          Ydata[y * output_width + x] = static_cast<T>(result);
-        }
-      }
+            const auto& coeff_y = y_table.coeffs[y_idx];
+            const float y_coeff_sum = y_table.coeff_sums[y_idx];
+            std::array<const float*, CubicModeGridLength> horizontal_rows;
+            for (size_t tap = 0; tap < CubicModeGridLength; ++tap) {
+              const int64_t in_y = clamp(y_table.first_input_idx[y_idx] + static_cast<int64_t>(tap), input_height);
+              horizontal_rows[tap] = horizontal.data() + in_y * output_width;
+            }
 
-      Xdata += input_height * input_width;
-      Ydata += output_height * output_width;
+            for (int64_t x = 0; x < output_width; ++x) {
+              if (x_table.extrapolate[narrow<size_t>(x)]) {
+                output_row[x] = static_cast<T>(extrapolation_value);
+                continue;
+              }
 
-      // clear the cache when moving to the next channel
-      coeff_to_1Dinterpolation_map.clear();
-    }
-  }
+              float result = 0;
+              for (size_t tap = 0; tap < CubicModeGridLength; ++tap) {
+                result += horizontal_rows[tap][x] * coeff_y[tap] / y_coeff_sum;
+              }
+              output_row[x] = static_cast<T>(result);
+            }
+          }
+        }
+      });
 }
 #if defined(_MSC_VER)
 #pragma warning(pop)
 #endif
 
+template void ResizeBiCubic<float>(int64_t, int64_t, int64_t, int64_t, int64_t, int64_t, float, float, float, bool,
+                                   float, bool, gsl::span<const float>, const float*, float*,
+                                   const GetOriginalCoordinateFunc&, concurrency::ThreadPool*);
+
 template <typename T>
 Status Upsample<T>::BaseCompute(OpKernelContext* context,
                                 gsl::span<const float> roi,
@@ -1150,7 +1117,8 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
     case UpsampleMode::NN:
       return UpsampleNearest<T>(X->Data<T>(), Y->MutableData<T>(), X->Shape(), Y->Shape(),
                                 scales, roi, is_resize_, use_extrapolation_, static_cast<T>(extrapolation_value_),
-                                use_nearest2x_optimization_, get_original_coordinate_, get_nearest_pixel_);
+                                use_nearest2x_optimization_, get_original_coordinate_, get_nearest_pixel_,
+                                context->GetOperatorThreadPool());
     case UpsampleMode::LINEAR: {
       // Supports 'bilinear' and 'trilinear' sampling only
 
@@ -1361,7 +1329,8 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
         ResizeBiCubic(batch_size, num_channels, input_height, input_width, output_height, output_width,
                       height_scale, width_scale, cubic_coeff_a_, use_extrapolation_,
                       extrapolation_value_, exclude_outside_, roi, X->Data<float>(),
-                      Y->MutableData<float>(), get_original_coordinate_);
+                      Y->MutableData<float>(), get_original_coordinate_,
+                      output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
       }
       return Status::OK();
     }
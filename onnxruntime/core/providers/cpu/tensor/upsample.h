@@ -70,6 +70,42 @@ class Upsample : public UpsampleBase, public OpKernel {
                      gsl::span<const int64_t> output_dims) const;
 };
 
+// Resizes a tensor of any rank in 'Nearest' mode. Rows of the innermost dim are processed in parallel.
+template <typename T>
+Status UpsampleNearest(const T* input,
+                       T* output,
+                       const TensorShape& input_shape,
+                       const TensorShape& output_shape,
+                       gsl::span<const float> scales,
+                       gsl::span<const float> roi,
+                       bool is_resize,
+                       bool extrapolation_enabled,
+                       T extrapolation_value,
+                       bool use_nearest2x_optimization,
+                       const GetOriginalCoordinateFunc& get_original_coordinate,
+                       const GetNearestPixelFunc& get_nearest_pixel,
+                       concurrency::ThreadPool* tp);
+
+// Resizes NCHW data in 'Cubic' mode. Images are processed in parallel.
+template <typename T>
+void ResizeBiCubic(int64_t batch_size,
+                   int64_t num_channels,
+                   int64_t input_height,
+                   int64_t input_width,
+                   int64_t output_height,
+                   int64_t output_width,
+                   float height_scale,
+                   float width_scale,
+                   float cubic_coeff_a,
+                   bool use_extrapolation,
+                   float extrapolation_value,
+                   bool exclude_outside,
+                   gsl::span<const float> roi,
+                   const T* Xdata,
+                   T* Ydata,
+                   const GetOriginalCoordinateFunc& get_original_coordinate,
+                   concurrency::ThreadPool* tp);
+
 BilinearParams SetupUpsampleBilinear(const int32_t input_height,
                                      const int32_t input_width,
                                      const int32_t output_height,
@@ -101,38 +137,48 @@ void UpsampleBilinear(const int32_t batch_size,
   BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
                                            height_scale, width_scale, roi,
                                            alloc, get_original_coordinate, true);
-  for (int32_t n = 0; n < batch_size; ++n) {
-    concurrency::ThreadPool::TrySimpleParallelFor(
-        tp, num_channels,
-        [&](std::ptrdiff_t c) {
-          const T* const Xdata =
-              XdataBase + (n * num_channels + static_cast<int32_t>(c)) * (input_height * input_width);
-          T* const Ydata = YdataBase + (n * num_channels + static_cast<int32_t>(c)) * (output_height * output_width);
-          for (int32_t y = 0; y < output_height; ++y) {
-            for (int32_t x = 0; x < output_width; ++x) {
-              const int32_t output_offset = output_width * y + x;
-              // when use_extrapolation is set and original index of x or y is out of the dim range
-              // then use extrapolation_value as the output value.
-              if (use_extrapolation &&
-                  ((p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1)) ||
-                   (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1)))) {
-                Ydata[output_offset] = static_cast<T>(extrapolation_value);
-                continue;
-              }
 
-              T X11 = Xdata[p.input_width_mul_y1[y] + p.in_x1[x]];
-              T X21 = Xdata[p.input_width_mul_y1[y] + p.in_x2[x]];
-              T X12 = Xdata[p.input_width_mul_y2[y] + p.in_x1[x]];
-              T X22 = Xdata[p.input_width_mul_y2[y] + p.in_x2[x]];
+  // parallelize over the output rows of all the images so that inputs with few channels, e.g. RGB images, still use
+  // all the threads
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(batch_size) * num_channels * output_height,
+      static_cast<double>(output_width * 8),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const auto image = static_cast<int32_t>(row / output_height);
+          const auto y = static_cast<int32_t>(row % output_height);
+          const T* const Xdata = XdataBase + static_cast<std::ptrdiff_t>(image) * (input_height * input_width);
+          T* const Ydata = YdataBase + row * output_width;
+
+          // when use_extrapolation is set and original index of y is out of the dim range
+          // then use extrapolation_value as the output value.
+          if (use_extrapolation &&
+              (p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1))) {
+            std::fill_n(Ydata, output_width, static_cast<T>(extrapolation_value));
+            continue;
+          }
 
-              Ydata[output_offset] = static_cast<T>(p.dx2[x] * p.dy2[y] * X11 +
-                                                    p.dx1[x] * p.dy2[y] * X21 +
-                                                    p.dx2[x] * p.dy1[y] * X12 +
-                                                    p.dx1[x] * p.dy1[y] * X22);
+          for (int32_t x = 0; x < output_width; ++x) {
+            // when use_extrapolation is set and original index of x is out of the dim range
+            // then use extrapolation_value as the output value.
+            if (use_extrapolation &&
+                (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1))) {
+              Ydata[x] = static_cast<T>(extrapolation_value);
+              continue;
             }
+
+            T X11 = Xdata[p.input_width_mul_y1[y] + p.in_x1[x]];
+            T X21 = Xdata[p.input_width_mul_y1[y] + p.in_x2[x]];
+            T X12 = Xdata[p.input_width_mul_y2[y] + p.in_x1[x]];
+            T X22 = Xdata[p.input_width_mul_y2[y] + p.in_x2[x]];
+
+            Ydata[x] = static_cast<T>(p.dx2[x] * p.dy2[y] * X11 +
+                                      p.dx1[x] * p.dy2[y] * X21 +
+                                      p.dx2[x] * p.dy1[y] * X12 +
+                                      p.dx1[x] * p.dy1[y] * X22);
           }
-        });
-  }
+        }
+      });
 }
 
 template <typename T, bool UseExtrapolation>
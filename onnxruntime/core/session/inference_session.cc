@@ -4,6 +4,7 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/inference_session.h"
 
+#include <cstdlib>
 #include <memory>
 #include <sstream>
 #include <list>
@@ -13,6 +14,7 @@
 #include <iomanip>
 
 #include "core/common/denormal.h"
+#include "core/common/endian.h"
 #include "core/common/logging/isink.h"
 #include "core/common/logging/logging.h"
 #include "core/common/parse_string.h"
@@ -39,6 +41,7 @@
 #include "core/framework/transform_layout_functions.h"
 #include "core/framework/utils.h"
 #include "core/graph/constants.h"
+#include "core/graph/graph_flatbuffers_utils.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
 #include "core/graph/model_editor_api_types.h"
@@ -392,6 +395,7 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
   // Update the number of steps for the graph transformer manager using the "finalized" session options
   ORT_THROW_IF_ERROR(graph_transformer_mgr_.SetSteps(session_options_.max_num_graph_transformation_steps));
   graph_transformer_mgr_.SetLoadCancellationFn(this->check_load_cancellation_fn_);
+  graph_transformer_mgr_.SetProfiler(&session_profiler_);
 #endif
 
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
@@ -737,6 +741,22 @@ InferenceSession::InferenceSession(const SessionOptions& session_options, const
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 InferenceSession::~InferenceSession() {
+  // The SessionState shared with the clones references the session options, logger, profiler, data transfer manager
+  // and thread pools of this session, so the clones would be left with dangling references.
+  if (!is_clone_ && session_state_ && session_state_.use_count() > 1) {
+    LOGS(*session_logger_, FATAL) << "Session " << session_id_ << " was destroyed while "
+                                  << session_state_.use_count() - 1
+                                  << " session(s) created by InferenceSession::Clone are still alive. "
+                                     "A session must outlive its clones.";
+    std::abort();
+  }
+
+  // cancel any warm-up and wait for it before the session is torn down
+  if (warm_up_thread_pool_) {
+    warm_up_run_options_.terminate = true;
+    warm_up_thread_pool_.reset();
+  }
+
   // Flush any remaining RuntimePerf counters
   ORT_TRY {
     std::lock_guard<std::mutex> telemetry_lock(telemetry_mutex_);
@@ -941,7 +961,11 @@ common::Status InferenceSession::RegisterGraphTransformer(
                           "Graph transformers must be registered before the session is initialized.");
   }
 
-  return graph_transformer_mgr_.Register(std::move(p_graph_transformer), level);
+  // recorded for the optimized model cache key
+  std::string transformer_id = p_graph_transformer->Name() + ":" + std::to_string(static_cast<int>(level));
+  ORT_RETURN_IF_ERROR(graph_transformer_mgr_.Register(std::move(p_graph_transformer), level));
+  custom_graph_transformers_.push_back(std::move(transformer_id));
+  return Status::OK();
 }
 
 common::Status InferenceSession::SaveToOrtFormat(const std::filesystem::path& filepath) const {
@@ -1052,10 +1076,11 @@ common::Status InferenceSession::LoadOnnxModel(const PathString& model_uri) {
 
     const bool strict_shape_type_inference = session_options_.config_options.GetConfigOrDefault(
                                                  kOrtSessionOptionsConfigStrictShapeTypeInference, "0") == "1";
+    ModelOptions model_options(true, strict_shape_type_inference, check_load_cancellation_fn_);
+    model_options.stream_initializers_from_file = session_options_.config_options.GetConfigOrDefault(
+                                                      kOrtSessionOptionsStreamingModelLoad, "0") == "1";
     return onnxruntime::Model::Load(model_location_, model, HasLocalSchema() ? &custom_schema_registries_ : nullptr,
-                                    *session_logger_,
-                                    ModelOptions(true, strict_shape_type_inference,
-                                                 check_load_cancellation_fn_));
+                                    *session_logger_, model_options);
   };
 
   common::Status st = LoadWithLoader(loader, "model_loading_uri");
@@ -1092,6 +1117,10 @@ common::Status InferenceSession::Load(const PathString& model_uri) {
                            "Invoke Load().");
   }
 
+  if (!session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsOptimizedModelCacheDir, "").empty()) {
+    ORT_RETURN_IF_ERROR(inference_session_utils::HashModelFile(model_uri, optimized_model_cache_model_hash_));
+  }
+
   return LoadOnnxModel(model_uri);
 #else
   return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "ONNX format model is not supported in this build.");
@@ -1121,6 +1150,11 @@ common::Status InferenceSession::Load(const void* model_data, int model_data_len
                            "Invoke Load().");
   }
 
+  if (!session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsOptimizedModelCacheDir, "").empty()) {
+    optimized_model_cache_model_hash_ = inference_session_utils::HashModelBytes(
+        gsl::span<const uint8_t>(reinterpret_cast<const uint8_t*>(model_data), static_cast<size_t>(model_data_len)));
+  }
+
   auto loader = [this, model_data, model_data_len](std::shared_ptr<onnxruntime::Model>& model) {
     ModelProto model_proto;
 
@@ -1382,6 +1416,7 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph, bool
                                                                            session_logger_);
   GraphPartitioner partitioner(kernel_registry_manager_, execution_providers_, std::move(graph_optimizer_registry),
                                check_load_cancellation_fn_, on_partition_assignment_fn);
+  partitioner.SetProfiler(&session_profiler_);
 
   // Run Ahead Of time function inlining
   if (const bool disable_aot_function_inlining =
@@ -1618,6 +1653,116 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph, bool
 }
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
+#if !defined(ORT_MINIMAL_BUILD)
+// Publish an optimized model saved under its pending name to cache_path. A hard link is used rather than a rename as
+// it never replaces an entry another session published concurrently. The pending model file is always removed, and
+// its external data file is removed too unless the published entry references it.
+static void PublishOptimizedModelCacheEntry(const Status& save_status,
+                                            const std::filesystem::path& pending_model_path,
+                                            const std::filesystem::path& pending_data_path,
+                                            const std::filesystem::path& cache_path,
+                                            const logging::Logger& logger) {
+  bool published = false;
+  std::error_code ec;
+  if (!save_status.IsOK()) {
+    LOGS(logger, WARNING) << "Failed to save the optimized model to the cache: " << save_status.ErrorMessage();
+  } else {
+    std::filesystem::create_hard_link(pending_model_path, cache_path, ec);
+    if (!ec) {
+      published = true;
+    } else if (ec == std::errc::file_exists) {
+      LOGS(logger, INFO) << "The optimized model was added to the cache by another session: " << cache_path.string();
+    } else {
+      LOGS(logger, WARNING) << "Failed to add the optimized model to the cache at " << cache_path.string() << ": "
+                            << ec.message();
+    }
+  }
+
+  std::filesystem::remove(pending_model_path, ec);
+  if (!published) {
+    std::filesystem::remove(pending_data_path, ec);
+  }
+}
+
+Status InferenceSession::ApplyOptimizedModelCache() {
+  const std::string cache_dir = session_options_.config_options.GetConfigOrDefault(
+      kOrtSessionOptionsOptimizedModelCacheDir, "");
+  if (cache_dir.empty()) {
+    return Status::OK();
+  }
+
+  bool has_external_initializers = false;
+#if !defined(DISABLE_EXTERNAL_INITIALIZERS)
+  has_external_initializers = !session_options_.external_initializers.empty() ||
+                              !session_options_.external_initializer_files_mmap.empty();
+#endif
+
+  if (optimized_model_cache_model_hash_.empty() || !session_options_.optimized_model_filepath.empty() ||
+      has_external_initializers) {
+    LOGS(*session_logger_, WARNING)
+        << "The optimized model cache is only used for ONNX models loaded from a file path or bytes, "
+           "without optimized_model_filepath or external initializers. The cache will not be used.";
+    return Status::OK();
+  }
+
+  // the model hash only covers the .onnx file, so add the external data files the initializers are read from
+  std::string external_data_hash;
+  const std::filesystem::path model_dir = std::filesystem::path(model_location_).parent_path();
+  const Status external_data_status = inference_session_utils::HashExternalDataFiles(model_->MainGraph(), model_dir,
+                                                                                     external_data_hash);
+  if (!external_data_status.IsOK()) {
+    LOGS(*session_logger_, WARNING) << "Failed to hash the external data files of the model. The optimized model "
+                                    << "cache will not be used. " << external_data_status.ErrorMessage();
+    return Status::OK();
+  }
+
+  const std::string key = inference_session_utils::GetOptimizedModelCacheKey(
+      optimized_model_cache_model_hash_ + external_data_hash, session_options_, execution_providers_,
+      custom_registries_, custom_graph_transformers_, optimizers_to_disable_);
+  const std::filesystem::path cache_dir_path{ToPathString(cache_dir)};
+  const std::filesystem::path cache_path = cache_dir_path / ToPathString(key + ".onnx");
+
+  std::error_code ec;
+  if (std::filesystem::exists(cache_path, ec)) {
+    std::shared_ptr<Model> original_model;
+    const PathString original_model_location = model_location_;
+    {
+      std::lock_guard<std::mutex> l(session_mutex_);
+      original_model = std::move(model_);
+      is_model_loaded_ = false;
+    }
+
+    Status status = LoadOnnxModel(cache_path.native());
+    if (status.IsOK()) {
+      LOGS(*session_logger_, INFO) << "Loaded optimized model from cache: " << cache_path.string();
+      // the cached model has already been optimized with the same settings
+      session_options_.graph_optimization_level = TransformerLevel::Default;
+      return Status::OK();
+    }
+
+    LOGS(*session_logger_, WARNING) << "Failed to load optimized model from cache: " << cache_path.string()
+                                    << ". The model will be optimized again. " << status.ErrorMessage();
+    std::lock_guard<std::mutex> l(session_mutex_);
+    model_ = std::move(original_model);
+    model_location_ = original_model_location;
+    is_model_loaded_ = true;
+  }
+
+  // Save to a name unique to this session and link it into place once complete, so that other processes never
+  // see a partially written model. The external data file keeps its unique name.
+  const std::string pending_name = key + "." + std::to_string(Env::Default().GetSelfPid()) + "." +
+                                   std::to_string(session_id_);
+  session_options_.optimized_model_filepath = cache_dir_path / ToPathString(pending_name + ".onnx");
+  ORT_RETURN_IF_ERROR(session_options_.config_options.AddConfigEntry(
+      kOrtSessionOptionsOptimizedModelExternalInitializersFileName, (pending_name + ".onnx.data").c_str()));
+  ORT_RETURN_IF_ERROR(session_options_.config_options.AddConfigEntry(
+      kOrtSessionOptionsSavePrePackedConstantInitializers, "1"));
+  optimized_model_cache_path_ = cache_path;
+
+  return Status::OK();
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 static Status LoadOrtModelBytes(const PathString& model_uri,
                                 gsl::span<const uint8_t>& bytes,
                                 std::vector<uint8_t>& bytes_data_holder) {
@@ -1644,6 +1789,27 @@ Status InferenceSession::LoadOrtModel(const PathString& model_uri) {
   return LoadOrtModelWithLoader(
       [&]() {
         model_location_ = model_uri;
+
+        const bool map_model_file =
+            GetSessionOptions().config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMapOrtModelFile, "1") == "1";
+        if (map_model_file) {
+          size_t num_bytes = 0;
+          ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(model_location_.c_str(), num_bytes));
+          Env::MappedMemoryPtr mapping;
+          auto status = num_bytes > 0
+                            ? Env::Default().MapFileIntoMemory(model_location_.c_str(), 0, num_bytes, mapping)
+                            : ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Model file is empty.");
+          if (status.IsOK()) {
+            ort_format_model_bytes_ = gsl::span<const uint8_t>(reinterpret_cast<const uint8_t*>(mapping.get()),
+                                                               num_bytes);
+            ort_format_model_mapping_ = std::move(mapping);
+            return Status::OK();
+          }
+
+          LOGS(*session_logger_, INFO) << "Failed to memory map ORT format model. Reading it instead. "
+                                       << status.ErrorMessage();
+        }
+
         ORT_RETURN_IF_ERROR(
             LoadOrtModelBytes(model_location_, ort_format_model_bytes_, ort_format_model_bytes_data_holder_));
         return Status::OK();
@@ -1754,11 +1920,18 @@ Status InferenceSession::LoadOrtModelWithLoader(std::function<Status()> load_ort
   // provided an existing buffer of bytes when creating the InferenceSession, ort_format_model_bytes_data_holder_
   // will be empty.
   // if that is the case we also allow creating initializers that directly use those bytes.
+  // a memory mapped model file is owned by the session, so initializers always use it. only data aligned as written
+  // by the ORT format writer is used in place. data in the file is little endian.
   const auto& config_options = session_options_.config_options;
-  using_ort_model_bytes_for_initializers_ =
-      load_options.can_use_flatbuffer_for_initializers =
-          ort_format_model_bytes_data_holder_.empty() &&
-          config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseORTModelBytesForInitializers, "0") == "1";
+  if (ort_format_model_mapping_ && endian::native == endian::little) {
+    using_ort_model_bytes_for_initializers_ = load_options.can_use_flatbuffer_for_initializers = true;
+    load_options.initializer_alignment = fbs::utils::kInitializerAlignment;
+  } else {
+    using_ort_model_bytes_for_initializers_ =
+        load_options.can_use_flatbuffer_for_initializers =
+            ort_format_model_bytes_data_holder_.empty() &&
+            config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseORTModelBytesForInitializers, "0") == "1";
+  }
 
   // need to go from unique_ptr to shared_ptr when moving into model_
   std::unique_ptr<Model> tmp_model;
@@ -2034,6 +2207,7 @@ Status PartitionOrtFormatModel(onnxruntime::Graph& graph,
 
   GraphPartitioner partitioner(kernel_registry_manager, providers, std::move(graph_optimizer_registry),
                                [&sess_options]() -> bool { return sess_options.IsLoadCancellationFlagSet(); });
+  partitioner.SetProfiler(&session_state.Profiler());
   ORT_RETURN_IF_ERROR(partitioner.Partition(graph,
                                             session_state.GetMutableFuncMgr(),
                                             transform_layout_fn,
@@ -2149,6 +2323,12 @@ common::Status InferenceSession::Initialize() {
       have_cpu_ep = execution_providers_.Get(onnxruntime::kCpuExecutionProvider) != nullptr;
     }
 
+#if !defined(ORT_MINIMAL_BUILD)
+    if (ort_format_model_bytes_.empty()) {
+      ORT_RETURN_IF_ERROR_SESSIONID_(ApplyOptimizedModelCache());
+    }
+#endif
+
     // Verify that there are no external initializers in the graph if external data is disabled.
     onnxruntime::Graph& graph = model_->MainGraph();
 
@@ -2380,11 +2560,29 @@ common::Status InferenceSession::Initialize() {
       }
 #endif
 
+      TimePoint transform_tp;
+      if (session_profiler_.IsEnabled()) {
+        transform_tp = session_profiler_.Start();
+      }
+
+      // only re-run type/shape inferencing for the parts of the graph changed by each transformer
+      const bool incremental_resolve = session_options_.config_options.GetConfigOrDefault(
+                                           kOrtSessionOptionsDisableIncrementalGraphResolve, "0") != "1";
+      graph.SetIncrementalResolve(incremental_resolve);
+
       // apply any transformations to the main graph and any subgraphs
       ORT_RETURN_IF_ERROR_SESSIONID_(TransformGraph(graph, saving_ort_format));
 
       // now that all the transforms are done, call Resolve on the main graph. this will recurse into the subgraphs.
       ORT_RETURN_IF_ERROR_SESSIONID_(graph.Resolve());
+
+      if (incremental_resolve) {
+        graph.SetIncrementalResolve(false);
+      }
+
+      if (session_profiler_.IsEnabled()) {
+        session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "graph_transformation", transform_tp);
+      }
       if (session_options_.IsLoadCancellationFlagSet()) {
         return ORT_MAKE_STATUS(ONNXRUNTIME, MODEL_LOAD_CANCELED,
                                "Session initialization canceled due to user request.");
@@ -2542,14 +2740,27 @@ common::Status InferenceSession::Initialize() {
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
     }
 
+    TimePoint finalize_tp;
+    if (session_profiler_.IsEnabled()) {
+      finalize_tp = session_profiler_.Start();
+    }
+
     ORT_RETURN_IF_ERROR_SESSIONID_(
         session_state_->FinalizeSessionState(model_location_, kernel_registry_manager_,
                                              // need to keep the initializers if saving the optimized model
                                              !saving_model,
                                              saving_ort_format));
 
+    if (session_profiler_.IsEnabled()) {
+      session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "session_state_finalization", finalize_tp);
+    }
+
 #if !defined(ORT_MINIMAL_BUILD)
-    if (saving_model) {
+    const bool saving_to_optimized_model_cache = !optimized_model_cache_path_.empty();
+    if (saving_to_optimized_model_cache && session_state_->GetFuncMgr().NumFuncs() > 0) {
+      LOGS(*session_logger_, WARNING) << "The model contains compiled nodes and will not be added to the "
+                                         "optimized model cache.";
+    } else if (saving_model) {
       if (session_state_->GetFuncMgr().NumFuncs() > 0) {
         ORT_RETURN_IF_ERROR_SESSIONID_(
             ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
@@ -2580,10 +2791,20 @@ common::Status InferenceSession::Initialize() {
                   kOrtSessionOptionsOptimizedModelExternalInitializersMinSizeInBytes, "1024"));
           ModelSavingOptions model_saving_options{optimized_model_external_initializers_min_size_in_bytes};
           model_saving_options.align_offset = true;
-          ORT_RETURN_IF_ERROR_SESSIONID_(Model::SaveWithExternalInitializers(*model_,
-                                                                             session_options_.optimized_model_filepath,
-                                                                             optimized_model_external_initializers_file_name,
-                                                                             model_saving_options));
+          Status save_status = Model::SaveWithExternalInitializers(*model_,
+                                                                   session_options_.optimized_model_filepath,
+                                                                   optimized_model_external_initializers_file_name,
+                                                                   model_saving_options);
+          if (saving_to_optimized_model_cache) {
+            // a failure to populate the cache doesn't affect the session
+            const std::filesystem::path pending_model_path{session_options_.optimized_model_filepath};
+            PublishOptimizedModelCacheEntry(save_status, pending_model_path,
+                                            pending_model_path.parent_path() /
+                                                ToPathString(optimized_model_external_initializers_file_name),
+                                            optimized_model_cache_path_, *session_logger_);
+          } else {
+            ORT_RETURN_IF_ERROR_SESSIONID_(save_status);
+          }
         }
       }
     }
@@ -3185,6 +3406,8 @@ Status InferenceSession::Run(const RunOptions& run_options,
 #endif
 
       if (retval.IsOK()) {
+        // the thread pools of this session, which differ from the ones of session_state_ if this session is a clone
+        const ExecutionThreadPools thread_pools{GetIntraOpThreadPoolToUse(), GetInterOpThreadPoolToUse()};
         retval = utils::ExecuteGraph(*session_state_, feeds_fetches_manager, feeds, *p_fetches,
                                      session_options_.execution_mode,
                                      run_options,
@@ -3192,7 +3415,8 @@ Status InferenceSession::Run(const RunOptions& run_options,
                                      device_stream_collection_holder,
 #endif
                                      run_logger,
-                                     run_profiler ? &*run_profiler : nullptr);
+                                     run_profiler ? &*run_profiler : nullptr,
+                                     &thread_pools);
       }
 
       // info all execution providers InferenceSession:Run ended
@@ -3425,6 +3649,179 @@ common::Status InferenceSession::RunAsync(const RunOptions* run_options,
   return Status::OK();
 }
 
+namespace {
+
+// Creates zero-filled CPU tensors for the model inputs. Shapes are taken from shapes, or from the model with symbolic
+// dimensions set to 1.
+Status CreateWarmUpFeeds(const InputDefList& inputs, const InferenceSession::WarmUpShapes& shapes,
+                         InlinedVector<std::string>& feed_names, std::vector<OrtValue>& feeds) {
+  AllocatorPtr cpu_allocator = CPUAllocator::DefaultInstance();
+  feed_names.clear();
+  feeds.clear();
+  feeds.reserve(inputs.size());
+
+  for (const NodeArg* input : inputs) {
+    const auto* type_proto = input->TypeAsProto();
+    ORT_RETURN_IF(type_proto == nullptr || !utils::HasTensorType(*type_proto),
+                  "Warm-up only supports tensor inputs. Input: ", input->Name());
+
+    TensorShape shape;
+    if (auto it = shapes.find(input->Name()); it != shapes.end()) {
+      shape = TensorShape(it->second);
+    } else {
+      const auto* shape_proto = input->Shape();
+      ORT_RETURN_IF(shape_proto == nullptr, "The rank of input ", input->Name(),
+                    " is unknown. Its shape must be specified for the warm-up.");
+      TensorShapeVector dims;
+      dims.reserve(shape_proto->dim_size());
+      for (const auto& dim : shape_proto->dim()) {
+        dims.push_back(utils::HasDimValue(dim) ? dim.dim_value() : 1);
+      }
+      shape = TensorShape(dims);
+    }
+
+    const auto* element_type =
+        DataTypeImpl::TensorTypeFromONNXEnum(type_proto->tensor_type().elem_type())->GetElementType();
+    OrtValue feed;
+    Tensor::InitOrtValue(element_type, shape, cpu_allocator, feed);
+    auto& tensor = *feed.GetMutable<Tensor>();
+    if (!tensor.IsDataTypeString()) {
+      memset(tensor.MutableDataRaw(), 0, tensor.SizeInBytes());
+    }
+
+    feed_names.push_back(input->Name());
+    feeds.push_back(std::move(feed));
+  }
+
+  return Status::OK();
+}
+
+}  // namespace
+
+common::Status InferenceSession::WarmUpAsync(std::vector<WarmUpShapes> shape_buckets, WarmUpCallbackFn callback) {
+  ORT_RETURN_IF_NOT(callback, "A callback is required for the warm-up.");
+
+  concurrency::ThreadPool* warm_up_tp = nullptr;
+  {
+    std::lock_guard<std::mutex> l(session_mutex_);
+    ORT_RETURN_IF_NOT(is_inited_, "Session must be initialized before it can be warmed up.");
+
+    if (!warm_up_thread_pool_) {
+      // a single worker thread. warm-up runs are not latency sensitive, so it doesn't spin.
+      OrtThreadPoolParams to;
+      to.thread_pool_size = 2;
+      to.allow_spinning = false;
+      to.auto_set_affinity = false;
+      std::basic_stringstream<ORTCHAR_T> ss;
+      ss << ORT_TSTR("session-") << session_id_ << ORT_TSTR("-warm-up");
+      warm_up_thread_pool_name_ = ss.str();
+      to.name = warm_up_thread_pool_name_.c_str();
+      to.custom_create_thread_fn = session_options_.custom_create_thread_fn;
+      to.custom_thread_creation_options = session_options_.custom_thread_creation_options;
+      to.custom_join_thread_fn = session_options_.custom_join_thread_fn;
+      warm_up_thread_pool_ = concurrency::CreateThreadPool(&Env::Default(), to,
+                                                           concurrency::ThreadPoolType::INTRA_OP);
+      ORT_RETURN_IF_NOT(warm_up_thread_pool_, "Failed to create the warm-up thread.");
+      warm_up_run_options_.run_tag = "warm-up";
+    }
+
+    warm_up_tp = warm_up_thread_pool_.get();
+  }
+
+  if (shape_buckets.empty()) {
+    shape_buckets.emplace_back();
+  }
+
+  std::function<void()> warm_up_fn = [this, shape_buckets = std::move(shape_buckets),
+                                      callback = std::move(callback)]() {
+    Status status;
+    ORT_TRY {
+      const auto& inputs = *GetModelInputs().second;
+      const auto& outputs = *GetModelOutputs().second;
+      InlinedVector<std::string> output_names;
+      output_names.reserve(outputs.size());
+      for (const NodeArg* output : outputs) {
+        output_names.push_back(output->Name());
+      }
+
+      InlinedVector<std::string> feed_names;
+      std::vector<OrtValue> feeds;
+      std::vector<OrtValue> fetches;
+      for (const auto& shapes : shape_buckets) {
+        status = CreateWarmUpFeeds(inputs, shapes, feed_names, feeds);
+        if (status.IsOK()) {
+          fetches.clear();
+          status = Run(warm_up_run_options_, feed_names, feeds, output_names, &fetches);
+        }
+
+        if (!status.IsOK()) {
+          break;
+        }
+      }
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+    ORT_CATCH(...) {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, "unknown exception");
+    }
+
+    if (!status.IsOK()) {
+      LOGS(*session_logger_, WARNING) << "Warm-up failed: " << status.ErrorMessage();
+    }
+
+    callback(status);
+  };
+
+  concurrency::ThreadPool::Schedule(warm_up_tp, std::move(warm_up_fn));
+  return Status::OK();
+}
+
+common::Status InferenceSession::Clone(const SessionOptions& session_options,
+                                       std::unique_ptr<InferenceSession>& clone) const {
+  {
+    std::lock_guard<std::mutex> l(session_mutex_);
+    ORT_RETURN_IF_NOT(is_inited_, "Session must be initialized before it can be cloned.");
+  }
+
+  // Run serializes graph execution with session_mutex_ in this case, which the clone would not share.
+  ORT_RETURN_IF_NOT(is_concurrent_run_supported_,
+                    "Sessions with execution providers that do not support concurrent runs cannot be cloned.");
+  // the captured graphs are owned by the execution provider instances, which the clone would share.
+  ORT_RETURN_IF(cached_execution_provider_for_graph_replay_.IsGraphCaptureEnabled(),
+                "Sessions with graph capture enabled cannot be cloned.");
+
+  auto new_session = std::make_unique<InferenceSession>(session_options, environment_);
+
+  // the SessionState references the execution providers of this session. the clone calls OnRunStart/OnRunEnd on
+  // the same instances.
+  const auto& provider_ids = execution_providers_.GetIds();
+  size_t provider_idx = 0;
+  for (const auto& provider : execution_providers_) {
+    ORT_RETURN_IF_ERROR(new_session->execution_providers_.Add(provider_ids[provider_idx++], provider));
+  }
+  new_session->execution_providers_.SetCpuProviderWasImplicitlyAdded(
+      execution_providers_.GetCpuProviderWasImplicitlyAdded());
+
+  new_session->model_ = model_;
+  new_session->model_location_ = model_location_;
+  new_session->model_metadata_ = model_metadata_;
+  new_session->input_def_map_ = input_def_map_;
+  new_session->output_def_map_ = output_def_map_;
+  new_session->session_state_ = session_state_;
+  new_session->is_clone_ = true;
+  new_session->is_model_loaded_ = true;
+  new_session->is_inited_ = true;
+
+  LOGS(*new_session->session_logger_, INFO) << "Session " << new_session->session_id_ << " is a clone of session "
+                                            << session_id_;
+
+  clone = std::move(new_session);
+  return Status::OK();
+}
+
 common::Status InferenceSession::Run(const NameMLValMap& feeds, gsl::span<const std::string> output_names,
                                      std::vector<OrtValue>* p_fetches) {
   return Run(RunOptions(), feeds, output_names, p_fetches);
@@ -30,6 +30,7 @@
 #include "core/optimizer/graph_transformer_level.h"
 #include "core/optimizer/graph_transformer_mgr.h"
 #include "core/optimizer/insert_cast_transformer.h"
+#include "core/platform/env.h"
 #include "core/session/ep_graph_assignment_info.h"
 #include <mutex>
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
@@ -359,6 +360,22 @@ class InferenceSession {
    */
   [[nodiscard]] common::Status Initialize();
 
+  /**
+   * Creates a session that shares the model, kernels, initializers, pre-packed weights and execution plan of this
+   * initialized session instead of loading and initializing the model again.
+   * The clone is created with session_options and has its own thread pools, logger, profiler and telemetry, and can
+   * be run concurrently with this session. Options that only affect loading and initializing the model, such as the
+   * graph optimization level or the memory pattern setting, have no effect as that state is shared.
+   * The execution providers and their allocators, including the memory arenas, are shared with this session.
+   * Kernel events are only recorded by the profiler of this session. Use run-level profiling to profile the clone.
+   * This session must outlive the clone. Destroying it while a clone is alive aborts the process.
+   * @param session_options the options for the clone.
+   * @param clone the new session, which is already initialized.
+   * @return OK if the clone was created.
+   */
+  [[nodiscard]] common::Status Clone(const SessionOptions& session_options,
+                                     std::unique_ptr<InferenceSession>& clone) const;
+
   [[nodiscard]] common::Status SetEpDynamicOptions(gsl::span<const char* const> keys,
                                                    gsl::span<const char* const> values);
 
@@ -381,6 +398,30 @@ class InferenceSession {
                                         RunAsyncCallbackFn callback,
                                         void* user_data = nullptr);
 
+  /**
+   * Shapes of the model inputs for one warm-up run, by input name.
+   */
+  using WarmUpShapes = InlinedHashMap<std::string, TensorShapeVector>;
+
+  /**
+   * Called once a warm-up started by WarmUpAsync has completed, with OK or the first error encountered.
+   */
+  using WarmUpCallbackFn = std::function<void(const common::Status& status)>;
+
+  /**
+   * Warms up an initialized session in the background so that the first Run calls with real inputs are not slowed
+   * down by one-time work.
+   * The model is run once for each entry of shape_buckets with zero-filled inputs. This grows the arenas to the size
+   * required for those shapes, creates the memory patterns for them if memory patterns are enabled, and creates kernel
+   * state that is initialized on the first Run. Inputs not listed in an entry use their shape from the model with
+   * symbolic dimensions set to 1. If shape_buckets is empty, one run is done with those shapes.
+   * The runs are done on a dedicated thread that doesn't spin. Run can be called while the warm-up is in progress.
+   * If the session is destroyed first, the remaining runs are cancelled and callback is called with the error.
+   * This API is thread-safe.
+   * @return OK if the warm-up was started.
+   */
+  [[nodiscard]] common::Status WarmUpAsync(std::vector<WarmUpShapes> shape_buckets, WarmUpCallbackFn callback);
+
   /**
    * Run a pre-loaded and pre-intialized model.
    * Multiple threads are allowed to run this function; hence its thread-safe.
@@ -804,6 +845,15 @@ class InferenceSession {
 
   [[nodiscard]] common::Status LoadOrtModelWithLoader(std::function<Status()> load_ort_format_model_bytes);
 
+#if !defined(ORT_MINIMAL_BUILD)
+  /**
+   * Look up the loaded model in the optimized model cache (kOrtSessionOptionsOptimizedModelCacheDir).
+   * On a hit the cached optimized model replaces the loaded model and graph optimizations are disabled.
+   * On a miss the session is set up to save the optimized model and publish it to the cache in Initialize().
+   */
+  [[nodiscard]] common::Status ApplyOptimizedModelCache();
+#endif
+
   // Create a Logger for a single execution if possible. Otherwise use the default logger.
   // If a new logger is created, it will also be stored in new_run_logger,
   // which must remain valid for the duration of the execution.
@@ -867,6 +917,9 @@ class InferenceSession {
 
   onnxruntime::GraphTransformerManager graph_transformer_mgr_;
 
+  // Name and level of each graph transformer added with RegisterGraphTransformer.
+  std::vector<std::string> custom_graph_transformers_;
+
   InlinedHashSet<gsl::not_null<const ONNX_NAMESPACE::OpSchema*>> saved_runtime_optimization_produced_node_op_schemas_;
 #endif
   // Any GraphTransformer/RewriteRule name in this set will not be enabled.
@@ -897,9 +950,9 @@ class InferenceSession {
   MemoryProfiler memory_profiler_;
 #endif
 
-  // Immutable state for each op in the model. Shared by all executors.
+  // Immutable state for each op in the model. Shared by all executors, and with the sessions created by Clone.
   // It has a dependency on execution_providers_.
-  std::unique_ptr<SessionState> session_state_;
+  std::shared_ptr<SessionState> session_state_;
 
   // Threadpools per session. These are initialized and used for the entire duration of the session
   // when use_per_session_threads is true.
@@ -915,6 +968,12 @@ class InferenceSession {
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> thread_pool_;
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> inter_op_thread_pool_;
 
+  // Single thread for the runs of WarmUpAsync. Created on first use.
+  std::basic_string<ORTCHAR_T> warm_up_thread_pool_name_;
+  std::unique_ptr<onnxruntime::concurrency::ThreadPool> warm_up_thread_pool_;  // GUARDED_BY(session_mutex_)
+  // Options of the warm-up runs. terminate is set when the session is destroyed.
+  RunOptions warm_up_run_options_;
+
   // Global threadpools. These are intialized and used when use_per_session_threads is false *and*
   // the environment is created with create_global_thread_pools = true.
   onnxruntime::concurrency::ThreadPool* intra_op_thread_pool_from_env_{};
@@ -960,6 +1019,8 @@ class InferenceSession {
   bool is_model_loaded_ = false;             // GUARDED_BY(session_mutex_)
   bool is_inited_ = false;                   // GUARDED_BY(session_mutex_)
   bool is_concurrent_run_supported_ = true;  // Graph execution in Run is GUARDED_BY(session_mutex_) if false
+  // true if this session was created by Clone and doesn't own the objects the shared SessionState references
+  bool is_clone_ = false;
 
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
   InterOpDomains interop_domains_;
@@ -994,6 +1055,14 @@ class InferenceSession {
 
   // Flag indicating if ModelProto has been parsed in an applicable ctor
   bool is_model_proto_parsed_ = false;
+
+  // Hash of the ONNX model bytes, set when the optimized model cache is enabled and the model is loaded
+  // from a file path or bytes.
+  std::string optimized_model_cache_model_hash_;
+
+  // Path the optimized model is published to in the optimized model cache after it has been saved.
+  // Empty unless the model missed the cache.
+  std::filesystem::path optimized_model_cache_path_;
   const Environment& environment_;
 
   // View of the bytes from an ORT format model.
@@ -1022,6 +1091,11 @@ class InferenceSession {
   // "session.use_ort_model_bytes_directly" to "1", this will be empty
   std::vector<uint8_t> ort_format_model_bytes_data_holder_;
 
+  // Memory mapping of an ORT format model loaded from a file, used instead of ort_format_model_bytes_data_holder_
+  // unless "session.map_ort_model_file" is "0". Initializers use the mapped bytes in place, so it is kept for the
+  // lifetime of the session.
+  Env::MappedMemoryPtr ort_format_model_mapping_;
+
   bool using_ort_model_bytes_for_initializers_{false};
 
   // Container to store pre-packed weights to share between sessions.
@@ -5,12 +5,84 @@
 
 #include "core/session/inference_session_utils.h"
 
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <set>
+#include <sstream>
+
+#include "core/common/cpuid_info.h"
+#include "core/framework/customregistry.h"
+#include "core/framework/kernel_registry.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+
 namespace onnxruntime {
 
 //---------------------
 //--- local helpers ---
 //---------------------
 
+namespace {
+// 128-bit hash over a sequence of inputs, chaining MurmurHash3 from one input to the next.
+class CacheKeyHasher {
+ public:
+  void Update(const void* data, size_t len) {
+    uint32_t out[4];
+    MurmurHash3::x86_128(data, len, state_[0] ^ state_[3], out);
+    for (size_t i = 0; i < 4; ++i) {
+      state_[i] = out[i] ^ (state_[i] * 31u);
+    }
+  }
+
+  // strings are length-prefixed so that adjacent values can't alias each other
+  void Update(std::string_view value) {
+    const uint64_t len = value.size();
+    Update(&len, sizeof(len));
+    Update(value.data(), value.size());
+  }
+
+  std::string HexDigest() const {
+    std::ostringstream ss;
+    ss << std::hex << std::setfill('0');
+    for (uint32_t v : state_) {
+      ss << std::setw(8) << v;
+    }
+    return ss.str();
+  }
+
+ private:
+  uint32_t state_[4]{};
+};
+
+// Collect the files holding the external data of the initializers of graph and its subgraphs.
+Status CollectExternalDataFiles(const Graph& graph, const std::filesystem::path& model_dir,
+                                std::set<PathString>& external_files) {
+  for (const auto& [name, tensor_proto] : graph.GetAllInitializedTensors()) {
+    if (utils::HasExternalDataInFile(*tensor_proto)) {
+      PathString external_file_path;
+      FileOffsetType file_offset = 0;
+      SafeInt<size_t> tensor_byte_size;
+      ORT_RETURN_IF_ERROR(utils::GetExternalDataInfo(*tensor_proto, model_dir, external_file_path, file_offset,
+                                                     tensor_byte_size));
+      external_files.insert(external_file_path);
+    }
+  }
+
+  for (const auto& node : graph.Nodes()) {
+    for (const auto& subgraph : node.GetSubgraphs()) {
+      ORT_RETURN_IF_ERROR(CollectExternalDataFiles(*subgraph, model_dir, external_files));
+    }
+  }
+
+  return Status::OK();
+}
+}  // namespace
+
 //--------------------------------------------
 //--- session options related helpers ---
 //--------------------------------------------
@@ -270,6 +342,140 @@ Status ParseTuningResultsFromModelMetadata(const onnxruntime::ModelMetadata& met
   return Status::OK();
 }
 
+std::string HashModelBytes(gsl::span<const uint8_t> model_bytes) {
+  CacheKeyHasher hasher;
+  hasher.Update(model_bytes.data(), model_bytes.size());
+  return hasher.HexDigest();
+}
+
+Status HashModelFile(const PathString& model_path, std::string& hash) {
+  std::ifstream model_stream(model_path, std::ifstream::in | std::ifstream::binary);
+  ORT_RETURN_IF_NOT(model_stream.good(), "Failed to open model file ", ToUTF8String(model_path), " for hashing.");
+
+  // hash in chunks so large models don't need to be held in memory
+  constexpr size_t kChunkSize = 4 * 1024 * 1024;
+  std::vector<char> chunk(kChunkSize);
+  CacheKeyHasher hasher;
+  while (model_stream) {
+    model_stream.read(chunk.data(), kChunkSize);
+    const auto num_read = static_cast<size_t>(model_stream.gcount());
+    if (num_read > 0) {
+      hasher.Update(chunk.data(), num_read);
+    }
+  }
+
+  ORT_RETURN_IF_NOT(model_stream.eof(), "Failed to read model file ", ToUTF8String(model_path), " for hashing.");
+  hash = hasher.HexDigest();
+  return Status::OK();
+}
+
+Status HashExternalDataFiles(const Graph& graph, const std::filesystem::path& model_dir, std::string& hash) {
+  hash.clear();
+
+  // std::set keeps the files sorted so the hash doesn't depend on the order of the initializers
+  std::set<PathString> external_files;
+  ORT_RETURN_IF_ERROR(CollectExternalDataFiles(graph, model_dir, external_files));
+  if (external_files.empty()) {
+    return Status::OK();
+  }
+
+  CacheKeyHasher hasher;
+  for (const auto& external_file : external_files) {
+    std::error_code ec;
+    const auto file_size = std::filesystem::file_size(external_file, ec);
+    ORT_RETURN_IF(ec, "Failed to get the size of external data file ", ToUTF8String(external_file), ": ", ec.message());
+    const auto last_write_time = std::filesystem::last_write_time(external_file, ec);
+    ORT_RETURN_IF(ec, "Failed to get the modification time of external data file ", ToUTF8String(external_file), ": ",
+                  ec.message());
+
+    hasher.Update(ToUTF8String(external_file));
+    hasher.Update(std::to_string(file_size));
+    hasher.Update(std::to_string(last_write_time.time_since_epoch().count()));
+  }
+
+  hash = hasher.HexDigest();
+  return Status::OK();
+}
+
+std::string GetOptimizedModelCacheKey(const std::string& model_hash, const SessionOptions& session_options,
+                                      const ExecutionProviders& execution_providers,
+                                      gsl::span<const std::shared_ptr<CustomRegistry>> custom_registries,
+                                      gsl::span<const std::string> custom_graph_transformers,
+                                      const InlinedHashSet<std::string>& optimizers_to_disable) {
+  CacheKeyHasher hasher;
+  hasher.Update(model_hash);
+  hasher.Update(ORT_VERSION);
+  hasher.Update(std::to_string(static_cast<int>(session_options.graph_optimization_level)));
+
+  // the NCHWc layout transformer and the pre-packed weights saved with the optimized model depend on the instruction
+  // sets of the CPU, so a cache directory shared between machines must not mix their entries
+  const auto& cpu_info = CPUIDInfo::GetInstance();
+  hasher.Update(cpu_info.GetCPUVendor());
+  const bool cpu_features[] = {
+      cpu_info.HasAVX(), cpu_info.HasAVX2(), cpu_info.HasAVX512f(), cpu_info.HasAVX512_BF16(),
+      cpu_info.HasAVX512Skylake(), cpu_info.HasAMX_BF16(), cpu_info.HasF16C(), cpu_info.HasSSE3(),
+      cpu_info.HasSSE4_1(), cpu_info.HasArmNeonDot(), cpu_info.HasArmNeon_I8MM(), cpu_info.HasArmSve(),
+      cpu_info.HasArmSVE_I8MM(), cpu_info.HasArmNeon_BF16(), cpu_info.HasArm_SME(), cpu_info.HasArm_SME2(),
+      cpu_info.HasFp16VectorAcceleration()};
+  std::string cpu_feature_bits;
+  for (bool has_feature : cpu_features) {
+    cpu_feature_bits += has_feature ? '1' : '0';
+  }
+  hasher.Update(cpu_feature_bits);
+  hasher.Update(std::to_string(MlasNchwcGetBlockSize()));
+  hasher.Update(std::to_string(MlasGetPreferredBufferAlignment()));
+
+  // sort the config entries so the key doesn't depend on the order they were added in
+  std::vector<std::pair<std::string, std::string>> config_entries;
+  for (const auto& entry : session_options.config_options.GetConfigOptionsMap()) {
+    if (entry.first != kOrtSessionOptionsOptimizedModelCacheDir) {
+      config_entries.emplace_back(entry.first, entry.second);
+    }
+  }
+  std::sort(config_entries.begin(), config_entries.end());
+  for (const auto& entry : config_entries) {
+    hasher.Update(entry.first);
+    hasher.Update(entry.second);
+  }
+
+  for (const auto& dim_override : session_options.free_dimension_overrides) {
+    hasher.Update(dim_override.dim_identifier);
+    hasher.Update(std::to_string(static_cast<int>(dim_override.dim_identifier_type)));
+    hasher.Update(std::to_string(dim_override.dim_value));
+  }
+
+  // the provider options can change the capabilities of an EP, and with them the partitioning of the graph
+  for (const auto& ep : execution_providers) {
+    hasher.Update(ep->Type());
+    const ProviderOptions provider_options = ep->GetProviderOptions();
+    std::vector<std::pair<std::string, std::string>> sorted_options(provider_options.begin(), provider_options.end());
+    std::sort(sorted_options.begin(), sorted_options.end());
+    for (const auto& option : sorted_options) {
+      hasher.Update(option.first);
+      hasher.Update(option.second);
+    }
+  }
+
+  // the keys of the kernel create map identify the op, domain, versions and EP of each custom kernel
+  for (const auto& custom_registry : custom_registries) {
+    for (const auto& kernel : custom_registry->GetKernelRegistry()->GetKernelCreateMap()) {
+      hasher.Update(kernel.first);
+    }
+  }
+
+  for (const auto& transformer : custom_graph_transformers) {
+    hasher.Update(transformer);
+  }
+
+  std::vector<std::string> disabled(optimizers_to_disable.begin(), optimizers_to_disable.end());
+  std::sort(disabled.begin(), disabled.end());
+  for (const auto& optimizer : disabled) {
+    hasher.Update(optimizer);
+  }
+
+  return hasher.HexDigest();
+}
+
 }  // namespace inference_session_utils
 }  // namespace onnxruntime
 
@@ -65,6 +65,30 @@ Status ParseTuningResultsFromModelMetadata(const onnxruntime::ModelMetadata& met
                                            /*out*/ bool& key_found,
                                            const logging::Logger& logger);
 
+//
+// Helpers for the optimized model cache (kOrtSessionOptionsOptimizedModelCacheDir)
+//
+
+// Hash the bytes of an ONNX model. Returns a hex string.
+std::string HashModelBytes(gsl::span<const uint8_t> model_bytes);
+
+// Hash the bytes of the ONNX model file at model_path. External data files are not included.
+Status HashModelFile(const PathString& model_path, /*out*/ std::string& hash);
+
+// Hash the path, size and modification time of the external data files of the initializers in graph and its
+// subgraphs. Relative paths are resolved against model_dir. hash is empty if the graph has no external data.
+// The content isn't hashed as reading multi-GB weight files would cost more than the cache saves.
+Status HashExternalDataFiles(const Graph& graph, const std::filesystem::path& model_dir, /*out*/ std::string& hash);
+
+// Create the key of a cached optimized model from the model hash, the session options and config entries that can
+// affect the optimized graph, the registered execution providers and their options, the kernels of the custom
+// registries, the custom graph transformers, the features of the CPU and the ORT version.
+std::string GetOptimizedModelCacheKey(const std::string& model_hash, const SessionOptions& session_options,
+                                      const ExecutionProviders& execution_providers,
+                                      gsl::span<const std::shared_ptr<CustomRegistry>> custom_registries,
+                                      gsl::span<const std::string> custom_graph_transformers,
+                                      const InlinedHashSet<std::string>& optimizers_to_disable);
+
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 }  // namespace inference_session_utils
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/platform/env_var_utils.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "gtest/gtest.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
@@ -2248,6 +2249,69 @@ TEST(ContribOpAttentionTest, DISABLED_Attention_Mask1D_Fp16_B2_FusedNoPadding) {
   }
 }
 
+// Chunked prefill with past state, a causal mask and left padding is expected to give the same output and present
+// state as the unchunked path. Past and present hold keys followed by values, so this also checks the value offsets.
+TEST(ContribOpAttentionTest, AttentionPastStateChunkedPrefill) {
+  constexpr int batch_size = 2;
+  constexpr int sequence_length = 5;
+  constexpr int past_sequence_length = 3;
+  constexpr int total_sequence_length = past_sequence_length + sequence_length;
+  constexpr int hidden_size = 8;
+  constexpr int number_of_heads = 2;
+  constexpr int head_size = hidden_size / number_of_heads;
+
+  RandomValueGenerator random{1234};
+  std::vector<int64_t> input_dims{batch_size, sequence_length, hidden_size};
+  std::vector<int64_t> weight_dims{hidden_size, 3 * hidden_size};
+  std::vector<int64_t> bias_dims{3 * hidden_size};
+  std::vector<int64_t> mask_index_dims{batch_size, total_sequence_length};
+  std::vector<int64_t> past_dims{2, batch_size, number_of_heads, past_sequence_length, head_size};
+  std::vector<int64_t> present_dims{2, batch_size, number_of_heads, total_sequence_length, head_size};
+  std::vector<float> input_data = random.Uniform<float>(input_dims, -1.0f, 1.0f);
+  std::vector<float> weight_data = random.Uniform<float>(weight_dims, -1.0f, 1.0f);
+  std::vector<float> bias_data = random.Uniform<float>(bias_dims, -1.0f, 1.0f);
+  std::vector<float> past_data = random.Uniform<float>(past_dims, -1.0f, 1.0f);
+
+  // The first past token of the second batch is padding.
+  std::vector<int32_t> mask_index_data(batch_size * total_sequence_length, 1);
+  mask_index_data[total_sequence_length] = 0;
+
+  auto add_inputs = [&](OpTester& test) {
+    test.AddAttribute<int64_t>("num_heads", number_of_heads);
+    test.AddAttribute<int64_t>("unidirectional", 1);
+    test.AddInput<float>("input", input_dims, input_data);
+    test.AddInput<float>("weight", weight_dims, weight_data);
+    test.AddInput<float>("bias", bias_dims, bias_data);
+    test.AddInput<int32_t>("mask_index", mask_index_dims, mask_index_data);
+    test.AddInput<float>("past", past_dims, past_data);
+  };
+
+  // Outputs of the unchunked path.
+  OpTester reference("Attention", 1, onnxruntime::kMSDomain, /*verify_output*/ false);
+  add_inputs(reference);
+  reference.AddOutput<float>("output", input_dims, std::vector<float>(input_data.size()));
+  reference.AddOutput<float>("present", present_dims,
+                             std::vector<float>(2 * batch_size * number_of_heads * total_sequence_length * head_size));
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  reference.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  std::vector<OrtValue> fetches = reference.GetFetches();
+  auto output_data = fetches[0].Get<Tensor>().DataAsSpan<float>();
+  auto present_data = fetches[1].Get<Tensor>().DataAsSpan<float>();
+
+  OpTester test("Attention", 1, onnxruntime::kMSDomain);
+  add_inputs(test);
+  test.AddOutput<float>("output", input_dims, std::vector<float>(output_data.begin(), output_data.end()));
+  test.AddOutput<float>("present", present_dims, std::vector<float>(present_data.begin(), present_data.end()));
+  test.SetOutputTolerance(0.0001f, 0.0001f);
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsAttentionPrefillChunkSize, "2"));
+  execution_providers.clear();
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(so, OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 #ifndef ENABLE_TRAINING
 // Prepacking is disabled in full training build so no need to test the feature in a training build.
 TEST(ContribOpAttentionTest, SharedPrepackedWeights) {
@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+// (A - B) * C then Relu, where B repeats along the last dim and C is a scalar.
+TEST(FusedElementwiseTest, RepeatedInputs) {
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("operations", std::vector<std::string>{"Sub", "Mul", "Relu"});
+  test.AddAttribute("operands", std::vector<int64_t>{0, 1, 3, 2, 4, -1});
+  test.AddInput<float>("A", {2, 3}, {1.0f, 2.0f, 3.0f, -1.0f, -2.0f, -3.0f});
+  test.AddInput<float>("B", {3}, {0.5f, 1.0f, 1.5f});
+  test.AddInput<float>("C", {}, {2.0f});
+  test.AddOutput<float>("Y", {2, 3}, {1.0f, 2.0f, 3.0f, 0.0f, 0.0f, 0.0f});
+  test.Run();
+}
+
+// Inputs that don't repeat along the output are expanded: [2, 1] + [1, 3] -> [2, 3].
+TEST(FusedElementwiseTest, GeneralBroadcast) {
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("operations", std::vector<std::string>{"Add", "Neg"});
+  test.AddAttribute("operands", std::vector<int64_t>{0, 1, 2, -1});
+  test.AddInput<float>("A", {2, 1}, {1.0f, 2.0f});
+  test.AddInput<float>("B", {1, 3}, {10.0f, 20.0f, 30.0f});
+  test.AddOutput<float>("Y", {2, 3}, {-11.0f, -21.0f, -31.0f, -12.0f, -22.0f, -32.0f});
+  test.Run();
+}
+
+// An output spanning several tiles, with an input whose period doesn't divide the tile size and a result that is
+// used by two operations: Sigmoid(A * B) + Exp(A * B).
+TEST(FusedElementwiseTest, MultipleTiles) {
+  constexpr int64_t rows = 7;
+  constexpr int64_t cols = 333;
+  std::vector<float> a(rows * cols);
+  std::vector<float> b(cols);
+  std::vector<float> y(rows * cols);
+  for (int64_t j = 0; j < cols; ++j) {
+    b[j] = static_cast<float>(j % 7) * 0.25f - 0.75f;
+  }
+  for (int64_t i = 0; i < rows * cols; ++i) {
+    a[i] = static_cast<float>(i % 11) * 0.1f - 0.5f;
+    const float x = a[i] * b[i % cols];
+    y[i] = 1.0f / (1.0f + std::exp(-x)) + std::exp(x);
+  }
+
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("operations", std::vector<std::string>{"Mul", "Sigmoid", "Exp", "Add"});
+  test.AddAttribute("operands", std::vector<int64_t>{0, 1, 2, -1, 2, -1, 3, 4});
+  test.AddInput<float>("A", {rows, cols}, a);
+  test.AddInput<float>("B", {cols}, b);
+  test.AddOutput<float>("Y", {rows, cols}, y, false, 1e-5f, 1e-5f);
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,133 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <limits>
+#include <random>
+#include <set>
+#include <vector>
+#include "gtest/gtest.h"
+#include "core/platform/env.h"
+#include "core/platform/threadpool.h"
+#include "core/util/thread_utils.h"
+#include "contrib_ops/cpu/transformers/logits_processor.h"
+#include "contrib_ops/cpu/transformers/sequences.h"
+
+namespace onnxruntime {
+namespace test {
+
+using namespace contrib::transformers;
+
+namespace {
+
+constexpr int kBatchSize = 3;
+constexpr int kVocabSize = 67;
+constexpr int kSequenceLength = 9;
+
+SamplingParameters MakeParameters() {
+  SamplingParameters parameters{};
+  parameters.model_type = IGenerationParameters::kModelTypeGpt;
+  parameters.logits_processor = 0;
+  parameters.batch_size = kBatchSize;
+  parameters.num_beams = 1;
+  parameters.vocab_size = kVocabSize;
+  parameters.eos_token_id = 5;
+  parameters.min_length = kSequenceLength + 1;
+  parameters.repetition_penalty = 1.5f;
+  parameters.no_repeat_ngram_size = 2;
+  parameters.temperature = 0.7f;
+  parameters.presence_penalty = 0.25f;
+  return parameters;
+}
+
+// Applies the processors one after another, in the order the fused processor documents.
+void ReferenceProcess(const SamplingParameters& parameters, const Sequences& sequences,
+                      bool apply_prefix_vocab_mask, std::vector<float>& scores) {
+  constexpr float lowest = std::numeric_limits<float>::lowest();
+  for (int i = 0; i < kBatchSize; i++) {
+    float* row = scores.data() + i * kVocabSize;
+    gsl::span<const int32_t> sequence = sequences.GetSequence(i);
+
+    std::set<int32_t> unique_word_ids(sequence.begin(), sequence.end());
+    for (int32_t word_id : unique_word_ids) {
+      float score = row[word_id];
+      row[word_id] = score < 0 ? score * parameters.repetition_penalty : score / parameters.repetition_penalty;
+    }
+
+    const int n = parameters.no_repeat_ngram_size;
+    for (int j = 0; j + n <= kSequenceLength; j++) {
+      if (sequence[j] == sequence[kSequenceLength - 1]) {
+        row[sequence[j + 1]] = lowest;
+      }
+    }
+
+    for (int j = 0; j < kVocabSize; j++) {
+      if (parameters.vocab_mask[j] == 0 ||
+          (apply_prefix_vocab_mask && parameters.prefix_vocab_mask[i * kVocabSize + j] == 0)) {
+        row[j] = lowest;
+      }
+    }
+
+    row[parameters.eos_token_id] = lowest;
+
+    for (int j = 0; j < kVocabSize; j++) {
+      row[j] /= parameters.temperature;
+      row[j] -= parameters.presence_mask[i * kVocabSize + j] * parameters.presence_penalty;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(LogitsProcessorTest, FusedMatchesSequentialProcessors) {
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> score_dist(-8.0f, 8.0f);
+  // A small token range makes repeated tokens and ngram matches likely.
+  std::uniform_int_distribution<int32_t> token_dist(0, 11);
+  std::bernoulli_distribution keep_dist(0.85);
+
+  std::vector<int32_t> vocab_mask(kVocabSize);
+  std::vector<int32_t> prefix_vocab_mask(kBatchSize * kVocabSize);
+  std::vector<int32_t> presence_mask(kBatchSize * kVocabSize);
+  for (auto& v : vocab_mask) v = keep_dist(rng) ? 1 : 0;
+  for (auto& v : prefix_vocab_mask) v = keep_dist(rng) ? 1 : 0;
+  for (auto& v : presence_mask) v = keep_dist(rng) ? 0 : 1;
+
+  SamplingParameters parameters = MakeParameters();
+  parameters.vocab_mask = vocab_mask;
+  parameters.prefix_vocab_mask = prefix_vocab_mask;
+  parameters.presence_mask = presence_mask;
+
+  std::vector<int32_t> sequences_buffer(2 * kBatchSize * kSequenceLength);
+  for (auto& token : sequences_buffer) token = token_dist(rng);
+  Sequences sequences;
+  sequences.Init(sequences_buffer, kBatchSize, kSequenceLength, kSequenceLength);
+
+  std::vector<float> initial_scores(kBatchSize * kVocabSize);
+  for (auto& v : initial_scores) v = score_dist(rng);
+
+  OrtThreadPoolParams tp_params;
+  tp_params.thread_pool_size = 2;
+  auto thread_pool = concurrency::CreateThreadPool(&Env::Default(), tp_params,
+                                                   concurrency::ThreadPoolType::INTRA_OP);
+
+  for (concurrency::ThreadPool* tp : {static_cast<concurrency::ThreadPool*>(nullptr), thread_pool.get()}) {
+    for (int step : {1, 2}) {
+      LogitsProcessorList processors;
+      processors.Init(parameters, tp);
+
+      std::vector<float> scores = initial_scores;
+      gsl::span<float> scores_span(scores);
+      processors.Process(&sequences, scores_span, step);
+
+      std::vector<float> expected = initial_scores;
+      ReferenceProcess(parameters, sequences, step <= 1, expected);
+
+      for (size_t i = 0; i < expected.size(); i++) {
+        ASSERT_FLOAT_EQ(scores[i], expected[i]) << "index " << i << " step " << step;
+      }
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -3,6 +3,7 @@
 
 #ifndef ORT_MINIMAL_BUILD
 
+#include <fstream>
 #include <optional>
 
 #include "gtest/gtest.h"
@@ -15,12 +16,15 @@
 #include "core/mlas/inc/mlas_q4.h"
 #include "core/mlas/inc/mlas.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/common/cuda_op_test_utils.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "test/unittest_util/framework_test_utils.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/unittest_util/graph_transform_test_builder.h"
+#include "test/util/include/asserts.h"
 #include "test/util/include/default_providers.h"
+#include "test/util/include/file_util.h"
 #include "test/util/include/scoped_env_vars.h"
 #include "core/session/onnxruntime_cxx_api.h"
 #include "core/session/ort_env.h"
@@ -591,6 +595,142 @@ TEST(MatMulNBits, Float32_4b_Accuracy4_Batch) {
   RunTest<float>(opts);
 }
 
+// With session.lazy_external_initializers, pre-packing B memory-mapped from external data is deferred to the first
+// run. The scales and zero points are packed into the buffer created for B, so they must be deferred with it.
+TEST(MatMulNBits, LazyExternalB) {
+  constexpr int64_t M = 4;
+  constexpr int64_t N = 32;
+  constexpr int64_t K = 128;
+  constexpr int64_t block_size = 32;
+  constexpr int64_t k_blocks = K / block_size;
+  constexpr int64_t blob_size = block_size * QBits / 8;
+  constexpr int64_t zero_point_blob_size = (k_blocks * QBits + 7) / 8;
+
+  RandomValueGenerator random{1234};
+  std::vector<float> input0_vals(random.Gaussian<float>(AsSpan({M, K}), 0.0f, 0.25f));
+  std::vector<float> input1_f_vals(random.Gaussian<float>(AsSpan({K, N}), 0.0f, 0.25f));
+  std::vector<uint8_t> input1_vals(static_cast<size_t>(N * k_blocks * blob_size));
+  std::vector<float> scales(static_cast<size_t>(N * k_blocks));
+  std::vector<uint8_t> zp(static_cast<size_t>(N * zero_point_blob_size));
+  QuantizeDequantize(input1_f_vals, input1_vals, scales, &zp, static_cast<int32_t>(N), static_cast<int32_t>(K),
+                     static_cast<int32_t>(block_size));
+
+  std::vector<float> expected_vals(M * N);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        sum += input0_vals[m * K + k] * input1_f_vals[n * K + k];
+      }
+      expected_vals[m * N + n] = sum;
+    }
+  }
+
+  const PathString model_path = ORT_TSTR("matmul_nbits_lazy_external_b.onnx");
+  const PathString external_data_path = ORT_TSTR("matmul_nbits_lazy_external_b.bin");
+  ScopedFileDeleter model_deleter(model_path);
+  ScopedFileDeleter external_data_deleter(external_data_path);
+  {
+    std::ofstream external_data_file(external_data_path, std::ios::binary);
+    external_data_file.write(reinterpret_cast<const char*>(input1_vals.data()),
+                             static_cast<std::streamsize>(input1_vals.size()));
+  }
+
+  ONNX_NAMESPACE::ModelProto model_proto;
+  model_proto.set_ir_version(ONNX_NAMESPACE::Version::IR_VERSION);
+  auto* onnx_opset = model_proto.add_opset_import();
+  onnx_opset->set_domain(kOnnxDomain);
+  onnx_opset->set_version(21);
+  auto* ms_opset = model_proto.add_opset_import();
+  ms_opset->set_domain(kMSDomain);
+  ms_opset->set_version(1);
+
+  auto* graph = model_proto.mutable_graph();
+  graph->set_name("matmul_nbits_lazy_external_b");
+  auto add_value_info = [](ONNX_NAMESPACE::ValueInfoProto* value_info, const std::string& name, int64_t rows,
+                           int64_t cols) {
+    value_info->set_name(name);
+    auto* tensor_type = value_info->mutable_type()->mutable_tensor_type();
+    tensor_type->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    tensor_type->mutable_shape()->add_dim()->set_dim_value(rows);
+    tensor_type->mutable_shape()->add_dim()->set_dim_value(cols);
+  };
+  add_value_info(graph->add_input(), "A", M, K);
+  add_value_info(graph->add_output(), "Y", M, N);
+
+  auto* b = graph->add_initializer();
+  b->set_name("B");
+  b->set_data_type(ONNX_NAMESPACE::TensorProto_DataType_UINT8);
+  for (int64_t dim : {N, k_blocks, blob_size}) {
+    b->add_dims(dim);
+  }
+  b->set_data_location(ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL);
+  auto* location = b->add_external_data();
+  location->set_key("location");
+  location->set_value(ToUTF8String(external_data_path));
+
+  auto* scales_initializer = graph->add_initializer();
+  scales_initializer->set_name("scales");
+  scales_initializer->set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  scales_initializer->add_dims(N);
+  scales_initializer->add_dims(k_blocks);
+  scales_initializer->set_raw_data(scales.data(), scales.size() * sizeof(float));
+
+  auto* zp_initializer = graph->add_initializer();
+  zp_initializer->set_name("zero_points");
+  zp_initializer->set_data_type(ONNX_NAMESPACE::TensorProto_DataType_UINT8);
+  zp_initializer->add_dims(N);
+  zp_initializer->add_dims(zero_point_blob_size);
+  zp_initializer->set_raw_data(zp.data(), zp.size());
+
+  auto* node = graph->add_node();
+  node->set_op_type("MatMulNBits");
+  node->set_domain(kMSDomain);
+  for (const char* input : {"A", "B", "scales", "zero_points"}) {
+    node->add_input(input);
+  }
+  node->add_output("Y");
+  for (const auto& [name, value] : std::initializer_list<std::pair<const char*, int64_t>>{
+           {"K", K}, {"N", N}, {"block_size", block_size}, {"bits", QBits}, {"accuracy_level", 4}}) {
+    auto* attribute = node->add_attribute();
+    attribute->set_name(name);
+    attribute->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_INT);
+    attribute->set_i(value);
+  }
+
+  {
+    std::ofstream model_file(model_path, std::ios::binary);
+    ASSERT_TRUE(model_proto.SerializeToOstream(&model_file));
+  }
+
+  auto run = [&](bool lazy_external_initializers) {
+    SessionOptions so;
+    so.session_logid = "MatMulNBits.LazyExternalB";
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsLazyExternalInitializers,
+                                                      lazy_external_initializers ? "1" : "0"));
+    InferenceSession session{so, (**ort_env).GetEnvironment()};
+    ASSERT_STATUS_OK(session.Load(model_path));
+    ASSERT_STATUS_OK(session.Initialize());
+
+    const std::vector<int64_t> input_dims{M, K};
+    OrtValue input;
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], input_dims, input0_vals, &input);
+    NameMLValMap feeds{{"A", input}};
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session.Run(feeds, {"Y"}, &fetches));
+    ASSERT_EQ(fetches.size(), 1U);
+
+    const auto output = fetches[0].Get<Tensor>().DataAsSpan<float>();
+    ASSERT_EQ(output.size(), expected_vals.size());
+    for (size_t i = 0; i < expected_vals.size(); ++i) {
+      EXPECT_NEAR(output[i], expected_vals[i], 0.1f + 0.02f * std::abs(expected_vals[i])) << "index " << i;
+    }
+  };
+
+  run(false);
+  run(true);
+}
+
 #endif
 #endif
 #endif
@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cmath>
+
 #include "gtest/gtest.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
@@ -1781,6 +1784,83 @@ TEST(MoETest, MoECpuTest_BasicSwiGLU) {
                 fc3_experts_weights, fc1_experts_bias, fc2_experts_bias, output_data,
                 num_rows, num_experts, hidden_size, inter_size, "swiglu");
 }
+
+TEST(MoETest, MoECpuTest_SkewedRouting) {
+  // Most rows are routed to expert 0 so its rows span several work tiles, and the weights are
+  // initializers so that the prepacked GEMM path is used.
+  constexpr int num_rows = 96;
+  constexpr int num_experts = 4;
+  constexpr int hidden_size = 8;
+  constexpr int inter_size = 16;
+
+  std::vector<float> input(num_rows * hidden_size);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = std::sin(0.37f * static_cast<float>(i));
+  }
+
+  std::vector<float> router_probs(num_rows * num_experts, 0.0f);
+  std::vector<int> selected_expert(num_rows);
+  for (int r = 0; r < num_rows; ++r) {
+    selected_expert[r] = (r % 8 == 0) ? (r / 8) % num_experts : 0;
+    router_probs[r * num_experts + selected_expert[r]] = 4.0f;
+  }
+
+  std::vector<float> fc1_experts_weights(num_experts * inter_size * hidden_size);
+  for (size_t i = 0; i < fc1_experts_weights.size(); ++i) {
+    fc1_experts_weights[i] = 0.1f * std::cos(0.11f * static_cast<float>(i));
+  }
+  std::vector<float> fc2_experts_weights(num_experts * hidden_size * inter_size);
+  for (size_t i = 0; i < fc2_experts_weights.size(); ++i) {
+    fc2_experts_weights[i] = 0.1f * std::sin(0.13f * static_cast<float>(i));
+  }
+  std::vector<float> fc1_experts_bias(num_experts * inter_size);
+  for (size_t i = 0; i < fc1_experts_bias.size(); ++i) {
+    fc1_experts_bias[i] = 0.01f * static_cast<float>(i % 7);
+  }
+  std::vector<float> fc2_experts_bias(num_experts * hidden_size);
+  for (size_t i = 0; i < fc2_experts_bias.size(); ++i) {
+    fc2_experts_bias[i] = -0.02f * static_cast<float>(i % 5);
+  }
+
+  // Reference: top-1 routing with normalized weights, so each row is the output of its expert.
+  std::vector<float> output_data(num_rows * hidden_size);
+  std::vector<float> hidden(inter_size);
+  for (int r = 0; r < num_rows; ++r) {
+    const int e = selected_expert[r];
+    for (int j = 0; j < inter_size; ++j) {
+      float sum = fc1_experts_bias[e * inter_size + j];
+      for (int i = 0; i < hidden_size; ++i) {
+        sum += input[r * hidden_size + i] * fc1_experts_weights[(e * inter_size + j) * hidden_size + i];
+      }
+      hidden[j] = std::max(0.0f, sum);
+    }
+    for (int h = 0; h < hidden_size; ++h) {
+      float sum = fc2_experts_bias[e * hidden_size + h];
+      for (int j = 0; j < inter_size; ++j) {
+        sum += hidden[j] * fc2_experts_weights[(e * hidden_size + h) * inter_size + j];
+      }
+      output_data[r * hidden_size + h] = sum;
+    }
+  }
+
+  OpTester tester("MoE", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("k", 1);
+  tester.AddAttribute<std::string>("activation_type", "relu");
+  tester.AddAttribute<int64_t>("normalize_routing_weights", 1);
+
+  tester.AddInput<float>("input", {num_rows, hidden_size}, input);
+  tester.AddInput<float>("router_probs", {num_rows, num_experts}, router_probs);
+  tester.AddInput<float>("fc1_experts_weights", {num_experts, inter_size, hidden_size}, fc1_experts_weights, true);
+  tester.AddInput<float>("fc1_experts_bias", {num_experts, inter_size}, fc1_experts_bias, true);
+  tester.AddInput<float>("fc2_experts_weights", {num_experts, hidden_size, inter_size}, fc2_experts_weights, true);
+  tester.AddInput<float>("fc2_experts_bias", {num_experts, hidden_size}, fc2_experts_bias, true);
+  tester.AddOutput<float>("output", {num_rows, hidden_size}, output_data);
+  tester.SetOutputTolerance(0.001f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
 #endif
 
 }  // namespace test
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/platform/env_var_utils.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "gtest/gtest.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
@@ -280,6 +281,17 @@ static void RunMultiHeadAttentionTest(
       std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
       execution_providers.push_back(DefaultCpuExecutionProvider());
       tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+
+      // Chunked prefill with one query per chunk is expected to give the same result.
+      if (sequence_length > 1 && output_qk_data.empty() && !buffer_share) {
+        SessionOptions so;
+        so.use_per_session_threads = false;
+        so.graph_optimization_level = TransformerLevel::Default;
+        ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsAttentionPrefillChunkSize, "1"));
+        execution_providers.clear();
+        execution_providers.push_back(DefaultCpuExecutionProvider());
+        tester.Run(so, OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+      }
     }
 
     if (enable_dml) {
@@ -711,5 +723,70 @@ TEST(MultiHeadAttentionTest, CrossAttention_DiffSequenceLengths_UsingDMMHAInside
   RunMultiHeadAttentionTests(data, DISABLE_CPU | DISABLE_WEBGPU | DISABLE_DML);
 }
 
+// Chunked prefill with past key and value and a causal mask is expected to give the same output and present key
+// and value as the unchunked path.
+TEST(MultiHeadAttentionTest, SelfAttention_WithPastAndPresent_ChunkedPrefill) {
+  constexpr int batch_size = 2;
+  constexpr int sequence_length = 5;
+  constexpr int past_sequence_length = 3;
+  constexpr int total_sequence_length = past_sequence_length + sequence_length;
+  constexpr int hidden_size = 8;
+  constexpr int num_heads = 2;
+  constexpr int head_size = hidden_size / num_heads;
+
+  RandomValueGenerator random{1234};
+  std::vector<int64_t> qkv_dims{batch_size, sequence_length, hidden_size};
+  std::vector<int64_t> past_dims{batch_size, num_heads, past_sequence_length, head_size};
+  std::vector<int64_t> present_dims{batch_size, num_heads, total_sequence_length, head_size};
+  std::vector<float> query_data = random.Uniform<float>(qkv_dims, -1.0f, 1.0f);
+  std::vector<float> key_data = random.Uniform<float>(qkv_dims, -1.0f, 1.0f);
+  std::vector<float> value_data = random.Uniform<float>(qkv_dims, -1.0f, 1.0f);
+  std::vector<float> past_key_data = random.Uniform<float>(past_dims, -1.0f, 1.0f);
+  std::vector<float> past_value_data = random.Uniform<float>(past_dims, -1.0f, 1.0f);
+  const size_t present_size = static_cast<size_t>(batch_size) * num_heads * total_sequence_length * head_size;
+
+  auto add_inputs = [&](OpTester& tester) {
+    tester.AddAttribute<int64_t>("num_heads", num_heads);
+    tester.AddAttribute<int64_t>("unidirectional", 1);
+    tester.AddInput<float>("query", qkv_dims, query_data);
+    tester.AddInput<float>("key", qkv_dims, key_data);
+    tester.AddInput<float>("value", qkv_dims, value_data);
+    tester.AddOptionalInputEdge<float>();    // bias
+    tester.AddOptionalInputEdge<int32_t>();  // key_padding_mask
+    tester.AddOptionalInputEdge<float>();    // attention_bias
+    tester.AddInput<float>("past_key", past_dims, past_key_data);
+    tester.AddInput<float>("past_value", past_dims, past_value_data);
+  };
+
+  // Outputs of the unchunked path.
+  OpTester reference("MultiHeadAttention", 1, onnxruntime::kMSDomain, /*verify_output*/ false);
+  add_inputs(reference);
+  reference.AddOutput<float>("output", qkv_dims, std::vector<float>(query_data.size()));
+  reference.AddOutput<float>("present_key", present_dims, std::vector<float>(present_size));
+  reference.AddOutput<float>("present_value", present_dims, std::vector<float>(present_size));
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  reference.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  std::vector<OrtValue> fetches = reference.GetFetches();
+  auto output_data = fetches[0].Get<Tensor>().DataAsSpan<float>();
+  auto present_key_data = fetches[1].Get<Tensor>().DataAsSpan<float>();
+  auto present_value_data = fetches[2].Get<Tensor>().DataAsSpan<float>();
+
+  OpTester tester("MultiHeadAttention", 1, onnxruntime::kMSDomain);
+  add_inputs(tester);
+  tester.AddOutput<float>("output", qkv_dims, std::vector<float>(output_data.begin(), output_data.end()));
+  tester.AddOutput<float>("present_key", present_dims,
+                          std::vector<float>(present_key_data.begin(), present_key_data.end()));
+  tester.AddOutput<float>("present_value", present_dims,
+                          std::vector<float>(present_value_data.begin(), present_value_data.end()));
+  tester.SetOutputTolerance(0.0001f, 0.0001f);
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsAttentionPrefillChunkSize, "2"));
+  execution_providers.clear();
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(so, OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
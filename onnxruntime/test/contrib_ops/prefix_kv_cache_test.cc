@@ -0,0 +1,117 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "core/framework/allocator.h"
+#include "core/framework/tensor.h"
+#include "contrib_ops/cpu/transformers/prefix_kv_cache.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+using contrib::transformers::PrefixKVCache;
+
+namespace {
+
+// One layer of present state of shape (2, 1, 1, sequence_length, 1) filled with value.
+std::vector<OrtValue> MakePresent(int64_t sequence_length, float value) {
+  auto allocator = std::make_shared<CPUAllocator>();
+  OrtValue present;
+  Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), TensorShape{2, 1, 1, sequence_length, 1}, allocator, present);
+  auto data = present.GetMutable<Tensor>()->MutableDataAsSpan<float>();
+  std::fill(data.begin(), data.end(), value);
+  return {present};
+}
+
+size_t EntryBytes(size_t sequence_length) {
+  return sequence_length * sizeof(int32_t) + 2 * sequence_length * sizeof(float);
+}
+
+}  // namespace
+
+TEST(PrefixKVCacheTest, LongestProperPrefix) {
+  PrefixKVCache cache(1 << 20);
+
+  const std::vector<int32_t> short_prompt{1, 2, 3};
+  const std::vector<int32_t> long_prompt{1, 2, 3, 4, 5};
+  ASSERT_STATUS_OK(cache.Insert(short_prompt, MakePresent(3, 1.0f)));
+  ASSERT_STATUS_OK(cache.Insert(long_prompt, MakePresent(5, 2.0f)));
+
+  // The longest cached prefix is used.
+  auto entry = cache.Lookup(std::vector<int32_t>{1, 2, 3, 4, 5, 6, 7});
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(entry->tokens, long_prompt);
+  EXPECT_EQ(entry->present[0].Get<Tensor>().Data<float>()[0], 2.0f);
+
+  // An identical prompt leaves at least one token for the decoder.
+  entry = cache.Lookup(long_prompt);
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(entry->tokens, short_prompt);
+
+  // Diverging prompts miss.
+  EXPECT_EQ(cache.Lookup(std::vector<int32_t>{1, 2, 4, 4}), nullptr);
+
+  const auto stats = cache.GetStats();
+  EXPECT_EQ(stats.lookups, 3u);
+  EXPECT_EQ(stats.hits, 2u);
+  EXPECT_EQ(stats.reused_tokens, 8u);
+  EXPECT_EQ(stats.entries, 2u);
+  EXPECT_DOUBLE_EQ(stats.HitRate(), 2.0 / 3.0);
+}
+
+TEST(PrefixKVCacheTest, EvictsLeastRecentlyUsed) {
+  PrefixKVCache cache(2 * EntryBytes(4));
+
+  const std::vector<int32_t> prompt_a{1, 1, 1, 1};
+  const std::vector<int32_t> prompt_b{2, 2, 2, 2};
+  const std::vector<int32_t> prompt_c{3, 3, 3, 3};
+  ASSERT_STATUS_OK(cache.Insert(prompt_a, MakePresent(4, 1.0f)));
+  ASSERT_STATUS_OK(cache.Insert(prompt_b, MakePresent(4, 2.0f)));
+
+  // Touch A so that B becomes the least recently used entry.
+  ASSERT_NE(cache.Lookup(std::vector<int32_t>{1, 1, 1, 1, 9}), nullptr);
+  ASSERT_STATUS_OK(cache.Insert(prompt_c, MakePresent(4, 3.0f)));
+
+  EXPECT_NE(cache.Lookup(std::vector<int32_t>{1, 1, 1, 1, 9}), nullptr);
+  EXPECT_EQ(cache.Lookup(std::vector<int32_t>{2, 2, 2, 2, 9}), nullptr);
+  EXPECT_NE(cache.Lookup(std::vector<int32_t>{3, 3, 3, 3, 9}), nullptr);
+
+  const auto stats = cache.GetStats();
+  EXPECT_EQ(stats.evictions, 1u);
+  EXPECT_EQ(stats.entries, 2u);
+  EXPECT_LE(stats.bytes, cache.MaxBytes());
+}
+
+TEST(PrefixKVCacheTest, SkipsEntriesOverBudget) {
+  PrefixKVCache cache(EntryBytes(4));
+
+  ASSERT_STATUS_OK(cache.Insert(std::vector<int32_t>{1, 2, 3, 4, 5, 6}, MakePresent(6, 1.0f)));
+  EXPECT_EQ(cache.GetStats().entries, 0u);
+  EXPECT_EQ(cache.Lookup(std::vector<int32_t>{1, 2, 3, 4, 5, 6, 7}), nullptr);
+}
+
+// Runs that finish the same prompt concurrently only cache it once.
+TEST(PrefixKVCacheTest, ConcurrentInsertsOfSamePrompt) {
+  PrefixKVCache cache(1 << 20);
+  const std::vector<int32_t> prompt{1, 2, 3, 4};
+  const auto present = MakePresent(4, 1.0f);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back([&]() { ASSERT_STATUS_OK(cache.Insert(prompt, present)); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const auto stats = cache.GetStats();
+  EXPECT_EQ(stats.entries, 1u);
+  EXPECT_EQ(stats.bytes, EntryBytes(4));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
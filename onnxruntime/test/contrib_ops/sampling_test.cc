@@ -1,11 +1,15 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cstdio>
+#include <fstream>
 #include <memory>
 #include <vector>
 #include "gtest/gtest.h"
 #include <gsl/gsl>
+#include "nlohmann/json.hpp"
 #include "core/session/onnxruntime_cxx_api.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/common/cuda_op_test_utils.h"
 
 #ifdef USE_CUDA
@@ -14,6 +18,8 @@
 
 extern std::unique_ptr<Ort::Env> ort_env;
 
+using json = nlohmann::json;
+
 namespace onnxruntime {
 namespace test {
 
@@ -158,6 +164,86 @@ TEST(SamplingTest, Gpt2Sampling_CPU) {
 
   ASSERT_TRUE(std::equal(expected_output.cbegin(), expected_output.cend(), result_span.begin(), result_span.end()));
 }
+
+// Runs tiny_gpt2_sampling.onnx on a single prompt and returns the generated sequence.
+static std::vector<int32_t> RunGpt2SamplingOnPrompt(Ort::Session& session, std::vector<int32_t> input_ids,
+                                                     int32_t max_length) {
+  std::vector<int64_t> input_ids_shape{1, static_cast<int64_t>(input_ids.size())};
+  std::vector<int64_t> parameter_shape{1};
+  std::vector<int32_t> max_length_data{max_length};
+  std::vector<int32_t> min_length{1};
+  std::vector<float> repetition_penalty{1.0f};
+
+  Ort::MemoryInfo info("Cpu", OrtDeviceAllocator, 0, OrtMemTypeDefault);
+  std::vector<Ort::Value> ort_inputs;
+  ort_inputs.push_back(Ort::Value::CreateTensor(
+      info, input_ids.data(), input_ids.size(), input_ids_shape.data(), input_ids_shape.size()));
+  ort_inputs.push_back(Ort::Value::CreateTensor(
+      info, max_length_data.data(), max_length_data.size(), parameter_shape.data(), parameter_shape.size()));
+  ort_inputs.push_back(Ort::Value::CreateTensor(
+      info, min_length.data(), min_length.size(), parameter_shape.data(), parameter_shape.size()));
+  ort_inputs.push_back(Ort::Value::CreateTensor(
+      info, repetition_penalty.data(), repetition_penalty.size(), parameter_shape.data(), parameter_shape.size()));
+  const char* input_names[] = {"input_ids", "max_length", "min_length", "repetition_penalty"};
+  const char* const output_names[] = {"sequences"};
+
+  auto ort_outputs = session.Run(Ort::RunOptions{}, input_names, ort_inputs.data(), ort_inputs.size(),
+                                 output_names, 1);
+  const auto& sequences = ort_outputs[0];
+  const auto* result_vals = sequences.GetTensorData<int32_t>();
+  return std::vector<int32_t>(result_vals, result_vals + sequences.GetTensorTypeAndShapeInfo().GetElementCount());
+}
+
+// The second prompt extends the first one, so with the prefix cache enabled it reuses the state cached by the first
+// run. The sequences must be the same as those of a session without the cache.
+TEST(SamplingTest, Gpt2Sampling_PrefixCache_CPU) {
+  const std::vector<int32_t> prompt{52, 195, 731, 321, 301, 734, 620};
+  std::vector<int32_t> extended_prompt = prompt;
+  extended_prompt.insert(extended_prompt.end(), {41, 554, 74});
+  constexpr int32_t max_length = 15;
+
+  Ort::SessionOptions session_options;
+  Ort::Session session(*ort_env, ORT_TSTR("testdata/transformers/tiny_gpt2_sampling.onnx"), session_options);
+  const auto expected = RunGpt2SamplingOnPrompt(session, prompt, max_length);
+  const auto expected_extended = RunGpt2SamplingOnPrompt(session, extended_prompt, max_length);
+
+  Ort::SessionOptions cached_session_options;
+  cached_session_options.AddConfigEntry(kOrtSessionOptionsGenerationPrefixCacheMaxBytes, "16777216");
+  cached_session_options.EnableProfiling(ORT_TSTR("prefix_cache_profile"));
+  Ort::Session cached_session(*ort_env, ORT_TSTR("testdata/transformers/tiny_gpt2_sampling.onnx"),
+                              cached_session_options);
+  EXPECT_EQ(RunGpt2SamplingOnPrompt(cached_session, prompt, max_length), expected);
+  EXPECT_EQ(RunGpt2SamplingOnPrompt(cached_session, extended_prompt, max_length), expected_extended);
+  // a cached prompt is only reused by longer prompts, so an identical prompt reuses the first one.
+  EXPECT_EQ(RunGpt2SamplingOnPrompt(cached_session, extended_prompt, max_length), expected_extended);
+
+  // each lookup is recorded in the profile with the counters of the cache
+  Ort::AllocatorWithDefaultOptions allocator;
+  const auto profile_file = cached_session.EndProfilingAllocated(allocator);
+  const std::string profile_path = profile_file.get();
+  std::ifstream profile_stream(profile_path);
+  ASSERT_TRUE(profile_stream.good());
+  const auto profile = json::parse(profile_stream);
+  profile_stream.close();
+  std::remove(profile_path.c_str());
+
+  std::vector<json> lookups;
+  for (const auto& event : profile) {
+    if (event["name"] == "prefix_kv_cache_lookup") {
+      lookups.push_back(event["args"]);
+    }
+  }
+  ASSERT_EQ(lookups.size(), 3U);
+  EXPECT_EQ(lookups[0]["hit"], "0");
+  EXPECT_EQ(lookups[1]["hit"], "1");
+  EXPECT_EQ(lookups[1]["reused_tokens"], std::to_string(prompt.size()));
+  EXPECT_EQ(lookups[2]["hit"], "1");
+  EXPECT_EQ(lookups[2]["reused_tokens"], std::to_string(prompt.size()));
+  EXPECT_EQ(lookups[2]["lookups"], "3");
+  EXPECT_EQ(lookups[2]["hits"], "2");
+  EXPECT_EQ(lookups[2]["total_reused_tokens"], std::to_string(2 * prompt.size()));
+  EXPECT_EQ(lookups[2]["entries"], "2");
+}
 #endif
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,99 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+// Reference of TopK(Softmax(X, axis), k, axis) for an input viewed as [outer, dim, inner].
+static void ComputeSoftmaxTopK(const std::vector<float>& x, int64_t outer, int64_t dim, int64_t inner, int64_t k,
+                               bool largest, std::vector<float>& values, std::vector<int64_t>& indices) {
+  values.resize(outer * k * inner);
+  indices.resize(outer * k * inner);
+  for (int64_t o = 0; o < outer; ++o) {
+    for (int64_t i = 0; i < inner; ++i) {
+      auto at = [&](int64_t j) { return x[(o * dim + j) * inner + i]; };
+      float max_value = at(0);
+      for (int64_t j = 1; j < dim; ++j) {
+        max_value = std::max(max_value, at(j));
+      }
+      float sum = 0.0f;
+      for (int64_t j = 0; j < dim; ++j) {
+        sum += std::exp(at(j) - max_value);
+      }
+
+      std::vector<int64_t> order(dim);
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(),
+                       [&](int64_t a, int64_t b) { return largest ? at(a) > at(b) : at(a) < at(b); });
+      for (int64_t j = 0; j < k; ++j) {
+        values[(o * k + j) * inner + i] = std::exp(at(order[j]) - max_value) / sum;
+        indices[(o * k + j) * inner + i] = order[j];
+      }
+    }
+  }
+}
+
+TEST(SoftmaxTopKTest, LastAxis) {
+  OpTester test("SoftmaxTopK", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("X", {2, 4}, {1.0f, 2.0f, 3.0f, 4.0f, 0.0f, -1.0f, 0.0f, 1.0f});
+  test.AddInput<int64_t>("K", {1}, {2});
+  test.AddOutput<float>("Values", {2, 2}, {0.643914f, 0.236883f, 0.534447f, 0.196612f});
+  test.AddOutput<int64_t>("Indices", {2, 2}, {3, 2, 3, 0});
+  test.Run();
+}
+
+TEST(SoftmaxTopKTest, InnerAxisSmallest) {
+  constexpr int64_t outer = 2;
+  constexpr int64_t dim = 7;
+  constexpr int64_t inner = 3;
+  constexpr int64_t k = 3;
+  std::vector<float> x(outer * dim * inner);
+  for (size_t i = 0; i < x.size(); ++i) {
+    x[i] = static_cast<float>((i * 37) % 19) * 0.25f - 2.0f;
+  }
+
+  std::vector<float> values;
+  std::vector<int64_t> indices;
+  ComputeSoftmaxTopK(x, outer, dim, inner, k, false, values, indices);
+
+  OpTester test("SoftmaxTopK", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("axis", 1);
+  test.AddAttribute<int64_t>("largest", 0);
+  test.AddInput<float>("X", {outer, dim, inner}, x);
+  test.AddInput<int64_t>("K", {1}, {k});
+  test.AddOutput<float>("Values", {outer, k, inner}, values, false, 1e-5f, 1e-5f);
+  test.AddOutput<int64_t>("Indices", {outer, k, inner}, indices);
+  test.Run();
+}
+
+// A row long enough for the sums to be split across threads, with masked logits.
+TEST(SoftmaxTopKTest, LongRow) {
+  constexpr int64_t dim = 100000;
+  constexpr int64_t k = 5;
+  std::vector<float> x(dim);
+  for (int64_t i = 0; i < dim; ++i) {
+    x[i] = i < dim / 2 ? -std::numeric_limits<float>::infinity() : static_cast<float>((i * 7919) % 10007) * 1e-3f;
+  }
+
+  std::vector<float> values;
+  std::vector<int64_t> indices;
+  ComputeSoftmaxTopK(x, 1, dim, 1, k, true, values, indices);
+
+  OpTester test("SoftmaxTopK", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("X", {1, dim}, x);
+  test.AddInput<int64_t>("K", {1}, {k});
+  test.AddOutput<float>("Values", {1, k}, values, false, 1e-5f, 1e-4f);
+  test.AddOutput<int64_t>("Indices", {1, k}, indices);
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -55,6 +55,7 @@
 #include "test/optimizer/dummy_graph_transformer.h"
 #include "test/util/include/default_providers.h"
 #include "test/util/include/inference_session_wrapper.h"
+#include "test/util/include/temp_dir.h"
 
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
@@ -324,6 +325,113 @@ TEST(InferenceSessionTests, TestModelSerialization) {
   ASSERT_TRUE(session_object_emptyValidation.Initialize().IsOK());
 }
 
+TEST(InferenceSessionTests, OptimizedModelCache) {
+  TemporaryDirectory cache_dir(ORT_TSTR("optimized_model_cache_test_dir"));
+  const std::string test_model = "testdata/transform/abs-id-max.onnx";
+
+  auto count_cached_models = [&cache_dir]() {
+    size_t count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(cache_dir.Path())) {
+      if (entry.path().extension() == ".onnx") {
+        // the models saved under a pending name are removed once they have been published
+        EXPECT_TRUE(entry.path().stem().extension().empty()) << "Pending model left in the cache: " << entry.path();
+        ++count;
+      }
+    }
+    return count;
+  };
+
+  // The dummy transformer is only invoked when the graph is optimized, i.e. when the model missed the cache.
+  auto create_session = [&](TransformerLevel level, const std::string& transformer_name,
+                            std::map<std::string, int>& op_to_count, bool& transformer_invoked) {
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.OptimizedModelCache";
+    so.graph_optimization_level = level;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsOptimizedModelCacheDir,
+                                                      ToUTF8String(cache_dir.Path()).c_str()));
+    InferenceSessionWrapper session_object{so, GetEnvironment()};
+    auto dummy_transformer = std::make_unique<DummyGraphTransformer>(transformer_name);
+    const auto* dummy_transformer_ptr = dummy_transformer.get();
+    ASSERT_STATUS_OK(session_object.RegisterGraphTransformer(std::move(dummy_transformer), TransformerLevel::Level1));
+    ASSERT_STATUS_OK(session_object.Load(test_model));
+    ASSERT_STATUS_OK(session_object.Initialize());
+    op_to_count = CountOpsInGraph(session_object.GetGraph());
+    transformer_invoked = dummy_transformer_ptr->IsTransformerInvoked();
+  };
+
+  // cache miss: the model is optimized and saved to the cache
+  std::map<std::string, int> op_to_count;
+  bool transformer_invoked = false;
+  create_session(TransformerLevel::Level1, "DummyTransformer", op_to_count, transformer_invoked);
+  ASSERT_TRUE(transformer_invoked);
+  ASSERT_EQ(op_to_count["Identity"], 0);
+  ASSERT_EQ(count_cached_models(), 1U);
+
+  // cache hit: the optimized model is loaded from the cache and isn't optimized again
+  create_session(TransformerLevel::Level1, "DummyTransformer", op_to_count, transformer_invoked);
+  ASSERT_FALSE(transformer_invoked);
+  ASSERT_EQ(op_to_count["Identity"], 0);
+  ASSERT_EQ(count_cached_models(), 1U);
+
+  // a different optimization level selects a different cache entry
+  create_session(TransformerLevel::Level2, "DummyTransformer", op_to_count, transformer_invoked);
+  ASSERT_TRUE(transformer_invoked);
+  ASSERT_EQ(count_cached_models(), 2U);
+
+  // so does a different custom transformer
+  create_session(TransformerLevel::Level1, "OtherDummyTransformer", op_to_count, transformer_invoked);
+  ASSERT_TRUE(transformer_invoked);
+  ASSERT_EQ(count_cached_models(), 3U);
+
+  // and each entry is hit afterwards
+  create_session(TransformerLevel::Level2, "DummyTransformer", op_to_count, transformer_invoked);
+  ASSERT_FALSE(transformer_invoked);
+  create_session(TransformerLevel::Level1, "OtherDummyTransformer", op_to_count, transformer_invoked);
+  ASSERT_FALSE(transformer_invoked);
+  ASSERT_EQ(count_cached_models(), 3U);
+}
+
+TEST(InferenceSessionTests, OptimizedModelCacheExternalData) {
+  TemporaryDirectory model_dir(ORT_TSTR("optimized_model_cache_external_data_model_dir"));
+  TemporaryDirectory cache_dir(ORT_TSTR("optimized_model_cache_external_data_test_dir"));
+  const std::filesystem::path model_dir_path{model_dir.Path()};
+  const std::filesystem::path model_path = model_dir_path / ORT_TSTR("conv_qdq_external_ini.onnx");
+  const std::filesystem::path data_path = model_dir_path / ORT_TSTR("conv_qdq_external_ini.bin");
+  std::filesystem::copy_file(ORT_TSTR("testdata/conv_qdq_external_ini.onnx"), model_path);
+  std::filesystem::copy_file(ORT_TSTR("testdata/conv_qdq_external_ini.bin"), data_path);
+
+  auto count_cached_models = [&cache_dir]() {
+    size_t count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(cache_dir.Path())) {
+      if (entry.path().extension() == ".onnx") {
+        ++count;
+      }
+    }
+    return count;
+  };
+
+  auto create_session = [&]() {
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.OptimizedModelCacheExternalData";
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsOptimizedModelCacheDir,
+                                                      ToUTF8String(cache_dir.Path()).c_str()));
+    InferenceSession session_object{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.Load(model_path.native()));
+    ASSERT_STATUS_OK(session_object.Initialize());
+  };
+
+  create_session();
+  ASSERT_EQ(count_cached_models(), 1U);
+  create_session();
+  ASSERT_EQ(count_cached_models(), 1U);
+
+  // the .onnx file is unchanged but the weights were replaced, so the cached model must not be used
+  std::filesystem::last_write_time(data_path,
+                                   std::filesystem::last_write_time(data_path) + std::chrono::hours(1));
+  create_session();
+  ASSERT_EQ(count_cached_models(), 2U);
+}
+
 TEST(InferenceSessionTests, RequestLoadCancellation) {
   {
     // Explicit cancel during load, small model is fine
@@ -389,6 +497,115 @@ TEST(InferenceSessionTests, CheckRunLogger) {
 #endif
 }
 
+#if !defined(__wasm__)
+TEST(InferenceSessionTests, WarmUpAsync) {
+  SessionOptions so;
+  so.session_logid = "WarmUpAsync";
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+
+  auto warm_up = [&session_object](std::vector<InferenceSession::WarmUpShapes> shape_buckets) {
+    std::promise<Status> done;
+    auto result = done.get_future();
+    Status status = session_object.WarmUpAsync(std::move(shape_buckets), [&done](const Status& warm_up_status) {
+      done.set_value(warm_up_status);
+    });
+    if (!status.IsOK()) {
+      return status;
+    }
+    return result.get();
+  };
+
+  // not initialized
+  ASSERT_FALSE(warm_up({}).IsOK());
+
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // shapes from the model, and explicit shapes
+  ASSERT_STATUS_OK(warm_up({}));
+  ASSERT_STATUS_OK(warm_up({{{"X", {3, 2}}}, {{"X", {3, 2}}}}));
+
+  // the error of a failing run is reported
+  ASSERT_FALSE(warm_up({{{"X", {4, 5}}}}).IsOK());
+
+  // the session is usable after the warm-up
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+}
+#endif
+
+TEST(InferenceSessionTests, Clone) {
+  SessionOptions so;
+  so.session_logid = "Clone";
+  so.intra_op_param.thread_pool_size = 1;
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+
+  std::unique_ptr<InferenceSession> clone;
+  // not initialized
+  ASSERT_FALSE(session_object.Clone(so, clone).IsOK());
+  ASSERT_EQ(clone, nullptr);
+
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  SessionOptions clone_so;
+  clone_so.session_logid = "Clone_clone";
+  clone_so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  clone_so.intra_op_param.thread_pool_size = 2;
+  clone_so.inter_op_param.thread_pool_size = 2;
+  ASSERT_STATUS_OK(session_object.Clone(clone_so, clone));
+  ASSERT_NE(clone, nullptr);
+
+  // the state created by Initialize is shared
+  EXPECT_EQ(&clone->GetSessionState(), &session_object.GetSessionState());
+  EXPECT_FALSE(clone->Load(MODEL_URI).IsOK());
+  ASSERT_STATUS_OK(clone->Initialize());
+
+  // both sessions can be run concurrently
+  RunOptions run_options;
+  std::thread clone_runs([&clone, &run_options]() {
+    for (int i = 0; i < 10; ++i) {
+      RunModel(*clone, run_options);
+    }
+  });
+  for (int i = 0; i < 10; ++i) {
+    RunModel(session_object, run_options);
+  }
+  clone_runs.join();
+
+  // a clone of a clone shares the same state
+  std::unique_ptr<InferenceSession> second_clone;
+  ASSERT_STATUS_OK(clone->Clone(so, second_clone));
+  EXPECT_EQ(&second_clone->GetSessionState(), &session_object.GetSessionState());
+  RunModel(*second_clone, run_options);
+  second_clone.reset();
+  clone.reset();
+
+  RunModel(session_object, run_options);
+}
+
+#if GTEST_HAS_DEATH_TEST
+TEST(InferenceSessionDeathTest, CloneOutlivesSource) {
+  SessionOptions so;
+  so.session_logid = "CloneOutlivesSource";
+
+  auto session_object = std::make_unique<InferenceSession>(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object->Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object->Initialize());
+
+  std::unique_ptr<InferenceSession> clone;
+  ASSERT_STATUS_OK(session_object->Clone(so, clone));
+  // the message goes to the session logger, which may not write to stderr
+  ASSERT_DEATH(session_object.reset(), "");
+
+  // destroying the clone first is fine
+  clone.reset();
+  session_object.reset();
+}
+#endif
+
 // WebAssembly will emit profiling data into console
 // TODO(hasesh): Investigate why this test fails on Windows CUDA builds
 #if (!defined(__wasm__) && !defined(_WIN32))
@@ -5,6 +5,7 @@
 #include "core/framework/data_types.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/TensorSeq.h"
+#include "core/graph/graph_flatbuffers_utils.h"
 #include "core/graph/model.h"
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/onnxruntime_cxx_api.h"
@@ -322,6 +323,37 @@ TEST(OrtModelOnlyTests, SerializeToOrtFormat) {
   RunOrtModel(test_info);
 }
 
+// initializer data that can be used in place is aligned so kernels can use it directly from a memory mapped file
+TEST(OrtModelOnlyTests, SerializeToOrtFormatAlignsInitializers) {
+  const auto ort_file = ORT_TSTR("testdata/mnist.onnx.aligned_initializers.test_output.ort");
+  SaveAndCompareModels(ORT_TSTR("testdata/mnist.onnx"), ort_file);
+
+  size_t num_bytes = 0;
+  ASSERT_STATUS_OK(Env::Default().GetFileLength(ort_file, num_bytes));
+  std::vector<uint8_t> bytes(num_bytes);
+  std::ifstream bytes_stream(ort_file, std::ifstream::in | std::ifstream::binary);
+  bytes_stream.read(reinterpret_cast<char*>(bytes.data()), num_bytes);
+  ASSERT_TRUE(bytes_stream);
+
+  const auto* fbs_session = fbs::GetInferenceSession(bytes.data());
+  const auto* fbs_initializers = fbs_session->model()->graph()->initializers();
+  ASSERT_NE(fbs_initializers, nullptr);
+
+  size_t num_large_initializers = 0;
+  for (const auto* fbs_initializer : *fbs_initializers) {
+    const auto* raw_data = fbs_initializer->raw_data();
+    if (raw_data == nullptr || raw_data->size() <= utils::kSmallTensorExternalDataThreshold) {
+      continue;
+    }
+
+    EXPECT_EQ(static_cast<size_t>(raw_data->Data() - bytes.data()) % fbs::utils::kInitializerAlignment, 0u)
+        << fbs_initializer->name()->str();
+    ++num_large_initializers;
+  }
+
+  EXPECT_GT(num_large_initializers, 0u);
+}
+
 TEST(OrtModelOnlyTests, SparseInitializerHandling) {
   const auto ort_file = ORT_TSTR("testdata/ort_minimal_test_models/sparse_initializer_handling.onnx.test_output.ort");
   SaveAndCompareModels(ORT_TSTR("testdata/ort_minimal_test_models/sparse_initializer_handling.onnx"), ort_file);
@@ -557,6 +589,13 @@ TEST(OrtModelOnlyTests, LoadOrtFormatModelFromBufferNoCopyInitializersUseBuffer)
   RunOrtModel(test_info);
 }
 
+// Load the model from a file path without memory mapping it
+TEST(OrtModelOnlyTests, LoadOrtFormatModelNoMapping) {
+  OrtModelTestInfo test_info = GetTestInfoForLoadOrtFormatModel();
+  test_info.configs.push_back(std::make_pair(kOrtSessionOptionsConfigMapOrtModelFile, "0"));
+  RunOrtModel(test_info);
+}
+
 // regression test for 2 issues covered by PR #17000 (internally reported issue).
 // 1) allocation planner broke in minimal build when subgraph had no nodes.
 // 2) usage of a sequence data type caused an exception due to IsSparseTensor() throwing
@@ -0,0 +1,154 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "core/framework/allocator_utils.h"
+#include "core/framework/prepacked_weights_file_store.h"
+#include "core/platform/env.h"
+#include "gtest/gtest.h"
+#include "test/util/include/asserts.h"
+#include "test/util/include/temp_dir.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// Two buffers with an unused place-holder between them, as some kernels produce.
+PrePackedWeights MakeWeights(uint8_t first_value) {
+  AllocatorPtr allocator = CPUAllocator::DefaultInstance();
+  PrePackedWeights weights;
+
+  constexpr size_t first_size = 13;
+  auto first = IAllocator::MakeUniquePtr<void>(allocator, first_size);
+  std::iota(static_cast<uint8_t*>(first.get()), static_cast<uint8_t*>(first.get()) + first_size, first_value);
+  weights.buffers_.push_back(std::move(first));
+  weights.buffer_sizes_.push_back(first_size);
+
+  weights.buffers_.push_back(nullptr);
+  weights.buffer_sizes_.push_back(0);
+
+  constexpr size_t second_size = 100;
+  auto second = IAllocator::MakeUniquePtr<void>(allocator, second_size);
+  std::memset(second.get(), 7, second_size);
+  weights.buffers_.push_back(std::move(second));
+  weights.buffer_sizes_.push_back(second_size);
+
+  return weights;
+}
+
+void ExpectSameContent(const PrePackedWeights& expected, const PrePackedWeights& actual) {
+  ASSERT_EQ(expected.buffers_.size(), actual.buffers_.size());
+  ASSERT_EQ(expected.buffer_sizes_.size(), actual.buffer_sizes_.size());
+  for (size_t i = 0; i < expected.buffers_.size(); ++i) {
+    ASSERT_EQ(expected.buffer_sizes_[i], actual.buffer_sizes_[i]);
+    if (expected.buffers_[i] == nullptr) {
+      ASSERT_EQ(actual.buffers_[i], nullptr);
+      continue;
+    }
+    ASSERT_NE(actual.buffers_[i], nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(actual.buffers_[i].get()) % PrepackedWeightsFileStore::kBufferAlignment,
+              0u);
+    EXPECT_EQ(std::memcmp(expected.buffers_[i].get(), actual.buffers_[i].get(), expected.buffer_sizes_[i]), 0);
+  }
+}
+
+}  // namespace
+
+TEST(PrepackedWeightsFileStoreTest, ShareMapsStoredWeights) {
+  TemporaryDirectory tmp_dir(ORT_TSTR("prepacked_weights_file_store_test_share"));
+  PrepackedWeightsFileStore store(Env::Default(), std::filesystem::path(tmp_dir.Path()) / "store");
+
+  const std::string key = "MatMul+" + std::to_string(MakeWeights(1).GetHash());
+  const PrePackedWeights expected = MakeWeights(1);
+
+  PrePackedWeights first = MakeWeights(1);
+  const void* heap_buffer = first.buffers_[0].get();
+  ASSERT_STATUS_OK(store.Share(key, first));
+  ASSERT_TRUE(std::filesystem::exists(store.GetFilePath(key)));
+  EXPECT_NE(first.buffers_[0].get(), heap_buffer);
+  ExpectSameContent(expected, first);
+
+  const auto last_write_time = std::filesystem::last_write_time(store.GetFilePath(key));
+
+  // a second user of the same weight maps the existing file
+  PrePackedWeights second = MakeWeights(1);
+  ASSERT_STATUS_OK(store.Share(key, second));
+  ExpectSameContent(expected, second);
+  EXPECT_EQ(std::filesystem::last_write_time(store.GetFilePath(key)), last_write_time);
+
+  // the mapping is kept alive by the remaining buffers
+  first = PrePackedWeights{};
+  ExpectSameContent(expected, second);
+}
+
+TEST(PrepackedWeightsFileStoreTest, MismatchedFileIsRewritten) {
+  TemporaryDirectory tmp_dir(ORT_TSTR("prepacked_weights_file_store_test_mismatch"));
+  PrepackedWeightsFileStore store(Env::Default(), std::filesystem::path(tmp_dir.Path()));
+
+  const std::string key = "MatMul+1234";
+
+  // same layout but different content, e.g. a stale file written for another weight
+  PrePackedWeights other = MakeWeights(2);
+  ASSERT_STATUS_OK(store.Share(key, other));
+  other = PrePackedWeights{};
+
+  const PrePackedWeights expected = MakeWeights(1);
+  PrePackedWeights weights = MakeWeights(1);
+  ASSERT_STATUS_OK(store.Share(key, weights));
+  ExpectSameContent(expected, weights);
+
+  // truncated file
+  weights = PrePackedWeights{};
+  {
+    std::ofstream out(store.GetFilePath(key), std::ios::binary | std::ios::trunc);
+    out << "ORTPPW01";
+  }
+
+  weights = MakeWeights(1);
+  ASSERT_STATUS_OK(store.Share(key, weights));
+  ExpectSameContent(expected, weights);
+}
+
+// Sessions in the same process that share the same weight concurrently each write their own temporary file.
+TEST(PrepackedWeightsFileStoreTest, ConcurrentSharesOfSameKey) {
+  TemporaryDirectory tmp_dir(ORT_TSTR("prepacked_weights_file_store_test_concurrent"));
+  PrepackedWeightsFileStore store(Env::Default(), std::filesystem::path(tmp_dir.Path()));
+
+  const std::string key = "MatMul+" + std::to_string(MakeWeights(1).GetHash());
+  const PrePackedWeights expected = MakeWeights(1);
+
+  constexpr size_t num_threads = 8;
+  std::vector<PrePackedWeights> weights(num_threads);
+  std::vector<Status> statuses(num_threads);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < num_threads; ++i) {
+    weights[i] = MakeWeights(1);
+    threads.emplace_back([&, i]() { statuses[i] = store.Share(key, weights[i]); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t i = 0; i < num_threads; ++i) {
+    ASSERT_STATUS_OK(statuses[i]);
+    ExpectSameContent(expected, weights[i]);
+  }
+
+  // no temporary file is left behind
+  size_t num_files = 0;
+  for (const auto& entry : std::filesystem::directory_iterator(tmp_dir.Path())) {
+    EXPECT_NE(entry.path().extension(), ".tmp") << entry.path();
+    ++num_files;
+  }
+  EXPECT_EQ(num_files, 1u);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
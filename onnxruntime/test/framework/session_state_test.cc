@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <fstream>
 #include <iostream>
 #include <absl/base/config.h>
 
@@ -579,7 +580,8 @@ class PrePackingTestOpKernel : public OpKernel {
   IAllocatorUniquePtr<void> weight_packed_;
 };
 
-static void CreateSimpleGraph(Graph& graph) {
+// If external_data_path is set, the initializer is stored in that file as external data.
+static void CreateSimpleGraph(Graph& graph, const PathString& external_data_path = PathString()) {
   // node creation and placement
   TypeProto type;
   type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
@@ -600,9 +602,20 @@ static void CreateSimpleGraph(Graph& graph) {
   // add an initializer
   ONNX_NAMESPACE::TensorProto tensor;
   tensor.add_dims(1);
-  tensor.add_float_data(1.0f);
   tensor.set_data_type(TensorProto_DataType_FLOAT);
   tensor.set_name("node_0_input_1");
+  if (external_data_path.empty()) {
+    tensor.add_float_data(1.0f);
+  } else {
+    const float value = 1.0f;
+    std::ofstream external_data_file(external_data_path, std::ios::binary);
+    external_data_file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+
+    tensor.set_data_location(TensorProto_DataLocation_EXTERNAL);
+    auto* location = tensor.add_external_data();
+    location->set_key("location");
+    location->set_value(ToUTF8String(external_data_path));
+  }
   graph.AddInitializedTensor(tensor);
 
   auto status = graph.Resolve();
@@ -711,6 +724,7 @@ static void PlaceAllNodesToCPUEP(Graph& graph) {
 struct PrepackingTestParam {
   bool test_subgraph;
   bool test_prepacking;
+  bool test_parallel_initialization = false;
 };
 
 class SessionStatePrepackingTest : public testing::TestWithParam<PrepackingTestParam> {};
@@ -718,6 +732,9 @@ TEST_P(SessionStatePrepackingTest, PrePackingTest) {
   PrepackingTestParam test_param = GetParam();
 
   OrtThreadPoolParams to;
+  if (test_param.test_parallel_initialization) {
+    to.thread_pool_size = 2;
+  }
   auto tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(), to, concurrency::ThreadPoolType::INTRA_OP);
   ONNX_OPERATOR_SCHEMA(PrePackingTest)
       .SetDoc("Faking Node for PrePacking")
@@ -753,6 +770,8 @@ TEST_P(SessionStatePrepackingTest, PrePackingTest) {
   sess_options.enable_mem_reuse = true;
   sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] =
       test_param.test_prepacking ? "0" : "1";
+  sess_options.config_options.configurations[kOrtSessionOptionsParallelInitialization] =
+      test_param.test_parallel_initialization ? "1" : "0";
 
   SessionState session_state(model.MainGraph(),
                              execution_providers,
@@ -1372,12 +1391,59 @@ TEST_F(SessionStateTestSharedInitalizersWithPrePacking, TestPrepackedSerializati
 }
 #endif  // __wasm__
 
+// Pre-packing of an initializer memory-mapped from external data is deferred until the node first runs,
+// and then happens exactly once.
+TEST_F(SessionStateTestSharedInitalizersWithPrePacking, LazyExternalInitializerPrePacking) {
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = true;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  sess_options.use_deterministic_compute = false;
+  sess_options.enable_mem_reuse = true;
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] = "0";
+  sess_options.config_options.configurations[kOrtSessionOptionsLazyExternalInitializers] = "1";
+
+  const PathString external_data_path = ORT_TSTR("lazy_external_initializer_prepacking_test.bin");
+  ScopedFileDeleter file_deleter(external_data_path);
+
+  Model model("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+              DefaultLoggingManager().DefaultLogger());
+
+  CreateSimpleGraph(model.MainGraph(), external_data_path);
+  PlaceAllNodesToCPUEP(model.MainGraph());
+  SessionState session_state(model.MainGraph(),
+                             execution_providers,
+                             tp.get(),
+                             nullptr, /*inter_op_thread_pool*/
+                             dtm,
+                             edlm,
+                             DefaultLoggingManager().DefaultLogger(),
+                             profiler,
+                             sess_options);
+
+  ASSERT_STATUS_OK(session_state.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                      kernel_registry_manager));
+
+  const auto* kernel = reinterpret_cast<const PrePackingTestOpKernel*>(session_state.GetKernel(0));
+
+  // nothing was pre-packed and the initializer is still needed as an input
+  ASSERT_EQ(kernel->prepack_calls_count, 0);
+  ASSERT_EQ(session_state.GetConstantInitializedTensors().size(), 1U);
+
+  ASSERT_STATUS_OK(session_state.RunDeferredPrePack(0));
+  ASSERT_EQ(kernel->prepack_calls_count, 1);
+  ASSERT_STATUS_OK(session_state.RunDeferredPrePack(0));
+  ASSERT_EQ(kernel->prepack_calls_count, 1);
+}
+
 INSTANTIATE_TEST_SUITE_P(SessionStateTests,
                          SessionStatePrepackingTest,
                          testing::Values(PrepackingTestParam{false, false},
                                          PrepackingTestParam{false, true},
                                          PrepackingTestParam{true, false},
-                                         PrepackingTestParam{true, true}));
+                                         PrepackingTestParam{true, true},
+                                         PrepackingTestParam{false, true, true},
+                                         PrepackingTestParam{true, true, true}));
 #endif
 
 }  // namespace test
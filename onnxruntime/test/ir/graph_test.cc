@@ -6,6 +6,7 @@
 #include "core/common/inlined_containers.h"
 #include "core/common/span_utils.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
 #include "core/graph/op.h"
@@ -2833,5 +2834,85 @@ TEST_F(GraphTest, ShapeInferenceAfterInitializerExternalization) {
   ASSERT_TRUE(second_resolve.IsOK()) << "Second resolve failed: " << second_resolve.ErrorMessage();
 }
 
+TEST_F(GraphTest, IncrementalResolve) {
+  Model model("incremental_resolve", false, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto float_2x3;
+  float_2x3.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_2x3.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  float_2x3.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  auto is_2x3 = [](const NodeArg& arg) {
+    const auto* shape = arg.Shape();
+    return shape != nullptr && shape->dim_size() == 2 &&
+           shape->dim(0).has_dim_value() && shape->dim(0).dim_value() == 2 &&
+           shape->dim(1).has_dim_value() && shape->dim(1).dim_value() == 3;
+  };
+
+  // the Reshape output shape is only known if the value propagated from the Shape node is available
+  auto& x = graph.GetOrCreateNodeArg("x", &float_2x3);
+  auto& relu_out = graph.GetOrCreateNodeArg("relu_out", nullptr);
+  auto& shape_out = graph.GetOrCreateNodeArg("shape_out", nullptr);
+  auto& reshape_out = graph.GetOrCreateNodeArg("reshape_out", nullptr);
+  graph.AddNode("relu", "Relu", "", {&x}, {&relu_out});
+  graph.AddNode("shape", "Shape", "", {&x}, {&shape_out});
+  graph.AddNode("reshape", "Reshape", "", {&relu_out, &shape_out}, {&reshape_out});
+
+  graph.SetIncrementalResolve(true);
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_TRUE(is_2x3(reshape_out));
+  EXPECT_TRUE(shape_out.GetInferredShapeValues().has_value());
+
+  // add nodes downstream of the existing ones, which are not re-run. the new Reshape uses the value the Shape node
+  // propagated in the previous Resolve.
+  auto& neg_out = graph.GetOrCreateNodeArg("neg_out", nullptr);
+  auto& reshape_2_out = graph.GetOrCreateNodeArg("reshape_2_out", nullptr);
+  graph.AddNode("neg", "Neg", "", {&reshape_out}, {&neg_out});
+  graph.AddNode("reshape_2", "Reshape", "", {&neg_out, &shape_out}, {&reshape_2_out});
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_TRUE(is_2x3(neg_out));
+  EXPECT_TRUE(is_2x3(reshape_2_out));
+
+  graph.SetIncrementalResolve(false);
+  EXPECT_FALSE(shape_out.GetInferredShapeValues().has_value());
+}
+
+TEST_F(GraphTest, IncrementalResolveClearsStalePropagatedValues) {
+  Model model("incremental_resolve_clears_stale_values", false, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto float_2x3;
+  float_2x3.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_2x3.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  float_2x3.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  TypeProto float_unknown_shape;
+  float_unknown_shape.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+
+  // the Concat output values are propagated from the Shape node
+  auto& x = graph.GetOrCreateNodeArg("x", &float_2x3);
+  auto& y = graph.GetOrCreateNodeArg("y", &float_unknown_shape);
+  auto& shape_out = graph.GetOrCreateNodeArg("shape_out", nullptr);
+  auto& concat_out = graph.GetOrCreateNodeArg("concat_out", nullptr);
+  auto& shape_node = graph.AddNode("shape", "Shape", "", {&x}, {&shape_out});
+  auto& concat_node = graph.AddNode("concat", "Concat", "", {&shape_out, &shape_out}, {&concat_out});
+  concat_node.AddAttribute("axis", static_cast<int64_t>(0));
+
+  graph.SetIncrementalResolve(true);
+  ASSERT_STATUS_OK(graph.Resolve());
+  ASSERT_TRUE(concat_out.GetInferredShapeValues().has_value());
+  EXPECT_EQ(concat_out.GetInferredShapeValues()->dim_size(), 4);
+
+  // the Shape node no longer propagates values once its input has an unknown shape. the Concat node is unchanged,
+  // but its propagated values have to be cleared as well.
+  graph_utils::ReplaceNodeInput(shape_node, 0, y);
+  graph.SetGraphResolveNeeded();
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_FALSE(shape_out.GetInferredShapeValues().has_value());
+  EXPECT_FALSE(concat_out.GetInferredShapeValues().has_value());
+
+  graph.SetIncrementalResolve(false);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
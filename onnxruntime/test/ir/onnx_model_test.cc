@@ -2,7 +2,12 @@
 // Licensed under the MIT License.
 
 #include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <memory>
+#include <numeric>
+#include "core/framework/tensorprotoutils.h"
 #include "core/platform/env.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
@@ -10,6 +15,7 @@
 #include "core/session/onnxruntime_c_api.h"
 #include "test/providers/provider_test_utils.h"  //For ASSERT_STATUS_OK
 #include "test/test_environment.h"
+#include "test/util/include/temp_dir.h"
 #include "gtest/gtest.h"
 #include "onnx/defs/function.h"
 #include "onnx/defs/parser.h"
@@ -42,6 +48,99 @@ TEST_F(ONNXModelsTest, future_opset) {
   ASSERT_FALSE(st.IsOK());
 }
 
+// Load a model with inline initializers without reading their raw data into the ModelProto.
+TEST_F(ONNXModelsTest, StreamInitializersFromFile) {
+  ModelProto model_proto;
+  model_proto.set_ir_version(ONNX_NAMESPACE::Version::IR_VERSION);
+  model_proto.set_producer_name("streaming_test");
+  auto* opset = model_proto.add_opset_import();
+  opset->set_domain("");
+  opset->set_version(13);
+  auto* metadata = model_proto.add_metadata_props();
+  metadata->set_key("key");
+  metadata->set_value("value");
+
+  auto* graph_proto = model_proto.mutable_graph();
+  graph_proto->set_name("graph");
+
+  auto add_float_tensor = [&](const std::string& name, int64_t size, float first_value) {
+    std::vector<float> values(static_cast<size_t>(size));
+    std::iota(values.begin(), values.end(), first_value);
+    auto* initializer = graph_proto->add_initializer();
+    initializer->set_name(name);
+    initializer->set_data_type(TensorProto_DataType_FLOAT);
+    initializer->add_dims(size);
+    initializer->set_raw_data(values.data(), values.size() * sizeof(float));
+    return values;
+  };
+
+  const auto large_values = add_float_tensor("large", 256, 1.f);
+  const auto small_values = add_float_tensor("small", 1, 0.5f);
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(256);
+  auto* input = graph_proto->add_input();
+  input->set_name("x");
+  *input->mutable_type() = float_tensor;
+  auto* output = graph_proto->add_output();
+  output->set_name("z");
+  *output->mutable_type() = float_tensor;
+
+  auto* add_large = graph_proto->add_node();
+  add_large->set_op_type("Add");
+  add_large->add_input("x");
+  add_large->add_input("large");
+  add_large->add_output("y");
+  auto* add_small = graph_proto->add_node();
+  add_small->set_op_type("Add");
+  add_small->add_input("y");
+  add_small->add_input("small");
+  add_small->add_output("z");
+
+  TemporaryDirectory tmp_dir(ORT_TSTR("streaming_model_load_test"));
+  const auto model_path = std::filesystem::path(tmp_dir.Path()) / ORT_TSTR("model.onnx");
+  {
+    std::ofstream out(model_path, std::ios::binary);
+    ASSERT_TRUE(model_proto.SerializeToOstream(&out));
+  }
+
+  ModelOptions options;
+  options.stream_initializers_from_file = true;
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(model_path.native(), model, nullptr, *logger_, options));
+
+  const ModelProto loaded_proto = model->ToProto();
+  EXPECT_EQ(loaded_proto.producer_name(), "streaming_test");
+  ASSERT_EQ(loaded_proto.metadata_props_size(), 1);
+  EXPECT_EQ(loaded_proto.metadata_props(0).value(), "value");
+
+  const Graph& graph = model->MainGraph();
+  EXPECT_EQ(graph.NumberOfNodes(), 2);
+
+  const TensorProto* large = nullptr;
+  ASSERT_TRUE(graph.GetInitializedTensor("large", large));
+  ASSERT_TRUE(utils::HasExternalData(*large));
+  EXPECT_FALSE(utils::HasRawData(*large));
+  for (const auto& entry : large->external_data()) {
+    if (entry.key() == "location") {
+      EXPECT_EQ(entry.value(), "model.onnx");
+    }
+  }
+
+  std::vector<uint8_t> unpacked;
+  ASSERT_STATUS_OK(utils::UnpackInitializerData(*large, model->ModelPath(), unpacked));
+  ASSERT_EQ(unpacked.size(), large_values.size() * sizeof(float));
+  EXPECT_EQ(std::memcmp(unpacked.data(), large_values.data(), unpacked.size()), 0);
+
+  const TensorProto* small = nullptr;
+  ASSERT_TRUE(graph.GetInitializedTensor("small", small));
+  EXPECT_FALSE(utils::HasExternalData(*small));
+  ASSERT_STATUS_OK(utils::UnpackInitializerData(*small, model->ModelPath(), unpacked));
+  ASSERT_EQ(unpacked.size(), sizeof(float));
+  EXPECT_EQ(std::memcmp(unpacked.data(), small_values.data(), unpacked.size()), 0);
+}
+
 class ONNXModelsTest1 : public ::testing::TestWithParam<const ORTCHAR_T*> {
   // You can implement all the usual fixture class members here.
   // To access the test parameter, call GetParam() from class
@@ -77,6 +77,28 @@ static void BM_StridedCopy_SingleThread_Axis_1(benchmark::State& state) {
   aligned_free(output);
 }
 
+// Broadcast of a column to [batch_size, feature_size], as done by Expand and Tile.
+static void BM_StridedCopy_Broadcast_Parallel(benchmark::State& state) {
+  const size_t batch_size = static_cast<size_t>(state.range(0));
+  const size_t feature_size = static_cast<size_t>(state.range(1));
+
+  float* output = (float*)aligned_alloc(sizeof(float) * batch_size * feature_size, 64);
+  float* data = GenerateArrayWithRandomValue<float>(batch_size, -1, 1);
+
+  OrtThreadPoolParams tpo;
+  tpo.auto_set_affinity = true;
+  std::unique_ptr<concurrency::ThreadPool> tp(
+      concurrency::CreateThreadPool(&onnxruntime::Env::Default(), tpo, concurrency::ThreadPoolType::INTRA_OP));
+
+  int64_t ibatch_size = static_cast<int64_t>(batch_size);
+  int64_t ifeature_size = static_cast<int64_t>(feature_size);
+  for (auto _ : state) {
+    StridedCopy<float>(tp.get(), output, {ifeature_size, 1}, {ibatch_size, ifeature_size}, data, {1, 0});
+  }
+  aligned_free(data);
+  aligned_free(output);
+}
+
 #define SC_BENCHMARK(name)                     \
   BENCHMARK(name)                              \
       ->UseRealTime()                          \
@@ -95,3 +117,4 @@ SC_BENCHMARK(BM_StridedCopy_Memcpy);
 SC_BENCHMARK(BM_StridedCopy_SingleThread);
 SC_BENCHMARK(BM_StridedCopy_Parallel);
 SC_BENCHMARK(BM_StridedCopy_SingleThread_Axis_1);
+SC_BENCHMARK(BM_StridedCopy_Broadcast_Parallel);
@@ -0,0 +1,142 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/model.h>
+#include <core/session/onnxruntime_c_api.h>
+#include <core/session/onnxruntime_session_options_config_keys.h>
+#include <core/session/ort_env.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+extern OrtEnv* env;
+extern const OrtApi* g_ort;
+
+using namespace onnxruntime;
+
+namespace {
+
+// Creates a model with a chain of num_blocks Relu -> Identity -> Add blocks. Each Add has its own initializer.
+// The Identity nodes are removed by the level 1 optimizers.
+std::unique_ptr<Model> CreateLargeModel(int64_t num_blocks, const logging::Logger& logger) {
+  auto model = std::make_unique<Model>("large_model", false, logger);
+  Graph& graph = model->MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(16);
+
+  NodeArg* prev = &graph.GetOrCreateNodeArg("input", &float_tensor);
+  for (int64_t i = 0; i < num_blocks; ++i) {
+    const std::string suffix = std::to_string(i);
+
+    ONNX_NAMESPACE::TensorProto bias;
+    bias.set_name("bias_" + suffix);
+    bias.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    bias.add_dims(16);
+    for (int j = 0; j < 16; ++j) {
+      bias.add_float_data(0.5f);
+    }
+    graph.AddInitializedTensor(bias);
+
+    auto& relu_out = graph.GetOrCreateNodeArg("relu_" + suffix, nullptr);
+    auto& identity_out = graph.GetOrCreateNodeArg("identity_" + suffix, nullptr);
+    auto& add_out = graph.GetOrCreateNodeArg("add_" + suffix, nullptr);
+    graph.AddNode("relu_node_" + suffix, "Relu", "", {prev}, {&relu_out});
+    graph.AddNode("identity_node_" + suffix, "Identity", "", {&relu_out}, {&identity_out});
+    graph.AddNode("add_node_" + suffix, "Add", "", {&identity_out, graph.GetNodeArg("bias_" + suffix)}, {&add_out});
+    prev = &add_out;
+  }
+
+  return model;
+}
+
+}  // namespace
+
+// Resolve after a change to a single node in the middle of a large graph, as happens after most graph transformers.
+// Arguments: number of blocks in the graph, whether incremental resolve is enabled.
+static void BM_ResolveAfterSingleNodeChange(benchmark::State& state) {
+  const int64_t num_blocks = state.range(0);
+  const bool incremental = state.range(1) != 0;
+
+  auto logger = env->GetLoggingManager()->CreateLogger("test");
+  auto model = CreateLargeModel(num_blocks, *logger);
+  Graph& graph = model->MainGraph();
+  graph.SetIncrementalResolve(incremental);
+  auto status = graph.Resolve();
+  if (!status.IsOK()) {
+    state.SkipWithError(status.ErrorMessage().c_str());
+    return;
+  }
+
+  Node* middle_node = graph.GetNode(static_cast<NodeIndex>(num_blocks / 2 * 3));
+  for (auto _ : state) {
+    // mark the node as modified
+    middle_node->ClearAttribute("unused");
+    status = graph.Resolve();
+    if (!status.IsOK()) {
+      state.SkipWithError(status.ErrorMessage().c_str());
+      break;
+    }
+  }
+}
+
+BENCHMARK(BM_ResolveAfterSingleNodeChange)
+    ->ArgsProduct({{1000, 10000, 50000}, {0, 1}})
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMillisecond);
+
+// Session creation with the default graph optimizations, which resolve the graph after each transformer that modifies
+// it. Arguments: number of blocks in the graph, whether incremental resolve is enabled.
+static void BM_OptimizeLargeGraph(benchmark::State& state) {
+  const int64_t num_blocks = state.range(0);
+  const bool incremental = state.range(1) != 0;
+
+  std::string model_data;
+  {
+    auto logger = env->GetLoggingManager()->CreateLogger("test");
+    auto model = CreateLargeModel(num_blocks, *logger);
+    auto status = model->MainGraph().Resolve();
+    if (!status.IsOK()) {
+      state.SkipWithError(status.ErrorMessage().c_str());
+      return;
+    }
+    model_data = model->ToProto().SerializeAsString();
+  }
+
+  OrtSessionOptions* session_options = nullptr;
+  OrtStatus* ort_status = g_ort->CreateSessionOptions(&session_options);
+  if (ort_status == nullptr) {
+    ort_status = g_ort->AddSessionConfigEntry(session_options, kOrtSessionOptionsDisableIncrementalGraphResolve,
+                                              incremental ? "0" : "1");
+  }
+
+  for (auto _ : state) {
+    if (ort_status != nullptr) {
+      break;
+    }
+
+    OrtSession* session = nullptr;
+    ort_status = g_ort->CreateSessionFromArray(env, model_data.data(), model_data.size(), session_options, &session);
+    if (ort_status == nullptr) {
+      state.PauseTiming();
+      g_ort->ReleaseSession(session);
+      state.ResumeTiming();
+    }
+  }
+
+  if (ort_status != nullptr) {
+    state.SkipWithError(g_ort->GetErrorMessage(ort_status));
+    g_ort->ReleaseStatus(ort_status);
+  }
+
+  g_ort->ReleaseSessionOptions(session_options);
+}
+
+BENCHMARK(BM_OptimizeLargeGraph)
+    ->ArgsProduct({{1000, 10000, 50000}, {0, 1}})
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMillisecond);
@@ -1,4 +1,6 @@
+#include <cmath>
 #include <limits>
+#include <memory>
 
 #include "common.h"
 
@@ -81,3 +83,116 @@ BENCHMARK_TEMPLATE(BM_NhwcUpsampleBilinear, float)
     ->Args({128, 128})
     ->Args({160, 160})
     ->Args({1, 1000000});
+
+// Resize of a batch of NCHW images, as done by image preprocessing inside models: 3 channels and an output of
+// state.range(0) x state.range(1).
+template <typename T>
+struct NchwResizeData {
+  static constexpr int32_t batch_size = 2;
+  static constexpr int32_t num_channels = 3;
+  static constexpr int32_t input_height = 480;
+  static constexpr int32_t input_width = 640;
+
+  NchwResizeData(int32_t output_height_, int32_t output_width_)
+      : output_height(output_height_),
+        output_width(output_width_),
+        height_scale(static_cast<float>(output_height_) / input_height),
+        width_scale(static_cast<float>(output_width_) / input_width),
+        Xdata(GenerateArrayWithRandomValue<T>(static_cast<size_t>(batch_size) * num_channels * input_height * input_width,
+                                              0, 255)),
+        Ydata(static_cast<T*>(aligned_alloc(sizeof(T) * batch_size * num_channels * output_height_ * output_width_, 64))) {
+    OrtThreadPoolParams tpo;
+    tpo.auto_set_affinity = true;
+    tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(), tpo, concurrency::ThreadPoolType::INTRA_OP);
+  }
+
+  ~NchwResizeData() {
+    aligned_free(Xdata);
+    aligned_free(Ydata);
+  }
+
+  const int32_t output_height;
+  const int32_t output_width;
+  const float height_scale;
+  const float width_scale;
+  T* const Xdata;
+  T* const Ydata;
+  std::unique_ptr<concurrency::ThreadPool> tp;
+  const std::vector<float> roi{0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+
+  static float HalfPixel(float x_resized, float x_scale, float, float, float, float) {
+    return ((x_resized + 0.5f) / x_scale) - 0.5f;
+  }
+};
+
+template <typename T>
+static void BM_UpsampleNearest(benchmark::State& state) {
+  NchwResizeData<T> d(static_cast<int32_t>(state.range(0)), static_cast<int32_t>(state.range(1)));
+  const TensorShape input_shape({d.batch_size, d.num_channels, d.input_height, d.input_width});
+  const TensorShape output_shape({d.batch_size, d.num_channels, d.output_height, d.output_width});
+  const std::vector<float> scales{1.0f, 1.0f, d.height_scale, d.width_scale};
+  const GetNearestPixelFunc get_nearest_pixel = [](float x_original, bool) {
+    return static_cast<int64_t>(std::round(x_original));
+  };
+
+  for (auto _ : state) {
+    auto status = UpsampleNearest<T>(d.Xdata, d.Ydata, input_shape, output_shape, scales, d.roi,
+                                     /*is_resize*/ true, /*extrapolation_enabled*/ false, T{},
+                                     /*use_nearest2x_optimization*/ false, &NchwResizeData<T>::HalfPixel,
+                                     get_nearest_pixel, d.tp.get());
+    if (!status.IsOK()) {
+      state.SkipWithError(status.ErrorMessage().c_str());
+    }
+  }
+}
+
+static void BM_UpsampleBilinear(benchmark::State& state) {
+  NchwResizeData<float> d(static_cast<int32_t>(state.range(0)), static_cast<int32_t>(state.range(1)));
+  AllocatorPtr alloc = CPUAllocator::DefaultInstance();
+
+  for (auto _ : state) {
+    UpsampleBilinear<float>(d.batch_size, d.num_channels, d.input_height, d.input_width, d.output_height,
+                            d.output_width, d.height_scale, d.width_scale, d.roi, /*use_extrapolation*/ false,
+                            /*extrapolation_value*/ 0.0f, d.Xdata, d.Ydata, alloc, &NchwResizeData<float>::HalfPixel,
+                            d.tp.get());
+  }
+}
+
+static void BM_ResizeBiCubic(benchmark::State& state) {
+  NchwResizeData<float> d(static_cast<int32_t>(state.range(0)), static_cast<int32_t>(state.range(1)));
+
+  for (auto _ : state) {
+    ResizeBiCubic<float>(d.batch_size, d.num_channels, d.input_height, d.input_width, d.output_height,
+                         d.output_width, d.height_scale, d.width_scale, /*cubic_coeff_a*/ -0.75f,
+                         /*use_extrapolation*/ false, /*extrapolation_value*/ 0.0f, /*exclude_outside*/ false,
+                         d.roi, d.Xdata, d.Ydata, &NchwResizeData<float>::HalfPixel, d.tp.get());
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_UpsampleNearest, uint8_t)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->Args({224, 224})
+    ->Args({320, 320})
+    ->Args({960, 1280});
+
+BENCHMARK_TEMPLATE(BM_UpsampleNearest, float)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->Args({224, 224})
+    ->Args({320, 320})
+    ->Args({960, 1280});
+
+BENCHMARK(BM_UpsampleBilinear)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->Args({224, 224})
+    ->Args({320, 320})
+    ->Args({960, 1280});
+
+BENCHMARK(BM_ResizeBiCubic)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->Args({224, 224})
+    ->Args({320, 320})
+    ->Args({960, 1280});
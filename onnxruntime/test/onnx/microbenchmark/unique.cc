@@ -0,0 +1,80 @@
+#include "common.h"
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "core/providers/cpu/tensor/unique.h"
+
+using namespace onnxruntime;
+
+// Ids with a long tail, as seen in the categorical features of recommendation models.
+static std::vector<int64_t> GenerateIds(size_t num_values, int64_t num_distinct) {
+  std::mt19937 generator(42);
+  std::geometric_distribution<int64_t> distribution(4.0 / static_cast<double>(num_distinct));
+  std::vector<int64_t> ids(num_values);
+  for (auto& id : ids) {
+    id = distribution(generator) % num_distinct;
+  }
+  return ids;
+}
+
+// Lookup through a std::map, as Unique did before it used a hash table.
+static void BM_UniqueOrderedMap(benchmark::State& state) {
+  const auto ids = GenerateIds(static_cast<size_t>(state.range(0)), state.range(1));
+
+  for (auto _ : state) {
+    std::map<const int64_t, int64_t> offsets;
+    std::vector<std::vector<int64_t>> indices;
+    std::vector<int64_t> inverse_index;
+    inverse_index.reserve(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+      auto entry = offsets.find(ids[i]);
+      if (entry == offsets.end()) {
+        offsets[ids[i]] = static_cast<int64_t>(indices.size());
+        inverse_index.push_back(static_cast<int64_t>(indices.size()));
+        indices.push_back({static_cast<int64_t>(i)});
+      } else {
+        indices[static_cast<size_t>(entry->second)].push_back(static_cast<int64_t>(i));
+        inverse_index.push_back(entry->second);
+      }
+    }
+    benchmark::DoNotOptimize(inverse_index.data());
+  }
+}
+
+static void BM_UniqueHash(benchmark::State& state) {
+  const auto ids = GenerateIds(static_cast<size_t>(state.range(0)), state.range(1));
+  const bool sorted = state.range(2) != 0;
+
+  for (auto _ : state) {
+    unique_helpers::UniqueEntries entries;
+    unique_helpers::FindUniqueValues(gsl::make_span(ids), entries);
+    auto order = unique_helpers::GetOutputOrder(entries, sorted, [&](int64_t lhs, int64_t rhs) {
+      return ids[static_cast<size_t>(lhs)] < ids[static_cast<size_t>(rhs)];
+    });
+    benchmark::DoNotOptimize(order.data());
+    benchmark::DoNotOptimize(entries.inverse_indices.data());
+  }
+}
+
+BENCHMARK(BM_UniqueOrderedMap)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->Args({4096, 256})
+    ->Args({65536, 1024})
+    ->Args({65536, 65536})
+    ->Args({1048576, 100000});
+
+BENCHMARK(BM_UniqueHash)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->Args({4096, 256, 0})
+    ->Args({65536, 1024, 0})
+    ->Args({65536, 65536, 0})
+    ->Args({1048576, 100000, 0})
+    ->Args({4096, 256, 1})
+    ->Args({65536, 1024, 1})
+    ->Args({65536, 65536, 1})
+    ->Args({1048576, 100000, 1});
@@ -0,0 +1,133 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/unittest_util/graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+// Sub -> Mul -> Add -> Sigmoid -> Mul as exported from PyTorch, with a scalar, a bias and a full sized input.
+TEST(ElementwiseFusionTests, ChainWithRepeatedInputs) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 1000}, -3.f, 3.f);
+    auto* gate_arg = builder.MakeInput<float>({2, 3, 1000}, -3.f, 3.f);
+    auto* mean_arg = builder.MakeScalarInitializer<float>(0.5f);
+    auto* scale_arg = builder.MakeInitializer<float>({1000}, 0.5f, 2.f);
+    auto* bias_arg = builder.MakeInitializer<float>({1, 3, 1000}, -1.f, 1.f);
+    auto* sub_out = builder.MakeIntermediate();
+    auto* mul_out = builder.MakeIntermediate();
+    auto* add_out = builder.MakeIntermediate();
+    auto* sigmoid_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Sub", {input_arg, mean_arg}, {sub_out});
+    builder.AddNode("Mul", {sub_out, scale_arg}, {mul_out});
+    builder.AddNode("Add", {mul_out, bias_arg}, {add_out});
+    builder.AddNode("Sigmoid", {add_out}, {sigmoid_out});
+    builder.AddNode("Mul", {sigmoid_out, gate_arg}, {output_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Sub"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+    EXPECT_EQ(op_to_count["Add"], 0);
+    EXPECT_EQ(op_to_count["Sigmoid"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level3, {13, 14},
+                    1e-5, 1e-5);
+}
+
+// A result consumed by two nodes of the group is fused, one that is also consumed outside of it is not.
+TEST(ElementwiseFusionTests, SharedIntermediates) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({4, 64}, -2.f, 2.f);
+    auto* abs_out = builder.MakeIntermediate();
+    auto* tanh_out = builder.MakeIntermediate();
+    auto* exp_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    auto* softmax_out = builder.MakeOutput();
+
+    builder.AddNode("Abs", {input_arg}, {abs_out});
+    builder.AddNode("Softmax", {abs_out}, {softmax_out});
+    builder.AddNode("Tanh", {abs_out}, {tanh_out});
+    builder.AddNode("Exp", {tanh_out}, {exp_out});
+    builder.AddNode("Add", {tanh_out, exp_out}, {output_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Abs"], 1);
+    EXPECT_EQ(op_to_count["Tanh"], 0);
+    EXPECT_EQ(op_to_count["Exp"], 0);
+    EXPECT_EQ(op_to_count["Add"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level3, 13,
+                    1e-5, 1e-5);
+}
+
+// An input of shape [4, 1] doesn't repeat along an output of [4, 16], so its consumer is left out of the group.
+TEST(ElementwiseFusionTests, NonRepeatedInput) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({4, 16}, -2.f, 2.f);
+    auto* row_arg = builder.MakeInput<float>({4, 1}, -2.f, 2.f);
+    auto* scale_arg = builder.MakeInput<float>({4, 16}, -2.f, 2.f);
+    auto* sub_out = builder.MakeIntermediate();
+    auto* relu_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Sub", {input_arg, row_arg}, {sub_out});
+    builder.AddNode("Relu", {sub_out}, {relu_out});
+    builder.AddNode("Mul", {relu_out, scale_arg}, {output_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Sub"], 1);
+    EXPECT_EQ(op_to_count["Relu"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level3, 13);
+}
+
+// The Sigmoid of the bias is smaller than the output and would be recomputed for every row, so it isn't fused.
+TEST(ElementwiseFusionTests, BroadcastProducer) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({64, 256}, -2.f, 2.f);
+    auto* bias_arg = builder.MakeInput<float>({256}, -2.f, 2.f);
+    auto* sigmoid_out = builder.MakeIntermediate();
+    auto* relu_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Sigmoid", {bias_arg}, {sigmoid_out});
+    builder.AddNode("Relu", {input_arg}, {relu_out});
+    builder.AddNode("Mul", {relu_out, sigmoid_out}, {output_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Sigmoid"], 1);
+    EXPECT_EQ(op_to_count["Relu"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level3, 13,
+                    1e-5, 1e-5);
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/unittest_util/graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+// Softmax -> TopK over the last axis, as used to pick the most likely classes or tokens.
+TEST(SoftmaxTopKFusionTests, LastAxis) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({4, 1000}, -5.f, 5.f);
+    auto* k_arg = builder.MakeInitializer<int64_t>({1}, std::vector<int64_t>{5});
+    auto* softmax_out = builder.MakeIntermediate();
+    auto* values_arg = builder.MakeOutput();
+    auto* indices_arg = builder.MakeOutput();
+
+    builder.AddNode("Softmax", {input_arg}, {softmax_out});
+    builder.AddNode("TopK", {softmax_out, k_arg}, {values_arg, indices_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.SoftmaxTopK"], 1);
+    EXPECT_EQ(op_to_count["Softmax"], 0);
+    EXPECT_EQ(op_to_count["TopK"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level2, {11, 13},
+                    1e-6, 1e-5);
+}
+
+// Since opset 13 Softmax is computed along a single axis, which doesn't have to be the last one.
+TEST(SoftmaxTopKFusionTests, InnerAxis) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 100, 8}, -5.f, 5.f);
+    auto* k_arg = builder.MakeInitializer<int64_t>({1}, std::vector<int64_t>{3});
+    auto* softmax_out = builder.MakeIntermediate();
+    auto* values_arg = builder.MakeOutput();
+    auto* indices_arg = builder.MakeOutput();
+
+    builder.AddNode("Softmax", {input_arg}, {softmax_out}).AddAttribute("axis", static_cast<int64_t>(1));
+    Node& topk_node = builder.AddNode("TopK", {softmax_out, k_arg}, {values_arg, indices_arg});
+    topk_node.AddAttribute("axis", static_cast<int64_t>(-2));
+    topk_node.AddAttribute("largest", static_cast<int64_t>(0));
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.SoftmaxTopK"], 1);
+    EXPECT_EQ(op_to_count["Softmax"], 0);
+    EXPECT_EQ(op_to_count["TopK"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level2, 13,
+                    1e-6, 1e-5);
+}
+
+// Before opset 13 Softmax normalizes over all the dims from its axis on, so a TopK along that axis is not fused.
+TEST(SoftmaxTopKFusionTests, CoercedAxisNotFused) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 100, 8}, -5.f, 5.f);
+    auto* k_arg = builder.MakeInitializer<int64_t>({1}, std::vector<int64_t>{3});
+    auto* softmax_out = builder.MakeIntermediate();
+    auto* values_arg = builder.MakeOutput();
+    auto* indices_arg = builder.MakeOutput();
+
+    builder.AddNode("Softmax", {input_arg}, {softmax_out}).AddAttribute("axis", static_cast<int64_t>(1));
+    builder.AddNode("TopK", {softmax_out, k_arg}, {values_arg, indices_arg})
+        .AddAttribute("axis", static_cast<int64_t>(1));
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.SoftmaxTopK"], 0);
+    EXPECT_EQ(op_to_count["Softmax"], 1);
+    EXPECT_EQ(op_to_count["TopK"], 1);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level2, 11);
+}
+
+// K computed at runtime can't be moved to the fused node.
+TEST(SoftmaxTopKFusionTests, DynamicKNotFused) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({4, 1000}, -5.f, 5.f);
+    auto* k_arg = builder.MakeInput<int64_t>({1}, std::vector<int64_t>{5});
+    auto* softmax_out = builder.MakeIntermediate();
+    auto* values_arg = builder.MakeOutput();
+    auto* indices_arg = builder.MakeOutput();
+
+    builder.AddNode("Softmax", {input_arg}, {softmax_out});
+    builder.AddNode("TopK", {softmax_out, k_arg}, {values_arg, indices_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.SoftmaxTopK"], 0);
+    EXPECT_EQ(op_to_count["Softmax"], 1);
+    EXPECT_EQ(op_to_count["TopK"], 1);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level2, 13);
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -86,7 +86,8 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
       input_names_(m.GetInputCount()),
       input_names_str_(m.GetInputCount()),
       input_length_(m.GetInputCount()),
-      run_config_entries_(performance_test_config.run_config.run_config_entries) {
+      run_config_entries_(performance_test_config.run_config.run_config_entries),
+      profiling_enabled_(!performance_test_config.run_config.profile_file.empty()) {
   Ort::SessionOptions session_options;
 
   // Add EP devices if any (created by plugin EP)
@@ -1072,6 +1073,14 @@ bool OnnxRuntimeTestSession::PopulateGeneratedInputTestData(int32_t seed) {
   }
   return true;
 }
+
+std::string OnnxRuntimeTestSession::EndProfiling() {
+  if (!profiling_enabled_) {
+    return {};
+  }
+  return session_.EndProfilingAllocated(default_allocator_).get();
+}
+
 OnnxRuntimeTestSession::~OnnxRuntimeTestSession() {
 #ifdef USE_CUDA
   if (device_memory_name_ == CUDA && stream_ != nullptr) {
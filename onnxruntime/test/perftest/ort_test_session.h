@@ -36,6 +36,8 @@ class OnnxRuntimeTestSession : public TestSession {
 
   RunTiming Run() override;
 
+  std::string EndProfiling() override;
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(OnnxRuntimeTestSession);
 
  private:
@@ -59,6 +61,7 @@ class OnnxRuntimeTestSession : public TestSession {
   std::string provider_name_;
   std::string device_memory_name_;  // Device memory type name to use from the list in allocator.h
   const std::unordered_map<std::string, std::string>& run_config_entries_;
+  const bool profiling_enabled_;
 #if defined(USE_CUDA) || defined(USE_TENSORRT) || defined(USE_NV)
   cudaStream_t stream_;  // Device stream if required by IO bindings
 #endif
@@ -7,7 +7,11 @@
 #endif
 
 #include "performance_runner.h"
+#include <iomanip>
 #include <iostream>
+#include <unordered_map>
+
+#include "nlohmann/json.hpp"
 
 #include "TestCase.h"
 #include "utils.h"
@@ -111,9 +115,90 @@ void PerformanceResult::DumpToFile(const std::basic_string<ORTCHAR_T>& path, boo
   }
 }
 
+namespace {
+
+// Prints the session events in the profile, which cover session creation, aggregated by name and sorted by their
+// total duration.
+void PrintSessionCreationProfile(const std::string& profile_file) {
+  std::ifstream profile(profile_file);
+  const auto events = nlohmann::json::parse(profile, nullptr, /*allow_exceptions*/ false);
+  if (!events.is_array()) {
+    std::cerr << "Failed to parse profile file " << profile_file << "\n";
+    return;
+  }
+
+  struct EventSummary {
+    std::string name;
+    size_t count = 0;
+    int64_t total_us = 0;
+    int64_t max_us = 0;
+    int64_t nodes_added = 0;
+    int64_t nodes_removed = 0;
+  };
+
+  auto get_int_arg = [](const nlohmann::json& event, const char* name) -> int64_t {
+    const auto args = event.find("args");
+    if (args == event.end() || !args->contains(name) || !(*args)[name].is_string()) {
+      return 0;
+    }
+    return std::stoll((*args)[name].get<std::string>());
+  };
+
+  std::vector<EventSummary> summaries;
+  std::unordered_map<std::string, size_t> summary_index;
+  for (const auto& event : events) {
+    if (!event.is_object() || event.value("cat", "") != "Session") {
+      continue;
+    }
+
+    const std::string name = event.value("name", "");
+    auto it = summary_index.find(name);
+    if (it == summary_index.end()) {
+      it = summary_index.emplace(name, summaries.size()).first;
+      summaries.push_back(EventSummary{name});
+    }
+
+    auto& summary = summaries[it->second];
+    const int64_t dur = event.value("dur", int64_t{0});
+    ++summary.count;
+    summary.total_us += dur;
+    summary.max_us = std::max(summary.max_us, dur);
+    summary.nodes_added += get_int_arg(event, "nodes_added");
+    summary.nodes_removed += get_int_arg(event, "nodes_removed");
+  }
+
+  std::stable_sort(summaries.begin(), summaries.end(), [](const EventSummary& a, const EventSummary& b) {
+    return a.total_us > b.total_us;
+  });
+
+  constexpr size_t max_rows = 30;
+  std::cout << "\nSession creation profile (top " << std::min(max_rows, summaries.size()) << " of "
+            << summaries.size() << " events by total time, full trace in " << profile_file << "):\n";
+  std::cout << std::left << std::setw(60) << "Event" << std::right << std::setw(8) << "Count" << std::setw(14)
+            << "Total (ms)" << std::setw(12) << "Max (ms)" << std::setw(10) << "Added" << std::setw(10) << "Removed"
+            << "\n";
+  std::cout << std::fixed << std::setprecision(3);
+  for (size_t i = 0; i < std::min(max_rows, summaries.size()); ++i) {
+    const auto& summary = summaries[i];
+    std::cout << std::left << std::setw(60) << summary.name.substr(0, 59) << std::right << std::setw(8)
+              << summary.count << std::setw(14) << summary.total_us / 1000.0 << std::setw(12)
+              << summary.max_us / 1000.0 << std::setw(10) << summary.nodes_added << std::setw(10)
+              << summary.nodes_removed << "\n";
+  }
+  std::cout << std::defaultfloat;
+}
+
+}  // namespace
+
 void PerformanceRunner::LogSessionCreationTime() {
   std::chrono::duration<double> session_create_duration = session_create_end_ - session_create_start_;
   std::cout << "\nSession creation time cost: " << session_create_duration.count() << " s\n";
+
+  // with profiling enabled, also summarize where the time went
+  const std::string profile_file = session_->EndProfiling();
+  if (!profile_file.empty()) {
+    PrintSessionCreationProfile(profile_file);
+  }
 }
 
 Status PerformanceRunner::Run() {
@@ -3,6 +3,7 @@
 
 #pragma once
 #include <stdlib.h>
+#include <string>
 
 #include "OrtValueList.h"
 
@@ -22,6 +23,8 @@ class TestSession {
   // Please measure the perf at a higher level.
   void ThreadSafeRun() { abort(); }
   virtual void PreLoadTestData(size_t test_data_id, size_t input_id, Ort::Value&& value) = 0;
+  // Ends profiling and returns the name of the profile file, or an empty string if profiling is not enabled.
+  virtual std::string EndProfiling() { return {}; }
 
   virtual ~TestSession() = default;
 };
@@ -257,5 +257,29 @@ TEST(CumSumTest, _1DTestLong) {
   test.AddOutput<int32_t>("y", {N}, output_value);
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
+
+// Two slices on a pool of 4 threads leave threads idle, so the axis is split into blocks that are scanned in parallel.
+TEST(CumSumTest, _3DTestLongAxis1ReverseExclusive) {
+  OpTester test("CumSum", 11, onnxruntime::kOnnxDomain);
+  test.AddAttribute<int64_t>("reverse", 1);
+  test.AddAttribute<int64_t>("exclusive", 1);
+  constexpr int64_t N = 50000;
+  std::vector<int64_t> output_value;
+  output_value.reserve(2 * N * 3);
+  for (int64_t outer = 0; outer < 2; ++outer) {
+    for (int64_t i = 0; i < N; ++i) {
+      output_value.insert(output_value.end(), 3, N - 1 - i);
+    }
+  }
+  test.AddInput<int64_t>("x", {2, N, 3}, std::vector<int64_t>(2 * N * 3, 1));
+  test.AddInput<int32_t>("axis", {}, {1});
+  test.AddOutput<int64_t>("y", {2, N, 3}, output_value);
+
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = 4;
+  test.Config(so)
+      .ConfigEp(DefaultCpuExecutionProvider())
+      .RunWithConfig();
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -245,6 +245,27 @@ TEST(Einsum, ExplicitEinsumAsMatmul_Multi_Input) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", ExcludeTrtOnA100());
 }
 
+// The last two inputs are contracted first as that gives the smallest intermediate result.
+// The right operand of that contraction is read as a transposed matrix.
+TEST(Einsum, ExplicitEinsumAsMatmul_Multi_Input_ContractionOrder) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ij,kl,lj->ik");
+  test.AddInput<float>("x", {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddInput<float>("y", {2, 4}, {1.f, 0.f, 1.f, 0.f, 0.f, 1.f, 0.f, 1.f});
+  test.AddInput<float>("z", {4, 3}, {1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f, 1.f, 1.f, 1.f});
+  test.AddOutput<float>("o", {2, 2}, {4.f, 8.f, 10.f, 20.f});
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", ExcludeTrtOnA100());
+}
+
+TEST(Einsum, ExplicitEinsumAsMatmulTransposeA_int32) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ji,jk->ik");
+  test.AddInput<int32_t>("x", {2, 2}, {1, 2, 3, 4});
+  test.AddInput<int32_t>("y", {2, 2}, {1, 2, 3, 4});
+  test.AddOutput<int32_t>("o", {2, 2}, {10, 14, 14, 20});
+  test.Run();
+}
+
 TEST(Einsum, ExplicitEinsumAsBatchedMatmul) {
   OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
   test.AddAttribute<std::string>("equation", "bij,bjk->bik");
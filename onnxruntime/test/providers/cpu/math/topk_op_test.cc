@@ -861,5 +861,31 @@ TEST(TopKOperator, SelectTopKThreaded) {
   TestThreaded<double>(k, n, batch_size);
 }
 
+// a single row long enough to be split across threads. the top values are repeated in every partition, so the merge
+// has to keep the lowest indices.
+TEST(TopKOperator, SingleLongRowWithTies) {
+  constexpr int64_t k = 10;
+  constexpr int64_t n = 200000;
+  std::vector<float> input_vals(n);
+  for (int64_t i = 0; i < n; ++i) {
+    input_vals[i] = static_cast<float>(i % 1000);
+  }
+
+  std::vector<float> expected_vals(k, 999.0f);
+  std::vector<int64_t> expected_indices(k);
+  for (int64_t i = 0; i < k; ++i) {
+    expected_indices[i] = 999 + i * 1000;
+  }
+
+  RunTest(11, k, input_vals, {1, n}, expected_vals, expected_indices, {1, k}, false);
+
+  // smallest
+  for (int64_t i = 0; i < k; ++i) {
+    expected_indices[i] = i * 1000;
+  }
+  std::fill(expected_vals.begin(), expected_vals.end(), 0.0f);
+  RunTest(11, k, input_vals, {1, n}, expected_vals, expected_indices, {1, k}, false, -1, 0);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
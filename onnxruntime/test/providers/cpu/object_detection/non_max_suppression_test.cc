@@ -404,5 +404,46 @@ TEST(NonMaxSuppressionOpTest, WithIOUThresholdOpset11) {
   test.Run();
 }
 
+// Enough batches, classes and selected boxes per class for the (batch, class) pairs to be evaluated in parallel and
+// the IOU against the selected boxes to span several blocks.
+TEST(NonMaxSuppressionOpTest, ManyBatchesAndClasses) {
+  constexpr int64_t num_batches = 3;
+  constexpr int64_t num_classes = 4;
+  constexpr int64_t num_boxes = 40;
+
+  // pairs of boxes with an IOU of about 0.9. pairs don't overlap each other.
+  std::vector<float> boxes;
+  for (int64_t batch = 0; batch < num_batches; ++batch) {
+    for (int64_t i = 0; i < num_boxes; i += 2) {
+      const float x = static_cast<float>(3 * i / 2);
+      boxes.insert(boxes.end(), {0.0f, x, 1.0f, x + 1.0f, 0.0f, x + 0.05f, 1.0f, x + 1.05f});
+    }
+  }
+
+  // even classes prefer the first box of each pair and odd classes the second one
+  std::vector<float> scores;
+  std::vector<int64_t> expected;
+  for (int64_t batch = 0; batch < num_batches; ++batch) {
+    for (int64_t c = 0; c < num_classes; ++c) {
+      for (int64_t i = 0; i < num_boxes; ++i) {
+        scores.push_back(c % 2 == 0 ? 1.0f - 0.01f * i : 0.01f * (i + 1));
+      }
+      for (int64_t i = 0; i < num_boxes; i += 2) {
+        const int64_t box = c % 2 == 0 ? i : num_boxes - 1 - i;
+        expected.insert(expected.end(), {batch, c, box});
+      }
+    }
+  }
+
+  OpTester test("NonMaxSuppression", 11, kOnnxDomain);
+  test.AddInput<float>("boxes", {num_batches, num_boxes, 4}, boxes);
+  test.AddInput<float>("scores", {num_batches, num_classes, num_boxes}, scores);
+  test.AddInput<int64_t>("max_output_boxes_per_class", {}, {100L});
+  test.AddInput<float>("iou_threshold", {}, {0.5f});
+  test.AddInput<float>("score_threshold", {}, {0.0f});
+  test.AddOutput<int64_t>("selected_indices", {static_cast<int64_t>(expected.size() / 3), 3}, expected);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
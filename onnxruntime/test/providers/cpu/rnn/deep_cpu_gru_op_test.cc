@@ -3,10 +3,12 @@
 
 #include "gtest/gtest.h"
 
+#include <cmath>
 #include <iterator>
 #include <vector>
 
 #include "core/providers/cpu/rnn/deep_cpu_gru.h"
+#include "test/common/random_generator.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/util/include/default_providers.h"
 using namespace std;
@@ -1095,5 +1097,105 @@ TEST(GRUTest, ONNXRuntime_TestGRUPositiveActivationAlphaBeta) {
   ctx.RunTest(X, batch_size, seq_length, sequence_length, &initial_h, expected_Y, expected_Y_h);
 }
 
+// Reference of one direction of a GRU with the default activations, no bias and no initial state, which writes its
+// results to the Y and Y_h of a bidirectional GRU.
+static void ComputeGruDirection(const std::vector<float>& X, const float* W, const float* R,
+                                int64_t seq_length, int64_t batch_size, int64_t input_size, int64_t hidden_size,
+                                int64_t direction, std::vector<float>& Y, std::vector<float>& Y_h) {
+  auto sigmoid = [](float x) { return 1.0f / (1.0f + std::exp(-x)); };
+  std::vector<float> gates(3 * hidden_size);
+  std::vector<float> h(hidden_size);
+  std::vector<float> next_h(hidden_size);
+  for (int64_t b = 0; b < batch_size; ++b) {
+    std::fill(h.begin(), h.end(), 0.0f);
+    for (int64_t i = 0; i < seq_length; ++i) {
+      const int64_t t = direction == 0 ? i : seq_length - 1 - i;
+      const float* x = X.data() + (t * batch_size + b) * input_size;
+      for (int64_t g = 0; g < 3 * hidden_size; ++g) {
+        float sum = 0.0f;
+        for (int64_t k = 0; k < input_size; ++k) {
+          sum += W[g * input_size + k] * x[k];
+        }
+        gates[g] = sum;
+      }
+
+      // update and reset gates
+      for (int64_t g = 0; g < 2 * hidden_size; ++g) {
+        float sum = gates[g];
+        for (int64_t k = 0; k < hidden_size; ++k) {
+          sum += R[g * hidden_size + k] * h[k];
+        }
+        gates[g] = sigmoid(sum);
+      }
+
+      for (int64_t j = 0; j < hidden_size; ++j) {
+        float sum = gates[2 * hidden_size + j];
+        for (int64_t k = 0; k < hidden_size; ++k) {
+          sum += R[(2 * hidden_size + j) * hidden_size + k] * gates[hidden_size + k] * h[k];
+        }
+        const float z = gates[j];
+        next_h[j] = (1.0f - z) * std::tanh(sum) + z * h[j];
+      }
+
+      h.swap(next_h);
+      std::copy(h.begin(), h.end(), Y.begin() + ((t * 2 + direction) * batch_size + b) * hidden_size);
+    }
+
+    std::copy(h.begin(), h.end(), Y_h.begin() + (direction * batch_size + b) * hidden_size);
+  }
+}
+
+// Runs a bidirectional GRU with a pool of 4 threads. The directions run concurrently when
+// batch_size * hidden_size^2 <= 256^2, in which case the input weights are applied to both of them beforehand with
+// the whole pool when seq_length * batch_size * input_size * hidden_size >= 64K.
+static void RunBidirectionalGruWithThreadPool(int64_t seq_length, int64_t batch_size, int64_t input_size,
+                                              int64_t hidden_size) {
+  RandomValueGenerator random{};
+  const std::vector<int64_t> X_dims{seq_length, batch_size, input_size};
+  const std::vector<int64_t> W_dims{2, 3 * hidden_size, input_size};
+  const std::vector<int64_t> R_dims{2, 3 * hidden_size, hidden_size};
+  const std::vector<float> X = random.Uniform<float>(X_dims, -1.0f, 1.0f);
+  const float weight_range = 1.0f / std::sqrt(static_cast<float>(hidden_size));
+  const std::vector<float> W = random.Uniform<float>(W_dims, -weight_range, weight_range);
+  const std::vector<float> R = random.Uniform<float>(R_dims, -weight_range, weight_range);
+
+  std::vector<float> Y(seq_length * 2 * batch_size * hidden_size);
+  std::vector<float> Y_h(2 * batch_size * hidden_size);
+  for (int64_t direction = 0; direction < 2; ++direction) {
+    ComputeGruDirection(X, W.data() + direction * 3 * hidden_size * input_size,
+                        R.data() + direction * 3 * hidden_size * hidden_size,
+                        seq_length, batch_size, input_size, hidden_size, direction, Y, Y_h);
+  }
+
+  OpTester test("GRU");
+  test.AddAttribute<std::vector<string>>("activations", {"Sigmoid", "Tanh", "Sigmoid", "Tanh"});
+  test.AddAttribute("direction", "bidirectional");
+  test.AddAttribute("hidden_size", hidden_size);
+  test.AddInput<float>("X", X_dims, X);
+  test.AddInput<float>("W", W_dims, W, true);
+  test.AddInput<float>("R", R_dims, R, true);
+  test.AddOutput<float>("Y", {seq_length, 2, batch_size, hidden_size}, Y);
+  test.AddOutput<float>("Y_h", {2, batch_size, hidden_size}, Y_h);
+  test.SetOutputTolerance(1e-4f);
+
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = 4;
+  test.Config(so)
+      .ConfigEp(DefaultCpuExecutionProvider())
+      .RunWithConfig();
+}
+
+TEST(GRUTest, BidirectionalConcurrentDirections) {
+  RunBidirectionalGruWithThreadPool(/*seq_length*/ 5, /*batch_size*/ 1, /*input_size*/ 4, /*hidden_size*/ 8);
+}
+
+TEST(GRUTest, BidirectionalConcurrentDirectionsPooledInputWeights) {
+  RunBidirectionalGruWithThreadPool(/*seq_length*/ 8, /*batch_size*/ 1, /*input_size*/ 64, /*hidden_size*/ 128);
+}
+
+TEST(GRUTest, BidirectionalSequentialDirections) {
+  RunBidirectionalGruWithThreadPool(/*seq_length*/ 3, /*batch_size*/ 2, /*input_size*/ 8, /*hidden_size*/ 256);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
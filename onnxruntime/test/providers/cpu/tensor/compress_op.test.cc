@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <memory>
+#include <numeric>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -148,5 +151,27 @@ TEST(CompressTest, Compress_3dims_neg_axis) {
   test.Run();
 }
 
+TEST(CompressTest, Compress_default_axis_multiple_blocks) {
+  OpTester test("Compress", 11);
+
+  // large enough for the condition to be counted and the input compressed in more than one block
+  constexpr int64_t N = 100000;
+  std::vector<int64_t> input(N);
+  std::iota(input.begin(), input.end(), int64_t{0});
+  std::unique_ptr<bool[]> condition = std::make_unique<bool[]>(N);
+  std::vector<int64_t> output;
+  for (int64_t i = 0; i < N; ++i) {
+    condition[i] = i % 3 == 0;
+    if (condition[i]) {
+      output.push_back(i);
+    }
+  }
+
+  test.AddInput<int64_t>("input", {N}, input);
+  test.AddInput<bool>("condition", {N}, condition.get(), N);
+  test.AddOutput<int64_t>("output", {static_cast<int64_t>(output.size())}, output);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
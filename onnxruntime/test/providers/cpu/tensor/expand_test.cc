@@ -4,15 +4,12 @@
 #include "core/util/math.h"
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
 
 #if defined(ENABLE_STRIDED_TENSORS) && defined(USE_CUDA)
 #include "test/providers/kernel_compute_test_utils.h"
 #endif
 
-#ifdef USE_WEBGPU
-#include "test/util/include/default_providers.h"
-#endif
-
 namespace onnxruntime {
 namespace test {
 
@@ -323,6 +320,44 @@ TEST(ExpandOpTest, Expand_scalar_int32) {
   test.Run();
 }
 
+// Expands an input of shape [rows, 1, inner] to [rows, middle, inner] with a pool of 4 threads. The copy is large
+// enough to be split across the threads.
+static void RunExpandWithThreadPool(int64_t rows, int64_t middle, int64_t inner) {
+  std::vector<float> input(rows * inner);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i);
+  }
+
+  std::vector<float> expected(rows * middle * inner);
+  for (int64_t r = 0; r < rows; ++r) {
+    for (int64_t m = 0; m < middle; ++m) {
+      for (int64_t i = 0; i < inner; ++i) {
+        expected[(r * middle + m) * inner + i] = input[r * inner + i];
+      }
+    }
+  }
+
+  OpTester test("Expand", 13);
+  test.AddInput<float>("data_0", {rows, 1, inner}, input);
+  test.AddInput<int64_t>("data_1", {3}, {rows, middle, inner});
+  test.AddOutput<float>("result", {rows, middle, inner}, expected);
+
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = 4;
+  test.Config(so)
+      .ConfigEp(DefaultCpuExecutionProvider())
+      .RunWithConfig();
+}
+
+// The input stride of the innermost axis is 0, so every element is a fill of a single value.
+TEST(ExpandOpTest, Expand_InnermostAxis_ThreadPool) {
+  RunExpandWithThreadPool(1024, 256, 1);
+}
+
+TEST(ExpandOpTest, Expand_MiddleAxis_ThreadPool) {
+  RunExpandWithThreadPool(16, 128, 100);
+}
+
 #if defined(ENABLE_STRIDED_TENSORS) && defined(USE_CUDA)
 TEST(ExpandOpTest, Strided) {
 #ifdef USE_CUDA
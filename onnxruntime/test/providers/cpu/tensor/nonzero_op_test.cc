@@ -109,5 +109,29 @@ TEST(NonZeroOpTest, EmptyInput) {
   test.Run();
 }
 
+TEST(NonZeroOpTest, MultipleBlocks) {
+  OpTester test{kOpName, kOpVersion};
+
+  // large enough for the input to be counted and written in more than one block
+  constexpr int64_t rows = 200, columns = 300;
+  std::vector<int32_t> X(rows * columns, 0);
+  std::vector<int64_t> row_indices, column_indices;
+  for (int64_t r = 0; r < rows; ++r) {
+    for (int64_t c = 0; c < columns; ++c) {
+      if ((r * columns + c) % 7 == 0) {
+        X[r * columns + c] = 1;
+        row_indices.push_back(r);
+        column_indices.push_back(c);
+      }
+    }
+  }
+
+  std::vector<int64_t> Y(row_indices);
+  Y.insert(Y.end(), column_indices.begin(), column_indices.end());
+  test.AddInput<int32_t>("X", {rows, columns}, X);
+  test.AddOutput<int64_t>("Y", {2, static_cast<int64_t>(row_indices.size())}, Y);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1268,6 +1268,57 @@ TEST(PadOpTest, ConstantMode_InnermostCropThenPostPad) {
   test.RunWithConfig();
 }
 
+// Constant padding with a pool of 4 threads, which fills the output and copies the input into it with a strided
+// copy. Negative pads crop the input.
+static void RunConstantPadWithThreadPool(const std::vector<int64_t>& pads) {
+  const std::vector<int64_t> input_dims{4, 128, 200};
+  std::vector<float> input(4 * 128 * 200);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i);
+  }
+
+  std::vector<int64_t> output_dims(3);
+  for (size_t axis = 0; axis < 3; ++axis) {
+    output_dims[axis] = input_dims[axis] + pads[axis] + pads[axis + 3];
+  }
+
+  const float value = -1.0f;
+  std::vector<float> expected(output_dims[0] * output_dims[1] * output_dims[2], value);
+  for (int64_t i = 0; i < output_dims[0]; ++i) {
+    for (int64_t j = 0; j < output_dims[1]; ++j) {
+      for (int64_t k = 0; k < output_dims[2]; ++k) {
+        const int64_t x = i - pads[0];
+        const int64_t y = j - pads[1];
+        const int64_t z = k - pads[2];
+        if (x >= 0 && x < input_dims[0] && y >= 0 && y < input_dims[1] && z >= 0 && z < input_dims[2]) {
+          expected[(i * output_dims[1] + j) * output_dims[2] + k] = input[(x * input_dims[1] + y) * input_dims[2] + z];
+        }
+      }
+    }
+  }
+
+  OpTester test("Pad", 18);
+  test.AddInput<float>("data", input_dims, input);
+  test.AddInput<int64_t>("pads", {static_cast<int64_t>(pads.size())}, pads, true);
+  test.AddInput<float>("constant_value", {}, {value}, true);
+  test.AddOutput<float>("output", output_dims, expected);
+  test.AddAttribute("mode", "constant");
+
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = 4;
+  test.Config(so)
+      .ConfigEp(DefaultCpuExecutionProvider())
+      .RunWithConfig();
+}
+
+TEST(PadOpTest, ConstantMode_ThreadPool) {
+  RunConstantPadWithThreadPool({1, 3, 2, 2, 0, 7});
+}
+
+TEST(PadOpTest, ConstantMode_MixedSigns_ThreadPool) {
+  RunConstantPadWithThreadPool({1, -5, 3, 0, 2, -11});
+}
+
 TEST(PadOpTest, EdgeMode_ZeroExtentFails) {
   std::vector<int64_t> input_shape = {4};
   // Generate input as above
@@ -1519,6 +1519,40 @@ TEST(ResizeOpTest, ResizeOpCubicDownSampleTest) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", ExcludeTrtOnA100());
 }
 
+// Several images, which are resized in parallel. Each image is the one of ResizeOpCubicDownSampleTest plus an offset,
+// which the cubic interpolation preserves as its coefficients sum to 1.
+TEST(ResizeOpTest, ResizeOpCubicDownSampleTest_MultiImage) {
+  OpTester test("Resize", 13);
+  std::vector<float> scales{1.0f, 1.0f, 0.8f, 0.8f};
+  std::vector<float> roi{};
+
+  test.AddAttribute("mode", "cubic");
+
+  constexpr int64_t N = 2, C = 3, H = 4, W = 4;
+  const std::vector<float> image = {
+      1.0f, 2.0f, 3.0f, 4.0f,
+      5.0f, 6.0f, 7.0f, 8.0f,
+      9.0f, 10.0f, 11.0f, 12.0f,
+      13.0f, 14.0f, 15.0f, 16.0f};
+  const std::vector<float> resized_image = {1.47119f, 2.78125f, 4.08252f,
+                                            6.71143f, 8.02148f, 9.32275f,
+                                            11.9165f, 13.2266f, 14.5278f};
+
+  std::vector<float> X;
+  std::vector<float> Y;
+  for (int64_t i = 0; i < N * C; ++i) {
+    const float offset = 10.0f * i;
+    for (float v : image) X.push_back(v + offset);
+    for (float v : resized_image) Y.push_back(v + offset);
+  }
+
+  test.AddInput<float>("X", {N, C, H, W}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {4}, scales);
+  test.AddOutput<float>("Y", {N, C, static_cast<int64_t>(H * scales[2]), static_cast<int64_t>(W * scales[3])}, Y);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", ExcludeTrtOnA100());
+}
+
 TEST(ResizeOpTest, ResizeOpCubicDownSampleTest_antialias_large_custom_coeff) {
   OpTester test("Resize", 18);
   std::vector<float> scales{};
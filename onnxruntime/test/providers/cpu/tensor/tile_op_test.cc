@@ -3,6 +3,7 @@
 
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
 
 namespace onnxruntime {
 namespace test {
@@ -357,5 +358,50 @@ TEST(TensorOpTest, TileOverflowMultipleAxes) {
   test.Run(OpTester::ExpectResult::kExpectFailure, "", {kTensorrtExecutionProvider});
 }
 
+// Tiles an input of shape [8, 16, 32] with a pool of 4 threads. The output is copied from the input viewed with a
+// repeat axis of stride 0 before each of its axes, and is large enough for the copy to be split across the threads.
+static void RunTileWithThreadPool(const std::vector<int64_t>& repeats) {
+  const std::vector<int64_t> input_dims{8, 16, 32};
+  std::vector<float> input(8 * 16 * 32);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i);
+  }
+
+  const std::vector<int64_t> output_dims{input_dims[0] * repeats[0], input_dims[1] * repeats[1],
+                                         input_dims[2] * repeats[2]};
+  std::vector<float> expected(output_dims[0] * output_dims[1] * output_dims[2]);
+  for (int64_t i = 0; i < output_dims[0]; ++i) {
+    for (int64_t j = 0; j < output_dims[1]; ++j) {
+      for (int64_t k = 0; k < output_dims[2]; ++k) {
+        expected[(i * output_dims[1] + j) * output_dims[2] + k] =
+            input[((i % input_dims[0]) * input_dims[1] + j % input_dims[1]) * input_dims[2] + k % input_dims[2]];
+      }
+    }
+  }
+
+  OpTester test("Tile", 13);
+  test.AddInput<float>("input", input_dims, input);
+  test.AddInput<int64_t>("repeats", {3}, repeats);
+  test.AddOutput<float>("output", output_dims, expected);
+
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = 4;
+  test.Config(so)
+      .ConfigEp(DefaultCpuExecutionProvider())
+      .RunWithConfig();
+}
+
+TEST(TensorOpTest, TileInnermostAxisThreadPool) {
+  RunTileWithThreadPool({1, 1, 64});
+}
+
+TEST(TensorOpTest, TileAllAxesThreadPool) {
+  RunTileWithThreadPool({2, 3, 5});
+}
+
+TEST(TensorOpTest, TileOuterAxisThreadPool) {
+  RunTileWithThreadPool({32, 1, 1});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
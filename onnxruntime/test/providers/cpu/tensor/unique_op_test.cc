@@ -1,7 +1,12 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
 #include "gtest/gtest.h"
+#include "core/providers/cpu/tensor/unique.h"
 #include "test/providers/provider_test_utils.h"
 
 namespace onnxruntime {
@@ -137,6 +142,66 @@ TEST(Unique, Flatten_Sorted_String) {
                              inverse_indices_dims, inverse_indices, counts_dims, counts);
 }
 
+// enough entries for the hash table to grow several times, with the unique values first occurring out of order
+TEST(Unique, Flatten_ManyRepeatedValues) {
+  constexpr int64_t num_values = 2000;
+  constexpr int64_t num_unique = 97;
+  std::vector<int64_t> X(num_values);
+  for (int64_t i = 0; i < num_values; ++i) {
+    X[i] = (i * 7919) % num_unique;
+  }
+
+  for (bool sorted : {false, true}) {
+    std::vector<int64_t> Y;
+    std::vector<int64_t> indices;
+    std::vector<int64_t> counts;
+    for (int64_t i = 0; i < num_values; ++i) {
+      if (std::find(Y.begin(), Y.end(), X[i]) == Y.end()) {
+        Y.push_back(X[i]);
+        indices.push_back(i);
+      }
+    }
+
+    if (sorted) {
+      std::vector<size_t> order(Y.size());
+      std::iota(order.begin(), order.end(), size_t{0});
+      std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) { return Y[lhs] < Y[rhs]; });
+      std::vector<int64_t> sorted_Y, sorted_indices;
+      for (size_t i : order) {
+        sorted_Y.push_back(Y[i]);
+        sorted_indices.push_back(indices[i]);
+      }
+      Y = std::move(sorted_Y);
+      indices = std::move(sorted_indices);
+    }
+
+    std::vector<int64_t> inverse_indices;
+    counts.assign(Y.size(), 0);
+    for (int64_t x : X) {
+      const auto idx = std::find(Y.begin(), Y.end(), x) - Y.begin();
+      inverse_indices.push_back(idx);
+      ++counts[idx];
+    }
+
+    const std::vector<int64_t> unique_dims{static_cast<int64_t>(Y.size())};
+    RunUniqueTest<int64_t>({num_values}, X, nullptr, sorted, unique_dims, Y, unique_dims, indices,
+                           {num_values}, inverse_indices, unique_dims, counts);
+  }
+}
+
+// each NaN is a separate unique value, and NaNs are sorted after all other values in order of first occurrence
+TEST(Unique, Flatten_NaN) {
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const std::vector<int64_t> X_dims{6};
+  const std::vector<float> X{2.f, nan, 1.f, nan, 2.f, 1.f};
+  const std::vector<int64_t> unique_dims{4};
+
+  RunUniqueTest<float>(X_dims, X, nullptr, false, unique_dims, {2.f, nan, 1.f, nan}, unique_dims, {0, 1, 2, 3},
+                       X_dims, {0, 1, 2, 3, 0, 2}, unique_dims, {2, 1, 2, 1});
+  RunUniqueTest<float>(X_dims, X, nullptr, true, unique_dims, {1.f, 2.f, nan, nan}, unique_dims, {2, 0, 1, 3},
+                       X_dims, {1, 2, 0, 3, 1, 0}, unique_dims, {2, 2, 1, 1});
+}
+
 TEST(Unique, NoOptionalOutput) {
   const std::vector<int64_t> X_dims{2, 4};
   const std::vector<int8_t> X{1, 4, -1, 2, 2, 0, -1, 4};
@@ -353,6 +418,72 @@ TEST(Unique, Axis2_Sorted) {
                          inverse_indices_dims, inverse_indices, counts_dims, counts);
 }
 
+// enough slices for the hash table to grow several times, with the unique slices first occurring out of order
+TEST(Unique, Axis1_ManyRepeatedSlices) {
+  constexpr int64_t rows = 2;
+  constexpr int64_t num_slices = 300;
+  constexpr int64_t columns = 3;
+  constexpr int64_t num_unique = 17;
+  constexpr int64_t axis = 1;
+
+  // the slice with key k holds k * 10 + row * columns + column, so slices sort by key
+  auto key_of_slice = [](int64_t slice) { return (slice * 31) % num_unique; };
+  auto fill_slice = [&](std::vector<int64_t>& data, int64_t slices, int64_t slice, int64_t key) {
+    for (int64_t r = 0; r < rows; ++r) {
+      for (int64_t c = 0; c < columns; ++c) {
+        data[(r * slices + slice) * columns + c] = key * 10 + r * columns + c;
+      }
+    }
+  };
+
+  std::vector<int64_t> X(rows * num_slices * columns);
+  for (int64_t i = 0; i < num_slices; ++i) {
+    fill_slice(X, num_slices, i, key_of_slice(i));
+  }
+
+  for (bool sorted : {false, true}) {
+    std::vector<int64_t> keys;
+    std::vector<int64_t> indices;
+    for (int64_t i = 0; i < num_slices; ++i) {
+      if (std::find(keys.begin(), keys.end(), key_of_slice(i)) == keys.end()) {
+        keys.push_back(key_of_slice(i));
+        indices.push_back(i);
+      }
+    }
+
+    if (sorted) {
+      std::vector<size_t> order(keys.size());
+      std::iota(order.begin(), order.end(), size_t{0});
+      std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) { return keys[lhs] < keys[rhs]; });
+      std::vector<int64_t> sorted_keys, sorted_indices;
+      for (size_t i : order) {
+        sorted_keys.push_back(keys[i]);
+        sorted_indices.push_back(indices[i]);
+      }
+      keys = std::move(sorted_keys);
+      indices = std::move(sorted_indices);
+    }
+
+    const auto num_keys = static_cast<int64_t>(keys.size());
+    std::vector<int64_t> Y(rows * num_keys * columns);
+    for (int64_t i = 0; i < num_keys; ++i) {
+      fill_slice(Y, num_keys, i, keys[i]);
+    }
+
+    std::vector<int64_t> inverse_indices;
+    std::vector<int64_t> counts(keys.size(), 0);
+    for (int64_t i = 0; i < num_slices; ++i) {
+      const auto idx = std::find(keys.begin(), keys.end(), key_of_slice(i)) - keys.begin();
+      inverse_indices.push_back(idx);
+      ++counts[idx];
+    }
+
+    const std::vector<int64_t> unique_dims{num_keys};
+    RunUniqueTest<int64_t>({rows, num_slices, columns}, X, &axis, sorted, {rows, num_keys, columns}, Y,
+                           unique_dims, indices, {num_slices}, inverse_indices, unique_dims, counts);
+  }
+}
+
 TEST(Unique, InvalidAxis) {
   constexpr int64_t axis = 12;
   const std::vector<int64_t> X_dims{2, 3};
@@ -394,5 +525,20 @@ TEST(Unique, EmptyInput) {
   test.Run();
 }
 
+// unsorted output keeps the order of first occurrence, and sorting keeps equivalent NaNs in that order
+TEST(Unique, OutputOrder) {
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const std::vector<float> data{nan, 3.f, 1.f, nan, 3.f, 0.f};
+  unique_helpers::UniqueEntries entries;
+  unique_helpers::FindUniqueValues<float>(data, entries);
+  ASSERT_EQ(entries.Size(), 5U);
+
+  auto less = [&data](int64_t lhs, int64_t rhs) {
+    return unique_helpers::Less(data[static_cast<size_t>(lhs)], data[static_cast<size_t>(rhs)]);
+  };
+  EXPECT_EQ(unique_helpers::GetOutputOrder(entries, false, less), (std::vector<int64_t>{0, 1, 2, 3, 4}));
+  EXPECT_EQ(unique_helpers::GetOutputOrder(entries, true, less), (std::vector<int64_t>{4, 2, 1, 0, 3}));
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,130 @@
+# -------------------------------------------------------------------------
+# Copyright (c) Microsoft Corporation.  All rights reserved.
+# Licensed under the MIT License.
+# --------------------------------------------------------------------------
+
+"""
+Benchmark token generation of CPU GroupQueryAttention with a float32 and an int8 KV cache.
+
+Each step attends a single new token to a past of the given length, with the cache shared between past and present
+as done by generation loops. The int8 cache is read without being dequantized to a float copy, so it is expected to
+be faster once the cache no longer fits in the last level cache.
+"""
+
+import argparse
+import time
+
+import numpy
+from onnx import TensorProto
+from test_gqa import GQAConfig, create_group_query_attention_graph_past
+
+from onnxruntime import InferenceSession, OrtValue, SessionOptions
+
+
+def benchmark(
+    batch_size: int,
+    num_heads: int,
+    kv_num_heads: int,
+    head_size: int,
+    past_sequence_length: int,
+    kv_cache_type: str,
+    intra_op_num_threads: int,
+    warmup: int = 5,
+    repeat: int = 50,
+):
+    quantized = kv_cache_type == "int8"
+    config = GQAConfig(
+        batch_size=batch_size,
+        q_sequence_length=1,
+        kv_sequence_length=1,
+        num_heads=num_heads,
+        kv_num_heads=kv_num_heads,
+        head_size=head_size,
+        past_kv_sequence_length=past_sequence_length,
+        buffer_sequence_length=past_sequence_length + 1,
+        kv_cache_type=kv_cache_type,
+        k_quant_type="PER_TENSOR" if quantized else "NONE",
+        v_quant_type="PER_TENSOR" if quantized else "NONE",
+        kv_cache_bit_width=8 if quantized else 0,
+    )
+
+    sess_options = SessionOptions()
+    sess_options.intra_op_num_threads = intra_op_num_threads
+    session = InferenceSession(
+        create_group_query_attention_graph_past(config, TensorProto.FLOAT, share_buffer=True),
+        sess_options,
+        providers=["CPUExecutionProvider"],
+    )
+
+    rng = numpy.random.default_rng(0)
+    kv_hidden_size = kv_num_heads * head_size
+    cache_shape = (batch_size, kv_num_heads, config.buffer_sequence_length, head_size)
+    if quantized:
+        past_key = rng.integers(-127, 128, size=cache_shape, dtype=numpy.int8)
+        past_value = rng.integers(-127, 128, size=cache_shape, dtype=numpy.int8)
+    else:
+        past_key = rng.standard_normal(cache_shape, dtype=numpy.float32)
+        past_value = rng.standard_normal(cache_shape, dtype=numpy.float32)
+
+    feeds = {
+        "query": rng.standard_normal((batch_size, 1, num_heads * head_size), dtype=numpy.float32),
+        "key": rng.standard_normal((batch_size, 1, kv_hidden_size), dtype=numpy.float32),
+        "value": rng.standard_normal((batch_size, 1, kv_hidden_size), dtype=numpy.float32),
+        "seqlens_k": numpy.full((batch_size,), past_sequence_length, dtype=numpy.int32),
+        "total_sequence_length": numpy.array([past_sequence_length + 1], dtype=numpy.int32),
+    }
+    if quantized:
+        feeds["k_scale"] = numpy.array([0.02], dtype=numpy.float32)
+        feeds["v_scale"] = numpy.array([0.02], dtype=numpy.float32)
+
+    # The present outputs are bound to the past buffers so that the cache is updated in place.
+    io_binding = session.io_binding()
+    for name, value in feeds.items():
+        io_binding.bind_cpu_input(name, value)
+    past_key_value = OrtValue.ortvalue_from_numpy(past_key)
+    past_value_value = OrtValue.ortvalue_from_numpy(past_value)
+    io_binding.bind_ortvalue_input("past_key", past_key_value)
+    io_binding.bind_ortvalue_input("past_value", past_value_value)
+    io_binding.bind_ortvalue_output("present_key", past_key_value)
+    io_binding.bind_ortvalue_output("present_value", past_value_value)
+    io_binding.bind_output("output")
+
+    for _ in range(warmup):
+        session.run_with_iobinding(io_binding)
+
+    start = time.perf_counter()
+    for _ in range(repeat):
+        session.run_with_iobinding(io_binding)
+    latency_ms = (time.perf_counter() - start) * 1000 / repeat
+
+    cache_mb = (past_key.nbytes + past_value.nbytes) / (1024 * 1024)
+    return latency_ms, batch_size * 1000 / latency_ms, cache_mb
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--batch_size", type=int, default=1)
+    parser.add_argument("--num_heads", type=int, default=32)
+    parser.add_argument("--kv_num_heads", type=int, default=8)
+    parser.add_argument("--head_size", type=int, default=128)
+    parser.add_argument("--intra_op_num_threads", type=int, default=0)
+    parser.add_argument("--past_sequence_lengths", type=int, nargs="+", default=[256, 1024, 4096, 16384])
+    args = parser.parse_args()
+
+    print("past_sequence_length,kv_cache_type,cache_mb,latency_ms,tokens_per_second")
+    for past_sequence_length in args.past_sequence_lengths:
+        for kv_cache_type in ["float32", "int8"]:
+            latency_ms, tokens_per_second, cache_mb = benchmark(
+                args.batch_size,
+                args.num_heads,
+                args.kv_num_heads,
+                args.head_size,
+                past_sequence_length,
+                kv_cache_type,
+                args.intra_op_num_threads,
+            )
+            print(f"{past_sequence_length},{kv_cache_type},{cache_mb:.1f},{latency_ms:.3f},{tokens_per_second:.1f}")
+
+
+if __name__ == "__main__":
+    main()
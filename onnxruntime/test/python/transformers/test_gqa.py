@@ -1920,6 +1920,47 @@ def gqa_cuda_quantized_test_cases(is_past: bool):
                     yield q_name, q_config
 
 
+def gqa_cpu_quantized_test_cases(is_past: bool):
+    # The CPU kernel supports a static int8 KV cache for float32 inputs only.
+    batches = [1, 2]
+    seqs = [(1, 64), (3, 32)] if is_past else [(16, 16), (33, 33)]
+    heads = [(8, 2), (4, 4)]
+    h_sizes = [64, 80]
+
+    combo_index = 0
+    for h in h_sizes:
+        for packed in [False, True]:
+            for rotary in [False, True]:
+                for quant_mode in ["PER_TENSOR", "PER_CHANNEL"]:
+                    b = batches[combo_index % len(batches)]
+                    s, s2 = seqs[combo_index % len(seqs)]
+                    n, n2 = heads[combo_index % len(heads)]
+                    lws = [-1, max(1, (s + s2) // 2)][combo_index % 2]
+                    combo_index += 1
+
+                    config = GQAConfig(
+                        batch_size=b,
+                        q_sequence_length=s,
+                        kv_sequence_length=s if is_past else s2,
+                        past_kv_sequence_length=s2 if is_past else 0,
+                        buffer_sequence_length=s + s2 + 8,
+                        num_heads=n,
+                        kv_num_heads=n2,
+                        head_size=h,
+                        local_window_size=lws,
+                        rotary=rotary,
+                        rotary_interleaved=False,
+                        packed=packed,
+                        share_buffer=True,
+                        k_quant_type=quant_mode,
+                        v_quant_type=quant_mode,
+                        kv_cache_type="int8",
+                        kv_cache_bit_width=8,
+                    )
+                    name = f"b{b}_s{s}_{s2}_nh{n}_{n2}_h{h}_w{lws}_rot{rotary}_pkd{packed}_quant_int8_{quant_mode}"
+                    yield name, config
+
+
 # #################################################################################################
 #  Unit Test Classes
 # #################################################################################################
@@ -1948,6 +1989,7 @@ rtol = {
     "fp16": 5e-3,
     "bf16": 5e-2,
     "int8_fp16": 5e-2,
+    "int8_fp32": 5e-2,
     "int4_fp16": 5e-2,
     "int8_bf16": 5e-2,
     "int4_bf16": 5e-2,
@@ -1958,6 +2000,7 @@ atol = {
     "fp16": 5e-3,
     "bf16": 1e-2,
     "int8_fp16": 1e-1,
+    "int8_fp32": 5e-2,
     "int4_fp16": 1e-1,
     "int8_bf16": 2e-1,
     "int4_bf16": 2e-1,
@@ -2129,6 +2172,51 @@ class TestFlashGQABF16QuantizedKV(unittest.TestCase):
         )
 
 
+@unittest.skipIf(not has_quantized_kv_cache(), "Quantized KV Cache is not available, skipping tests.")
+class TestCpuGQAQuantizedKV(unittest.TestCase):
+    def manual_seed(self):
+        torch.manual_seed(0)
+        random.seed(69)
+        numpy.random.seed(42)
+
+    def setUp(self):
+        self.manual_seed()
+
+    @parameterized.expand(gqa_cpu_quantized_test_cases(is_past=False))
+    def test_gqa_quantized_prompt_cpu(self, name, config):
+        if enable_debug_print:
+            print("-" * 20)
+            print(f"test_case: {name}\n{config}")
+
+        parity_check_gqa_prompt(
+            config=config,
+            ep="CPUExecutionProvider",
+            device="cpu",
+            torch_type=torch.float32,
+            ort_type=TensorProto.FLOAT,
+            causal=True,
+            rtol=rtol["int8_fp32"],
+            atol=atol["int8_fp32"],
+        )
+
+    @parameterized.expand(gqa_cpu_quantized_test_cases(is_past=True))
+    def test_gqa_quantized_past_cpu(self, name, config):
+        if enable_debug_print:
+            print("-" * 20)
+            print(f"test_case: {name}\n{config}")
+
+        parity_check_gqa_past(
+            config=config,
+            ep="CPUExecutionProvider",
+            device="cpu",
+            torch_type=torch.float32,
+            ort_type=TensorProto.FLOAT,
+            causal=True,
+            rtol=rtol["int8_fp32"],
+            atol=atol["int8_fp32"],
+        )
+
+
 @unittest.skipIf(not has_cuda_device(53), "Memory Efficient Attention is not available, skipping tests.")
 class TestMemoryEfficientGQA(unittest.TestCase):
     @parameterized.expand(gqa_cuda_prompt_test_cases(allow_head_sink=False))
@@ -795,6 +795,7 @@ def gqa_prompt_func(
     use_smooth_softmax=False,
     ort_type=TensorProto.FLOAT16,
     numpy_type=numpy.float16,
+    prefill_chunk_size=0,
 ):
     onnx_model_str = create_group_query_attention_graph_prompt(
         config,
@@ -827,6 +828,8 @@ def gqa_prompt_func(
         new_v = torch.reshape(new_v, (config.batch_size, config.kv_sequence_length, -1))
 
     sess_options = SessionOptions()
+    if prefill_chunk_size > 0:
+        sess_options.add_session_config_entry("attention.prefill_chunk_size", str(prefill_chunk_size))
     ort_session = InferenceSession(onnx_model_str, sess_options, providers=["CPUExecutionProvider"])
     io_binding = ort_session.io_binding()
     ort_outputs = {}
@@ -953,6 +956,7 @@ def gqa_past_func(
     use_smooth_softmax=False,
     ort_type=TensorProto.FLOAT16,
     numpy_type=numpy.float16,
+    prefill_chunk_size=0,
 ):
     assert seqlens_k is not None
     onnx_model_str = create_group_query_attention_graph_past(
@@ -985,6 +989,8 @@ def gqa_past_func(
         new_v = torch.reshape(new_v, (config.batch_size, config.sequence_length, -1))
 
     sess_options = SessionOptions()
+    if prefill_chunk_size > 0:
+        sess_options.add_session_config_entry("attention.prefill_chunk_size", str(prefill_chunk_size))
     ort_session = InferenceSession(onnx_model_str, sess_options, providers=["CPUExecutionProvider"])
     io_binding = ort_session.io_binding()
     ort_outputs = {}
@@ -1335,6 +1341,7 @@ def parity_check_gqa_prompt(
     use_smooth_softmax=False,
     rtol=RTOL,
     atol=ATOL,
+    prefill_chunk_size=0,
 ):
     q = torch.randn(
         config.batch_size,
@@ -1510,6 +1517,7 @@ def parity_check_gqa_prompt(
             use_smooth_softmax=use_smooth_softmax,
             ort_type=ort_type,
             numpy_type=numpy_type,
+            prefill_chunk_size=prefill_chunk_size,
         )
     else:
         out, present_k, present_v, out_qk = gqa_prompt_func(
@@ -1534,6 +1542,7 @@ def parity_check_gqa_prompt(
             use_smooth_softmax=use_smooth_softmax,
             ort_type=ort_type,
             numpy_type=numpy_type,
+            prefill_chunk_size=prefill_chunk_size,
         )
     out = torch.squeeze(out, 0)
     out = torch.reshape(out, (config.batch_size, config.q_sequence_length, config.num_heads, config.head_size))
@@ -1880,6 +1889,7 @@ def parity_check_gqa_past(
     use_smooth_softmax=False,
     rtol=RTOL,
     atol=ATOL,
+    prefill_chunk_size=0,
 ):
     q = torch.randn(
         config.batch_size,
@@ -2061,6 +2071,7 @@ def parity_check_gqa_past(
             use_smooth_softmax=use_smooth_softmax,
             ort_type=ort_type,
             numpy_type=numpy_type,
+            prefill_chunk_size=prefill_chunk_size,
         )
     else:
         out, present_k, present_v, out_qk = gqa_past_func(
@@ -2085,6 +2096,7 @@ def parity_check_gqa_past(
             use_smooth_softmax=use_smooth_softmax,
             ort_type=ort_type,
             numpy_type=numpy_type,
+            prefill_chunk_size=prefill_chunk_size,
         )
     out = torch.squeeze(out, 0)
     out = torch.reshape(out, (config.batch_size, config.sequence_length, config.num_heads, config.head_size))
@@ -2682,6 +2694,39 @@ class TestGQA(unittest.TestCase):
             additional_params={"softcap": 0.0, "use_smooth_softmax": False},
         )
 
+    def test_gqa_chunked_prefill(self):
+        print("-------- TEST GQA CHUNKED PREFILL ---------")
+        batches = [1, 3]
+        pos_ids_attn_bias = [(False, False), (True, True), (False, True), (True, False)]
+        num_h = [(6, 3), (9, 9)]
+        h_sizes = [32, 80]
+        # Q*K' output is not chunked, so only test without it.
+        qk_output = [QKOutputType.NO_OUTPUT]
+
+        for chunk_size in [1, 16]:
+            self.run_test_config(
+                parity_check_gqa_prompt,
+                PromptConfig,
+                batches,
+                [(35, 35), (127, 127)],
+                num_h,
+                h_sizes,
+                pos_ids_attn_bias,
+                qk_output,
+                additional_params={"prefill_chunk_size": chunk_size},
+            )
+            self.run_test_config(
+                parity_check_gqa_past,
+                Config,
+                [1],
+                [(33, 128), (64, 256)],
+                num_h,
+                h_sizes,
+                pos_ids_attn_bias,
+                qk_output,
+                additional_params={"prefill_chunk_size": chunk_size},
+            )
+
 
 if __name__ == "__main__":
     unittest.main()